@@ -0,0 +1,265 @@
+// host/audiobench.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+/**
+ * @file
+ * Benchmark of the software mixer.
+ *
+ * Plays the sound effects of the game in a loop on the given number of
+ * voices, each with its own volume, pan and start delay, through the same
+ * Voice class as the Wii build. The mix is rendered one 60 Hz frame at a
+ * time, to a WAV file or to nothing, through the effects of the game; it
+ * is muffled for the second half, as under the HOME screen. The throughput
+ * is printed as seconds of voices mixed per second of CPU time, with a
+ * hash of the output: a change of the mixer that should not change the
+ * sound must keep it.
+ *
+ * Then each kernel of MixKernels is run on a block of noise, in its scalar
+ * and vector version, and its speed is printed in samples per second with
+ * the largest difference between the two versions.
+ *
+ * Usage: wtt-audiobench [voices] [seconds] [output.wav]
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <memory>
+#include <vector>
+#include "audiosink.h"
+#include "decodedsound.h"
+#include "mixeffects.h"
+#include "mixkernels.h"
+#include "softaudio.h"
+#include "voice.h"
+
+#include "button_rollover_sfx.h"
+#include "screen_change_sfx.h"
+
+/**
+ * Sink computing an FNV-1a hash of the samples, then passing them on.
+ */
+class HashSink : public AudioSink
+{
+public:
+    explicit HashSink(AudioSink &ANext) :
+        Next(ANext)
+    {
+    }
+
+    void Write(std::span<const s16> Samples) override
+    {
+        for(const s16 Sample : Samples)
+        {
+            const u16 Value = static_cast<u16>(Sample);
+            Hash = (Hash ^ (Value & 0xFF)) * 16777619u;
+            Hash = (Hash ^ (Value >> 8)) * 16777619u;
+        }
+        Next.Write(Samples);
+    }
+
+    [[nodiscard]] u32 GetHash() const
+    {
+        return Hash;
+    }
+private:
+    AudioSink &Next;
+    u32 Hash{2166136261u};
+};
+
+static constexpr size_t KERNEL_FRAMES = 4096;     /**< Frames of the block given to the kernels. */
+static constexpr u32 KERNEL_ITERATIONS = 10000;   /**< Times each kernel processes the block. */
+
+/**
+ * Get the CPU time of a kernel.
+ * The block is copied from the source before each pass, so every pass
+ * processes the same samples.
+ * @param[in] Kernel Called with the block to process in place, and the pass.
+ * @param[in] Source The samples the block starts with.
+ * @return The CPU time of all the passes, in seconds.
+ */
+template <typename Function>
+static double TimeKernel(Function Kernel, const std::vector<s16> &Source)
+{
+    std::vector<s16> Block(Source.size());
+    const std::clock_t Start = std::clock();
+    for(u32 i = 0; i < KERNEL_ITERATIONS; ++i)
+    {
+        std::copy(Source.begin(), Source.end(), Block.begin());
+        Kernel(std::span<s16>{Block}, i);
+    }
+    return static_cast<double>(std::clock() - Start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * Get the speed of a kernel, without the time spent copying the block.
+ * @param[in] Kernel Called with the block to process in place, and the pass.
+ * @param[in] Source The samples the block starts with.
+ * @return The samples processed per second of CPU time.
+ */
+template <typename Function>
+static double GetKernelSpeed(Function Kernel, const std::vector<s16> &Source)
+{
+    static const double CopySeconds = TimeKernel([](std::span<s16>, u32) {}, Source);
+    const double CpuSeconds = TimeKernel(Kernel, Source) - CopySeconds;
+    return (CpuSeconds > 0.0) ? static_cast<double>(Source.size()) * KERNEL_ITERATIONS / CpuSeconds : 0.0;
+}
+
+/**
+ * Compare the scalar and vector versions of a kernel and print their speed.
+ * @param[in] Name Name of the kernel.
+ * @param[in] Scalar The scalar version.
+ * @param[in] Vector The vector version.
+ * @param[in] Source The samples given to the kernel.
+ */
+template <typename Function>
+static void BenchKernel(const char *Name, Function Scalar, Function Vector, const std::vector<s16> &Source)
+{
+    std::vector<s16> Expected(Source);
+    std::vector<s16> Actual(Source);
+    Scalar(std::span<s16>{Expected}, 0);
+    Vector(std::span<s16>{Actual}, 0);
+    s32 Difference = 0;
+    for(size_t i = 0; i < Source.size(); ++i)
+    {
+        Difference = std::max(Difference, std::abs(Expected[i] - Actual[i]));
+    }
+
+    const double ScalarSpeed = GetKernelSpeed(Scalar, Source);
+    const double VectorSpeed = GetKernelSpeed(Vector, Source);
+    std::printf("%s: scalar %.1f M samples/s, vector %.1f M samples/s (%.2fx), max difference %d\n",
+        Name, ScalarSpeed / 1e6, VectorSpeed / 1e6, (ScalarSpeed > 0.0) ? VectorSpeed / ScalarSpeed : 0.0,
+        Difference);
+}
+
+/**
+ * Benchmark each kernel of MixKernels.
+ */
+static void BenchKernels()
+{
+    using namespace MixKernels;
+    using Kernel = void (*)(std::span<s16>, u32);
+
+    std::vector<s16> Noise(KERNEL_FRAMES * 2);
+    u32 Seed = 12345;
+    for(s16 &Sample : Noise)
+    {
+        Seed = Seed * 1664525u + 1013904223u;
+        Sample = static_cast<s16>(Seed >> 16);
+    }
+
+    static constexpr StereoGain Panned = {GAIN_ONE, GAIN_ONE / 2};
+    static constexpr StereoGain Quiet = {GAIN_ONE / 4, GAIN_ONE / 3};
+    static const f32 Coefficient = GetLowPassCoefficient(MixEffects::MUFFLED_CUTOFF, SoftAudio::SAMPLE_RATE);
+
+    std::printf("vector unit: %s\n", HAS_VECTOR_UNIT ? "yes" : "no, the game uses the scalar kernels");
+    BenchKernel("gain",
+        Kernel{[](std::span<s16> Block, u32) { Scalar::Gain(Block, Panned); }},
+        Kernel{[](std::span<s16> Block, u32) { Vector::Gain(Block, Panned); }}, Noise);
+    BenchKernel("gain ramp",
+        Kernel{[](std::span<s16> Block, u32 i) { Scalar::GainRamp(Block, (i & 1) ? Quiet : Panned, (i & 1) ? Panned : Quiet); }},
+        Kernel{[](std::span<s16> Block, u32 i) { Vector::GainRamp(Block, (i & 1) ? Quiet : Panned, (i & 1) ? Panned : Quiet); }},
+        Noise);
+    static LowPassState ScalarState;
+    static LowPassState VectorState;
+    BenchKernel("low-pass",
+        Kernel{[](std::span<s16> Block, u32) { Scalar::LowPass(Block, Coefficient, ScalarState); }},
+        Kernel{[](std::span<s16> Block, u32) { Vector::LowPass(Block, Coefficient, VectorState); }}, Noise);
+}
+
+/**
+ * Entry point.
+ * @param[in] argc The number of arguments invoked with the program.
+ * @param[in] argv The array containing the arguments.
+ * @return 0 on success, an error code otherwise.
+ */
+int main(int argc, char **argv)
+{
+    const u32 VoiceCount = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 16;
+    const u32 Seconds = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 60;
+    const char *Output = (argc > 3) ? argv[3] : nullptr;
+
+    NullSink Null;
+    std::unique_ptr<WavSink> Wav;
+    if(Output != nullptr)
+    {
+        Wav = std::make_unique<WavSink>(Output, SoftAudio::SAMPLE_RATE);
+        if(!Wav->IsOpen())
+        {
+            std::fprintf(stderr, "wtt-audiobench: cannot create %s\n", Output);
+            return 1;
+        }
+    }
+    HashSink Sink(Wav ? static_cast<AudioSink&>(*Wav) : Null);
+
+    auto Backend = std::make_unique<SoftAudio>(Sink);
+    SoftAudio &Soft = *Backend;
+    SetAudioBackend(std::move(Backend));
+    Soft.Initialize();
+    MixEffects Effects(SoftAudio::SAMPLE_RATE);
+    Soft.SetEffects(&Effects);
+
+    // Compressed effects are decoded like the game does
+    std::vector<std::unique_ptr<DecodedSound>> Decoded;
+    std::vector<const Sound*> Sounds;
+    for(const Sound *Effect : {&screen_change_sfx, &button_rollover_sfx})
+    {
+        if(Effect->GetFormat() == SoundFormat::MonoAdpcm)
+        {
+            Effect = &Decoded.emplace_back(std::make_unique<DecodedSound>(*Effect))->Get();
+        }
+        Sounds.push_back(Effect);
+    }
+    std::vector<std::unique_ptr<Voice>> Voices;
+    for(u32 i = 0; i < VoiceCount; ++i)
+    {
+        auto &Item = Voices.emplace_back(std::make_unique<Voice>());
+        const u16 Volume = 255 - (i * 37) % 128;
+        const f32 Pan = ((i % 5) - 2) * 0.5f;
+        Item->SetVolume(static_cast<u16>(Volume * std::min(1.0f, 1.0f - Pan)),
+            static_cast<u16>(Volume * std::min(1.0f, 1.0f + Pan)));
+        Item->Play(*Sounds[i % Sounds.size()], i * 7, true);
+    }
+
+    const u64 TotalFrames = static_cast<u64>(Seconds) * SoftAudio::SAMPLE_RATE;
+    const u32 FramesPerTick = SoftAudio::SAMPLE_RATE / 60;
+    const std::clock_t Start = std::clock();
+    for(u64 Rendered = 0; Rendered < TotalFrames; Rendered += FramesPerTick)
+    {
+        Effects.SetMuffled(Rendered >= TotalFrames / 2);
+        Soft.Render(static_cast<u32>(std::min<u64>(FramesPerTick, TotalFrames - Rendered)));
+    }
+    const double CpuSeconds = static_cast<double>(std::clock() - Start) / CLOCKS_PER_SEC;
+
+    Voices.clear();
+    Soft.SetEffects(nullptr);
+    Soft.Exit();
+
+    std::printf("voices: %u\n", VoiceCount);
+    std::printf("audio: %u s at %u Hz\n", Seconds, SoftAudio::SAMPLE_RATE);
+    std::printf("cpu time: %.3f s\n", CpuSeconds);
+    if(CpuSeconds > 0.0)
+    {
+        std::printf("throughput: %.1f voice-seconds per cpu second (%.1fx real time)\n",
+            VoiceCount * Seconds / CpuSeconds, Seconds / CpuSeconds);
+    }
+    std::printf("output hash: %08x\n", Sink.GetHash());
+    if(Output != nullptr)
+    {
+        std::printf("output: %s\n", Output);
+    }
+
+    BenchKernels();
+    return 0;
+}
+
+// EOF
@@ -0,0 +1,119 @@
+// host/audiosink.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#include <array>
+#include "audiosink.h"
+
+/**
+ * Drop the samples.
+ * @param[in] Samples The samples.
+ */
+void NullSink::Write(std::span<const s16>)
+{
+}
+
+/**
+ * Constructor for the WavSink class.
+ * @param[in] Path Path of the file, it is replaced.
+ * @param[in] ARate Sample rate of the frames.
+ */
+WavSink::WavSink(const char *Path, u32 ARate) :
+    File(std::fopen(Path, "wb")),
+    Rate(ARate)
+{
+    if(File != nullptr)
+    {
+        WriteHeader();
+    }
+}
+
+/**
+ * Destructor for the WavSink class.
+ * The sizes of the header are written when the file is closed.
+ */
+WavSink::~WavSink()
+{
+    if(File != nullptr)
+    {
+        std::fseek(File, 0, SEEK_SET);
+        WriteHeader();
+        std::fclose(File);
+    }
+}
+
+/**
+ * Append samples to the file, as little-endian.
+ * @param[in] Samples Interleaved stereo samples.
+ */
+void WavSink::Write(std::span<const s16> Samples)
+{
+    if(File == nullptr)
+    {
+        return;
+    }
+    for(const s16 Sample : Samples)
+    {
+        const u16 Value = static_cast<u16>(Sample);
+        std::fputc(Value & 0xFF, File);
+        std::fputc(Value >> 8, File);
+    }
+    DataSize += Samples.size_bytes();
+}
+
+/**
+ * Check if the file could be created.
+ * @return true if the file is open, false otherwise.
+ */
+bool WavSink::IsOpen() const
+{
+    return File != nullptr;
+}
+
+/**
+ * Write the RIFF header, with the size of the data written so far.
+ */
+void WavSink::WriteHeader()
+{
+    constexpr u16 CHANNELS = 2;
+    constexpr u16 BITS = 16;
+    std::array<u8, 44> Header{};
+    size_t Pos = 0;
+    const auto Put = [&Header, &Pos](u32 Value, u32 Bytes)
+    {
+        for(u32 i = 0; i < Bytes; ++i)
+        {
+            Header[Pos++] = static_cast<u8>(Value >> (i * 8));
+        }
+    };
+    const auto Tag = [&Header, &Pos](const char *Name)
+    {
+        for(u32 i = 0; i < 4; ++i)
+        {
+            Header[Pos++] = static_cast<u8>(Name[i]);
+        }
+    };
+    Tag("RIFF");
+    Put(36 + DataSize, 4);
+    Tag("WAVE");
+    Tag("fmt ");
+    Put(16, 4);
+    Put(1, 2);  // PCM
+    Put(CHANNELS, 2);
+    Put(Rate, 4);
+    Put(Rate * CHANNELS * BITS / 8, 4);
+    Put(CHANNELS * BITS / 8, 2);
+    Put(BITS, 2);
+    Tag("data");
+    Put(DataSize, 4);
+    std::fwrite(Header.data(), 1, Header.size(), File);
+}
+
+// EOF
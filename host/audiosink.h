@@ -0,0 +1,66 @@
+// host/audiosink.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#ifndef AudioSinkH
+#define AudioSinkH
+//---------------------------------------------------------------------------
+
+#include <cstdio>
+#include <span>
+#include <gctypes.h>
+
+/**
+ * Where the software mixer writes its output: interleaved 16-bit stereo
+ * frames, left then right.
+ * @author Crayon
+ */
+class AudioSink
+{
+public:
+    virtual ~AudioSink() = default;
+    virtual void Write(std::span<const s16> Samples) = 0;
+};
+
+/**
+ * Sink dropping the frames, to measure the mixer alone.
+ * @author Crayon
+ */
+class NullSink : public AudioSink
+{
+public:
+    void Write(std::span<const s16> Samples) override;
+};
+
+/**
+ * Sink writing a 16-bit stereo WAV file.
+ * @author Crayon
+ */
+class WavSink : public AudioSink
+{
+public:
+    WavSink(const char *Path, u32 ARate);
+    WavSink(WavSink const&) = delete;
+    ~WavSink() override;
+    WavSink& operator=(WavSink const&) = delete;
+
+    void Write(std::span<const s16> Samples) override;
+    [[nodiscard]] bool IsOpen() const;
+private:
+    void WriteHeader();
+
+    std::FILE *File;
+    u32 Rate;
+    u32 DataSize{0};  /**< Bytes of samples written. */
+};
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
@@ -0,0 +1,396 @@
+// host/audiotest.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+/**
+ * @file
+ * Test the sound classes over the software mixer.
+ *
+ * The DSP-ADPCM decoder is checked against frames decoded by hand, whole
+ * and one frame at a time, and the sounds it decodes must be big-endian
+ * like the other PCM sounds. The voice pool is checked for free voices,
+ * priorities and both steal policies, by mixing sounds of a constant level
+ * and reading which ones are in the output. Then a fixed scene of sound
+ * effects, decoded like the game does when they are compressed, is mixed
+ * through the effects of the game, and the hash of the output is compared with the one it had when the test was written: a
+ * change of the mixer that should not change the sound must keep it. Each
+ * failed check is printed, and the exit code is not 0 if one failed.
+ *
+ * Usage: wtt-audiotest
+ */
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "adpcm.h"
+#include "audiosink.h"
+#include "decodedsound.h"
+#include "mixeffects.h"
+#include "softaudio.h"
+#include "sound.h"
+#include "voice.h"
+#include "voicepool.h"
+
+#include "button_rollover_sfx.h"
+#include "screen_change_sfx.h"
+
+// Hash of the output of TestMixHash, with the effects as built by sfxconv
+static constexpr u32 MIX_HASH_PCM = 0x9f01723e;
+static constexpr u32 MIX_HASH_ADPCM = 0x7225e837;
+
+static int Failures = 0;
+
+/**
+ * Count and print a failed check.
+ * @param[in] Passed The result of the check.
+ * @param[in] What What is checked.
+ */
+static void Check(bool Passed, const char *What)
+{
+    if(!Passed)
+    {
+        std::fprintf(stderr, "FAILED: %s\n", What);
+        ++Failures;
+    }
+}
+
+/**
+ * Sink keeping the samples, and their FNV-1a hash.
+ */
+class CaptureSink : public AudioSink
+{
+public:
+    void Write(std::span<const s16> Samples) override
+    {
+        for(const s16 Sample : Samples)
+        {
+            const u16 Value = static_cast<u16>(Sample);
+            Hash = (Hash ^ (Value & 0xFF)) * 16777619u;
+            Hash = (Hash ^ (Value >> 8)) * 16777619u;
+        }
+        Last.assign(Samples.begin(), Samples.end());
+    }
+
+    /**
+     * Get the left channel of the last frame written.
+     * @return The sample.
+     */
+    [[nodiscard]] s16 GetLastLeft() const
+    {
+        return Last.empty() ? 0 : Last[Last.size() - 2];
+    }
+
+    [[nodiscard]] u32 GetHash() const
+    {
+        return Hash;
+    }
+private:
+    std::vector<s16> Last;
+    u32 Hash{2166136261u};
+};
+
+// --- DSP-ADPCM ---
+
+// Predictor 0 is silence, 1 adds to the last sample, 2 extends the last two
+static constexpr s16 COEFFICIENTS[Adpcm::COEFFICIENT_COUNT] = {0, 0, 2048, 0, 4096, -2048};
+
+// Three frames: scaled codes, a ramp, then a clipped extrapolation
+static constexpr u8 FRAMES[] = {
+    0x04, 0x12, 0x3F, 0x87, 0x00, 0x00, 0x00, 0x00,
+    0x10, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+    0x2C, 0x77, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+static constexpr s16 DECODED[] = {
+    16, 32, 48, -16, -128, 112, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+    28687, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767
+};
+
+/**
+ * Frames decode to the samples worked out by hand, silence follows them.
+ */
+static void TestAdpcmDecode()
+{
+    std::array<s16, std::size(DECODED) + 3> Samples;
+    Samples.fill(-1);
+    Adpcm::Decode(FRAMES, COEFFICIENTS, Samples);
+    Check(std::equal(std::begin(DECODED), std::end(DECODED), Samples.begin()),
+        "frames decode to the expected samples");
+    Check(std::all_of(Samples.begin() + std::size(DECODED), Samples.end(), [](s16 s) { return s == 0; }),
+        "samples after the last frame are silent");
+}
+
+/**
+ * Decoding one frame at a time gives the same samples, the state carries
+ * the previous samples from a frame to the next.
+ */
+static void TestAdpcmStream()
+{
+    std::array<s16, std::size(DECODED)> Samples{};
+    Adpcm::History State;
+    size_t Written = 0;
+    for(size_t Frame = 0; Frame < std::size(FRAMES); Frame += Adpcm::FRAME_SIZE)
+    {
+        Written += Adpcm::Decode(std::span{FRAMES}.subspan(Frame, Adpcm::FRAME_SIZE), COEFFICIENTS, State,
+            std::span{Samples}.subspan(Written));
+    }
+    Check(Written == std::size(DECODED), "every sample of the frames is written");
+    Check(std::equal(std::begin(DECODED), std::end(DECODED), Samples.begin()),
+        "frames decoded one at a time match the whole decode");
+
+    std::array<s16, std::size(DECODED) * 2> Longer{};
+    Adpcm::History Fresh;
+    Check(Adpcm::Decode(FRAMES, COEFFICIENTS, Fresh, Longer) == std::size(DECODED),
+        "no sample is written past the last frame");
+    Check(Adpcm::GetEncodedSize(std::size(DECODED)) == std::size(FRAMES) &&
+        Adpcm::GetEncodedSize(std::size(DECODED) + 1) == std::size(FRAMES) + Adpcm::FRAME_SIZE,
+        "the encoded size is whole frames");
+}
+
+/**
+ * A decoded sound is big-endian 16-bit PCM, the format the mixers read,
+ * whatever the byte order of the CPU.
+ */
+static void TestDecodedSound()
+{
+    const Sound Compressed(SoundFormat::MonoAdpcm, FRAMES, static_cast<f32>(SoftAudio::SAMPLE_RATE),
+        std::size(DECODED), COEFFICIENTS);
+    const DecodedSound Decoded(Compressed);
+    const Sound &Pcm = Decoded.Get();
+    Check(Pcm.GetFormat() == SoundFormat::Mono16 && Pcm.GetSampleCount() == std::size(DECODED),
+        "a decoded sound is 16-bit PCM with every sample");
+    const std::span<const u8> Bytes = Pcm.GetBuffer();
+    bool BigEndian = Bytes.size() == std::size(DECODED) * 2;
+    for(size_t i = 0; BigEndian && i < std::size(DECODED); ++i)
+    {
+        const u16 Value = static_cast<u16>(DECODED[i]);
+        BigEndian = Bytes[i * 2] == (Value >> 8) && Bytes[i * 2 + 1] == (Value & 0xFF);
+    }
+    Check(BigEndian, "decoded samples are big-endian");
+}
+
+// --- Voice pool ---
+
+static constexpr u32 LEVEL_UNIT = 256;            /**< Level of a sound scaled by its volume, exactly. */
+static constexpr u32 POOL_SOUND_SAMPLES = 48000;  /**< One second, longer than each test. */
+
+/**
+ * A sound of a constant level, at the rate of the mixer.
+ */
+class LevelSound
+{
+public:
+    explicit LevelSound(s16 Level, u32 Samples = POOL_SOUND_SAMPLES) :
+        Data(Samples * 2)
+    {
+        for(size_t i = 0; i < Data.size(); i += 2)
+        {   // Big-endian, like the sounds of the game
+            Data[i] = static_cast<u8>(static_cast<u16>(Level) >> 8);
+            Data[i + 1] = static_cast<u8>(Level);
+        }
+    }
+
+    [[nodiscard]] const Sound& Get() const
+    {
+        return Item;
+    }
+private:
+    std::vector<u8> Data;
+    Sound Item{SoundFormat::Mono16, Data, static_cast<f32>(SoftAudio::SAMPLE_RATE)};
+};
+
+/**
+ * Sounds of level 1, 4, 16 and 64 units: the output at a volume tells
+ * which of them play.
+ */
+static const LevelSound &GetLevelSound(u32 Units)
+{
+    static const LevelSound Sounds[] = {
+        LevelSound(LEVEL_UNIT * 1), LevelSound(LEVEL_UNIT * 4),
+        LevelSound(LEVEL_UNIT * 16), LevelSound(LEVEL_UNIT * 64)
+    };
+    return Sounds[std::countr_zero(Units) / 2];
+}
+
+/**
+ * Mix the pool for 10 ms, past the delays of the tests.
+ * @param[in] Soft The mixer.
+ * @param[in] Sink Its output.
+ * @return The left channel of the last frame.
+ */
+static s32 MixPool(SoftAudio &Soft, const CaptureSink &Sink)
+{
+    Soft.Render(SoftAudio::SAMPLE_RATE / 100);
+    return Sink.GetLastLeft();
+}
+
+/**
+ * Free voices are taken first, then the priority decides.
+ */
+static void TestPoolPriority(SoftAudio &Soft, const CaptureSink &Sink)
+{
+    VoicePool Pool(2, VoicePool::StealPolicy::Oldest);
+    Check(Pool.GetVoiceCount() == 2 && Pool.GetActiveCount() == 0, "a new pool has only free voices");
+    Check(Pool.Play(GetLevelSound(1).Get(), 2, 100, 0.0f), "a sound takes a free voice");
+    Check(Pool.Play(GetLevelSound(4).Get(), 2, 100, 0.0f, 1), "a sound takes the other free voice");
+    Check(Pool.GetActiveCount() == 2, "both voices are busy");
+    Check(MixPool(Soft, Sink) == 1 * 100 + 4 * 100, "both sounds are mixed");
+
+    Check(!Pool.Play(GetLevelSound(16).Get(), 1, 255, 0.0f), "a sound of lower priority is dropped");
+    Check(MixPool(Soft, Sink) == 1 * 100 + 4 * 100, "a dropped sound is not mixed");
+    Check(Pool.Play(GetLevelSound(16).Get(), 3, 255, 0.0f), "a sound of higher priority steals a voice");
+    Check(MixPool(Soft, Sink) == 4 * 100 + 16 * 255, "the stolen voice plays the new sound");
+
+    const VoicePool::Stats &Stats = Pool.GetStats();
+    Check(Stats.Plays == 3 && Stats.Steals == 1 && Stats.Dropped == 1, "the counters match the sounds played");
+
+    Pool.StopAll();
+    Check(Pool.GetActiveCount() == 0, "no voice is busy once stopped");
+    Check(MixPool(Soft, Sink) == 0, "stopped voices are silent");
+}
+
+/**
+ * Among sounds of the same priority, each policy steals its own voice.
+ * The sounds start 1 ms apart, so their order does not depend on the
+ * resolution of the clock.
+ */
+static void TestPoolPolicies(SoftAudio &Soft, const CaptureSink &Sink)
+{
+    for(const auto Policy : {VoicePool::StealPolicy::Oldest, VoicePool::StealPolicy::Quietest})
+    {
+        VoicePool Pool(3, Policy);
+        Pool.Play(GetLevelSound(1).Get(), 1, 100, 0.0f, 0);
+        Pool.Play(GetLevelSound(4).Get(), 1, 50, 0.0f, 1);
+        Pool.Play(GetLevelSound(16).Get(), 1, 200, 0.0f, 2);
+        Check(Pool.Play(GetLevelSound(64).Get(), 1, 100, 0.0f), "a sound of the same priority steals a voice");
+        const s32 Mixed = MixPool(Soft, Sink);
+        if(Policy == VoicePool::StealPolicy::Oldest)
+        {
+            Check(Mixed == 4 * 50 + 16 * 200 + 64 * 100, "the oldest sound is stolen");
+        }
+        else
+        {
+            Check(Mixed == 1 * 100 + 16 * 200 + 64 * 100, "the quietest sound is stolen");
+        }
+        Pool.StopAll();
+    }
+
+    // Equal volumes fall back to the oldest sound
+    VoicePool Pool(2, VoicePool::StealPolicy::Quietest);
+    Pool.Play(GetLevelSound(1).Get(), 1, 100, 0.0f, 0);
+    Pool.Play(GetLevelSound(4).Get(), 1, 100, 0.0f, 1);
+    Pool.Play(GetLevelSound(16).Get(), 1, 100, 0.0f);
+    Check(MixPool(Soft, Sink) == 4 * 100 + 16 * 100, "the oldest of the quietest sounds is stolen");
+    Pool.StopAll();
+}
+
+/**
+ * A voice is free again once its sound is over, nothing is stolen.
+ */
+static void TestPoolExpired(SoftAudio &Soft, const CaptureSink &Sink)
+{
+    static const LevelSound Short(LEVEL_UNIT, SoftAudio::SAMPLE_RATE / 1000);
+    VoicePool Pool(1, VoicePool::StealPolicy::Oldest);
+    Pool.Play(Short.Get(), 1, 255, 0.0f);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    Check(Pool.GetActiveCount() == 0, "a voice is free at the end of its sound");
+    Check(Pool.Play(GetLevelSound(4).Get(), 0, 255, 0.0f), "a sound of any priority takes an idle voice");
+    Check(Pool.GetStats().Steals == 0, "an idle voice is not stolen");
+    Check(MixPool(Soft, Sink) == 4 * 255, "the new sound is mixed");
+    Pool.StopAll();
+}
+
+// --- Mix ---
+
+/**
+ * The sound effects of the game on a few voices, at different volumes,
+ * pans and delays, muffled for the second half like under the HOME screen.
+ */
+static void TestMixHash(SoftAudio &Soft, const CaptureSink &Sink, MixEffects &Effects)
+{
+    // Compressed effects are decoded like the game does
+    std::vector<std::unique_ptr<DecodedSound>> Decoded;
+    std::vector<const Sound*> Sounds;
+    for(const Sound *Effect : {&screen_change_sfx, &button_rollover_sfx})
+    {
+        if(Effect->GetFormat() == SoundFormat::MonoAdpcm)
+        {
+            Effect = &Decoded.emplace_back(std::make_unique<DecodedSound>(*Effect))->Get();
+        }
+        Sounds.push_back(Effect);
+    }
+    std::vector<std::unique_ptr<Voice>> Voices;
+    for(u32 i = 0; i < 4; ++i)
+    {
+        auto &Item = Voices.emplace_back(std::make_unique<Voice>());
+        Item->SetVolume(static_cast<u16>(255 - i * 40), static_cast<u16>(100 + i * 40));
+        Item->Play(*Sounds[i % Sounds.size()], i * 50, true);
+    }
+
+    const u32 Hash = Sink.GetHash();
+    static constexpr u32 TICKS = 60;
+    for(u32 Tick = 0; Tick < TICKS; ++Tick)
+    {
+        Effects.SetMuffled(Tick >= TICKS / 2);
+        Soft.Render(SoftAudio::SAMPLE_RATE / TICKS);
+    }
+    Effects.SetMuffled(false);
+    Check(Sink.GetHash() != Hash, "the scene is not silent");
+    std::printf("mix hash: %08x\n", Sink.GetHash());
+    const bool Compressed = !Decoded.empty();
+    Check(Sink.GetHash() == (Compressed ? MIX_HASH_ADPCM : MIX_HASH_PCM), "the scene mixes to the expected samples");
+}
+
+/**
+ * Entry point.
+ * @return 0 if every check passed, 1 otherwise.
+ */
+int main()
+{
+    TestAdpcmDecode();
+    TestAdpcmStream();
+
+    CaptureSink Sink;
+    auto Backend = std::make_unique<SoftAudio>(Sink);
+    SoftAudio &Soft = *Backend;
+    SetAudioBackend(std::move(Backend));
+    Soft.Initialize();
+    TestDecodedSound();
+    TestPoolPriority(Soft, Sink);
+    TestPoolPolicies(Soft, Sink);
+    TestPoolExpired(Soft, Sink);
+
+    // The hash covers the whole output, so the scene gets its own mixer
+    CaptureSink SceneSink;
+    SetAudioBackend(std::make_unique<SoftAudio>(SceneSink));
+    SoftAudio &Scene = static_cast<SoftAudio&>(GetAudioBackend());
+    Scene.Initialize();
+    MixEffects Effects(SoftAudio::SAMPLE_RATE);
+    Scene.SetEffects(&Effects);
+    TestMixHash(Scene, SceneSink, Effects);
+    Scene.SetEffects(nullptr);
+    Scene.Exit();
+
+    if(Failures > 0)
+    {
+        std::fprintf(stderr, "%d check(s) failed\n", Failures);
+        return 1;
+    }
+    std::puts("All checks passed");
+    return 0;
+}
+
+// EOF
@@ -0,0 +1,31 @@
+# Write a file as a C++ array, for the headless build.
+# It replaces raw2c for the images and #embed for compilers without it.
+#
+# Usage: cmake -DINPUT=<file> -DOUTPUT=<header> -DNAME=<symbol> [-DTYPE=<type>] -P embed.cmake
+# The header defines NAME, an array of TYPE (unsigned char by default) with
+# a null byte after the data, and NAME_size, the size of the data in bytes.
+
+if(NOT TYPE)
+    set(TYPE "unsigned char")
+endif()
+
+file(READ ${INPUT} HEX HEX)
+string(LENGTH "${HEX}" HEX_LENGTH)
+math(EXPR SIZE "${HEX_LENGTH} / 2")
+# A string literal initializes both char and unsigned char, 32 bytes per line
+string(REPEAT "[0-9a-f][0-9a-f]" 32 LINE)
+string(REGEX REPLACE "(${LINE})" "\\1\"\n    \"" HEX "${HEX}")
+string(REGEX REPLACE "([0-9a-f][0-9a-f])" "\\\\x\\1" BYTES "${HEX}")
+
+get_filename_component(FILE_NAME ${INPUT} NAME)
+file(WRITE ${OUTPUT}
+"/**
+ * This file was autogenerated from ${FILE_NAME} by embed.cmake. Do not edit.
+ */
+
+#pragma once
+
+alignas(32) inline constexpr ${TYPE} ${NAME}[] =
+    \"${BYTES}\";
+inline constexpr int ${NAME}_size = ${SIZE};
+")
@@ -0,0 +1,376 @@
+// host/gamehost.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+/**
+ * @file
+ * Run the whole game on the host.
+ *
+ * The Game class is built for the host like the headless renderer, with the
+ * software renderer, the software mixer and simulated Wii Remotes. A scene
+ * is a fixed script of Wii Remote input played from the start of the game,
+ * with a fixed seed, so it always ends on the same frame. The last frame is
+ * saved to a PNG file and can be compared with a reference image: the exit
+ * code is not 0 if they differ by more than a small tolerance, left for the
+ * rounding of another compiler or machine.
+ *
+ * The input can be recorded and played back like on the Wii, with the same
+ * Input class: a recording replaces the scene, and the game runs until its
+ * end.
+ *
+ * Usage: wtt-game <scene>|--replay <file> [--output frame.png]
+ *                 [--compare reference.png] [--record file]
+ *
+ * Scenes: start, menu, game, home.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <vector>
+#include <png.h>
+#include <wiiuse/wpad.h>
+#include "audiosink.h"
+#include "game.h"
+#include "grrlib_class.h"
+#include "input.h"
+#include "profiler.h"
+#include "softaudio.h"
+#include "softbackend.h"
+
+/**
+ * Wii Remote input held for a number of frames.
+ */
+struct Step
+{
+    u32 Frames;  /**< Number of frames the input lasts. */
+    u32 Held;    /**< WPAD_BUTTON_* held on the first Wii Remote. */
+    f32 X;       /**< Point of the screen under the pointer, negative to point away. */
+    f32 Y;
+};
+
+/**
+ * A fixed script of input.
+ */
+struct Scene
+{
+    std::string_view Name;
+    std::vector<Step> Steps;
+};
+
+static constexpr u32 SEED = 1;               /**< Seed of every scene. */
+static constexpr u32 CHANNEL_TOLERANCE = 16; /**< Largest difference of a color channel taken as equal. */
+static constexpr u32 PIXEL_TOLERANCE = 150;  /**< Pixels allowed to differ by more, 0.05% of the screen. */
+
+// Points of the screen the scenes use, at the hotspot of the cursor
+static constexpr f32 MENU_FIRST_X = 320.0f, MENU_FIRST_Y = 120.0f;  // 2 Players (1 Wiimote)
+static constexpr f32 MENU_AI_X = 320.0f, MENU_AI_Y = 320.0f;        // 1 Player (Vs AI)
+static constexpr f32 HOME_RESET_X = 400.0f, HOME_RESET_Y = 200.0f;  // Reset
+
+// Top left corner of the cells of the board, as in Game::Table, and their size
+static constexpr f32 CELL_LEFT[] = {180.0f, 322.0f, 464.0f};
+static constexpr f32 CELL_TOP[] = {28.0f, 131.0f, 233.0f};
+static constexpr f32 CELL_WIDTH = 136.0f, CELL_HEIGHT = 100.0f;
+
+/**
+ * Get the center of a cell of the board.
+ * @param[in] x The column, from 0 to 2.
+ * @return The x-coordinate of the center.
+ */
+static constexpr f32 CellX(int x)
+{
+    return CELL_LEFT[x] + CELL_WIDTH / 2;
+}
+
+/**
+ * Get the center of a cell of the board.
+ * @param[in] y The row, from 0 to 2.
+ * @return The y-coordinate of the center.
+ */
+static constexpr f32 CellY(int y)
+{
+    return CELL_TOP[y] + CELL_HEIGHT / 2;
+}
+
+/**
+ * Build the scenes.
+ * @return Every scene.
+ */
+static std::vector<Scene> BuildScenes()
+{
+    const std::vector<Step> ToMenu = {
+        {10, 0, -1.0f, -1.0f},
+        {1, WPAD_BUTTON_A, -1.0f, -1.0f},
+        {5, 0, -1.0f, -1.0f}
+    };
+
+    std::vector<Step> Menu = ToMenu;
+    Menu.push_back({20, 0, MENU_AI_X, MENU_AI_Y});
+
+    // Two players on one Wii Remote, a few moves and the pointer over a free cell
+    std::vector<Step> Game = ToMenu;
+    Game.push_back({10, 0, MENU_FIRST_X, MENU_FIRST_Y});
+    Game.push_back({1, WPAD_BUTTON_A, MENU_FIRST_X, MENU_FIRST_Y});
+    for(const auto &[x, y] : {std::pair{0, 0}, {1, 1}, {2, 0}, {0, 2}})
+    {
+        Game.push_back({5, 0, CellX(x), CellY(y)});
+        Game.push_back({1, WPAD_BUTTON_A, CellX(x), CellY(y)});
+    }
+    Game.push_back({20, 0, CellX(2), CellY(2)});
+
+    std::vector<Step> Home = Game;
+    Home.push_back({1, WPAD_BUTTON_HOME, CellX(2), CellY(2)});
+    Home.push_back({20, 0, HOME_RESET_X, HOME_RESET_Y});
+
+    return {
+        {"start", {{40, 0, -1.0f, -1.0f}}},
+        {"menu", Menu},
+        {"game", Game},
+        {"home", Home}
+    };
+}
+
+/**
+ * Set the first Wii Remote, the others are not connected.
+ * The cursor is drawn so its hotspot is on the given point, see Game::MovePointer.
+ * @param[in] Input The input of the frame.
+ */
+static void SetPads(const Step &Input)
+{
+    constexpr f32 CURSOR_SIZE = 96.0f;
+    const f32 Width = Screen::GetWidth();
+    const f32 Height = Screen::GetHeight();
+    const bool Pointing = Input.X >= 0.0f && Input.Y >= 0.0f;
+    WPAD_SetHostState(WPAD_CHAN_0, true, Input.Held, Pointing,
+        (Input.X + CURSOR_SIZE) * Width / (Width + CURSOR_SIZE * 2),
+        (Input.Y + CURSOR_SIZE) * Height / (Height + CURSOR_SIZE * 2));
+    for(s32 Chan = WPAD_CHAN_1; Chan < WPAD_MAX_WIIMOTES; ++Chan)
+    {
+        WPAD_SetHostState(Chan, false, 0, false, 0.0f, 0.0f);
+    }
+}
+
+/**
+ * Read a PNG file as RGBA pixels.
+ * @param[in] filename The file.
+ * @param[out] Pixels The pixels, row by row.
+ * @param[out] Width The width in pixels.
+ * @param[out] Height The height in pixels.
+ * @return true if the file was read, false otherwise.
+ */
+static bool ReadPNG(const char *filename, std::vector<u8> &Pixels, u32 &Width, u32 &Height)
+{
+    png_image Image;
+    std::memset(&Image, 0, sizeof(Image));
+    Image.version = PNG_IMAGE_VERSION;
+    if(!png_image_begin_read_from_file(&Image, filename))
+    {
+        return false;
+    }
+    Image.format = PNG_FORMAT_RGBA;
+    Pixels.resize(PNG_IMAGE_SIZE(Image));
+    Width = Image.width;
+    Height = Image.height;
+    return png_image_finish_read(&Image, nullptr, Pixels.data(), 0, nullptr) != 0;
+}
+
+/**
+ * Compare two PNG files.
+ * @param[in] Output The frame of the scene.
+ * @param[in] Reference The reference image.
+ * @return true if they match within the tolerance, false otherwise.
+ */
+static bool ComparePNG(const char *Output, const char *Reference)
+{
+    std::vector<u8> Frame;
+    std::vector<u8> Expected;
+    u32 FrameWidth, FrameHeight, ExpectedWidth, ExpectedHeight;
+    if(!ReadPNG(Output, Frame, FrameWidth, FrameHeight))
+    {
+        std::fprintf(stderr, "wtt-game: cannot read %s\n", Output);
+        return false;
+    }
+    if(!ReadPNG(Reference, Expected, ExpectedWidth, ExpectedHeight))
+    {
+        std::fprintf(stderr, "wtt-game: cannot read %s\n", Reference);
+        return false;
+    }
+    if(FrameWidth != ExpectedWidth || FrameHeight != ExpectedHeight)
+    {
+        std::fprintf(stderr, "wtt-game: %s is %ux%u, the reference is %ux%u\n",
+            Output, FrameWidth, FrameHeight, ExpectedWidth, ExpectedHeight);
+        return false;
+    }
+
+    u32 Largest = 0;
+    u32 Different = 0;
+    for(size_t i = 0; i < Frame.size(); i += 4)
+    {
+        u32 Difference = 0;
+        for(size_t c = 0; c < 4; ++c)
+        {
+            Difference = std::max<u32>(Difference, std::abs(Frame[i + c] - Expected[i + c]));
+        }
+        Largest = std::max(Largest, Difference);
+        Different += (Difference > CHANNEL_TOLERANCE) ? 1 : 0;
+    }
+    std::printf("largest difference: %u, pixels over tolerance: %u\n", Largest, Different);
+    if(Different > PIXEL_TOLERANCE)
+    {
+        std::fprintf(stderr, "wtt-game: %s does not match %s\n", Output, Reference);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Entry point.
+ * @param[in] argc The number of arguments invoked with the program.
+ * @param[in] argv The array containing the arguments.
+ * @return 0 on success, 1 if the frame does not match the reference, 2 on error.
+ */
+int main(int argc, char **argv)
+{
+    const char *SceneName = nullptr;
+    const char *Output = "wtt-game.png";
+    const char *Reference = nullptr;
+    const char *RecordFile = nullptr;
+    const char *ReplayFile = nullptr;
+    for(int i = 1; i < argc; ++i)
+    {
+        const std::string_view Option = argv[i];
+        if(!Option.starts_with("--"))
+        {
+            SceneName = argv[i];
+        }
+        else if(i + 1 == argc)
+        {
+            break;
+        }
+        else if(Option == "--output")
+        {
+            Output = argv[++i];
+        }
+        else if(Option == "--compare")
+        {
+            Reference = argv[++i];
+        }
+        else if(Option == "--record")
+        {
+            RecordFile = argv[++i];
+        }
+        else if(Option == "--replay")
+        {
+            ReplayFile = argv[++i];
+        }
+    }
+    if((SceneName == nullptr) == (ReplayFile == nullptr))
+    {
+        std::fputs("usage: wtt-game <scene>|--replay <file> [--output frame.png] "
+            "[--compare reference.png] [--record file]\n", stderr);
+        return 2;
+    }
+
+    // A recording is played instead of a scene
+    const std::vector<Scene> Scenes = BuildScenes();
+    std::vector<Step> Script;
+    if(SceneName != nullptr)
+    {
+        const auto Found = std::find_if(Scenes.begin(), Scenes.end(),
+            [SceneName](const Scene &s) { return s.Name == SceneName; });
+        if(Found == Scenes.end())
+        {
+            std::fprintf(stderr, "wtt-game: unknown scene %s\n", SceneName);
+            return 2;
+        }
+        Script = Found->Steps;
+    }
+    Input Pads;
+    if(ReplayFile != nullptr && !Pads.Replay(ReplayFile))
+    {
+        std::fprintf(stderr, "wtt-game: %s is not a recording\n", ReplayFile);
+        return 2;
+    }
+    const u32 Seed = Pads.IsReplaying() ? Pads.GetSeed() : SEED;
+    if(RecordFile != nullptr && !Pads.Record(RecordFile, Seed))
+    {
+        std::fprintf(stderr, "wtt-game: cannot create %s\n", RecordFile);
+        return 2;
+    }
+
+    auto Backend = std::make_unique<SoftBackend>();
+    SoftBackend &Soft = *Backend;
+    SetRenderBackend(std::move(Backend));
+    Screen::Initialize();
+    NullSink Sink;
+    SetAudioBackend(std::make_unique<SoftAudio>(Sink));
+
+    auto MyGame = std::make_unique<Game>(Screen::GetWidth(), Screen::GetHeight(), Pads, Seed);
+
+    // Same loop as the Wii, the last frame is painted but not shown
+    u32 Frames = 0;
+    size_t StepIndex = 0;
+    u32 StepFrames = 0;
+    while(true)
+    {
+        MyGame->Paint();
+        if(!Pads.IsReplaying())
+        {
+            if(StepIndex == Script.size())
+            {
+                break;
+            }
+            SetPads(Script[StepIndex]);
+            if(++StepFrames == Script[StepIndex].Frames)
+            {
+                ++StepIndex;
+                StepFrames = 0;
+            }
+        }
+        Pads.Scan();
+        if(MyGame->ControllerManager())
+        {
+            std::fputs("wtt-game: the game exited before the end of the input\n", stderr);
+            return 2;
+        }
+        if(Pads.IsFinished())
+        {
+            break;
+        }
+        Screen::Render();
+        Profiler::EndFrame();
+        ++Frames;
+    }
+    Pads.StopRecording();
+    Screen::ScreenShot(Output);
+
+    // FNV-1a hash of the last frame, to compare runs
+    u32 Hash = 2166136261u;
+    for(const u32 Pixel : Soft.GetFrame())
+    {
+        Hash = (Hash ^ Pixel) * 16777619u;
+    }
+    std::printf("%s: %s, %u frames\n", (SceneName != nullptr) ? "scene" : "replay",
+        (SceneName != nullptr) ? SceneName : ReplayFile, Frames);
+    std::printf("last frame: %s, hash: %08x\n", Output, Hash);
+
+    MyGame.reset();
+    Screen::Exit();
+    if(Reference != nullptr && !ComparePNG(Output, Reference))
+    {
+        return 1;
+    }
+    return 0;
+}
+
+// EOF
@@ -0,0 +1,206 @@
+// host/headless.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+/**
+ * @file
+ * Headless renderer for the game screen.
+ *
+ * Draws the game board through the same Texture, Font, TextLabel and
+ * Compositor code as the Wii build, but in a software framebuffer. Scores
+ * and moves change over time so dirty rows are exercised like in a real
+ * game. The average frame time and a hash of the last frame are printed,
+ * and the last frame is written to a PNG file, followed by the profiler
+ * statistics of the last frames.
+ *
+ * Usage: wtt-headless [frames] [output.png] [trace.json]
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include "compositor.h"
+#include "font.h"
+#include "framearena.h"
+#include "grrlib_class.h"
+#include "memtrack.h"
+#include "profiler.h"
+#include "softbackend.h"
+#include "textlabel.h"
+#include "trace.h"
+
+// Fonts
+#include "Swis721_Ex_BT_sdf.h"
+
+/**
+ * Position of each cell of the board, same as the game.
+ */
+static constexpr std::array<std::array<std::array<f32, 2>, 3>, 3> Table = {{
+    {{{180, 28}, {180, 131}, {180, 233}}},
+    {{{322, 28}, {322, 131}, {322, 233}}},
+    {{{464, 28}, {464, 131}, {464, 233}}}}};
+
+static constexpr u16 CELL_HEIGHT = 100;
+static constexpr u16 SCORE_TOP[3] = {75, 175, 280};
+static constexpr u16 SCORE_HEIGHT = 50;
+static constexpr u32 SCORE_COLOR[3] = {0x6BB6DEFF, 0xE6313AFF, 0xFFFFFFFF};
+static constexpr u32 SCORE_SHADOW_COLOR[3] = {0xFFFFFFFF, 0xFFFFFFFF, 0x109642FF};
+
+/**
+ * Entry point.
+ * @param[in] argc The number of arguments invoked with the program.
+ * @param[in] argv The array containing the arguments.
+ * @return 0 on success, an error code otherwise.
+ */
+int main(int argc, char **argv)
+{
+    const u32 Frames = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 600;
+    const char *Output = (argc > 2) ? argv[2] : "wtt-headless.png";
+    const char *TraceOutput = (argc > 3) ? argv[3] : nullptr;
+
+    auto Backend = std::make_unique<SoftBackend>();
+    SoftBackend &Soft = *Backend;
+    SetRenderBackend(std::move(Backend));
+    Screen::Initialize();
+
+    const std::string GfxDir = WTT_GFX_DIR;
+    Texture Background(GfxDir + "/backg.png");
+    Texture Symbols(GfxDir + "/symbols.png");
+    if(Background.GetWidth() == 0 || Symbols.GetWidth() == 0)
+    {
+        std::fputs("wtt-headless: cannot load the images\n", stderr);
+        return 1;
+    }
+    Symbols.InitTileSet(136, 100, 0);
+
+    Font DefaultFont(Swis721_Ex_BT_sdf);
+    std::array<std::unique_ptr<TextLabel>, 3> ScoreLabel;
+    std::array<u16, 3> Score{};
+    std::array<std::array<int, 3>, 3> Board;
+    for(auto &Column : Board)
+    {
+        Column.fill(-1);
+    }
+
+    Compositor Layers(Screen::GetWidth(), Screen::GetHeight());
+    Layers.AddLayer(0, Screen::GetHeight(), [&Background]() { Background.Draw(0, 0); });
+    std::array<u8, 3> ScoreLayer;
+    for(size_t i = 0; i < ScoreLabel.size(); ++i)
+    {
+        ScoreLabel[i] = std::make_unique<TextLabel>(DefaultFont);
+        ScoreLabel[i]->SetLocation(52, SCORE_TOP[i]);
+        ScoreLabel[i]->SetWidth(100);
+        ScoreLabel[i]->SetStyle(35, SCORE_COLOR[i]);
+        ScoreLabel[i]->SetShadow(SCORE_SHADOW_COLOR[i], 2, 2);
+        ScoreLabel[i]->SetText("0");
+        ScoreLayer[i] = Layers.AddLayer(SCORE_TOP[i], SCORE_HEIGHT, [&ScoreLabel, i]() { ScoreLabel[i]->Paint(); });
+    }
+    for(size_t y = 0; y < 3; ++y)
+    {
+        Layers.AddLayer(Table[0][y][1], CELL_HEIGHT, [&Symbols, &Board, y]()
+        {
+            for(size_t x = 0; x < 3; ++x)
+            {
+                if(Board[x][y] >= 0)
+                {
+                    Symbols.DrawTile(Table[x][y][0], Table[x][y][1], 0, 1, 1, 0xFFFFFFFF, Board[x][y]);
+                }
+            }
+        });
+    }
+
+    u32 SteadyAllocations = 0; // Most heap allocations in a frame, without the first and last
+    const auto Start = std::chrono::steady_clock::now();
+    for(u32 Frame = 0; Frame < Frames; ++Frame)
+    {
+        if(Frame % 30 == 29)
+        {   // A move, the board is cleared when full
+            const u32 Move = (Frame / 30) % 10;
+            for(size_t y = 0; y < 3; ++y)
+            {
+                for(size_t x = 0; x < 3; ++x)
+                {
+                    const u32 Cell = y * 3 + x;
+                    const int Sign = (Cell < Move) ? static_cast<int>(Cell % 2) : -1;
+                    if(Board[x][y] != Sign)
+                    {
+                        Board[x][y] = Sign;
+                        Layers.Invalidate(Table[x][y][1], CELL_HEIGHT);
+                    }
+                }
+            }
+            if(Move == 9)
+            {
+                const size_t Winner = (Frame / 300) % 3;
+                if(ScoreLabel[Winner]->SetText(std::to_string(++Score[Winner])))
+                {
+                    Layers.Invalidate(ScoreLayer[Winner]);
+                }
+            }
+        }
+        {
+            ScopedTimer Timer(Profiler::Phase::PaintGame);
+            Layers.Paint();
+        }
+        if(Frame + 1 == Frames)
+        {
+            Screen::ScreenShot(Output);
+        }
+        {
+            ScopedTimer Timer(Profiler::Phase::Render);
+            Screen::Render();
+        }
+        Profiler::EndFrame();
+        if(Frame > 0 && Frame + 1 < Frames)
+        {
+            SteadyAllocations = std::max(SteadyAllocations, FrameArena::GetHeapAllocations());
+        }
+        TRACE_INSTANT("Frame");
+    }
+    const std::chrono::duration<double, std::milli> Elapsed = std::chrono::steady_clock::now() - Start;
+
+    // FNV-1a hash of the last frame, to compare runs
+    u32 Hash = 2166136261u;
+    for(const u32 Pixel : Soft.GetFrame())
+    {
+        Hash = (Hash ^ Pixel) * 16777619u;
+    }
+    std::printf("frames: %u\n", Soft.GetFrameCount());
+    std::printf("average frame time: %.3f ms\n", Frames ? Elapsed.count() / Frames : 0.0);
+    std::printf("last frame hash: %08x\n", Hash);
+    std::printf("last frame: %s\n", Output);
+    if(TraceOutput != nullptr && Trace::Save(TraceOutput))
+    {
+        std::printf("trace: %s\n", TraceOutput);
+    }
+    for(const Profiler::Phase Which : {Profiler::Phase::Frame, Profiler::Phase::PaintGame,
+        Profiler::Phase::Text, Profiler::Phase::Render})
+    {
+        const Profiler::Stats Stats = Profiler::GetStats(Which);
+        std::printf("%s (last %u frames): min %u us, avg %u us, p99 %u us\n", Profiler::GetName(Which),
+            Stats.Samples, Stats.Min, Stats.Avg, Stats.P99);
+    }
+
+    MemTrack::Dump(stdout);
+#ifdef DEBUG
+    std::printf("most heap allocations in a steady frame: %u\n", SteadyAllocations);
+#else
+    static_cast<void>(SteadyAllocations);
+#endif
+
+    Screen::Exit();
+    return 0;
+}
+
+// EOF
@@ -0,0 +1,36 @@
+// host/include/gctypes.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+/**
+ * @file
+ * The libogc integer types, for the headless build.
+ */
+
+#ifndef GCTypesH
+#define GCTypesH
+//---------------------------------------------------------------------------
+
+#include <cstdint>
+
+typedef std::uint8_t u8;
+typedef std::uint16_t u16;
+typedef std::uint32_t u32;
+typedef std::uint64_t u64;
+typedef std::int8_t s8;
+typedef std::int16_t s16;
+typedef std::int32_t s32;
+typedef std::int64_t s64;
+typedef float f32;
+typedef double f64;
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
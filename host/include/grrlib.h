@@ -0,0 +1,69 @@
+// host/include/grrlib.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+/**
+ * @file
+ * The part of GRRLIB used by GRRLIBpp, for the headless build.
+ * Only the texture structure, the color macros and the GX texture formats
+ * are declared, everything else goes through a RenderBackend.
+ */
+
+#ifndef GRRLIBHostH
+#define GRRLIBHostH
+//---------------------------------------------------------------------------
+
+#include <malloc.h>
+#include <gctypes.h>
+
+#define R(c)  (((c) >>24) &0xFF)  /**< Extract red   component of colour. */
+#define G(c)  (((c) >>16) &0xFF)  /**< Extract green component of colour. */
+#define B(c)  (((c) >> 8) &0xFF)  /**< Extract blue  component of colour. */
+#define A(c)  ( (c)       &0xFF)  /**< Extract alpha component of colour. */
+
+/**
+ * Build an RGBA pixel from components.
+ */
+#define RGBA(r,g,b,a) ( (u32)( ( ((u32)(r))        <<24) |  \
+                               ((((u32)(g)) &0xFF) <<16) |  \
+                               ((((u32)(b)) &0xFF) << 8) |  \
+                               ( ((u32)(a)) &0xFF      ) ) )
+
+#define GX_TF_IA8   0x03 /**< GX texture format with 8 bits of intensity and 8 bits of alpha. */
+#define GX_TF_RGBA8 0x06 /**< GX texture format with 8 bits per component. */
+
+/**
+ * Structure to hold the texture information.
+ */
+typedef struct GRRLIB_texImg
+{
+    u32 w;         /**< The width of the texture in pixels.  */
+    u32 h;         /**< The height of the texture in pixels. */
+    int handlex;   /**< Texture handle x. */
+    int handley;   /**< Texture handle y. */
+    int offsetx;   /**< Texture offset x. */
+    int offsety;   /**< Texture offset y. */
+
+    bool tiledtex; /**< Texture is tiled? */
+    u32 tilew;     /**< Width of one tile. */
+    u32 tileh;     /**< Height of one tile. */
+    u32 nbtilew;   /**< Number of tiles for the x axis. */
+    u32 nbtileh;   /**< Number of tiles for the y axis. */
+    u32 tilestart; /**< Offset to tile starting position. */
+    f32 ofnormaltexx; /**< Offset of normalized texture on x. */
+    f32 ofnormaltexy; /**< Offset of normalized texture on y. */
+
+    void *data;    /**< Pointer to the texture data. */
+    u32 format;    /**< Texture format. */
+} GRRLIB_texImg;
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
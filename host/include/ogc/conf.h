@@ -0,0 +1,48 @@
+// host/include/ogc/conf.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+/**
+ * @file
+ * The system settings of libogc used by the game, for the headless build.
+ * The host behaves like a console set to English.
+ */
+
+#ifndef ConfHostH
+#define ConfHostH
+//---------------------------------------------------------------------------
+
+#include <gctypes.h>
+
+enum {
+    CONF_LANG_JAPANESE = 0,
+    CONF_LANG_ENGLISH,
+    CONF_LANG_GERMAN,
+    CONF_LANG_FRENCH,
+    CONF_LANG_SPANISH,
+    CONF_LANG_ITALIAN,
+    CONF_LANG_DUTCH,
+    CONF_LANG_SIMP_CHINESE,
+    CONF_LANG_TRAD_CHINESE,
+    CONF_LANG_KOREAN
+};
+
+/**
+ * Get the language of the console.
+ * @return Always CONF_LANG_ENGLISH.
+ */
+inline s32 CONF_GetLanguage()
+{
+    return CONF_LANG_ENGLISH;
+}
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
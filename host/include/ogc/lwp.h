@@ -0,0 +1,33 @@
+// host/include/ogc/lwp.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+/**
+ * @file
+ * The libogc threads used by the game, for the headless build.
+ * They run on native threads; the priority and the stack are ignored.
+ */
+
+#ifndef LWPHostH
+#define LWPHostH
+//---------------------------------------------------------------------------
+
+#include <gctypes.h>
+
+#define LWP_THREAD_NULL 0xffffffff
+
+typedef u32 lwp_t;
+
+s32 LWP_CreateThread(lwp_t *thethread, void* (*entry)(void *), void *arg, void *stackbase, u32 stack_size, u8 prio);
+s32 LWP_JoinThread(lwp_t thethread, void **value_ptr);
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
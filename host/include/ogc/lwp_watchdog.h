@@ -0,0 +1,57 @@
+// host/include/ogc/lwp_watchdog.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+/**
+ * @file
+ * The libogc time base functions, for the headless build.
+ * Ticks run at the same rate as the Wii time base so the same conversions apply.
+ */
+
+#ifndef LWPWatchdogHostH
+#define LWPWatchdogHostH
+//---------------------------------------------------------------------------
+
+#include <chrono>
+#include <gctypes.h>
+
+#define TB_TIMER_CLOCK 60750 /**< Time base frequency in kHz. */
+
+#define ticks_to_secs(ticks)      (((u64)(ticks) / (u64)(TB_TIMER_CLOCK * 1000)))
+#define ticks_to_millisecs(ticks) (((u64)(ticks) / (u64)(TB_TIMER_CLOCK)))
+#define ticks_to_microsecs(ticks) ((((u64)(ticks) * 8) / (u64)(TB_TIMER_CLOCK / 125)))
+#define ticks_to_nanosecs(ticks)  ((((u64)(ticks) * 8000) / (u64)(TB_TIMER_CLOCK / 125)))
+
+#define secs_to_ticks(sec)        ((u64)(sec) * (TB_TIMER_CLOCK * 1000))
+#define millisecs_to_ticks(msec)  ((u64)(msec) * (TB_TIMER_CLOCK))
+#define microsecs_to_ticks(usec)  (((u64)(usec) * (TB_TIMER_CLOCK / 125)) / 8)
+
+/**
+ * Read the time base.
+ * @return The number of ticks since an arbitrary point.
+ */
+inline u64 gettime()
+{
+    const auto Now = std::chrono::steady_clock::now().time_since_epoch();
+    const u64 Nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(Now).count();
+    return (Nanoseconds / 1000) * (TB_TIMER_CLOCK / 125) / 8 + (Nanoseconds % 1000) * (TB_TIMER_CLOCK / 125) / 8000;
+}
+
+/**
+ * Ticks elapsed between two readings of the time base.
+ */
+inline u64 diff_ticks(u64 start, u64 end)
+{
+    return end - start;
+}
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
@@ -0,0 +1,34 @@
+// host/include/ogc/semaphore.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+/**
+ * @file
+ * The libogc semaphores used by the game, for the headless build.
+ */
+
+#ifndef SemaphoreHostH
+#define SemaphoreHostH
+//---------------------------------------------------------------------------
+
+#include <gctypes.h>
+
+#define LWP_SEM_NULL 0xffffffff
+
+typedef u32 sem_t;
+
+s32 LWP_SemInit(sem_t *sem, u32 start, u32 max);
+s32 LWP_SemDestroy(sem_t sem);
+s32 LWP_SemWait(sem_t sem);
+s32 LWP_SemPost(sem_t sem);
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
@@ -0,0 +1,89 @@
+// host/include/wiiuse/wpad.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+/**
+ * @file
+ * The part of the libogc Wii Remote API used by the game, for the headless
+ * build. There is no Wii Remote on the host: the state of each one is set
+ * by the program driving the game, see WPAD_SetHostState, and read back by
+ * WPAD_ScanPads like the real ones.
+ */
+
+#ifndef WPADHostH
+#define WPADHostH
+//---------------------------------------------------------------------------
+
+#include <gctypes.h>
+
+#define WPAD_CHAN_ALL           -1
+#define WPAD_CHAN_0             0
+#define WPAD_CHAN_1             1
+#define WPAD_CHAN_2             2
+#define WPAD_CHAN_3             3
+#define WPAD_MAX_WIIMOTES       4
+
+#define WPAD_ERR_NONE           0
+#define WPAD_ERR_NO_CONTROLLER  -1
+
+#define WPAD_BUTTON_2           0x0001
+#define WPAD_BUTTON_1           0x0002
+#define WPAD_BUTTON_B           0x0004
+#define WPAD_BUTTON_A           0x0008
+#define WPAD_BUTTON_MINUS       0x0010
+#define WPAD_BUTTON_HOME        0x0080
+#define WPAD_BUTTON_LEFT        0x0100
+#define WPAD_BUTTON_RIGHT       0x0200
+#define WPAD_BUTTON_DOWN        0x0400
+#define WPAD_BUTTON_UP          0x0800
+#define WPAD_BUTTON_PLUS        0x1000
+
+/**
+ * Pointer of a Wii Remote.
+ */
+typedef struct ir_t
+{
+    int valid;  /**< The remote points at the screen. */
+    f32 x;      /**< Pointer x-coordinate. */
+    f32 y;      /**< Pointer y-coordinate. */
+} ir_t;
+
+/**
+ * Orientation of a Wii Remote, in degrees.
+ */
+typedef struct orient_t
+{
+    f32 roll;
+    f32 pitch;
+    f32 yaw;
+} orient_t;
+
+/**
+ * State of a Wii Remote.
+ */
+typedef struct WPADData
+{
+    u32 btns_h;  /**< Buttons held down. */
+    u32 btns_d;  /**< Buttons pressed since the previous scan. */
+    u32 btns_u;  /**< Buttons released since the previous scan. */
+    ir_t ir;
+    orient_t orient;
+} WPADData;
+
+s32 WPAD_ScanPads();
+WPADData* WPAD_Data(int chan);
+s32 WPAD_Probe(s32 chan, u32 *type);
+s32 WPAD_Rumble(s32 chan, int status);
+
+void WPAD_SetHostState(s32 chan, bool connected, u32 held, bool pointing, f32 x, f32 y);
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
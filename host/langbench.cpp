@@ -0,0 +1,204 @@
+// host/langbench.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+/**
+ * @file
+ * Benchmark of the translation lookups.
+ *
+ * The elements of a language file are kept in document order, and the old
+ * lookup is repeated on them: a walk comparing the element name and the
+ * "from" attribute, like mxmlFindElement does on the DOM. The same lookups
+ * are then done with a StringTable, and with the tables compiled by langc
+ * that Language uses, where a text is found by the index given by its key
+ * when the game is compiled. They must return the same texts, and the number
+ * of lookups per second of each is printed. The compiled tables are those of
+ * English, they are only compared with the default file.
+ *
+ * Usage: wtt-langbench [language.xml] [lookups]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "languages.h"
+#include "stringtable.h"
+
+/**
+ * An element of the document, with the attributes used by Language.
+ */
+struct Element
+{
+    std::string Name;
+    std::string From;
+    std::string To;
+};
+
+/**
+ * Replace the predefined XML entities of an attribute value.
+ */
+static std::string Unescape(std::string_view Text)
+{
+    static constexpr std::pair<std::string_view, char> Entities[] = {
+        {"&amp;", '&'}, {"&lt;", '<'}, {"&gt;", '>'}, {"&quot;", '"'}, {"&apos;", '\''}
+    };
+    std::string Result;
+    for(size_t i = 0; i < Text.size(); ++i)
+    {
+        bool Replaced = false;
+        for(const auto &[Entity, Character] : Entities)
+        {
+            if(Text.substr(i, Entity.size()) == Entity)
+            {
+                Result += Character;
+                i += Entity.size() - 1;
+                Replaced = true;
+                break;
+            }
+        }
+        if(!Replaced)
+        {
+            Result += Text[i];
+        }
+    }
+    return Result;
+}
+
+/**
+ * Get the value of an attribute in the text of a start tag.
+ */
+static std::string GetAttribute(std::string_view Tag, std::string_view Name)
+{
+    std::string Pattern(" ");
+    Pattern.append(Name).append("=\"");
+    const size_t Start = Tag.find(Pattern);
+    if(Start == std::string_view::npos)
+    {
+        return {};
+    }
+    const size_t ValueStart = Start + Pattern.size();
+    return Unescape(Tag.substr(ValueStart, Tag.find('"', ValueStart) - ValueStart));
+}
+
+/**
+ * Split a document into its elements, comments and declarations are skipped.
+ */
+static std::vector<Element> ReadElements(const std::string &Document)
+{
+    std::vector<Element> Elements;
+    for(size_t Pos = Document.find('<'); Pos != std::string::npos; Pos = Document.find('<', Pos + 1))
+    {
+        const char Next = Document[Pos + 1];
+        if(Next == '?' || Next == '!' || Next == '/')
+        {
+            continue;
+        }
+        const size_t End = Document.find('>', Pos);
+        const std::string_view Tag = std::string_view(Document).substr(Pos, End - Pos);
+        const size_t NameEnd = Tag.find_first_of(" />", 1);
+        Elements.push_back({std::string(Tag.substr(1, NameEnd - 1)),
+            GetAttribute(Tag, "from"), GetAttribute(Tag, "to")});
+    }
+    return Elements;
+}
+
+/**
+ * Entry point.
+ * @param[in] argc The number of arguments invoked with the program.
+ * @param[in] argv The array containing the arguments.
+ * @return 0 if both lookups agree, an error code otherwise.
+ */
+int main(int argc, char **argv)
+{
+    const char *Filename = (argc > 1) ? argv[1] : WTT_LANGUAGES_DIR "/english.xml";
+    const u32 Lookups = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 1000000;
+
+    std::ifstream File(Filename, std::ios::binary);
+    const std::string Document{std::istreambuf_iterator<char>(File), std::istreambuf_iterator<char>()};
+    const std::vector<Element> Elements = ReadElements(Document);
+
+    StringTable Table;
+    std::vector<std::string> Keys;
+    for(const Element &Item : Elements)
+    {
+        if(Item.Name == "translation")
+        {
+            Table.Add(Item.From, Item.To);
+            Keys.push_back(Item.From);
+        }
+    }
+    if(Keys.empty())
+    {
+        std::fprintf(stderr, "wtt-langbench: no translation in %s\n", Filename);
+        return 2;
+    }
+
+    // Old lookup, a walk over every element of the document
+    auto FindElement = [&Elements](const char *From) -> std::string_view
+    {
+        for(const Element &Item : Elements)
+        {
+            if(std::strcmp(Item.Name.c_str(), "translation") == 0 && std::strcmp(Item.From.c_str(), From) == 0)
+            {
+                return Item.To;
+            }
+        }
+        return {};
+    };
+
+    for(const std::string &Key : Keys)
+    {
+        if(FindElement(Key.c_str()) != Table.Find(Key))
+        {
+            std::fprintf(stderr, "wtt-langbench: lookups differ for \"%s\"\n", Key.c_str());
+            return 1;
+        }
+    }
+
+    // Index of each key in the compiled tables, known when compiling the game
+    std::vector<u16> Ids;
+    for(const std::string &Key : Keys)
+    {
+        const auto Id = std::find(Languages::Keys.begin(), Languages::Keys.end(), Key);
+        Ids.push_back((Id != Languages::Keys.end()) ? Id - Languages::Keys.begin() : 0);
+        if(argc <= 1 && (Id == Languages::Keys.end() || Languages::English.Texts[Ids.back()] != Table.Find(Key)))
+        {
+            std::fprintf(stderr, "wtt-langbench: compiled table differs for \"%s\"\n", Key.c_str());
+            return 1;
+        }
+    }
+
+    size_t Checksum = 0; // Keeps the lookups from being optimized away
+    auto Measure = [&](const char *Name, auto &&Lookup)
+    {
+        const auto Start = std::chrono::steady_clock::now();
+        for(u32 i = 0; i < Lookups; ++i)
+        {
+            Checksum += Lookup(i % Keys.size()).size();
+        }
+        const std::chrono::duration<double> Elapsed = std::chrono::steady_clock::now() - Start;
+        std::printf("%-12s %12.0f lookups/s\n", Name, Lookups / Elapsed.count());
+    };
+
+    std::printf("%s: %zu elements, %zu translations\n", Filename, Elements.size(), Keys.size());
+    Measure("DOM walk", [&](size_t i) { return FindElement(Keys[i].c_str()); });
+    Measure("StringTable", [&](size_t i) { return Table.Find(Keys[i]); });
+    Measure("Compiled", [&](size_t i) { return Languages::English.Texts[Ids[i]]; });
+    std::printf("table memory: %zu bytes (checksum %zu)\n", Table.GetMemoryUsage(), Checksum);
+    return 0;
+}
+
+// EOF
@@ -0,0 +1,161 @@
+// host/lwp.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <ogc/lwp.h>
+#define sem_t lwp_sem_t // The POSIX sem_t comes with <condition_variable>
+#include <ogc/semaphore.h>
+#undef sem_t
+
+/**
+ * A counting semaphore, as LWP_SemInit makes it.
+ */
+struct HostSemaphore
+{
+    std::mutex Lock;
+    std::condition_variable Posted;
+    u32 Count{0};
+    u32 Max{0};
+};
+
+// Handles of the threads and the semaphores, from 0
+static std::mutex HandlesLock;
+static std::map<lwp_t, std::thread> Threads;
+static std::map<lwp_sem_t, std::shared_ptr<HostSemaphore>> Semaphores;
+static u32 NextHandle{0};
+
+/**
+ * Find a semaphore from its handle.
+ * @param[in] sem The handle.
+ * @return The semaphore, nullptr if there is none.
+ */
+static std::shared_ptr<HostSemaphore> FindSemaphore(lwp_sem_t sem)
+{
+    std::lock_guard<std::mutex> Guard(HandlesLock);
+    const auto Found = Semaphores.find(sem);
+    return (Found != Semaphores.end()) ? Found->second : nullptr;
+}
+
+/**
+ * Start a thread.
+ * @param[out] thethread Handle of the thread.
+ * @param[in] entry Function run by the thread.
+ * @param[in] arg Argument of the function.
+ * @return 0 on success.
+ */
+s32 LWP_CreateThread(lwp_t *thethread, void* (*entry)(void *), void *arg,
+    [[maybe_unused]] void *stackbase, [[maybe_unused]] u32 stack_size, [[maybe_unused]] u8 prio)
+{
+    std::lock_guard<std::mutex> Guard(HandlesLock);
+    *thethread = NextHandle++;
+    Threads.emplace(*thethread, std::thread(entry, arg));
+    return 0;
+}
+
+/**
+ * Wait for a thread to end.
+ * @param[in] thethread Handle of the thread.
+ * @param[out] value_ptr Not set.
+ * @return 0 on success, -1 if there is no such thread.
+ */
+s32 LWP_JoinThread(lwp_t thethread, [[maybe_unused]] void **value_ptr)
+{
+    std::thread Thread;
+    {
+        std::lock_guard<std::mutex> Guard(HandlesLock);
+        const auto Found = Threads.find(thethread);
+        if(Found == Threads.end())
+        {
+            return -1;
+        }
+        Thread = std::move(Found->second);
+        Threads.erase(Found);
+    }
+    Thread.join();
+    return 0;
+}
+
+/**
+ * Create a semaphore.
+ * @param[out] sem Handle of the semaphore.
+ * @param[in] start Initial count.
+ * @param[in] max Highest count, a post above it is lost.
+ * @return 0 on success.
+ */
+s32 LWP_SemInit(lwp_sem_t *sem, u32 start, u32 max)
+{
+    auto Semaphore = std::make_shared<HostSemaphore>();
+    Semaphore->Count = start;
+    Semaphore->Max = max;
+    std::lock_guard<std::mutex> Guard(HandlesLock);
+    *sem = NextHandle++;
+    Semaphores.emplace(*sem, std::move(Semaphore));
+    return 0;
+}
+
+/**
+ * Destroy a semaphore.
+ * @param[in] sem Handle of the semaphore.
+ * @return 0 on success, -1 if there is no such semaphore.
+ */
+s32 LWP_SemDestroy(lwp_sem_t sem)
+{
+    std::lock_guard<std::mutex> Guard(HandlesLock);
+    return (Semaphores.erase(sem) != 0) ? 0 : -1;
+}
+
+/**
+ * Wait until the count of a semaphore is not 0, and decrement it.
+ * @param[in] sem Handle of the semaphore.
+ * @return 0 on success, -1 if there is no such semaphore.
+ */
+s32 LWP_SemWait(lwp_sem_t sem)
+{
+    const std::shared_ptr<HostSemaphore> Semaphore = FindSemaphore(sem);
+    if(Semaphore == nullptr)
+    {
+        return -1;
+    }
+    std::unique_lock<std::mutex> Guard(Semaphore->Lock);
+    Semaphore->Posted.wait(Guard, [&Semaphore] { return Semaphore->Count > 0; });
+    --Semaphore->Count;
+    return 0;
+}
+
+/**
+ * Increment the count of a semaphore, and wake up a waiting thread.
+ * @param[in] sem Handle of the semaphore.
+ * @return 0 on success, -1 if there is no such semaphore or it is at its highest count.
+ */
+s32 LWP_SemPost(lwp_sem_t sem)
+{
+    const std::shared_ptr<HostSemaphore> Semaphore = FindSemaphore(sem);
+    if(Semaphore == nullptr)
+    {
+        return -1;
+    }
+    {
+        std::lock_guard<std::mutex> Guard(Semaphore->Lock);
+        if(Semaphore->Count >= Semaphore->Max)
+        {
+            return -1;
+        }
+        ++Semaphore->Count;
+    }
+    Semaphore->Posted.notify_one();
+    return 0;
+}
+
+// EOF
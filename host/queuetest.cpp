@@ -0,0 +1,310 @@
+// host/queuetest.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+/**
+ * @file
+ * Test the queues shared by the game threads.
+ *
+ * The single-producer single-consumer queue is checked for the order of
+ * its items, a full and an empty queue, the wraparound of its indices and
+ * a run with a producer and a consumer thread. The input queue is checked
+ * for the order in which the handlers see the events of a frame. Each
+ * failed check is printed, and the exit code is not 0 if one failed.
+ *
+ * Usage: wtt-queuetest
+ */
+
+#include <cstdio>
+#include <vector>
+#include <thread>
+#include <gctypes.h>
+#include "inputqueue.h"
+#include "spscqueue.h"
+
+static int Failures = 0;
+
+/**
+ * Count and print a failed check.
+ * @param[in] Passed The result of the check.
+ * @param[in] What What is checked.
+ */
+static void Check(bool Passed, const char *What)
+{
+    if(!Passed)
+    {
+        std::fprintf(stderr, "FAILED: %s\n", What);
+        ++Failures;
+    }
+}
+
+/**
+ * Items come out in the order they went in.
+ */
+static void TestSpscOrder()
+{
+    SpscQueue<u32, 8> Queue;
+    Check(Queue.IsEmpty(), "a new queue is empty");
+    for(u32 i = 0; i < 5; ++i)
+    {
+        Check(Queue.Push(i), "push to a queue with room");
+    }
+    Check(!Queue.IsEmpty(), "a queue with items is not empty");
+    bool InOrder = true;
+    for(u32 i = 0; i < 5; ++i)
+    {
+        u32 Item = ~0u;
+        InOrder = InOrder && Queue.Pop(Item) && Item == i;
+    }
+    Check(InOrder, "items are popped in the order they were pushed");
+    Check(Queue.IsEmpty(), "a queue is empty once every item is popped");
+}
+
+/**
+ * A full queue refuses items and keeps the ones it has, an empty queue
+ * gives nothing.
+ */
+static void TestSpscLimits()
+{
+    SpscQueue<u32, 4> Queue;
+    u32 Item = 42;
+    Check(!Queue.Pop(Item), "pop from an empty queue fails");
+    Check(Item == 42, "a failed pop leaves the item untouched");
+    Check(Queue.GetCapacity() == 3, "one slot is kept empty");
+    for(u32 i = 0; i < Queue.GetCapacity(); ++i)
+    {
+        Check(Queue.Push(i), "push up to the capacity");
+    }
+    Check(!Queue.Push(99), "push to a full queue fails");
+    Check(Queue.Pop(Item) && Item == 0, "a full queue still pops its oldest item");
+    Check(Queue.Push(3), "push after a pop from a full queue");
+    for(u32 i = 1; i <= 3; ++i)
+    {
+        Check(Queue.Pop(Item) && Item == i, "the rejected item was not queued");
+    }
+    Check(!Queue.Pop(Item), "pop from a drained queue fails");
+}
+
+/**
+ * The indices wrap around the slots many times without losing an item.
+ */
+static void TestSpscWraparound()
+{
+    SpscQueue<u32, 4> Queue;
+    u32 Pushed = 0;
+    u32 Popped = 0;
+    bool InOrder = true;
+    for(int Round = 0; Round < 100; ++Round)
+    {
+        // Batches of 1 to 3 items, so the indices wrap at every offset
+        const u32 Batch = Round % Queue.GetCapacity() + 1;
+        for(u32 i = 0; i < Batch; ++i)
+        {
+            InOrder = InOrder && Queue.Push(Pushed++);
+        }
+        u32 Item;
+        while(Queue.Pop(Item))
+        {
+            InOrder = InOrder && Item == Popped++;
+        }
+    }
+    Check(InOrder && Popped == Pushed, "items stay in order across wraparounds");
+}
+
+/**
+ * A producer and a consumer thread pass a long sequence through a small
+ * queue, so both often find it full or empty.
+ */
+static void TestSpscThreads()
+{
+    static constexpr u32 ITEMS = 1000000;
+    SpscQueue<u32, 16> Queue;
+    std::thread Producer([&Queue]
+    {
+        for(u32 i = 0; i < ITEMS; ++i)
+        {
+            while(!Queue.Push(i))
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    u32 Expected = 0;
+    bool InOrder = true;
+    while(Expected < ITEMS)
+    {
+        u32 Item;
+        if(!Queue.Pop(Item))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        InOrder = InOrder && Item == Expected;
+        ++Expected;
+    }
+    Producer.join();
+    Check(InOrder, "items cross threads in order, none lost or repeated");
+    Check(Queue.IsEmpty(), "the queue is empty after the threads are done");
+}
+
+/**
+ * Remove every event of an input queue.
+ * @param[in] Queue The input queue.
+ * @return The events, oldest first.
+ */
+static std::vector<InputEvent> Drain(InputQueue &Queue)
+{
+    std::vector<InputEvent> Events;
+    InputEvent Event;
+    while(Queue.Pop(Event))
+    {
+        Events.push_back(Event);
+    }
+    return Events;
+}
+
+/**
+ * Check the type, channel and button of an event.
+ */
+static bool IsEvent(const InputEvent &Event, InputEvent::Type What, u8 Chan, u32 Button = 0)
+{
+    return Event.What == What && Event.Chan == Chan && Event.Button == Button;
+}
+
+/**
+ * The pointer moves of a frame come before its buttons, and the buttons
+ * of each Wii Remote are queued in the order of their bit, presses before
+ * releases.
+ */
+static void TestInputOrder()
+{
+    using enum InputEvent::Type;
+    InputQueue Queue;
+    PadFrame Frame{};
+    Frame[0].Down = Frame[0].Held = 0x0C;
+    Frame[2].IRValid = true;
+    Frame[2].IRX = 10.0f;
+    Queue.Scan(Frame);
+    std::vector<InputEvent> Events = Drain(Queue);
+    Check(Events.size() == 3 &&
+        IsEvent(Events[0], PointerMove, 2) && Events[0].Pointing && Events[0].X == 10.0f &&
+        IsEvent(Events[1], Press, 0, 0x04) &&
+        IsEvent(Events[2], Press, 0, 0x08),
+        "pointer moves come first, then the presses in bit order");
+
+    Frame[0].Down = 0;
+    Queue.Scan(Frame);
+    Check(Drain(Queue).empty(), "a frame where nothing changes queues nothing");
+
+    Frame[0].Held = 0x04;
+    Frame[1].Down = Frame[1].Held = 0x01;
+    Queue.Scan(Frame);
+    Events = Drain(Queue);
+    Check(Events.size() == 2 &&
+        IsEvent(Events[0], Release, 0, 0x08) &&
+        IsEvent(Events[1], Press, 1, 0x01),
+        "the buttons of each Wii Remote in the order of the channels");
+
+    Frame[0].Down = Frame[0].Held = 0x01;
+    Frame[1].Down = 0;
+    Queue.Scan(Frame);
+    Events = Drain(Queue);
+    Check(Events.size() == 2 &&
+        IsEvent(Events[0], Press, 0, 0x01) &&
+        IsEvent(Events[1], Release, 0, 0x04),
+        "the presses of a Wii Remote come before its releases");
+}
+
+/**
+ * Every zone left is queued before any zone entered, and ClearZones
+ * enters the zones again without leaving them.
+ */
+static void TestInputZones()
+{
+    using enum InputEvent::Type;
+    InputQueue Queue;
+    Queue.SetZones({1, InputQueue::NO_ZONE, InputQueue::NO_ZONE, InputQueue::NO_ZONE});
+    std::vector<InputEvent> Events = Drain(Queue);
+    Check(Events.size() == 1 && IsEvent(Events[0], ZoneEnter, 0) && Events[0].Zone == 1,
+        "a zone entered is queued");
+
+    // Remote 1 enters the zone remote 0 leaves for another one
+    Queue.SetZones({2, 1, InputQueue::NO_ZONE, InputQueue::NO_ZONE});
+    Events = Drain(Queue);
+    Check(Events.size() == 3 &&
+        IsEvent(Events[0], ZoneLeave, 0) && Events[0].Zone == 1 &&
+        IsEvent(Events[1], ZoneEnter, 0) && Events[1].Zone == 2 &&
+        IsEvent(Events[2], ZoneEnter, 1) && Events[2].Zone == 1,
+        "zones left come before zones entered");
+
+    Queue.SetZones({2, 1, InputQueue::NO_ZONE, InputQueue::NO_ZONE});
+    Check(Drain(Queue).empty(), "the same zones queue nothing");
+
+    Queue.ClearZones();
+    Queue.SetZones({2, InputQueue::NO_ZONE, InputQueue::NO_ZONE, InputQueue::NO_ZONE});
+    Events = Drain(Queue);
+    Check(Events.size() == 1 && IsEvent(Events[0], ZoneEnter, 0) && Events[0].Zone == 2,
+        "zones are entered again after ClearZones, none left");
+}
+
+/**
+ * The events that do not fit are dropped and counted, the queue works
+ * again once emptied.
+ */
+static void TestInputOverflow()
+{
+    InputQueue Queue;
+    PadFrame Frame{};
+    u32 Queued = 0;
+    for(u32 i = 0; Queued <= InputQueue::CAPACITY; ++i)
+    {   // 32 presses, then 32 releases, of each Wii Remote
+        for(PadState &Pad : Frame)
+        {
+            Pad.Down = (i % 2 == 0) ? ~0u : 0;
+            Pad.Held = Pad.Down;
+        }
+        Queue.Scan(Frame);
+        Queued += MAX_PADS * 32;
+    }
+    const size_t Kept = Drain(Queue).size();
+    Check(Kept == InputQueue::CAPACITY, "a full input queue keeps its capacity");
+    Check(Queue.GetDropped() == Queued - InputQueue::CAPACITY, "the events dropped are counted");
+
+    Frame[3].Down = Frame[3].Held = 0x02;
+    Queue.Scan(Frame);
+    const std::vector<InputEvent> Events = Drain(Queue);
+    Check(!Events.empty() && IsEvent(Events.front(), InputEvent::Type::Press, 3, 0x02),
+        "an emptied input queue takes events again");
+}
+
+/**
+ * Entry point.
+ * @return 0 if every check passed, 1 otherwise.
+ */
+int main()
+{
+    TestSpscOrder();
+    TestSpscLimits();
+    TestSpscWraparound();
+    TestSpscThreads();
+    TestInputOrder();
+    TestInputZones();
+    TestInputOverflow();
+    if(Failures > 0)
+    {
+        std::fprintf(stderr, "%d check(s) failed\n", Failures);
+        return 1;
+    }
+    std::puts("All checks passed");
+    return 0;
+}
+
+// EOF
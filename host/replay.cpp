@@ -0,0 +1,128 @@
+// host/replay.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+/**
+ * @file
+ * Check an input recording made with --record.
+ *
+ * The recording is decoded with the same reader as the game. The seed, the
+ * number of frames, the button presses of each Wii Remote, the input
+ * events the game makes of them and a hash of every decoded frame are
+ * printed. Two recordings with the same hash replay
+ * the same session. The exit code is not 0 if the recording is truncated.
+ *
+ * Usage: wtt-replay <file> [--dump]
+ */
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdio>
+#include <cstring>
+#include "inputqueue.h"
+#include "inputstream.h"
+
+/**
+ * Add a value to an FNV-1a hash.
+ */
+static u32 HashValue(u32 Hash, u32 Value)
+{
+    for(int i = 0; i < 4; ++i)
+    {
+        Hash = (Hash ^ ((Value >> (i * 8)) & 0xFF)) * 16777619u;
+    }
+    return Hash;
+}
+
+/**
+ * Entry point.
+ * @param[in] argc The number of arguments invoked with the program.
+ * @param[in] argv The array containing the arguments.
+ * @return 0 if the recording is valid, an error code otherwise.
+ */
+int main(int argc, char **argv)
+{
+    if(argc < 2)
+    {
+        std::fputs("usage: wtt-replay <file> [--dump]\n", stderr);
+        return 2;
+    }
+    const bool Dump = argc > 2 && std::strcmp(argv[2], "--dump") == 0;
+
+    InputReader Reader;
+    if(!Reader.Open(argv[1]))
+    {
+        std::fprintf(stderr, "wtt-replay: %s is not an input recording\n", argv[1]);
+        return 1;
+    }
+
+    PadFrame Frame;
+    u32 Frames = 0;
+    u32 Hash = 2166136261u;
+    std::array<u32, MAX_PADS> Presses{};
+    InputQueue Queue;
+    std::array<u32, static_cast<size_t>(InputEvent::Type::Count)> Events{};
+    u32 MostEvents = 0;
+    while(Reader.Read(Frame))
+    {
+        Queue.Scan(Frame);
+        InputEvent Event;
+        u32 FrameEvents = 0;
+        while(Queue.Pop(Event))
+        {
+            ++Events[static_cast<size_t>(Event.What)];
+            ++FrameEvents;
+        }
+        MostEvents = std::max(MostEvents, FrameEvents);
+
+        for(u8 i = 0; i < MAX_PADS; ++i)
+        {
+            const PadState &Pad = Frame[i];
+            Presses[i] += std::popcount(Pad.Down);
+            Hash = HashValue(Hash, Pad.Down);
+            Hash = HashValue(Hash, Pad.Held);
+            Hash = HashValue(Hash, std::bit_cast<u32>(Pad.IRX));
+            Hash = HashValue(Hash, std::bit_cast<u32>(Pad.IRY));
+            Hash = HashValue(Hash, std::bit_cast<u32>(Pad.Roll));
+            Hash = HashValue(Hash, (Pad.IRValid ? 1 : 0) | (Pad.Connected ? 2 : 0));
+            if(Dump && Pad.Connected)
+            {
+                std::printf("%6u pad %u: down %08x held %08x", Frames, i, Pad.Down, Pad.Held);
+                if(Pad.IRValid)
+                {
+                    std::printf(" ir %.2f,%.2f roll %.2f", Pad.IRX, Pad.IRY, Pad.Roll);
+                }
+                std::putchar('\n');
+            }
+        }
+        ++Frames;
+    }
+
+    std::printf("seed: %u\n", Reader.GetSeed());
+    std::printf("frames: %u\n", Frames);
+    for(u8 i = 0; i < MAX_PADS; ++i)
+    {
+        std::printf("pad %u presses: %u\n", i, Presses[i]);
+    }
+    std::printf("events: %u presses, %u releases, %u pointer moves, at most %u in a frame\n",
+        Events[static_cast<size_t>(InputEvent::Type::Press)],
+        Events[static_cast<size_t>(InputEvent::Type::Release)],
+        Events[static_cast<size_t>(InputEvent::Type::PointerMove)], MostEvents);
+    std::printf("hash: %08x\n", Hash);
+    if(!Reader.IsFinished())
+    {
+        std::fputs("wtt-replay: the recording is truncated\n", stderr);
+        return 1;
+    }
+    return 0;
+}
+
+// EOF
@@ -0,0 +1,414 @@
+// host/softaudio.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#include <algorithm>
+#include "audiosink.h"
+#include "mixeffects.h"
+#include "softaudio.h"
+
+/**
+ * Read a frame of a voice.
+ * @tparam Format Encoding of the samples.
+ * @tparam Native The samples are a stream buffer in the byte order of the host.
+ * @param[in] Data The big-endian samples of a sound.
+ * @param[in] Stream The samples of a stream buffer.
+ * @param[in] Index The frame.
+ * @param[out] Left The left sample.
+ * @param[out] Right The right sample, the same as the left one for mono.
+ */
+template <SoundFormat Format, bool Native>
+static inline void ReadFrame(const u8 *Data, const s16 *Stream, u32 Index, s32 &Left, s32 &Right)
+{
+    if constexpr(Native)
+    {
+        Left = Right = Stream[Index];
+    }
+    else if constexpr(Format == SoundFormat::Mono8)
+    {
+        Left = Right = static_cast<s8>(Data[Index]) * 256;
+    }
+    else if constexpr(Format == SoundFormat::Stereo8)
+    {
+        Left = static_cast<s8>(Data[Index * 2]) * 256;
+        Right = static_cast<s8>(Data[Index * 2 + 1]) * 256;
+    }
+    else if constexpr(Format == SoundFormat::Stereo16)
+    {
+        const u8 *Frame = Data + Index * 4;
+        Left = static_cast<s16>((Frame[0] << 8) | Frame[1]);
+        Right = static_cast<s16>((Frame[2] << 8) | Frame[3]);
+    }
+    else
+    {
+        const u8 *Frame = Data + Index * 2;
+        Left = Right = static_cast<s16>((Frame[0] << 8) | Frame[1]);
+    }
+}
+
+/**
+ * Constructor for the SoftAudio class.
+ * @param[in] ASink Where the mix is written, it must outlive the backend.
+ */
+SoftAudio::SoftAudio(AudioSink &ASink) :
+    Sink(ASink),
+    Mix(BLOCK_FRAMES * 2),
+    Output(BLOCK_FRAMES * 2)
+{
+}
+
+/**
+ * Start mixing.
+ */
+void SoftAudio::Initialize()
+{
+    Paused = false;
+}
+
+/**
+ * Stop mixing.
+ */
+void SoftAudio::Exit()
+{
+    Paused = true;
+}
+
+/**
+ * Pause or resume every voice, silence is rendered while paused.
+ * @param[in] APaused On or off.
+ */
+void SoftAudio::Pause(bool APaused)
+{
+    Paused = APaused;
+}
+
+/**
+ * Nothing to do, the mixer reads main memory.
+ */
+void SoftAudio::FlushBuffer(const void*, u32)
+{
+}
+
+/**
+ * Set the effects applied to the output.
+ * @param[in] AEffects The effects, they must outlive the backend; nullptr for none.
+ */
+void SoftAudio::SetEffects(MixEffects *AEffects)
+{
+    Effects = AEffects;
+}
+
+/**
+ * Allocate a voice.
+ * @param[in] Callback Called when a stream voice needs its next buffer,
+ *                     nullptr for a voice playing whole sounds.
+ * @param[in] User Given to the callback.
+ * @return The voice.
+ */
+AudioBackend::VoiceId SoftAudio::AllocateVoice(StreamCallback Callback, void *User)
+{
+    auto Free = std::find_if(Voices.begin(), Voices.end(), [](const SoftVoice &Item) { return !Item.Allocated; });
+    if(Free == Voices.end())
+    {
+        Free = Voices.emplace(Voices.end());
+    }
+    *Free = SoftVoice();
+    Free->Allocated = true;
+    Free->Callback = Callback;
+    Free->User = User;
+    return static_cast<VoiceId>(Free - Voices.begin());
+}
+
+/**
+ * Free a voice.
+ * @param[in] Id The voice, NO_VOICE is ignored.
+ */
+void SoftAudio::FreeVoice(VoiceId Id)
+{
+    if(Id != NO_VOICE)
+    {
+        Voices[Id] = SoftVoice();
+    }
+}
+
+/**
+ * Play a sound on a voice.
+ * @param[in] Id The voice.
+ * @param[in] sound The sound, it cannot be ADPCM.
+ * @param[in] Delay Time before the sound starts, in milliseconds.
+ * @param[in] Looped Set true to make the sound loop, false otherwise.
+ */
+void SoftAudio::PlayVoice(VoiceId Id, const Sound &sound, u32 Delay, bool Looped)
+{
+    SoftVoice &Voice = Voices[Id];
+    Voice.Format = sound.GetFormat();
+    Voice.Data = sound.GetBuffer().data();
+    Voice.Stream = nullptr;
+    Voice.Length = sound.GetSampleCount();
+    Voice.Position = 0;
+    Voice.Step = GetStep(sound.GetFrequency());
+    Voice.Delay = Delay * (SAMPLE_RATE / 1000);
+    Voice.Looped = Looped;
+    Voice.Playing = (Voice.Format != SoundFormat::MonoAdpcm);
+    Voice.Stopped = false;
+}
+
+/**
+ * Give a stream voice the buffer to play.
+ * @param[in] Id The voice.
+ * @param[in] Samples The samples.
+ * @param[in] Frequency Their sample rate.
+ */
+void SoftAudio::SetVoiceBuffer(VoiceId Id, std::span<const s16> Samples, f32 Frequency)
+{
+    SoftVoice &Voice = Voices[Id];
+    Voice.Format = SoundFormat::Mono16;
+    Voice.Data = nullptr;
+    Voice.Stream = Samples.data();
+    Voice.Length = Samples.size();
+    Voice.Position = 0;
+    Voice.Step = GetStep(Frequency);
+    Voice.Playing = true;
+}
+
+/**
+ * Set the volume of a voice, between 0 and 255.
+ * @param[in] Id The voice.
+ * @param[in] LeftVolume The left volume.
+ * @param[in] RightVolume The right volume.
+ */
+void SoftAudio::SetVoiceVolume(VoiceId Id, u16 LeftVolume, u16 RightVolume)
+{
+    Voices[Id].LeftVolume = LeftVolume;
+    Voices[Id].RightVolume = RightVolume;
+}
+
+/**
+ * Mute a voice, it keeps playing silently.
+ * @param[in] Id The voice.
+ * @param[in] Mute Set true to mute the voice, false otherwise.
+ */
+void SoftAudio::SetVoiceMute(VoiceId Id, bool Mute)
+{
+    Voices[Id].Muted = Mute;
+}
+
+/**
+ * Stop or resume a voice.
+ * @param[in] Id The voice.
+ * @param[in] Stop Set true to stop the voice, false to resume it.
+ */
+void SoftAudio::SetVoiceStop(VoiceId Id, bool Stop)
+{
+    Voices[Id].Stopped = Stop;
+}
+
+/**
+ * There is no module player.
+ * @return Always false.
+ */
+bool SoftAudio::LoadModule(std::span<const char>)
+{
+    return false;
+}
+
+/**
+ * There is no module player.
+ */
+void SoftAudio::StartModule(u16)
+{
+}
+
+/**
+ * There is no module player.
+ */
+void SoftAudio::PauseModule(bool)
+{
+}
+
+/**
+ * There is no module player.
+ */
+void SoftAudio::UnloadModule()
+{
+}
+
+/**
+ * There is no module player.
+ * @return Always 0.
+ */
+u32 SoftAudio::TakeModuleTicks()
+{
+    return 0;
+}
+
+/**
+ * Mix the voices and write the result to the sink.
+ * Stream callbacks are called from here, on the calling thread.
+ * @param[in] FrameCount Number of stereo frames to render.
+ */
+void SoftAudio::Render(u32 FrameCount)
+{
+    while(FrameCount > 0)
+    {
+        const u32 Count = std::min(FrameCount, BLOCK_FRAMES);
+        std::fill_n(Mix.begin(), Count * 2, 0);
+        if(!Paused)
+        {
+            for(SoftVoice &Voice : Voices)
+            {
+                if(Voice.Allocated && Voice.Playing && !Voice.Stopped)
+                {
+                    MixVoice(Voice, Mix.data(), Count);
+                }
+            }
+        }
+        for(u32 i = 0; i < Count * 2; ++i)
+        {
+            Output[i] = static_cast<s16>(std::clamp(Mix[i], -32768, 32767));
+        }
+        if(Effects != nullptr)
+        {
+            Effects->Process({Output.data(), Count * 2});
+        }
+        Sink.Write({Output.data(), Count * 2});
+        RenderedFrames += Count;
+        FrameCount -= Count;
+    }
+}
+
+/**
+ * Get the number of frames rendered since the backend was created.
+ * @return The number of frames.
+ */
+u64 SoftAudio::GetRenderedFrames() const
+{
+    return RenderedFrames;
+}
+
+/**
+ * Add a voice to the mix.
+ * At the end of its data, a stream voice asks for its next buffer and a
+ * looped voice starts again.
+ * @param[in,out] Voice The voice.
+ * @param[in,out] Mix The stereo mix.
+ * @param[in] FrameCount Number of frames to mix.
+ */
+void SoftAudio::MixVoice(SoftVoice &Voice, s32 *Mix, u32 FrameCount)
+{
+    u32 Done = std::min(Voice.Delay, FrameCount);
+    Voice.Delay -= Done;
+    while(Done < FrameCount && Voice.Playing && !Voice.Stopped)
+    {
+        if(Voice.Length == 0)
+        {
+            Voice.Playing = false;
+            break;
+        }
+        s32 *Out = Mix + Done * 2;
+        const u32 Count = FrameCount - Done;
+        if(Voice.Stream != nullptr)
+        {
+            Done += MixFrames<SoundFormat::Mono16, true>(Voice, Out, Count);
+        }
+        else
+        {
+            switch(Voice.Format)
+            {
+                case SoundFormat::Mono8:
+                    Done += MixFrames<SoundFormat::Mono8, false>(Voice, Out, Count);
+                    break;
+                case SoundFormat::Stereo8:
+                    Done += MixFrames<SoundFormat::Stereo8, false>(Voice, Out, Count);
+                    break;
+                case SoundFormat::Stereo16:
+                    Done += MixFrames<SoundFormat::Stereo16, false>(Voice, Out, Count);
+                    break;
+                default:
+                    Done += MixFrames<SoundFormat::Mono16, false>(Voice, Out, Count);
+                    break;
+            }
+        }
+
+        const u64 End = static_cast<u64>(Voice.Length) << 32;
+        if(Voice.Position < End)
+        {
+            continue;
+        }
+        const u64 Over = Voice.Position - End;
+        if(Voice.Callback != nullptr)
+        {
+            Voice.Playing = false;
+            Voice.Callback(Voice.User);
+            Voice.Position = Over;
+        }
+        else if(Voice.Looped)
+        {
+            Voice.Position = Over % End;
+        }
+        else
+        {
+            Voice.Playing = false;
+        }
+    }
+}
+
+/**
+ * Mix the frames of a voice until the end of its data.
+ * The voice is resampled by linear interpolation.
+ * @tparam Format Encoding of the samples.
+ * @tparam Native The samples are a stream buffer in the byte order of the host.
+ * @param[in,out] Voice The voice.
+ * @param[in,out] Mix The stereo mix.
+ * @param[in] FrameCount Most frames to mix.
+ * @return The number of frames mixed.
+ */
+template <SoundFormat Format, bool Native>
+u32 SoftAudio::MixFrames(SoftVoice &Voice, s32 *Mix, u32 FrameCount)
+{
+    const u8 *Data = Voice.Data;
+    const s16 *Stream = Voice.Stream;
+    const u32 Last = Voice.Length - 1;
+    const s32 LeftVolume = Voice.Muted ? 0 : Voice.LeftVolume;
+    const s32 RightVolume = Voice.Muted ? 0 : Voice.RightVolume;
+    u64 Position = Voice.Position;
+    u32 Done = 0;
+    for(; Done < FrameCount; ++Done)
+    {
+        const u32 Index = static_cast<u32>(Position >> 32);
+        if(Index > Last)
+        {
+            break;
+        }
+        const s32 Fraction = static_cast<s32>((Position >> 17) & 0x7FFF);
+        s32 Left0, Right0, Left1, Right1;
+        ReadFrame<Format, Native>(Data, Stream, Index, Left0, Right0);
+        ReadFrame<Format, Native>(Data, Stream, std::min(Index + 1, Last), Left1, Right1);
+        const s32 Left = Left0 + (((Left1 - Left0) * Fraction) >> 15);
+        const s32 Right = Right0 + (((Right1 - Right0) * Fraction) >> 15);
+        Mix[Done * 2] += (Left * LeftVolume) >> 8;
+        Mix[Done * 2 + 1] += (Right * RightVolume) >> 8;
+        Position += Voice.Step;
+    }
+    Voice.Position = Position;
+    return Done;
+}
+
+/**
+ * Get the step of a voice in its data for each output frame.
+ * @param[in] Frequency Sample rate of the voice.
+ * @return The step, 32.32 fixed point.
+ */
+u64 SoftAudio::GetStep(f32 Frequency)
+{
+    return static_cast<u64>(static_cast<f64>(Frequency) / SAMPLE_RATE * 4294967296.0);
+}
+
+// EOF
@@ -0,0 +1,100 @@
+// host/softaudio.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#ifndef SoftAudioH
+#define SoftAudioH
+//---------------------------------------------------------------------------
+
+#include <vector>
+#include "audiobackend.h"
+#include "sound.h"
+
+class AudioSink;
+
+/**
+ * Audio backend mixing the voices in main memory.
+ * Like the DSP mixer of AESND, it runs at 48 kHz, resamples each voice to
+ * that rate and scales it by its volumes (255 is full scale). Time only
+ * moves when Render is called, so the output does not depend on the speed
+ * of the machine. There is no module player: modules are silent.
+ * @author Crayon
+ */
+class SoftAudio : public AudioBackend
+{
+public:
+    static constexpr u32 SAMPLE_RATE = 48000;  /**< Output rate. */
+    static constexpr u32 BLOCK_FRAMES = 256;   /**< Frames mixed at a time. */
+
+    explicit SoftAudio(AudioSink &ASink);
+
+    void Initialize() override;
+    void Exit() override;
+    void Pause(bool Paused) override;
+    void FlushBuffer(const void *Data, u32 Size) override;
+    void SetEffects(MixEffects *AEffects) override;
+
+    [[nodiscard]] VoiceId AllocateVoice(StreamCallback Callback = nullptr, void *User = nullptr) override;
+    void FreeVoice(VoiceId Id) override;
+    void PlayVoice(VoiceId Id, const Sound &sound, u32 Delay, bool Looped) override;
+    void SetVoiceBuffer(VoiceId Id, std::span<const s16> Samples, f32 Frequency) override;
+    void SetVoiceVolume(VoiceId Id, u16 LeftVolume, u16 RightVolume) override;
+    void SetVoiceMute(VoiceId Id, bool Mute) override;
+    void SetVoiceStop(VoiceId Id, bool Stop) override;
+
+    bool LoadModule(std::span<const char> Data) override;
+    void StartModule(u16 Volume) override;
+    void PauseModule(bool Paused) override;
+    void UnloadModule() override;
+    [[nodiscard]] u32 TakeModuleTicks() override;
+
+    void Render(u32 FrameCount);
+    [[nodiscard]] u64 GetRenderedFrames() const;
+private:
+    /**
+     * State of a voice.
+     */
+    struct SoftVoice
+    {
+        bool Allocated{false};
+        bool Playing{false};
+        bool Stopped{false};
+        bool Muted{false};
+        bool Looped{false};
+        SoundFormat Format{SoundFormat::Mono16};
+        const u8 *Data{nullptr};     /**< Big-endian samples of a sound. */
+        const s16 *Stream{nullptr};  /**< Native samples of a stream buffer. */
+        u32 Length{0};               /**< Frames of the data. */
+        u64 Position{0};             /**< Frame being played, 32.32 fixed point. */
+        u64 Step{0};                 /**< Frames per output frame, 32.32 fixed point. */
+        u32 Delay{0};                /**< Output frames before the voice starts. */
+        s32 LeftVolume{255};
+        s32 RightVolume{255};
+        StreamCallback Callback{nullptr};
+        void *User{nullptr};
+    };
+
+    void MixVoice(SoftVoice &Voice, s32 *Mix, u32 FrameCount);
+    template <SoundFormat Format, bool Native>
+    static u32 MixFrames(SoftVoice &Voice, s32 *Mix, u32 FrameCount);
+    static u64 GetStep(f32 Frequency);
+
+    AudioSink &Sink;
+    MixEffects *Effects{nullptr};
+    std::vector<SoftVoice> Voices;
+    std::vector<s32> Mix;      /**< Sum of the voices, stereo. */
+    std::vector<s16> Output;   /**< Clamped mix, stereo. */
+    bool Paused{true};
+    u64 RenderedFrames{0};
+};
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
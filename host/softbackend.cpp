@@ -0,0 +1,693 @@
+// host/softbackend.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <numbers>
+#include <png.h>
+#include "softbackend.h"
+
+using namespace GRRLIBpp;
+
+/**
+ * Return the offset of a texel in an RGBA8 texture.
+ * @param x Specifies the x-coordinate of the texel.
+ * @param y Specifies the y-coordinate of the texel.
+ * @param w Width of the texture.
+ * @return The offset of the alpha byte, the green byte is 32 bytes later.
+ */
+static inline u32 RGBA8Offset(u32 x, u32 y, u32 w)
+{
+    return (((y & ~3u) << 2) * w) + ((x & ~3u) << 4) + ((((y & 3) << 2) + (x & 3)) << 1);
+}
+
+/**
+ * Return the offset of a texel in an IA8 texture.
+ * @param x Specifies the x-coordinate of the texel.
+ * @param y Specifies the y-coordinate of the texel.
+ * @param w Width of the texture.
+ * @return The offset of the alpha byte, the intensity byte follows it.
+ */
+static inline u32 IA8Offset(u32 x, u32 y, u32 w)
+{
+    return (((y >> 2) * ((w + 3) >> 2) + (x >> 2)) << 5) + ((((y & 3) << 2) + (x & 3)) << 1);
+}
+
+/**
+ * Multiply two 8-bit components.
+ */
+static inline u32 Modulate(u32 a, u32 b)
+{
+    return (a * b + 127) / 255;
+}
+
+/**
+ * Constructor for the SoftBackend class.
+ * @param AWidth Width of the framebuffer.
+ * @param AHeight Height of the framebuffer.
+ */
+SoftBackend::SoftBackend(u16 AWidth, u16 AHeight) :
+    Width(AWidth),
+    Height(AHeight),
+    Framebuffer(AWidth * AHeight, 0x000000FF),
+    Displayed(AWidth * AHeight, 0x000000FF),
+    ClipRight(AWidth),
+    ClipBottom(AHeight)
+{
+}
+
+/**
+ * Clear the framebuffer.
+ * @return Always 0.
+ */
+s32 SoftBackend::Initialize()
+{
+    std::fill(Framebuffer.begin(), Framebuffer.end(), Background);
+    ClipReset();
+    return 0;
+}
+
+/**
+ * Nothing to release, the framebuffer lives as long as the backend.
+ */
+void SoftBackend::Exit()
+{
+}
+
+/**
+ * Keep the frame as the displayed one and clear the framebuffer.
+ */
+void SoftBackend::Render()
+{
+    Displayed = Framebuffer;
+    std::fill(Framebuffer.begin(), Framebuffer.end(), Background);
+    ++FrameCount;
+}
+
+/**
+ * Return the width of the framebuffer in pixels.
+ * @return The width in pixels.
+ */
+u16 SoftBackend::GetWidth() const
+{
+    return Width;
+}
+
+/**
+ * Return the height of the framebuffer in pixels.
+ * @return The height in pixels.
+ */
+u16 SoftBackend::GetHeight() const
+{
+    return Height;
+}
+
+/**
+ * Set the color used to clear the framebuffer, there is no alpha in the framebuffer.
+ * @param color The color in RGBA format.
+ */
+void SoftBackend::SetBackgroundColor(u32 color)
+{
+    Background = color | 0xFF;
+}
+
+/**
+ * Fill the screen with a color, blended like any other primitive.
+ * @param color The color in RGBA format.
+ */
+void SoftBackend::FillScreen(u32 color)
+{
+    Rectangle(0, 0, Width, Height, color, true);
+}
+
+/**
+ * Draw a dot.
+ * @param x Specifies the x-coordinate of the dot.
+ * @param y Specifies the y-coordinate of the dot.
+ * @param color The color of the dot in RGBA format.
+ */
+void SoftBackend::Plot(f32 x, f32 y, u32 color)
+{
+    BlendPixel(std::lround(x), std::lround(y), color);
+}
+
+/**
+ * Draw a line with the Bresenham algorithm.
+ * @param x1 Starting point for the x-coordinate.
+ * @param y1 Starting point for the y-coordinate.
+ * @param x2 Ending point for the x-coordinate.
+ * @param y2 Ending point for the y-coordinate.
+ * @param color Line color in RGBA format.
+ */
+void SoftBackend::Line(f32 x1, f32 y1, f32 x2, f32 y2, u32 color)
+{
+    int x = std::lround(x1);
+    int y = std::lround(y1);
+    const int xEnd = std::lround(x2);
+    const int yEnd = std::lround(y2);
+    const int dx = std::abs(xEnd - x);
+    const int dy = -std::abs(yEnd - y);
+    const int sx = (x < xEnd) ? 1 : -1;
+    const int sy = (y < yEnd) ? 1 : -1;
+    int err = dx + dy;
+
+    while(true)
+    {
+        BlendPixel(x, y, color);
+        if(x == xEnd && y == yEnd)
+        {
+            break;
+        }
+        const int e2 = 2 * err;
+        if(e2 >= dy)
+        {
+            err += dy;
+            x += sx;
+        }
+        if(e2 <= dx)
+        {
+            err += dx;
+            y += sy;
+        }
+    }
+}
+
+/**
+ * Draw a rectangle.
+ * @param x Specifies the x-coordinate of the upper-left corner.
+ * @param y Specifies the y-coordinate of the upper-left corner.
+ * @param width The width of the rectangle.
+ * @param height The height of the rectangle.
+ * @param color The color of the rectangle in RGBA format.
+ * @param filled Set to true to fill the rectangle.
+ */
+void SoftBackend::Rectangle(f32 x, f32 y, f32 width, f32 height, u32 color, bool filled)
+{
+    const f32 x2 = x + width;
+    const f32 y2 = y + height;
+    if(!filled)
+    {
+        Line(x, y, x2, y, color);
+        Line(x2, y, x2, y2, color);
+        Line(x2, y2, x, y2, color);
+        Line(x, y2, x, y, color);
+        return;
+    }
+
+    // Pixels whose center is inside the rectangle
+    const int Left = std::max<int>(std::ceil(x - 0.5f), ClipLeft);
+    const int Top = std::max<int>(std::ceil(y - 0.5f), ClipTop);
+    const int Right = std::min<int>(std::ceil(x2 - 0.5f), ClipRight);
+    const int Bottom = std::min<int>(std::ceil(y2 - 0.5f), ClipBottom);
+    for(int py = Top; py < Bottom; ++py)
+    {
+        for(int px = Left; px < Right; ++px)
+        {
+            BlendPixel(px, py, color);
+        }
+    }
+}
+
+/**
+ * Draw a circle.
+ * @param x Specifies the x-coordinate of the center.
+ * @param y Specifies the y-coordinate of the center.
+ * @param radius The radius of the circle.
+ * @param color The color of the circle in RGBA format.
+ * @param filled Set to true to fill the circle.
+ */
+void SoftBackend::Circle(f32 x, f32 y, f32 radius, u32 color, bool filled)
+{
+    if(!filled)
+    {   // Same number of segments as GRRLIB
+        constexpr int SEGMENTS = 36;
+        for(int i = 0; i < SEGMENTS; ++i)
+        {
+            const f32 a1 = 2 * std::numbers::pi_v<f32> * i / SEGMENTS;
+            const f32 a2 = 2 * std::numbers::pi_v<f32> * (i + 1) / SEGMENTS;
+            Line(x + radius * std::cos(a1), y + radius * std::sin(a1),
+                 x + radius * std::cos(a2), y + radius * std::sin(a2), color);
+        }
+        return;
+    }
+
+    const int Top = std::max<int>(std::floor(y - radius), ClipTop);
+    const int Bottom = std::min<int>(std::ceil(y + radius) + 1, ClipBottom);
+    for(int py = Top; py < Bottom; ++py)
+    {
+        const f32 dy = py + 0.5f - y;
+        if(dy * dy > radius * radius)
+        {
+            continue;
+        }
+        const f32 Half = std::sqrt(radius * radius - dy * dy);
+        const int Left = std::max<int>(std::ceil(x - Half - 0.5f), ClipLeft);
+        const int Right = std::min<int>(std::ceil(x + Half - 0.5f), ClipRight);
+        for(int px = Left; px < Right; ++px)
+        {
+            BlendPixel(px, py, color);
+        }
+    }
+}
+
+/**
+ * Discard the pixels with an alpha lower or equal to a threshold.
+ * @param threshold The alpha threshold, 0 to keep every visible pixel.
+ */
+void SoftBackend::SetAlphaTest(u8 threshold)
+{
+    AlphaThreshold = threshold;
+}
+
+/**
+ * Restrict drawing to a rectangle.
+ * @param x Specifies the x-coordinate of the upper-left corner.
+ * @param y Specifies the y-coordinate of the upper-left corner.
+ * @param width The width of the rectangle.
+ * @param height The height of the rectangle.
+ */
+void SoftBackend::ClipDrawing(int x, int y, int width, int height)
+{
+    ClipLeft = std::clamp<int>(x, 0, Width);
+    ClipTop = std::clamp<int>(y, 0, Height);
+    ClipRight = std::clamp<int>(x + width, 0, Width);
+    ClipBottom = std::clamp<int>(y + height, 0, Height);
+}
+
+/**
+ * Allow drawing on the whole framebuffer.
+ */
+void SoftBackend::ClipReset()
+{
+    ClipDrawing(0, 0, Width, Height);
+}
+
+/**
+ * Write the framebuffer to a PNG file.
+ * @param filename Name of the file to write.
+ * @return true if everything worked, false otherwise.
+ */
+bool SoftBackend::ScreenShot(const char *filename)
+{
+    std::vector<u8> Pixels;
+    Pixels.reserve(Framebuffer.size() * 3);
+    for(const u32 Color : Framebuffer)
+    {
+        Pixels.push_back(R(Color));
+        Pixels.push_back(G(Color));
+        Pixels.push_back(B(Color));
+    }
+
+    png_image Image;
+    std::memset(&Image, 0, sizeof(Image));
+    Image.version = PNG_IMAGE_VERSION;
+    Image.width = Width;
+    Image.height = Height;
+    Image.format = PNG_FORMAT_RGB;
+    return png_image_write_to_file(&Image, filename, 0, Pixels.data(), 0, nullptr) != 0;
+}
+
+/**
+ * Decode a PNG image to an RGBA8 texture.
+ * @param Buffer The image file in memory.
+ * @param Size The size of the buffer, found from the PNG chunks when 0.
+ * @return A texture allocated with malloc, or nullptr if the image is not a valid PNG.
+ */
+GRRLIB_texImg* SoftBackend::LoadTexture(const u8 *Buffer, u32 Size)
+{
+    if(png_sig_cmp(Buffer, 0, 8) != 0)
+    {   // JPEG and Bitmap images are not used by the game
+        return nullptr;
+    }
+    if(Size == 0)
+    {   // Walk the chunks up to IEND, like GRRLIB the game may not know the size
+        Size = 8;
+        while(true)
+        {
+            const u8 *Chunk = Buffer + Size;
+            const u32 Length = (Chunk[0] << 24) | (Chunk[1] << 16) | (Chunk[2] << 8) | Chunk[3];
+            Size += 12 + Length;
+            if(std::memcmp(Chunk + 4, "IEND", 4) == 0)
+            {
+                break;
+            }
+        }
+    }
+
+    png_image Image;
+    std::memset(&Image, 0, sizeof(Image));
+    Image.version = PNG_IMAGE_VERSION;
+    if(png_image_begin_read_from_memory(&Image, Buffer, Size) == 0)
+    {
+        return nullptr;
+    }
+    Image.format = PNG_FORMAT_RGBA;
+    std::vector<u8> Pixels(PNG_IMAGE_SIZE(Image));
+    if(png_image_finish_read(&Image, nullptr, Pixels.data(), 0, nullptr) == 0)
+    {
+        png_image_free(&Image);
+        return nullptr;
+    }
+
+    auto *tex = static_cast<GRRLIB_texImg*>(std::calloc(1, sizeof(GRRLIB_texImg)));
+    tex->w = Image.width;
+    tex->h = Image.height;
+    tex->format = GX_TF_RGBA8;
+    tex->handlex = -static_cast<int>(tex->w / 2);
+    tex->handley = -static_cast<int>(tex->h / 2);
+    const u32 DataSize = ((tex->w + 3) & ~3u) * ((tex->h + 3) & ~3u) * 4;
+    tex->data = memalign(32, DataSize);
+    std::memset(tex->data, 0, DataSize);
+
+    u8 *Texels = static_cast<u8*>(tex->data);
+    const u8 *Source = Pixels.data();
+    for(u32 y = 0; y < tex->h; ++y)
+    {
+        for(u32 x = 0; x < tex->w; ++x, Source += 4)
+        {
+            u8 *Texel = Texels + RGBA8Offset(x, y, tex->w);
+            Texel[0] = Source[3];
+            Texel[1] = Source[0];
+            Texel[32] = Source[1];
+            Texel[33] = Source[2];
+        }
+    }
+    return tex;
+}
+
+/**
+ * Nothing to do, textures are read directly from main memory.
+ * @param data The texels.
+ * @param size The size in bytes.
+ */
+void SoftBackend::FlushTexture([[maybe_unused]] void *data, [[maybe_unused]] u32 size)
+{
+}
+
+/**
+ * Draw a texture.
+ * @param xpos Specifies the x-coordinate of the upper-left corner.
+ * @param ypos Specifies the y-coordinate of the upper-left corner.
+ * @param tex The texture to draw.
+ * @param degrees Angle of rotation.
+ * @param scaleX Specifies the x-coordinate scale.
+ * @param scaleY Specifies the y-coordinate scale.
+ * @param color Color in RGBA format.
+ */
+void SoftBackend::DrawImg(f32 xpos, f32 ypos, const GRRLIB_texImg *tex,
+                          f32 degrees, f32 scaleX, f32 scaleY, u32 color)
+{
+    DrawQuad(xpos, ypos, tex, tex->w * 0.5f, tex->h * 0.5f, 0.0f, 0.0f, 1.0f, 1.0f,
+             degrees, scaleX, scaleY, color);
+}
+
+/**
+ * Draw a part of a texture.
+ * @param xpos Specifies the x-coordinate of the upper-left corner.
+ * @param ypos Specifies the y-coordinate of the upper-left corner.
+ * @param partx Specifies the x-coordinate of the upper-left corner in the texture.
+ * @param party Specifies the y-coordinate of the upper-left corner in the texture.
+ * @param partw Specifies the width in the texture.
+ * @param parth Specifies the height in the texture.
+ * @param tex The texture to draw.
+ * @param degrees Angle of rotation.
+ * @param scaleX Specifies the x-coordinate scale.
+ * @param scaleY Specifies the y-coordinate scale.
+ * @param color Color in RGBA format.
+ */
+void SoftBackend::DrawPart(f32 xpos, f32 ypos, f32 partx, f32 party, f32 partw, f32 parth,
+                           const GRRLIB_texImg *tex, f32 degrees, f32 scaleX, f32 scaleY, u32 color)
+{
+    DrawQuad(xpos, ypos, tex, partw * 0.5f, parth * 0.5f,
+             partx / tex->w, party / tex->h, (partx + partw) / tex->w, (party + parth) / tex->h,
+             degrees, scaleX, scaleY, color);
+}
+
+/**
+ * Draw a tile of a texture.
+ * @param xpos Specifies the x-coordinate of the upper-left corner.
+ * @param ypos Specifies the y-coordinate of the upper-left corner.
+ * @param tex The tile set.
+ * @param degrees Angle of rotation.
+ * @param scaleX Specifies the x-coordinate scale.
+ * @param scaleY Specifies the y-coordinate scale.
+ * @param color Color in RGBA format.
+ * @param frame Specifies the frame to draw.
+ */
+void SoftBackend::DrawTile(f32 xpos, f32 ypos, const GRRLIB_texImg *tex,
+                           f32 degrees, f32 scaleX, f32 scaleY, u32 color, int frame)
+{
+    if(tex->nbtilew == 0)
+    {
+        return;
+    }
+    const f32 s1 = (frame % tex->nbtilew) * tex->ofnormaltexx;
+    const f32 t1 = static_cast<int>(frame / tex->nbtilew) * tex->ofnormaltexy;
+    DrawQuad(xpos, ypos, tex, tex->tilew * 0.5f, tex->tileh * 0.5f,
+             s1, t1, s1 + tex->ofnormaltexx, t1 + tex->ofnormaltexy,
+             degrees, scaleX, scaleY, color);
+}
+
+/**
+ * Copy a part of the framebuffer into a texture, without alpha.
+ * @param posx Specifies the x-coordinate of the upper-left corner of the copy.
+ * @param posy Specifies the y-coordinate of the upper-left corner of the copy.
+ * @param tex The destination, its size is the size of the copy.
+ * @param clear Set to true to clear the framebuffer after the copy.
+ */
+void SoftBackend::CopyScreen(int posx, int posy, GRRLIB_texImg *tex, bool clear)
+{
+    for(u32 y = 0; y < tex->h; ++y)
+    {
+        CopyToTexture(posx, posy + y, tex, y);
+    }
+    if(clear)
+    {
+        std::fill(Framebuffer.begin(), Framebuffer.end(), Background);
+    }
+}
+
+/**
+ * Copy rows of the framebuffer into the same rows of an RGBA8 texture.
+ * @param tex The destination, as wide as the screen.
+ * @param posy Top of the rows.
+ * @param height Height of the rows.
+ */
+void SoftBackend::CopyScreenRows(GRRLIB_texImg *tex, u16 posy, u16 height)
+{
+    for(u32 y = posy; y < posy + height; ++y)
+    {
+        CopyToTexture(0, y, tex, y);
+    }
+}
+
+/**
+ * Return the last frame shown by Render.
+ * @return The pixels in RGBA format, row by row.
+ */
+const std::vector<u32>& SoftBackend::GetFrame() const
+{
+    return Displayed;
+}
+
+/**
+ * Return the number of frames shown by Render.
+ * @return The number of frames.
+ */
+u32 SoftBackend::GetFrameCount() const
+{
+    return FrameCount;
+}
+
+/**
+ * Draw a textured quad with the same transform as GRRLIB.
+ * @param xpos Specifies the x-coordinate of the upper-left corner.
+ * @param ypos Specifies the y-coordinate of the upper-left corner.
+ * @param tex The texture to sample.
+ * @param width Half of the width of the quad.
+ * @param height Half of the height of the quad.
+ * @param s1 Left texture coordinate.
+ * @param t1 Top texture coordinate.
+ * @param s2 Right texture coordinate.
+ * @param t2 Bottom texture coordinate.
+ * @param degrees Angle of rotation.
+ * @param scaleX Specifies the x-coordinate scale.
+ * @param scaleY Specifies the y-coordinate scale.
+ * @param color Color in RGBA format, multiplied with the texels.
+ */
+void SoftBackend::DrawQuad(f32 xpos, f32 ypos, const GRRLIB_texImg *tex, f32 width, f32 height,
+                           f32 s1, f32 t1, f32 s2, f32 t2, f32 degrees, f32 scaleX, f32 scaleY, u32 color)
+{
+    if(tex == nullptr || tex->data == nullptr || scaleX == 0.0f || scaleY == 0.0f ||
+       width <= 0.0f || height <= 0.0f)
+    {
+        return;
+    }
+
+    const f32 Angle = degrees * std::numbers::pi_v<f32> / 180.0f;
+    const f32 Cos = std::cos(Angle);
+    const f32 Sin = std::sin(Angle);
+    const f32 CenterX = xpos + width + tex->handlex - tex->offsetx +
+        scaleX * (-tex->handley * std::sin(-Angle) - tex->handlex * std::cos(-Angle));
+    const f32 CenterY = ypos + height + tex->handley - tex->offsety +
+        scaleY * (-tex->handley * std::cos(-Angle) + tex->handlex * std::sin(-Angle));
+
+    // Bounding box of the transformed corners
+    f32 MinX = CenterX, MaxX = CenterX, MinY = CenterY, MaxY = CenterY;
+    for(const f32 cx : {-width, width})
+    {
+        for(const f32 cy : {-height, height})
+        {
+            const f32 vx = cx * scaleX * Cos - cy * scaleY * Sin + CenterX;
+            const f32 vy = cx * scaleX * Sin + cy * scaleY * Cos + CenterY;
+            MinX = std::min(MinX, vx);
+            MaxX = std::max(MaxX, vx);
+            MinY = std::min(MinY, vy);
+            MaxY = std::max(MaxY, vy);
+        }
+    }
+    const int Left = std::max<int>(std::floor(MinX), ClipLeft);
+    const int Top = std::max<int>(std::floor(MinY), ClipTop);
+    const int Right = std::min<int>(std::ceil(MaxX), ClipRight);
+    const int Bottom = std::min<int>(std::ceil(MaxY), ClipBottom);
+
+    for(int py = Top; py < Bottom; ++py)
+    {
+        for(int px = Left; px < Right; ++px)
+        {   // Back to the quad space, from -1 to 1 inside the quad
+            const f32 dx = px + 0.5f - CenterX;
+            const f32 dy = py + 0.5f - CenterY;
+            const f32 u = (dx * Cos + dy * Sin) / (scaleX * width);
+            const f32 v = (-dx * Sin + dy * Cos) / (scaleY * height);
+            if(u < -1.0f || u >= 1.0f || v < -1.0f || v >= 1.0f)
+            {
+                continue;
+            }
+            const u32 Texel = Sample(tex, s1 + (u + 1.0f) * 0.5f * (s2 - s1),
+                                          t1 + (v + 1.0f) * 0.5f * (t2 - t1));
+            const u32 Alpha = Modulate(A(Texel), A(color));
+            if(Alpha <= AlphaThreshold)
+            {
+                continue;
+            }
+            BlendPixel(px, py, RGBA(Modulate(R(Texel), R(color)),
+                                    Modulate(G(Texel), G(color)),
+                                    Modulate(B(Texel), B(color)), Alpha));
+        }
+    }
+}
+
+/**
+ * Blend a pixel over the framebuffer with its alpha.
+ * @param x Specifies the x-coordinate of the pixel.
+ * @param y Specifies the y-coordinate of the pixel.
+ * @param color The color in RGBA format.
+ */
+void SoftBackend::BlendPixel(int x, int y, u32 color)
+{
+    if(x < ClipLeft || x >= ClipRight || y < ClipTop || y >= ClipBottom)
+    {
+        return;
+    }
+    const u32 Alpha = A(color);
+    if(Alpha == 0)
+    {
+        return;
+    }
+    u32 &Pixel = Framebuffer[y * Width + x];
+    if(Alpha == 0xFF)
+    {
+        Pixel = color;
+        return;
+    }
+    const u32 Inverse = 0xFF - Alpha;
+    Pixel = RGBA(Modulate(R(color), Alpha) + Modulate(R(Pixel), Inverse),
+                 Modulate(G(color), Alpha) + Modulate(G(Pixel), Inverse),
+                 Modulate(B(color), Alpha) + Modulate(B(Pixel), Inverse), 0xFF);
+}
+
+/**
+ * Sample a texture with bilinear filtering, clamped to its edges like GRRLIB sets GX.
+ * @param tex The texture.
+ * @param s Horizontal texture coordinate.
+ * @param t Vertical texture coordinate.
+ * @return The filtered color in RGBA format.
+ */
+u32 SoftBackend::Sample(const GRRLIB_texImg *tex, f32 s, f32 t)
+{
+    const f32 fx = std::clamp(s * tex->w - 0.5f, 0.0f, tex->w - 1.0f);
+    const f32 fy = std::clamp(t * tex->h - 0.5f, 0.0f, tex->h - 1.0f);
+    const u32 x0 = fx;
+    const u32 y0 = fy;
+    const u32 x1 = std::min(x0 + 1, tex->w - 1);
+    const u32 y1 = std::min(y0 + 1, tex->h - 1);
+    const u32 wx = (fx - x0) * 256;
+    const u32 wy = (fy - y0) * 256;
+
+    const u32 c00 = FetchTexel(tex, x0, y0);
+    const u32 c10 = FetchTexel(tex, x1, y0);
+    const u32 c01 = FetchTexel(tex, x0, y1);
+    const u32 c11 = FetchTexel(tex, x1, y1);
+    u32 Result = 0;
+    for(u32 Shift = 0; Shift < 32; Shift += 8)
+    {
+        const u32 Top = ((c00 >> Shift) & 0xFF) * (256 - wx) + ((c10 >> Shift) & 0xFF) * wx;
+        const u32 Bottom = ((c01 >> Shift) & 0xFF) * (256 - wx) + ((c11 >> Shift) & 0xFF) * wx;
+        Result |= (((Top * (256 - wy) + Bottom * wy) >> 16) & 0xFF) << Shift;
+    }
+    return Result;
+}
+
+/**
+ * Read a texel from an RGBA8 or IA8 texture.
+ * @param tex The texture.
+ * @param x Specifies the x-coordinate of the texel.
+ * @param y Specifies the y-coordinate of the texel.
+ * @return The color in RGBA format.
+ */
+u32 SoftBackend::FetchTexel(const GRRLIB_texImg *tex, u32 x, u32 y)
+{
+    const u8 *Texels = static_cast<const u8*>(tex->data);
+    if(tex->format == GX_TF_IA8)
+    {
+        const u8 *Texel = Texels + IA8Offset(x, y, tex->w);
+        return RGBA(Texel[1], Texel[1], Texel[1], Texel[0]);
+    }
+    const u8 *Texel = Texels + RGBA8Offset(x, y, tex->w);
+    return RGBA(Texel[1], Texel[32], Texel[33], Texel[0]);
+}
+
+/**
+ * Copy a row of the framebuffer into a row of an RGBA8 texture.
+ * @param posx Specifies the x-coordinate of the first pixel to copy.
+ * @param posy Specifies the row of the framebuffer.
+ * @param tex The destination texture, the copy is as wide as the texture.
+ * @param row The row of the texture.
+ */
+void SoftBackend::CopyToTexture(int posx, int posy, GRRLIB_texImg *tex, u32 row)
+{
+    u8 *Texels = static_cast<u8*>(tex->data);
+    for(u32 x = 0; x < tex->w; ++x)
+    {
+        const int fx = posx + x;
+        const u32 Color = (fx >= 0 && fx < Width && posy >= 0 && posy < Height) ?
+            Framebuffer[posy * Width + fx] : 0x000000FF;
+        u8 *Texel = Texels + RGBA8Offset(x, row, tex->w);
+        Texel[0] = 0xFF;
+        Texel[1] = R(Color);
+        Texel[32] = G(Color);
+        Texel[33] = B(Color);
+    }
+}
+
+// EOF
@@ -0,0 +1,88 @@
+// host/softbackend.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#ifndef SoftBackendH
+#define SoftBackendH
+//---------------------------------------------------------------------------
+
+#include <vector>
+#include "renderbackend.h"
+
+namespace GRRLIBpp
+{
+
+/**
+ * Render backend drawing in a framebuffer in main memory.
+ * It follows what GRRLIB does with GX closely enough to compare frames:
+ * same quad transforms, bilinear filtering, source alpha blending, alpha
+ * test and an EFB without alpha. Only PNG images can be loaded.
+ * @author Crayon
+ */
+class SoftBackend : public RenderBackend
+{
+public:
+    SoftBackend(u16 AWidth = 640, u16 AHeight = 480);
+
+    s32 Initialize() override;
+    void Exit() override;
+    void Render() override;
+    [[nodiscard]] u16 GetWidth() const override;
+    [[nodiscard]] u16 GetHeight() const override;
+    void SetBackgroundColor(u32 color) override;
+    void FillScreen(u32 color) override;
+    void Plot(f32 x, f32 y, u32 color) override;
+    void Line(f32 x1, f32 y1, f32 x2, f32 y2, u32 color) override;
+    void Rectangle(f32 x, f32 y, f32 width, f32 height, u32 color, bool filled) override;
+    void Circle(f32 x, f32 y, f32 radius, u32 color, bool filled) override;
+    void SetAlphaTest(u8 threshold) override;
+    void ClipDrawing(int x, int y, int width, int height) override;
+    void ClipReset() override;
+    bool ScreenShot(const char *filename) override;
+
+    [[nodiscard]] GRRLIB_texImg* LoadTexture(const u8 *Buffer, u32 Size) override;
+    void FlushTexture(void *data, u32 size) override;
+    void DrawImg(f32 xpos, f32 ypos, const GRRLIB_texImg *tex,
+                 f32 degrees, f32 scaleX, f32 scaleY, u32 color) override;
+    void DrawPart(f32 xpos, f32 ypos, f32 partx, f32 party, f32 partw, f32 parth,
+                  const GRRLIB_texImg *tex, f32 degrees, f32 scaleX, f32 scaleY, u32 color) override;
+    void DrawTile(f32 xpos, f32 ypos, const GRRLIB_texImg *tex,
+                  f32 degrees, f32 scaleX, f32 scaleY, u32 color, int frame) override;
+    void CopyScreen(int posx, int posy, GRRLIB_texImg *tex, bool clear) override;
+    void CopyScreenRows(GRRLIB_texImg *tex, u16 posy, u16 height) override;
+
+    [[nodiscard]] const std::vector<u32>& GetFrame() const;
+    [[nodiscard]] u32 GetFrameCount() const;
+private:
+    void DrawQuad(f32 xpos, f32 ypos, const GRRLIB_texImg *tex, f32 width, f32 height,
+                  f32 s1, f32 t1, f32 s2, f32 t2, f32 degrees, f32 scaleX, f32 scaleY, u32 color);
+    void BlendPixel(int x, int y, u32 color);
+    [[nodiscard]] static u32 Sample(const GRRLIB_texImg *tex, f32 s, f32 t);
+    [[nodiscard]] static u32 FetchTexel(const GRRLIB_texImg *tex, u32 x, u32 y);
+    void CopyToTexture(int posx, int posy, GRRLIB_texImg *tex, u32 row);
+
+    u16 Width;
+    u16 Height;
+    std::vector<u32> Framebuffer; /**< The frame being drawn, RGBA with an opaque alpha. */
+    std::vector<u32> Displayed;   /**< The last frame shown by Render. */
+    u32 Background{0x000000FF};
+    u8 AlphaThreshold{0};
+    int ClipLeft{0};
+    int ClipTop{0};
+    int ClipRight;
+    int ClipBottom;
+    u32 FrameCount{0};
+};
+
+}   /* namespace GRRLIBpp */
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
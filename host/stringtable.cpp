@@ -0,0 +1,148 @@
+// host/stringtable.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#include "stringtable.h"
+
+/**
+ * Compute the FNV-1a hash of a text.
+ * @param[in] Text The text to hash.
+ * @return The hash.
+ */
+static constexpr u32 HashText(std::string_view Text)
+{
+    u32 Hash = 2166136261u;
+    for(const char c : Text)
+    {
+        Hash = (Hash ^ static_cast<u8>(c)) * 16777619u;
+    }
+    return Hash;
+}
+
+/**
+ * Add a translation, or replace the value of an existing key.
+ * Texts returned by Find before this call are no longer valid.
+ * @param[in] Key Original text.
+ * @param[in] Value Translated text.
+ */
+void StringTable::Add(std::string_view Key, std::string_view Value)
+{
+    if((Count + 1) * 2 > Slots.size())
+    {   // Keep the table at most half full, so probe sequences stay short
+        Grow();
+    }
+
+    const u32 Hash = HashText(Key);
+    Slot &Item = Slots[FindSlot(Key, Hash)];
+    if(!Item.Used)
+    {
+        Item.Used = true;
+        Item.Hash = Hash;
+        Item.KeyOffset = Pool.size();
+        Item.KeyLength = Key.size();
+        Pool.append(Key);
+        ++Count;
+    }
+    Item.ValueOffset = Pool.size();
+    Item.ValueLength = Value.size();
+    Pool.append(Value);
+}
+
+/**
+ * Find the translation of a text.
+ * @param[in] Key Original text.
+ * @return The translated text, empty if the key is unknown. It stays valid
+ *         until the table is changed.
+ */
+std::string_view StringTable::Find(std::string_view Key) const
+{
+    if(Slots.empty())
+    {
+        return {};
+    }
+    const Slot &Item = Slots[FindSlot(Key, HashText(Key))];
+    return Item.Used ? GetText(Item.ValueOffset, Item.ValueLength) : std::string_view();
+}
+
+/**
+ * Get the number of keys.
+ * @return The number of keys.
+ */
+size_t StringTable::GetCount() const
+{
+    return Count;
+}
+
+/**
+ * Get the heap used by the table.
+ * @return The size in bytes.
+ */
+size_t StringTable::GetMemoryUsage() const
+{
+    return Pool.capacity() + Slots.capacity() * sizeof(Slot);
+}
+
+/**
+ * Remove every translation and free the memory.
+ */
+void StringTable::Clear()
+{
+    Pool = std::string();
+    Slots = std::vector<Slot>();
+    Count = 0;
+}
+
+/**
+ * Double the number of slots and insert the entries again.
+ */
+void StringTable::Grow()
+{
+    std::vector<Slot> Old = std::move(Slots);
+    Slots.assign(Old.empty() ? 16 : Old.size() * 2, Slot{});
+    for(const Slot &Item : Old)
+    {
+        if(Item.Used)
+        {
+            Slots[FindSlot(GetText(Item.KeyOffset, Item.KeyLength), Item.Hash)] = Item;
+        }
+    }
+}
+
+/**
+ * Find the slot of a key, or the free slot where it would go.
+ * @param[in] Key The key.
+ * @param[in] Hash Hash of the key.
+ * @return Index of the slot.
+ */
+size_t StringTable::FindSlot(std::string_view Key, u32 Hash) const
+{
+    const size_t Mask = Slots.size() - 1;
+    for(size_t Index = Hash & Mask;; Index = (Index + 1) & Mask)
+    {
+        const Slot &Item = Slots[Index];
+        if(!Item.Used || (Item.Hash == Hash && GetText(Item.KeyOffset, Item.KeyLength) == Key))
+        {
+            return Index;
+        }
+    }
+}
+
+/**
+ * Get a text of the pool.
+ * @param[in] Offset Position of the text in the pool.
+ * @param[in] Length Length of the text in bytes.
+ * @return The text.
+ */
+std::string_view StringTable::GetText(u32 Offset, u16 Length) const
+{
+    return std::string_view(Pool).substr(Offset, Length);
+}
+
+// EOF
@@ -0,0 +1,65 @@
+// host/stringtable.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#ifndef StringTableH
+#define StringTableH
+//---------------------------------------------------------------------------
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <gctypes.h>
+
+/**
+ * A table of translations indexed by a hash of their key.
+ * Keys and values are interned in a single buffer, a lookup hashes the key
+ * once and usually compares a single entry.
+ * @author Crayon
+ */
+class StringTable
+{
+public:
+    StringTable() = default;
+    StringTable(StringTable const&) = delete;
+    ~StringTable() = default;
+    StringTable& operator=(StringTable const&) = delete;
+
+    void Add(std::string_view Key, std::string_view Value);
+    [[nodiscard]] std::string_view Find(std::string_view Key) const;
+    [[nodiscard]] size_t GetCount() const;
+    [[nodiscard]] size_t GetMemoryUsage() const;
+    void Clear();
+private:
+    /**
+     * An entry of the hash table, texts are ranges of the pool.
+     */
+    struct Slot
+    {
+        u32 Hash{0};
+        u32 KeyOffset{0};
+        u32 ValueOffset{0};
+        u16 KeyLength{0};
+        u16 ValueLength{0};
+        bool Used{false};
+    };
+
+    void Grow();
+    [[nodiscard]] size_t FindSlot(std::string_view Key, u32 Hash) const;
+    [[nodiscard]] std::string_view GetText(u32 Offset, u16 Length) const;
+
+    std::string Pool;         /**< Keys and values, one after the other. */
+    std::vector<Slot> Slots;  /**< Open addressing, the size is a power of two. */
+    size_t Count{0};
+};
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
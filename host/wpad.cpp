@@ -0,0 +1,96 @@
+// host/wpad.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#include <array>
+#include <cstddef>
+#include <wiiuse/wpad.h>
+
+/**
+ * State of a simulated Wii Remote.
+ */
+struct HostPad
+{
+    bool Connected{false};
+    u32 Held{0};         /**< Buttons held, as set by the driver. */
+    bool Pointing{false};
+    f32 X{0.0f};
+    f32 Y{0.0f};
+};
+
+static std::array<HostPad, WPAD_MAX_WIIMOTES> HostPads;  /**< Set by the driver. */
+static std::array<WPADData, WPAD_MAX_WIIMOTES> Pads{};    /**< Read by the game. */
+
+/**
+ * Set the state of a simulated Wii Remote, read by the next scan.
+ * @param[in] chan The Wii Remote channel, from 0 to 3.
+ * @param[in] connected The remote is connected.
+ * @param[in] held The WPAD_BUTTON_* held down.
+ * @param[in] pointing The remote points at the screen.
+ * @param[in] x Pointer x-coordinate.
+ * @param[in] y Pointer y-coordinate.
+ */
+void WPAD_SetHostState(s32 chan, bool connected, u32 held, bool pointing, f32 x, f32 y)
+{
+    HostPads[chan] = {connected, connected ? held : 0, connected && pointing, x, y};
+}
+
+/**
+ * Read the simulated Wii Remotes.
+ * The pressed and released buttons are found by comparing with the
+ * previous scan, like libogc does.
+ * @return The number of channels.
+ */
+s32 WPAD_ScanPads()
+{
+    for(std::size_t i = 0; i < Pads.size(); ++i)
+    {
+        WPADData &Data = Pads[i];
+        const HostPad &Pad = HostPads[i];
+        Data.btns_d = Pad.Held & ~Data.btns_h;
+        Data.btns_u = Data.btns_h & ~Pad.Held;
+        Data.btns_h = Pad.Held;
+        Data.ir = {Pad.Pointing, Pad.X, Pad.Y};
+        Data.orient = {};
+    }
+    return WPAD_MAX_WIIMOTES;
+}
+
+/**
+ * Get the state of a Wii Remote, as of the last scan.
+ * @param[in] chan The Wii Remote channel, from 0 to 3.
+ * @return The state.
+ */
+WPADData* WPAD_Data(int chan)
+{
+    return &Pads[chan];
+}
+
+/**
+ * Check if a Wii Remote is connected.
+ * @param[in] chan The Wii Remote channel, from 0 to 3.
+ * @param[out] type Not set.
+ * @return WPAD_ERR_NONE if connected, WPAD_ERR_NO_CONTROLLER otherwise.
+ */
+s32 WPAD_Probe(s32 chan, [[maybe_unused]] u32 *type)
+{
+    return HostPads[chan].Connected ? WPAD_ERR_NONE : WPAD_ERR_NO_CONTROLLER;
+}
+
+/**
+ * Turn the rumble of a Wii Remote on or off, nothing to do on the host.
+ * @return Always WPAD_ERR_NONE.
+ */
+s32 WPAD_Rumble([[maybe_unused]] s32 chan, [[maybe_unused]] int status)
+{
+    return WPAD_ERR_NONE;
+}
+
+// EOF
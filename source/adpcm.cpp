@@ -0,0 +1,75 @@
+// source/adpcm.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#include <algorithm>
+#include "adpcm.h"
+
+/**
+ * Decode a sample, the way the DSP does.
+ * @param[in] Nibble The signed 4-bit code, from -8 to 7.
+ * @param[in] Header Header of the frame: predictor in the high nibble, scale
+ *                   exponent in the low nibble.
+ * @param[in] Coefficients The 16 coefficients of the sound.
+ * @param[in,out] State The previous samples, updated.
+ * @return The decoded sample.
+ */
+s16 Adpcm::DecodeSample(s32 Nibble, u8 Header, const s16 *Coefficients, History &State)
+{
+    const s32 Scale = 1 << (Header & 0x0F);
+    const u8 Predictor = (Header >> 4) & 0x07;
+    const s32 Value = ((Nibble * Scale) << 11) + 1024 +
+        Coefficients[Predictor * 2] * State.Previous + Coefficients[Predictor * 2 + 1] * State.Before;
+    const s16 Sample = static_cast<s16>(std::clamp(Value >> 11, -32768, 32767));
+    State.Before = State.Previous;
+    State.Previous = Sample;
+    return Sample;
+}
+
+/**
+ * Decode a sound.
+ * @param[in] Frames The encoded frames.
+ * @param[in] Coefficients The 16 coefficients of the sound.
+ * @param[out] Samples Where the samples are written, its size is the number
+ *                     of samples to decode.
+ */
+void Adpcm::Decode(std::span<const u8> Frames, const s16 *Coefficients, std::span<s16> Samples)
+{
+    History State;
+    const size_t Written = Decode(Frames, Coefficients, State, Samples);
+    std::fill(Samples.begin() + Written, Samples.end(), 0);
+}
+
+/**
+ * Decode part of a sound, the state is carried to the next part.
+ * @param[in] Frames The encoded frames.
+ * @param[in] Coefficients The 16 coefficients of the sound.
+ * @param[in,out] State The previous samples, updated.
+ * @param[out] Samples Where the samples are written.
+ * @return The number of samples written, less than the size of Samples
+ *         when there are not enough frames.
+ */
+size_t Adpcm::Decode(std::span<const u8> Frames, const s16 *Coefficients, History &State, std::span<s16> Samples)
+{
+    size_t Written = 0;
+    for(size_t Frame = 0; Frame + FRAME_SIZE <= Frames.size() && Written < Samples.size(); Frame += FRAME_SIZE)
+    {
+        const u8 Header = Frames[Frame];
+        for(u32 i = 0; i < SAMPLES_PER_FRAME && Written < Samples.size(); ++i)
+        {
+            const u8 Byte = Frames[Frame + 1 + i / 2];
+            const s32 Nibble = (i & 1) ? (Byte & 0x0F) : (Byte >> 4);
+            Samples[Written++] = DecodeSample((Nibble >= 8) ? Nibble - 16 : Nibble, Header, Coefficients, State);
+        }
+    }
+    return Written;
+}
+
+// EOF
@@ -0,0 +1,59 @@
+// source/adpcm.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#ifndef AdpcmH
+#define AdpcmH
+//---------------------------------------------------------------------------
+
+#include <span>
+#include <gctypes.h>
+
+/**
+ * Namespace containing the GameCube DSP-ADPCM codec.
+ * A frame is 8 bytes: a header giving the predictor and the scale, then 14
+ * samples of 4 bits. Each sound has its own table of 8 predictors, pairs
+ * of coefficients in 11-bit fixed point. It is decoded by the game and
+ * encoded by the sfxconv tool, which checks the result with this decoder.
+ * @author Crayon
+ */
+namespace Adpcm
+{
+    inline constexpr u32 FRAME_SIZE = 8;           /**< Bytes of a frame. */
+    inline constexpr u32 SAMPLES_PER_FRAME = 14;   /**< Samples of a frame. */
+    inline constexpr u32 COEFFICIENT_COUNT = 16;   /**< 8 predictors of 2 coefficients. */
+
+    /**
+     * State carried from a frame to the next.
+     */
+    struct History
+    {
+        s16 Previous{0};  /**< Last decoded sample. */
+        s16 Before{0};    /**< Sample decoded before the last one. */
+    };
+
+    /**
+     * Get the number of bytes needed to encode samples.
+     * @param[in] SampleCount Number of samples.
+     * @return The size in bytes, whole frames.
+     */
+    constexpr u32 GetEncodedSize(u32 SampleCount)
+    {
+        return (SampleCount + SAMPLES_PER_FRAME - 1) / SAMPLES_PER_FRAME * FRAME_SIZE;
+    }
+
+    s16 DecodeSample(s32 Nibble, u8 Header, const s16 *Coefficients, History &State);
+    void Decode(std::span<const u8> Frames, const s16 *Coefficients, std::span<s16> Samples);
+    size_t Decode(std::span<const u8> Frames, const s16 *Coefficients, History &State, std::span<s16> Samples);
+}   /* namespace Adpcm */
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
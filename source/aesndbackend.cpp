@@ -0,0 +1,360 @@
+// source/aesndbackend.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#include <atomic>
+#include <aesndlib.h>
+#include <grrmod.h>
+#include <ogc/cache.h>
+#include <ogc/lwp_watchdog.h>
+#include "mixeffects.h"
+#include "sound.h"
+#include "aesndbackend.h"
+
+/**
+ * Backend whose voices are playing, the voice callback has no user data.
+ */
+static AesndBackend *Instance = nullptr;
+
+static bool HookModuleVoice = false;                       /**< Set while GRRMOD allocates its voice. */
+static AESNDVoiceCallback ModuleVoiceCallback = nullptr;   /**< The callback of GRRMOD. */
+static std::atomic<u32> ModuleTicks{0};                    /**< Time spent in it since the last take. */
+
+/**
+ * Call the voice callback of GRRMOD, which mixes the next part of the
+ * module, and add the time it took to ModuleTicks.
+ * @param[in] Pb The voice.
+ * @param[in] State Why it is called.
+ */
+static void TimedModuleCallback(AESNDPB *Pb, u32 State)
+{
+    const u64 Start = gettime();
+    ModuleVoiceCallback(Pb, State);
+    ModuleTicks.fetch_add(static_cast<u32>(diff_ticks(Start, gettime())), std::memory_order_relaxed);
+}
+
+extern "C"
+{
+    AESNDPB* __real_AESND_AllocateVoice(AESNDVoiceCallback cb);
+    AESNDPB* __wrap_AESND_AllocateVoice(AESNDVoiceCallback cb);
+}
+
+/**
+ * Called in place of AESND_AllocateVoice, the linker redirects every call
+ * to it, those of GRRMOD included. The callback of the voice allocated by
+ * GRRMOD is replaced by TimedModuleCallback.
+ * @param[in] cb The voice callback.
+ * @return The voice, nullptr if every voice is taken.
+ */
+AESNDPB* __wrap_AESND_AllocateVoice(AESNDVoiceCallback cb)
+{
+    if(HookModuleVoice && cb != nullptr)
+    {
+        ModuleVoiceCallback = cb;
+        cb = TimedModuleCallback;
+    }
+    return __real_AESND_AllocateVoice(cb);
+}
+
+/**
+ * Get the AESND format of a sound.
+ * @param[in] format The sound format, ADPCM must be decoded first.
+ * @return The VOICE_* format.
+ */
+static u32 ToVoiceFormat(SoundFormat format)
+{
+    switch(format)
+    {
+        case SoundFormat::Mono8:
+            return VOICE_MONO8;
+        case SoundFormat::Stereo8:
+            return VOICE_STEREO8;
+        case SoundFormat::Stereo16:
+            return VOICE_STEREO16;
+        default:
+            return VOICE_MONO16;
+    }
+}
+
+/**
+ * Constructor for the AesndBackend class.
+ * @param[in] AMode How the module is mixed.
+ */
+AesndBackend::AesndBackend(ModuleMode AMode) :
+    Mode(AMode)
+{
+}
+
+/**
+ * Initialize AESND and start mixing.
+ */
+void AesndBackend::Initialize()
+{
+    Instance = this;
+    AESND_Init();
+    AESND_RegisterAudioCallback(OutputCallback);
+    AESND_Pause(false);
+}
+
+/**
+ * Stop mixing.
+ */
+void AesndBackend::Exit()
+{
+    AESND_Pause(true);
+    AESND_RegisterAudioCallback(nullptr);
+    Instance = nullptr;
+}
+
+/**
+ * Pause or resume every voice.
+ * @param[in] Paused On or off.
+ */
+void AesndBackend::Pause(bool Paused)
+{
+    AESND_Pause(Paused);
+}
+
+/**
+ * Write a buffer back to main memory, so the DSP reads what the CPU wrote.
+ * @param[in] Data The buffer, 32-byte aligned.
+ * @param[in] Size Size in bytes.
+ */
+void AesndBackend::FlushBuffer(const void *Data, u32 Size)
+{
+    DCFlushRange(const_cast<void*>(Data), Size);
+}
+
+/**
+ * Set the effects applied to the output.
+ * @param[in] AEffects The effects, they must outlive the backend; nullptr for none.
+ */
+void AesndBackend::SetEffects(MixEffects *AEffects)
+{
+    Effects.store(AEffects, std::memory_order_release);
+}
+
+/**
+ * Allocate a voice.
+ * @param[in] Callback Called when a stream voice needs its next buffer,
+ *                     nullptr for a voice playing whole sounds.
+ * @param[in] User Given to the callback.
+ * @return The voice, NO_VOICE if every voice is taken.
+ */
+AudioBackend::VoiceId AesndBackend::AllocateVoice(StreamCallback Callback, void *User)
+{
+    for(size_t i = 0; i < Voices.size(); ++i)
+    {
+        Slot &Item = Voices[i];
+        if(Item.Pb != nullptr)
+        {
+            continue;
+        }
+        Item.Pb = AESND_AllocateVoice((Callback != nullptr) ? VoiceCallback : nullptr);
+        if(Item.Pb == nullptr)
+        {
+            return NO_VOICE;
+        }
+        Item.Callback = Callback;
+        Item.User = User;
+        if(Callback != nullptr)
+        {
+            AESND_SetVoiceFormat(Item.Pb, VOICE_MONO16);
+            AESND_SetVoiceStream(Item.Pb, true);
+        }
+        return static_cast<VoiceId>(i);
+    }
+    return NO_VOICE;
+}
+
+/**
+ * Free a voice.
+ * @param[in] Id The voice, NO_VOICE is ignored.
+ */
+void AesndBackend::FreeVoice(VoiceId Id)
+{
+    if(Id == NO_VOICE)
+    {
+        return;
+    }
+    AESND_FreeVoice(Voices[Id].Pb);
+    Voices[Id] = Slot();
+}
+
+/**
+ * Play a sound on a voice.
+ * @param[in] Id The voice.
+ * @param[in] sound The sound, it cannot be ADPCM.
+ * @param[in] Delay Time before the sound starts, in milliseconds.
+ * @param[in] Looped Set true to make the sound loop, false otherwise.
+ */
+void AesndBackend::PlayVoice(VoiceId Id, const Sound &sound, u32 Delay, bool Looped)
+{
+    AESND_PlayVoice(Voices[Id].Pb, ToVoiceFormat(sound.GetFormat()), sound.GetBuffer().data(),
+        sound.GetBuffer().size(), sound.GetFrequency(), Delay, Looped);
+}
+
+/**
+ * Give a stream voice the buffer to play.
+ * @param[in] Id The voice.
+ * @param[in] Samples The samples, 32-byte aligned and flushed.
+ * @param[in] Frequency Their sample rate.
+ */
+void AesndBackend::SetVoiceBuffer(VoiceId Id, std::span<const s16> Samples, f32 Frequency)
+{
+    AESND_SetVoiceFrequency(Voices[Id].Pb, Frequency);
+    AESND_SetVoiceBuffer(Voices[Id].Pb, Samples.data(), Samples.size_bytes());
+}
+
+/**
+ * Set the volume of a voice, between 0 and 255.
+ * @param[in] Id The voice.
+ * @param[in] LeftVolume The left volume.
+ * @param[in] RightVolume The right volume.
+ */
+void AesndBackend::SetVoiceVolume(VoiceId Id, u16 LeftVolume, u16 RightVolume)
+{
+    AESND_SetVoiceVolume(Voices[Id].Pb, LeftVolume, RightVolume);
+}
+
+/**
+ * Mute a voice.
+ * @param[in] Id The voice.
+ * @param[in] Mute Set true to mute the voice, false otherwise.
+ */
+void AesndBackend::SetVoiceMute(VoiceId Id, bool Mute)
+{
+    AESND_SetVoiceMute(Voices[Id].Pb, Mute);
+}
+
+/**
+ * Stop or resume a voice.
+ * @param[in] Id The voice.
+ * @param[in] Stop Set true to stop the voice, false to resume it.
+ */
+void AesndBackend::SetVoiceStop(VoiceId Id, bool Stop)
+{
+    AESND_SetVoiceStop(Voices[Id].Pb, Stop);
+}
+
+/**
+ * Load a module into GRRMOD.
+ * @param[in] Data The module file, it must outlive the backend.
+ * @return true if the module is loaded, false when the mode is Off.
+ */
+bool AesndBackend::LoadModule(std::span<const char> Data)
+{
+    if(Mode == ModuleMode::Off)
+    {
+        return false;
+    }
+    HookModuleVoice = true;
+    GRRMOD_Init(Mode == ModuleMode::Stereo);
+    GRRMOD_SetMOD(Data.data(), Data.size());
+    HookModuleVoice = false;
+    ModuleLoaded = true;
+    return true;
+}
+
+/**
+ * Play the module from the beginning.
+ * @param[in] Volume The volume, between 0 and 255.
+ */
+void AesndBackend::StartModule(u16 Volume)
+{
+    if(!ModuleLoaded)
+    {
+        return;
+    }
+    HookModuleVoice = true;
+    GRRMOD_Stop();
+    GRRMOD_Start();
+    HookModuleVoice = false;
+    GRRMOD_SetVolume(Volume, Volume);
+    ModulePaused = false;
+}
+
+/**
+ * Pause or resume the module.
+ * @param[in] Paused On or off.
+ */
+void AesndBackend::PauseModule(bool Paused)
+{
+    if(ModuleLoaded && ModulePaused != Paused)
+    {   // GRRMOD_Pause toggles
+        ModulePaused = Paused;
+        GRRMOD_Pause();
+    }
+}
+
+/**
+ * Release GRRMOD and the module.
+ */
+void AesndBackend::UnloadModule()
+{
+    if(ModuleLoaded)
+    {
+        GRRMOD_Unload();
+        GRRMOD_End();
+        ModuleLoaded = false;
+    }
+}
+
+/**
+ * Get the time GRRMOD spent mixing the module since the last call.
+ * @return The time in time base ticks, 0 when the callback is not timed.
+ */
+u32 AesndBackend::TakeModuleTicks()
+{
+    return ModuleTicks.exchange(0, std::memory_order_relaxed);
+}
+
+/**
+ * Called by AESND in the audio interrupt, forwards a request for the next
+ * buffer of a stream voice to its callback.
+ * @param[in] Pb The voice.
+ * @param[in] State Why it is called.
+ */
+void AesndBackend::VoiceCallback(aesndpb_t *Pb, u32 State)
+{
+    if(State != VOICE_STATE_STREAM || Instance == nullptr)
+    {
+        return;
+    }
+    for(const Slot &Item : Instance->Voices)
+    {
+        if(Item.Pb == Pb)
+        {
+            Item.Callback(Item.User);
+            return;
+        }
+    }
+}
+
+/**
+ * Called by AESND in the audio interrupt with each block mixed by the DSP,
+ * before it is played, to apply the effects.
+ * @param[in,out] Buffer The block, interleaved 16-bit stereo samples.
+ * @param[in] Size Size of the block in bytes.
+ */
+void AesndBackend::OutputCallback(void *Buffer, u32 Size)
+{
+    MixEffects *Effects = (Instance != nullptr) ? Instance->Effects.load(std::memory_order_acquire) : nullptr;
+    if(Effects == nullptr)
+    {
+        return;
+    }
+    // Written by the DSP, read by the DMA
+    DCInvalidateRange(Buffer, Size);
+    Effects->Process({static_cast<s16*>(Buffer), Size / sizeof(s16)});
+    DCFlushRange(Buffer, Size);
+}
+
+// EOF
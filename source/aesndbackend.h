@@ -0,0 +1,87 @@
+// source/aesndbackend.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#ifndef AesndBackendH
+#define AesndBackendH
+//---------------------------------------------------------------------------
+
+#include <array>
+#include <atomic>
+#include "audiobackend.h"
+
+struct aesndpb_t;
+
+/**
+ * Audio backend playing voices with AESND on the Wii DSP, and the music
+ * module with GRRMOD.
+ * GRRMOD mixes the module on the CPU, in the callback of an AESND voice.
+ * When linked with -Wl,--wrap=AESND_AllocateVoice, that callback is timed.
+ * @author Crayon
+ */
+class AesndBackend : public AudioBackend
+{
+public:
+    static constexpr size_t VOICE_COUNT = 32;  /**< Voices of AESND. */
+
+    /**
+     * How the module is mixed, from the best sounding to the cheapest.
+     */
+    enum class ModuleMode : u8 {
+        Stereo, /**< As the module was made. */
+        Mono,   /**< One channel, about half the mixing time. */
+        Off     /**< Not loaded, there is no music unless it is streamed. */
+    };
+
+    explicit AesndBackend(ModuleMode AMode = ModuleMode::Stereo);
+
+    void Initialize() override;
+    void Exit() override;
+    void Pause(bool Paused) override;
+    void FlushBuffer(const void *Data, u32 Size) override;
+    void SetEffects(MixEffects *AEffects) override;
+
+    [[nodiscard]] VoiceId AllocateVoice(StreamCallback Callback = nullptr, void *User = nullptr) override;
+    void FreeVoice(VoiceId Id) override;
+    void PlayVoice(VoiceId Id, const Sound &sound, u32 Delay, bool Looped) override;
+    void SetVoiceBuffer(VoiceId Id, std::span<const s16> Samples, f32 Frequency) override;
+    void SetVoiceVolume(VoiceId Id, u16 LeftVolume, u16 RightVolume) override;
+    void SetVoiceMute(VoiceId Id, bool Mute) override;
+    void SetVoiceStop(VoiceId Id, bool Stop) override;
+
+    bool LoadModule(std::span<const char> Data) override;
+    void StartModule(u16 Volume) override;
+    void PauseModule(bool Paused) override;
+    void UnloadModule() override;
+    [[nodiscard]] u32 TakeModuleTicks() override;
+private:
+    /**
+     * An AESND voice and its stream callback.
+     */
+    struct Slot
+    {
+        aesndpb_t *Pb{nullptr};
+        StreamCallback Callback{nullptr};
+        void *User{nullptr};
+    };
+
+    static void VoiceCallback(aesndpb_t *Pb, u32 State);
+    static void OutputCallback(void *Buffer, u32 Size);
+
+    std::array<Slot, VOICE_COUNT> Voices{};
+    std::atomic<MixEffects*> Effects{nullptr};
+    ModuleMode Mode;
+    bool ModuleLoaded{false};
+    bool ModulePaused{false};
+};
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
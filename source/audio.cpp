@@ -9,40 +9,91 @@
 // it under the terms of the MIT License. A copy of the license is
 // located in the LICENSE file included with this distribution.
 
-#include <aesndlib.h>
-#include <grrmod.h>
+#include <ogc/lwp_watchdog.h>
+#include "audiobackend.h"
+#include "decodedsound.h"
 #include "voice.h"
 #include "sound.h"
+#include "memtrack.h"
+#include "voicepool.h"
+#include "musicstream.h"
 #include "audio.h"
 
+// Sound effects converted by sfxconv
+#include "button_rollover_sfx.h"
+#include "screen_change_sfx.h"
+
+/**
+ * Folder of the music tracks streamed from the SD card.
+ */
+static constexpr const char *MUSIC_PATH = "sd:/apps/Wii-Tac-Toe/music/";
+
 // Audio files using modern C++23 #embed
-constexpr u8 button_rollover_raw[] = {
-    #embed "../audio/button_rollover.raw"
-};
-constexpr u8 screen_change_raw[] = {
-    #embed "../audio/screen_change.raw"
-};
+#ifdef __has_embed
 constexpr char tic_tac_it[] = {
     #embed "../audio/tic_tac.it"
 };
+constexpr int tic_tac_it_size = sizeof(tic_tac_it);
+#else
+#include "tic_tac_it.h" // Generated by the headless build, for host compilers without #embed
+#endif
 
-static constexpr Sound ChangeSound(VOICE_MONO16, std::span{screen_change_raw, sizeof(screen_change_raw)}, 44100.0f);
-static constexpr Sound RollOverSound(VOICE_MONO16, std::span{button_rollover_raw, sizeof(button_rollover_raw)}, 44100.0f);
+/**
+ * A sound effect and its priority, a sound steals the voice of a sound of
+ * lower or equal priority.
+ */
+struct SoundEffect
+{
+    const Sound &Data;
+    u8 Priority;
+};
+
+/**
+ * Sound effects, in the order of SoundId.
+ */
+static constexpr SoundEffect Effects[] = {
+    {screen_change_sfx, 2},
+    {button_rollover_sfx, 1}
+};
+static_assert(std::size(Effects) == static_cast<size_t>(SoundId::Count), "Every SoundId needs an effect");
 
 /**
  * Constructor for the Audio class.
+ * @param[in] VoiceCount Number of sound effects that can play at the same time.
+ * @param[in] Policy Which voice is stolen when every voice is busy.
  */
-Audio::Audio()
+Audio::Audio(u8 VoiceCount, VoicePool::StealPolicy Policy) :
+    PoolSize(VoiceCount)
 {
-    AESND_Init();
-    AESND_Pause(false);
+    {
+        MemTrack::HeapScope Scope(MemTrack::Category::Audio, &AudioBytes);
+        GetAudioBackend().Initialize();
+    }
+    GetAudioBackend().SetEffects(&Master);
+
+    {
+        MemTrack::HeapScope Scope(MemTrack::Category::Music, &MusicBytes);
+        Stream = std::make_unique<MusicStream>(MUSIC_PATH);
+        if(Stream->GetTrackCount() == 0)
+        {   // No music on the SD card
+            Stream.reset();
+            GetAudioBackend().LoadModule({tic_tac_it, tic_tac_it_size}); // Using your .it file
+        }
+    }
+
+    // Construct the voices after the backend has been initialized.
+    size_t VoiceBytes = 0;
+    {
+        MemTrack::HeapScope Scope(MemTrack::Category::Audio, &VoiceBytes);
+        Voices = std::make_unique<VoicePool>(VoiceCount, Policy);
+    }
+    AudioBytes += VoiceBytes;
 
-    GRRMOD_Init(true);
-    GRRMOD_SetMOD(tic_tac_it, sizeof(tic_tac_it)); // Using your .it file
+    DecodeEffects();
 
-    // Construct the Voice objects after AESND_Init has been called.
-    ScreenVoice.emplace();
-    ButtonVoice.emplace();
+    LWP_SemInit(&Pending, 0, COMMAND_QUEUE_SIZE);
+    Running.store(true, std::memory_order_release);
+    LWP_CreateThread(&Thread, ThreadEntry, this, nullptr, THREAD_STACK_SIZE, THREAD_PRIORITY);
 }
 
 /**
@@ -50,13 +101,45 @@ Audio::Audio()
  */
 Audio::~Audio()
 {
-    // Explicitly destroy Voice objects before AESND is shut down.
-    ScreenVoice.reset();
-    ButtonVoice.reset();
+    // The commands still queued are dropped
+    Running.store(false, std::memory_order_release);
+    LWP_SemPost(Pending);
+    LWP_JoinThread(Thread, nullptr);
+    LWP_SemDestroy(Pending);
+
+    // Explicitly destroy the voices before the backend is shut down.
+    Voices.reset();
+    Stream.reset();
+    GetAudioBackend().UnloadModule();
+    GetAudioBackend().SetEffects(nullptr);
+    GetAudioBackend().Exit();
 
-    GRRMOD_Unload();
-    GRRMOD_End();
-    AESND_Pause(true);
+    MemTrack::Remove(MemTrack::Category::Music, MusicBytes);
+    MemTrack::Remove(MemTrack::Category::Audio, AudioBytes);
+}
+
+/**
+ * Decode the compressed sound effects.
+ * Voices only play PCM, so DSP-ADPCM keeps the game small on the SD card
+ * and is decoded to RAM here, before any sound plays.
+ */
+void Audio::DecodeEffects()
+{
+    size_t DecodedBytes = 0;
+    {
+        MemTrack::HeapScope Scope(MemTrack::Category::Audio, &DecodedBytes);
+        for(size_t i = 0; i < std::size(Effects); ++i)
+        {
+            const Sound &Data = Effects[i].Data;
+            if(Data.GetFormat() != SoundFormat::MonoAdpcm)
+            {
+                Playable[i] = &Data;
+                continue;
+            }
+            Playable[i] = &Decoded.emplace_back(std::make_unique<DecodedSound>(Data))->Get();
+        }
+    }
+    AudioBytes += DecodedBytes;
 }
 
 /**
@@ -65,11 +148,10 @@ Audio::~Audio()
  */
 void Audio::PauseMusic(bool Paused)
 {
-    if(this->Paused != Paused)
-    {
-        this->Paused = Paused;
-        GRRMOD_Pause();
-    }
+    Command Item;
+    Item.What = Command::Type::PauseMusic;
+    Item.Paused = Paused;
+    Post(Item);
 }
 
 /**
@@ -78,30 +160,194 @@ void Audio::PauseMusic(bool Paused)
  */
 void Audio::LoadMusic(s16 Volume)
 {
-    GRRMOD_Stop();
-    GRRMOD_Start();
-    GRRMOD_SetVolume(Volume, Volume); // Maximum volume is 255
-    Paused = false;
+    Command Item;
+    Item.What = Command::Type::LoadMusic;
+    Item.Volume = Volume;
+    Post(Item);
+}
+
+/**
+ * Muffle the whole mix, or make it clear again.
+ * Takes effect with the next block mixed, without going through the audio thread.
+ * @param[in] Muffled On or off.
+ */
+void Audio::SetMuffled(bool Muffled)
+{
+    Master.SetMuffled(Muffled);
+}
+
+/**
+ * Play a sound effect, it stops by itself.
+ * It is heard LATENCY_MS after this call, whenever the audio thread runs.
+ * @param[in] Id The sound effect.
+ * @param[in] Volume The sound volume, between 0 and 255.
+ * @param[in] Pan Position from -1.0 (left) to 1.0 (right).
+ * @return true if the sound was posted, false if the command queue is full.
+ */
+bool Audio::Play(SoundId Id, u16 Volume, f32 Pan)
+{
+    Command Item;
+    Item.What = Command::Type::Play;
+    Item.Effect = Id;
+    Item.Volume = Volume;
+    Item.Pan = Pan;
+    return Post(Item);
+}
+
+/**
+ * Send a command to the audio thread.
+ * The semaphore counts the commands posted, so a command posted while the
+ * audio thread is still executing the previous ones is not missed.
+ * @param[in] Item The command, its time is set here.
+ * @return true if the command was queued, false if the queue is full.
+ */
+bool Audio::Post(Command Item)
+{
+    Item.Time = gettime();
+    if(!Commands.Push(Item))
+    {
+        Overflows.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    LWP_SemPost(Pending);
+    return true;
+}
+
+/**
+ * Execute a command, on the audio thread.
+ * A sound is delayed by what is left of LATENCY_MS since it was posted, so
+ * the time between posting and hearing it does not depend on when the
+ * thread ran. AESND delays a voice by whole milliseconds.
+ * @param[in] Item The command.
+ */
+void Audio::Execute(const Command &Item)
+{
+    switch(Item.What)
+    {
+        case Command::Type::Play:
+        {
+            const u32 Elapsed = ticks_to_millisecs(diff_ticks(Item.Time, gettime()));
+            const u32 Delay = (Elapsed < LATENCY_MS) ? LATENCY_MS - Elapsed : 0;
+            const size_t Index = static_cast<size_t>(Item.Effect);
+            Voices->Play(*Playable[Index], Effects[Index].Priority, Item.Volume, Item.Pan, Delay);
+            PublishStats();
+            break;
+        }
+        case Command::Type::PauseMusic:
+            if(Paused != Item.Paused)
+            {
+                Paused = Item.Paused;
+                if(Stream != nullptr)
+                {
+                    Stream->Pause(Paused);
+                }
+                else
+                {
+                    GetAudioBackend().PauseModule(Paused);
+                }
+            }
+            break;
+        case Command::Type::LoadMusic:
+            if(Stream != nullptr)
+            {
+                Stream->Start(Item.Volume);
+            }
+            else
+            {
+                GetAudioBackend().StartModule(Item.Volume); // Maximum volume is 255
+            }
+            Paused = false;
+            break;
+        case Command::Type::Stats:
+            PublishStats();
+            break;
+    }
+}
+
+/**
+ * Copy the counters of the voice pool where the game can read them, on
+ * the audio thread. The pool itself is only used by this thread.
+ */
+void Audio::PublishStats()
+{
+    const VoicePool::Stats &Stats = Voices->GetStats();
+    ActiveVoices.store(Voices->GetActiveCount(), std::memory_order_relaxed);
+    VoiceSteals.store(Stats.Steals, std::memory_order_relaxed);
+    DroppedSounds.store(Stats.Dropped, std::memory_order_relaxed);
+}
+
+/**
+ * Loop of the audio thread: wait for a command, then execute the commands
+ * queued. The semaphore may still count commands already executed, they
+ * only make the loop find an empty queue.
+ */
+void Audio::Run()
+{
+    Command Item;
+    while(Running.load(std::memory_order_acquire))
+    {
+        LWP_SemWait(Pending);
+        while(Commands.Pop(Item))
+        {
+            Execute(Item);
+        }
+    }
+}
+
+/**
+ * Entry point of the audio thread.
+ * @param[in] Arg The Audio object.
+ * @return Always nullptr.
+ */
+void* Audio::ThreadEntry(void *Arg)
+{
+    static_cast<Audio*>(Arg)->Run();
+    return nullptr;
+}
+
+/**
+ * Ask the audio thread to publish the counters of the voices again.
+ * A voice becomes free when its sound ends, without any command, so the
+ * number of active voices is only current after a refresh.
+ */
+void Audio::RefreshStats()
+{
+    Command Item;
+    Item.What = Command::Type::Stats;
+    Post(Item);
+}
+
+/**
+ * Get the counters of the voices, for statistics.
+ * @return The counters, as of the last sound played or the last refresh
+ *         executed by the audio thread.
+ */
+Audio::VoiceStats Audio::GetVoiceStats() const
+{
+    VoiceStats Stats;
+    Stats.Active = ActiveVoices.load(std::memory_order_relaxed);
+    Stats.Count = PoolSize;
+    Stats.Steals = VoiceSteals.load(std::memory_order_relaxed);
+    Stats.Dropped = DroppedSounds.load(std::memory_order_relaxed);
+    return Stats;
 }
 
 /**
- * Play the screen change sound FX.
- * @param[in] Volume The sound volume.
+ * Get the number of commands dropped because the queue was full.
+ * @return The number of commands.
  */
-void Audio::PlaySoundScreenChange(u16 Volume)
+u32 Audio::GetOverflows() const
 {
-    ScreenVoice->SetVolume(Volume);
-    ScreenVoice->Play(ChangeSound);
+    return Overflows.load(std::memory_order_relaxed);
 }
 
 /**
- * Play the button sound FX.
- * @param[in] Volume The sound volume.
+ * Get the music streamed from the SD card, for statistics.
+ * @return The stream, nullptr when the module built into the game is played.
  */
-void Audio::PlaySoundButton(u16 Volume)
+const MusicStream* Audio::GetMusicStream() const
 {
-    ButtonVoice->SetVolume(Volume);
-    ButtonVoice->Play(RollOverSound);
+    return Stream.get();
 }
 
 // EOF
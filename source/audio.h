@@ -12,31 +12,126 @@
 #ifndef AudioH
 #define AudioH
 //---------------------------------------------------------------------------
-#include <optional>
-#include "voice.h"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <gctypes.h>
+#include <ogc/lwp.h>
+#include <ogc/semaphore.h>
+#include "mixeffects.h"
+#include "spscqueue.h"
+#include "voicepool.h"
+
+class DecodedSound;
+class MusicStream;
+
+/**
+ * Sound effects of the game.
+ */
+enum class SoundId : u8 {
+    ScreenChange,   /**< A new screen is shown. */
+    ButtonRollOver, /**< The pointer enters a button or a free cell. */
+    Count           /**< Number of sound effects. */
+};
 
 /**
  * This is a class used for the game audio.
+ * Sound effects play on a pool of voices, so a sound played again before
+ * its end does not cut the previous one. The game does not call the audio
+ * backend: it posts commands to a queue drained by an audio thread, posting
+ * never waits. Compressed sound effects are decoded once, when it is
+ * created. The music is streamed from the SD card when tracks are found
+ * there, the module built into the game is played otherwise. The whole
+ * mix goes through MixEffects, which muffles it under the HOME screen.
  * @author Crayon
  */
 class Audio
 {
 public:
-    Audio();
+    static constexpr u8 DEFAULT_VOICE_COUNT = 6; /**< Sound effects playing at the same time. */
+    static constexpr u32 OUTPUT_RATE = 48000;    /**< Sample rate of the mix. */
+
+    /**
+     * Counters of the voices, as last published by the audio thread.
+     */
+    struct VoiceStats
+    {
+        u32 Active{0};   /**< Voices playing a sound. */
+        u32 Count{0};    /**< Voices of the pool. */
+        u32 Steals{0};   /**< Sounds cut to start another one. */
+        u32 Dropped{0};  /**< Sounds not played, every voice had a higher priority. */
+    };
+
+    explicit Audio(u8 VoiceCount = DEFAULT_VOICE_COUNT,
+        VoicePool::StealPolicy Policy = VoicePool::StealPolicy::Oldest);
     Audio(Audio const&) = delete;
     ~Audio();
     Audio& operator=(Audio const&) = delete;
 
     void PauseMusic(bool Paused);
     void LoadMusic(s16 Volume = 255);
-    void PlaySoundScreenChange(u16 Volume);
-    void PlaySoundButton(u16 Volume);
+    void SetMuffled(bool Muffled);
+    bool Play(SoundId Id, u16 Volume, f32 Pan = 0.0f);
+    void RefreshStats();
+    [[nodiscard]] VoiceStats GetVoiceStats() const;
+    [[nodiscard]] u32 GetOverflows() const;
+    [[nodiscard]] const MusicStream* GetMusicStream() const;
 private:
-    bool Paused{false};
-    std::optional<Voice> ScreenVoice; // These are initialized in the .cpp
-    std::optional<Voice> ButtonVoice; // and do not need a default here.
+    /**
+     * A request posted by the game to the audio thread.
+     */
+    struct Command
+    {
+        /**
+         * Kinds of request.
+         */
+        enum class Type : u8 {
+            Play,       /**< Play a sound effect. */
+            PauseMusic, /**< Pause or resume the music. */
+            LoadMusic,  /**< Start the music from the beginning. */
+            Stats       /**< Publish the counters of the voices. */
+        };
+
+        Type What{Type::Play};
+        SoundId Effect{SoundId::ScreenChange};
+        bool Paused{false};
+        s16 Volume{0};
+        f32 Pan{0.0f};
+        u64 Time{0};  /**< When the command was posted, in ticks. */
+    };
+
+    static constexpr size_t COMMAND_QUEUE_SIZE = 32;  /**< Slots of the command queue. */
+    static constexpr u32 LATENCY_MS = 5;              /**< Delay between posting a sound and hearing it. */
+    static constexpr u8 THREAD_PRIORITY = 80;         /**< Above the game thread. */
+    static constexpr u32 THREAD_STACK_SIZE = 16 * 1024;
+
+    void DecodeEffects();
+    bool Post(Command Item);
+    void Execute(const Command &Item);
+    void Run();
+    void PublishStats();
+    static void* ThreadEntry(void *Arg);
+
+    const u8 PoolSize;    /**< Voices of the pool. */
+    bool Paused{false};   /**< Only used by the audio thread. */
+    size_t MusicBytes{0}; /**< Heap used by the music, reported to MemTrack. */
+    size_t AudioBytes{0}; /**< Heap used by the mixer and the voices, reported to MemTrack. */
+    std::unique_ptr<VoicePool> Voices; /**< Created after the backend is initialized. */
+    std::unique_ptr<MusicStream> Stream; /**< nullptr when the module is played. */
+    std::vector<std::unique_ptr<DecodedSound>> Decoded; /**< PCM of the compressed sound effects. */
+    std::array<const Sound*, static_cast<size_t>(SoundId::Count)> Playable{}; /**< Sound effects, in the order of SoundId. */
+    MixEffects Master{OUTPUT_RATE}; /**< Applied to the whole mix by the backend. */
+    SpscQueue<Command, COMMAND_QUEUE_SIZE> Commands; /**< From the game to the audio thread. */
+    lwp_t Thread{LWP_THREAD_NULL};   /**< Audio thread, it executes the commands. */
+    sem_t Pending{LWP_SEM_NULL};     /**< Posted with each command, the audio thread waits on it. */
+    std::atomic<bool> Running{false};
+    std::atomic<u32> Overflows{0};   /**< Commands dropped because the queue was full. */
+    // Counters of the voice pool, written by the audio thread only
+    std::atomic<u32> ActiveVoices{0};
+    std::atomic<u32> VoiceSteals{0};
+    std::atomic<u32> DroppedSounds{0};
 };
-//---------------------------------------------------------------------------
 #endif
 
 // EOF
@@ -0,0 +1,70 @@
+// source/audiobackend.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#ifndef AudioBackendH
+#define AudioBackendH
+//---------------------------------------------------------------------------
+
+#include <memory>
+#include <span>
+#include <gctypes.h>
+
+class MixEffects;
+class Sound;
+
+/**
+ * Interface for everything the audio classes send to the sound hardware.
+ * Voices are numbered by the backend. A stream voice plays 16-bit mono
+ * buffers given one at a time, its callback is called when it needs the
+ * next one; on the Wii it runs in the audio interrupt and must not block.
+ * The same goes for the effects applied to each block of the output.
+ * @author Crayon
+ */
+class AudioBackend
+{
+public:
+    using VoiceId = s32;
+    using StreamCallback = void (*)(void *User);
+    static constexpr VoiceId NO_VOICE = -1;
+
+    virtual ~AudioBackend() = default;
+
+    // Mixer
+    virtual void Initialize() = 0;
+    virtual void Exit() = 0;
+    virtual void Pause(bool Paused) = 0;
+    virtual void FlushBuffer(const void *Data, u32 Size) = 0;
+    virtual void SetEffects(MixEffects *Effects) = 0;
+
+    // Voices
+    [[nodiscard]] virtual VoiceId AllocateVoice(StreamCallback Callback = nullptr, void *User = nullptr) = 0;
+    virtual void FreeVoice(VoiceId Id) = 0;
+    virtual void PlayVoice(VoiceId Id, const Sound &sound, u32 Delay, bool Looped) = 0;
+    virtual void SetVoiceBuffer(VoiceId Id, std::span<const s16> Samples, f32 Frequency) = 0;
+    virtual void SetVoiceVolume(VoiceId Id, u16 LeftVolume, u16 RightVolume) = 0;
+    virtual void SetVoiceMute(VoiceId Id, bool Mute) = 0;
+    virtual void SetVoiceStop(VoiceId Id, bool Stop) = 0;
+
+    // Module music
+    virtual bool LoadModule(std::span<const char> Data) = 0;
+    virtual void StartModule(u16 Volume) = 0;
+    virtual void PauseModule(bool Paused) = 0;
+    virtual void UnloadModule() = 0;
+    [[nodiscard]] virtual u32 TakeModuleTicks() = 0;
+};
+
+void SetAudioBackend(std::unique_ptr<AudioBackend> Backend);
+[[nodiscard]] AudioBackend& GetAudioBackend();
+
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
@@ -10,6 +10,8 @@
 // located in the LICENSE file included with this distribution.
 
 #include <string>
+#include "font.h"
+#include "textlabel.h"
 #include "button.h"
 
 // Graphics
@@ -47,6 +49,11 @@ Button::Button(buttonType NewType) : Object(),
     Height = ButtonImgOff->GetHeight();
 }
 
+/**
+ * Destructor for the Button class.
+ */
+Button::~Button() = default;
+
 /**
  * Draw the button to screen.
  */
@@ -57,7 +64,7 @@ void Button::Paint()
         ButtonImgOff->Draw(Left + 4.0f, Top + 5.0f, 0, 1.0f, 1.0f, 0x00000055);
     }
     ButtonImgOff->Draw(Left, Top, 0, 1.0f, 1.0f, 0xFFFFFFFF);
-    GRRLIB_PrintfTTF(TextLeft, TextTop, Font, Caption.c_str(), TextHeight, TextColor);
+    Label->Paint();
 
     if(Focused && ButtonImgOn)
     {
@@ -87,22 +94,26 @@ void Button::SetTextHeight(unsigned int NewHeight)
 void Button::SetCaption(std::string_view NewCaption)
 {
     Caption = NewCaption;
-    TextWidth = GRRLIB_WidthTTF(Font, Caption.c_str(), TextHeight);
+    TextWidth = TextFont->GetWidth(Caption, TextHeight);
     TextTop = Top + (Height / 2) - (TextHeight / 2);
     TextLeft = Left + (Width / 2) - (TextWidth / 2);
     if(Type == buttonType::Home)
     {
         TextLeft += 20;
     }
+    Label->SetLocation(TextLeft, TextTop);
+    Label->SetStyle(TextHeight, TextColor);
+    Label->SetText(Caption);
 }
 
 /**
  * Set the font to use for the text on the button.
  * @param[in] AFont Font to use for the text on the button.
  */
-void Button::SetFont(GRRLIB_ttfFont *AFont)
+void Button::SetFont(Font *AFont)
 {
-    Font = AFont;
+    TextFont = AFont;
+    Label = std::make_unique<TextLabel>(*TextFont);
 }
 
 /**
@@ -130,6 +141,22 @@ void Button::SetSelected(bool IsSelected)
 void Button::SetTextColor(u32 NewColor)
 {
     TextColor = NewColor;
+    if(Label)
+    {
+        Label->SetStyle(TextHeight, TextColor);
+    }
+}
+
+/**
+ * Render the caption again on the next paint.
+ * Must be called when the background under the button changed.
+ */
+void Button::Invalidate()
+{
+    if(Label)
+    {
+        Label->Invalidate();
+    }
 }
 
 // EOF
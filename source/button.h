@@ -18,6 +18,10 @@
 #include "object.h"
 #include "grrlib_class.h"
 
+// Forward declarations
+class Font;
+class TextLabel;
+
 /**
  * Types of button that could be used.
  */
@@ -36,20 +40,22 @@ class Button : public Object
 public:
     Button(buttonType NewType = buttonType::StdMenu);
     Button(Button const&) = delete;
-    ~Button() = default;
+    ~Button();
     Button& operator=(Button const&) = delete;
     void Paint() override;
     void SetCaption(std::string_view NewCaption);
-    void SetFont(GRRLIB_ttfFont *AFont);
+    void SetFont(Font *AFont);
     void SetFocused(bool IsFocused);
     void SetSelected(bool IsSelected);
     void SetTextColor(u32 NewColor);
     void SetTextHeight(unsigned int NewHeight);
+    void Invalidate();
 private:
     bool Focused{false};
     bool Selected{false};
     std::string Caption{};
-    GRRLIB_ttfFont *Font{nullptr};
+    Font *TextFont{nullptr};
+    std::unique_ptr<TextLabel> Label; /**< Caption kept in a texture. */
     unsigned int TextWidth{100}; // random default value
     unsigned int TextHeight{14};
     unsigned int TextTop{0};
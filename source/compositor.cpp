@@ -0,0 +1,140 @@
+// source/compositor.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#include <algorithm>
+#include "compositor.h"
+
+/**
+ * Constructor for the Compositor class.
+ * Every row is invalid until the first update.
+ * @param[in] AWidth Screen width.
+ * @param[in] AHeight Screen height.
+ */
+Compositor::Compositor(u16 AWidth, u16 AHeight) :
+    Width(AWidth),
+    Height(AHeight),
+    Backing(std::make_unique<Texture>(AWidth, AHeight)),
+    DirtyRows((AHeight + ROW_HEIGHT - 1) / ROW_HEIGHT, true)
+{
+}
+
+/**
+ * Add a layer over the previous ones.
+ * The first layer must cover every row it is asked to paint.
+ * @param[in] Top First row covered by the layer.
+ * @param[in] Height Number of rows covered by the layer.
+ * @param[in] Paint Function drawing the layer.
+ * @return The layer index, used to invalidate it.
+ */
+u8 Compositor::AddLayer(u16 Top, u16 Height, PaintFunction Paint)
+{
+    Layers.push_back({Top, Height, std::move(Paint)});
+    Invalidate(Top, Height);
+    return Layers.size() - 1;
+}
+
+/**
+ * Paint a layer again on the next update.
+ * @param[in] Layer The layer index.
+ */
+void Compositor::Invalidate(u8 Layer)
+{
+    Invalidate(Layers[Layer].Top, Layers[Layer].Height);
+}
+
+/**
+ * Paint rows again on the next update.
+ * @param[in] Top First row to paint.
+ * @param[in] Height Number of rows to paint.
+ */
+void Compositor::Invalidate(u16 Top, u16 Height)
+{
+    const size_t First = Top / ROW_HEIGHT;
+    const size_t Last = std::min<size_t>((Top + Height + ROW_HEIGHT - 1) / ROW_HEIGHT, DirtyRows.size());
+    for(size_t Row = First; Row < Last; ++Row)
+    {
+        DirtyRows[Row] = true;
+        Dirty = true;
+    }
+}
+
+/**
+ * Paint every layer again on the next update.
+ */
+void Compositor::InvalidateAll()
+{
+    std::fill(DirtyRows.begin(), DirtyRows.end(), true);
+    Dirty = true;
+}
+
+/**
+ * Paint the invalid rows and copy them in the texture.
+ * Invalid rows are drawn to screen, the rest of the screen is left untouched.
+ */
+void Compositor::Update()
+{
+    if(!Dirty)
+    {
+        return;
+    }
+
+    for(size_t Row = 0; Row < DirtyRows.size();)
+    {
+        if(!DirtyRows[Row])
+        {
+            ++Row;
+            continue;
+        }
+        size_t End = Row;
+        while(End < DirtyRows.size() && DirtyRows[End])
+        {
+            DirtyRows[End++] = false;
+        }
+
+        const u16 BandTop = Row * ROW_HEIGHT;
+        const u16 BandBottom = std::min<u16>(End * ROW_HEIGHT, Height);
+        for(auto &Item : Layers)
+        {   // A layer only draws on its own rows
+            const u16 Top = std::max(Item.Top, BandTop);
+            const u16 Bottom = std::min<u16>(Item.Top + Item.Height, BandBottom);
+            if(Top < Bottom)
+            {
+                Screen::ClipDrawing(0, Top, Width, Bottom - Top);
+                Item.Paint();
+            }
+        }
+        Screen::ClipReset();
+        const u16 BandHeight = BandBottom - BandTop;
+        Backing->CopyScreenRows(BandTop, BandHeight);
+        Row = End;
+    }
+    Dirty = false;
+}
+
+/**
+ * Update the invalid rows and draw the screen.
+ */
+void Compositor::Paint()
+{
+    Update();
+    Backing->Draw(0, 0);
+}
+
+/**
+ * Check if some rows must be painted again.
+ * @return true if an update is needed, false otherwise.
+ */
+bool Compositor::IsDirty() const
+{
+    return Dirty;
+}
+
+// EOF
@@ -0,0 +1,69 @@
+// source/compositor.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#ifndef CompositorH
+#define CompositorH
+//---------------------------------------------------------------------------
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include "grrlib_class.h"
+
+/**
+ * This class keeps the static part of a screen in a texture.
+ * The screen is made of layers painted in the order they were added. When a
+ * layer changes, only the rows it covers are painted again and copied back.
+ * Regions are full-width rows because an EFB copy can only fill contiguous
+ * tile rows of the texture.
+ * @author Crayon
+ */
+class Compositor
+{
+public:
+    using PaintFunction = std::function<void()>;
+
+    Compositor(u16 AWidth, u16 AHeight);
+    Compositor(Compositor const&) = delete;
+    ~Compositor() = default;
+    Compositor& operator=(Compositor const&) = delete;
+
+    u8 AddLayer(u16 Top, u16 Height, PaintFunction Paint);
+    void Invalidate(u8 Layer);
+    void Invalidate(u16 Top, u16 Height);
+    void InvalidateAll();
+    void Update();
+    void Paint();
+    [[nodiscard]] bool IsDirty() const;
+private:
+    /**
+     * A part of the screen drawn by the same function.
+     */
+    struct Layer
+    {
+        u16 Top;            /**< First row covered by the layer. */
+        u16 Height;         /**< Number of rows covered by the layer. */
+        PaintFunction Paint;
+    };
+
+    static constexpr u16 ROW_HEIGHT = 4; /**< Height of a texture tile. */
+
+    u16 Width;
+    u16 Height;
+    std::unique_ptr<Texture> Backing; /**< Copy of every layer. */
+    std::vector<Layer> Layers;
+    std::vector<bool> DirtyRows;      /**< One flag per tile row. */
+    bool Dirty{true};
+};
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
@@ -0,0 +1,61 @@
+// source/decodedsound.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#include <bit>
+#include <cstdlib>
+#include <span>
+#include "adpcm.h"
+#include "audiobackend.h"
+#include "decodedsound.h"
+
+/**
+ * Constructor for the DecodedSound class.
+ * The audio backend must be initialized.
+ * @param[in] Source The compressed sound.
+ */
+DecodedSound::DecodedSound(const Sound &Source) :
+    Size((Source.GetSampleCount() * sizeof(s16) + 31) & ~31u),
+    Samples(static_cast<s16*>(std::aligned_alloc(32, Size))),
+    Data(SoundFormat::Mono16,
+        std::span{reinterpret_cast<const u8*>(Samples), Source.GetSampleCount() * sizeof(s16)},
+        Source.GetFrequency())
+{
+    const std::span<s16> Decoded{Samples, Size / sizeof(s16)};
+    Adpcm::Decode(Source.GetBuffer(), Source.GetCoefficients(), Decoded);
+    if constexpr(std::endian::native != std::endian::big)
+    {   // Mono16 is big-endian, only the host build has to swap
+        for(s16 &Sample : Decoded)
+        {
+            const u16 Value = static_cast<u16>(Sample);
+            Sample = static_cast<s16>((Value >> 8) | (Value << 8));
+        }
+    }
+    GetAudioBackend().FlushBuffer(Samples, Size);
+}
+
+/**
+ * Destructor for the DecodedSound class.
+ */
+DecodedSound::~DecodedSound()
+{
+    std::free(Samples);
+}
+
+/**
+ * Get the decoded sound.
+ * @return The sound, 16-bit PCM.
+ */
+const Sound& DecodedSound::Get() const
+{
+    return Data;
+}
+
+// EOF
@@ -0,0 +1,43 @@
+// source/decodedsound.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#ifndef DecodedSoundH
+#define DecodedSoundH
+//---------------------------------------------------------------------------
+
+#include <cstddef>
+#include <gctypes.h>
+#include "sound.h"
+
+/**
+ * PCM samples decoded from a DSP-ADPCM sound.
+ * The samples are big-endian like every Mono16 sound, whatever the CPU, and
+ * the DSP reads them from a 32-byte aligned buffer.
+ * @author Crayon
+ */
+class DecodedSound
+{
+public:
+    explicit DecodedSound(const Sound &Source);
+    DecodedSound(DecodedSound const&) = delete;
+    ~DecodedSound();
+    DecodedSound& operator=(DecodedSound const&) = delete;
+
+    [[nodiscard]] const Sound& Get() const;
+private:
+    const size_t Size;  /**< Size of the buffer, whole cache lines. */
+    s16 *Samples;
+    const Sound Data;
+};
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
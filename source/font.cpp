@@ -0,0 +1,207 @@
+// source/font.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#include <algorithm>
+#include "font.h"
+#include "profiler.h"
+
+/**
+ * Constructor for the Font class.
+ * @param[in] AData Font data generated by fontbake, it must outlive the font.
+ */
+Font::Font(const FontData &AData) :
+    Data(AData),
+    Atlas(std::make_unique<Texture>())
+{
+    Atlas->SetMemCategory(MemTrack::Category::Font);
+    // The atlas is already tiled and aligned by fontbake, it is drawn from the binary
+    Atlas->UseRaw(Data.Atlas, Data.AtlasSize, Data.AtlasWidth, Data.AtlasHeight, GX_TF_IA8);
+
+    for(u32 i = 0; i < Data.GlyphCount && Data.Glyphs[i].Code < AsciiGlyphs.size(); ++i)
+    {
+        AsciiGlyphs[Data.Glyphs[i].Code] = &Data.Glyphs[i];
+    }
+    for(u32 i = 0; i < Data.StoredGlyphCount && Data.StoredGlyphs[i].Code < AsciiGlyphs.size(); ++i)
+    {
+        AsciiGlyphs[Data.StoredGlyphs[i].Code] = &Data.StoredGlyphs[i];
+    }
+    if(Data.StoredGlyphCount > 0)
+    {
+        Cache = std::make_unique<GlyphCache>(Data, GLYPH_CACHE_CELLS);
+    }
+}
+
+/**
+ * Decode the next code point from a UTF-8 string.
+ * @param[in] Text The string to decode.
+ * @param[in,out] Pos Position in the string, moved after the code point.
+ * @return The code point, or U+FFFD for malformed sequences.
+ */
+u32 Font::NextCodePoint(std::string_view Text, size_t &Pos)
+{
+    const u8 Lead = Text[Pos++];
+    int Extra = 0;
+    u32 Code = Lead;
+    if(Lead >= 0xF0) { Extra = 3; Code = Lead & 0x07; }
+    else if(Lead >= 0xE0) { Extra = 2; Code = Lead & 0x0F; }
+    else if(Lead >= 0xC0) { Extra = 1; Code = Lead & 0x1F; }
+    else if(Lead >= 0x80) { return 0xFFFD; }
+
+    while(Extra-- > 0)
+    {
+        if(Pos >= Text.size())
+        {
+            return 0xFFFD;
+        }
+        Code = (Code << 6) | (static_cast<u8>(Text[Pos++]) & 0x3F);
+    }
+    return Code;
+}
+
+/**
+ * Find a glyph in the atlas.
+ * @param[in] Code Unicode code point.
+ * @return The glyph, or nullptr if the font does not contain it.
+ */
+const FontGlyph* Font::FindGlyph(u32 Code) const
+{
+    if(Code < AsciiGlyphs.size())
+    {
+        return AsciiGlyphs[Code];
+    }
+    auto Find = [Code](const FontGlyph *Glyphs, u32 Count) -> const FontGlyph*
+    {
+        const FontGlyph *End = Glyphs + Count;
+        const FontGlyph *Glyph = std::lower_bound(Glyphs, End, Code,
+            [](const FontGlyph &g, u32 c) { return g.Code < c; });
+        return (Glyph != End && Glyph->Code == Code) ? Glyph : nullptr;
+    };
+    const FontGlyph *Glyph = Find(Data.Glyphs, Data.GlyphCount);
+    return (Glyph != nullptr) ? Glyph : Find(Data.StoredGlyphs, Data.StoredGlyphCount);
+}
+
+/**
+ * Return the kerning between two glyphs.
+ * @param[in] Left Code point on the left.
+ * @param[in] Right Code point on the right.
+ * @return Kerning in 26.6 fixed point at the base size.
+ */
+s32 Font::GetKerning(u32 Left, u32 Right) const
+{
+    const FontKerning *End = Data.Kerning + Data.KerningCount;
+    const FontKerning *Pair = std::lower_bound(Data.Kerning, End, std::pair{Left, Right},
+        [](const FontKerning &k, const std::pair<u32, u32> &p)
+        {
+            return (k.Left < p.first) || (k.Left == p.first && k.Right < p.second);
+        });
+    return (Pair != End && Pair->Left == Left && Pair->Right == Right) ? Pair->Amount : 0;
+}
+
+/**
+ * Return the size of the glyphs in the atlas.
+ * Glyph metrics and kerning are expressed at this size.
+ * @return The base size in pixels.
+ */
+u32 Font::GetBaseSize() const
+{
+    return Data.BaseSize;
+}
+
+/**
+ * Return the cache of the stored glyphs.
+ * @return The cache, nullptr if the font has no stored glyph.
+ */
+const GlyphCache* Font::GetCache() const
+{
+    return Cache.get();
+}
+
+/**
+ * Return the width of a text.
+ * @param[in] Text UTF-8 text to measure.
+ * @param[in] Size Size of the text in pixels.
+ * @return The width in pixels.
+ */
+u32 Font::GetWidth(std::string_view Text, u32 Size) const
+{
+    s32 Pen = 0; // 26.6 fixed point at the base size
+    u32 Previous = 0;
+    for(size_t Pos = 0; Pos < Text.size();)
+    {
+        const u32 Code = NextCodePoint(Text, Pos);
+        const FontGlyph *Glyph = FindGlyph(Code);
+        if(Glyph == nullptr)
+        {
+            continue;
+        }
+        if(Previous != 0)
+        {
+            Pen += GetKerning(Previous, Code);
+        }
+        Pen += Glyph->Advance;
+        Previous = Code;
+    }
+    return (Pen * Size / Data.BaseSize) >> 6;
+}
+
+/**
+ * Print a text.
+ * @param[in] x Specifies the x-coordinate of the upper-left corner of the text.
+ * @param[in] y Specifies the y-coordinate of the upper-left corner of the text.
+ * @param[in] Text UTF-8 text to draw.
+ * @param[in] Size Size of the text in pixels.
+ * @param[in] Color Text color in RGBA format.
+ */
+void Font::Print(f32 x, f32 y, std::string_view Text, u32 Size, u32 Color)
+{
+    ScopedTimer Timer(Profiler::Phase::Text);
+    const f32 Scale = static_cast<f32>(Size) / Data.BaseSize;
+    const f32 Baseline = y + Size;
+    f32 Pen = x;
+    u32 Previous = 0;
+
+    Screen::SetAlphaTest(EDGE_THRESHOLD);
+    for(size_t Pos = 0; Pos < Text.size();)
+    {
+        const u32 Code = NextCodePoint(Text, Pos);
+        const FontGlyph *Glyph = FindGlyph(Code);
+        if(Glyph == nullptr)
+        {
+            continue;
+        }
+        if(Previous != 0)
+        {
+            Pen += GetKerning(Previous, Code) * Scale / 64.0f;
+        }
+        Texture *Source = Atlas.get();
+        u16 X = Glyph->X;
+        u16 Y = Glyph->Y;
+        const bool Stored = (Data.StoredGlyphCount > 0 && Glyph >= Data.StoredGlyphs &&
+            Glyph < Data.StoredGlyphs + Data.StoredGlyphCount);
+        if(Stored && Glyph->Width > 0)
+        {
+            Source = Cache->Acquire(Glyph - Data.StoredGlyphs, X, Y) ? &Cache->GetTexture() : nullptr;
+        }
+        if(Glyph->Width > 0 && Source != nullptr)
+        {   // A part is scaled around the handle of the whole texture, move it back to the glyph corner
+            const f32 HandleX = Glyph->Width / 2.0f - Source->GetWidth() / 2;
+            const f32 HandleY = Glyph->Height / 2.0f - Source->GetHeight() / 2;
+            Source->DrawPart(Pen + Glyph->BearingX * Scale - HandleX * (1.0f - Scale),
+                Baseline - Glyph->BearingY * Scale - HandleY * (1.0f - Scale),
+                X, Y, Glyph->Width, Glyph->Height, 0, Scale, Scale, Color);
+        }
+        Pen += Glyph->Advance * Scale / 64.0f;
+        Previous = Code;
+    }
+    Screen::SetAlphaTest(0);
+}
+
+// EOF
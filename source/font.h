@@ -0,0 +1,66 @@
+// source/font.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#ifndef FontH
+#define FontH
+//---------------------------------------------------------------------------
+
+#include <array>
+#include <memory>
+#include <string_view>
+#include "fontdata.h"
+#include "glyphcache.h"
+#include "grrlib_class.h"
+
+/**
+ * This class draws text from a signed distance field atlas baked at build time.
+ * Any size can be drawn from the same atlas, the cost of a string only depends
+ * on its number of glyphs. Stored glyphs, CJK for instance, are drawn from a
+ * GlyphCache of fixed size.
+ * @author Crayon
+ */
+class Font
+{
+public:
+    explicit Font(const FontData &AData);
+    Font(Font const&) = delete;
+    ~Font() = default;
+    Font& operator=(Font const&) = delete;
+
+    void Print(f32 x, f32 y, std::string_view Text, u32 Size, u32 Color);
+    [[nodiscard]] u32 GetWidth(std::string_view Text, u32 Size) const;
+    [[nodiscard]] const FontGlyph* FindGlyph(u32 Code) const;
+    [[nodiscard]] s32 GetKerning(u32 Left, u32 Right) const;
+    [[nodiscard]] u32 GetBaseSize() const;
+    [[nodiscard]] const GlyphCache* GetCache() const;
+
+    [[nodiscard]] static u32 NextCodePoint(std::string_view Text, size_t &Pos);
+private:
+    /**
+     * Alpha threshold matching the outline of the glyphs in the distance field.
+     * It is slightly under the 0x80 edge value to keep small sizes readable.
+     */
+    static constexpr u8 EDGE_THRESHOLD = 0x70;
+
+    /**
+     * Number of stored glyphs kept in the cache, enough for a few screens of text.
+     */
+    static constexpr u16 GLYPH_CACHE_CELLS = 64;
+
+    const FontData &Data;
+    std::unique_ptr<Texture> Atlas;
+    std::unique_ptr<GlyphCache> Cache; /**< Only created if the font has stored glyphs. */
+    std::array<const FontGlyph*, 128> AsciiGlyphs{}; /**< Direct lookup for the ASCII range. */
+};
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
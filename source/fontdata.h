@@ -0,0 +1,72 @@
+// source/fontdata.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#ifndef FontDataH
+#define FontDataH
+//---------------------------------------------------------------------------
+
+#include <gctypes.h>
+
+/**
+ * A glyph inside a signed distance field atlas.
+ * All metrics are in pixels at the base size of the atlas.
+ */
+struct FontGlyph
+{
+    u32 Code;     /**< Unicode code point. */
+    u16 X;        /**< Left position of the glyph in the atlas. */
+    u16 Y;        /**< Top position of the glyph in the atlas. */
+    u16 Width;    /**< Width of the glyph in the atlas, including the spread. */
+    u16 Height;   /**< Height of the glyph in the atlas, including the spread. */
+    s16 BearingX; /**< Horizontal offset from the pen to the left of the glyph. */
+    s16 BearingY; /**< Vertical offset from the baseline to the top of the glyph. */
+    u16 Advance;  /**< Horizontal advance in 26.6 fixed point. */
+};
+
+/**
+ * Kerning between two glyphs.
+ */
+struct FontKerning
+{
+    u32 Left;   /**< Code point on the left. */
+    u32 Right;  /**< Code point on the right. */
+    s16 Amount; /**< Adjustment in 26.6 fixed point at the base size. */
+};
+
+/**
+ * Font baked at build time by the fontbake tool.
+ * Glyphs are sorted by code point and kerning pairs by left then right code point.
+ * Stored glyphs are not in the atlas, their fields are compressed with
+ * PackBits and drawn through a GlyphCache.
+ */
+struct FontData
+{
+    u16 BaseSize;               /**< Size in pixels of the glyphs in the atlas. */
+    u16 Spread;                 /**< Distance in pixels covered by the field outside a glyph. */
+    s16 Ascender;               /**< Ascender at the base size. */
+    s16 LineHeight;             /**< Line height at the base size. */
+    u16 AtlasWidth;             /**< Width of the atlas texture. */
+    u16 AtlasHeight;            /**< Height of the atlas texture. */
+    const u8 *Atlas;            /**< Atlas texels in GX IA8 format, distance in alpha. */
+    u32 AtlasSize;              /**< Size of the atlas in bytes. */
+    const FontGlyph *Glyphs;    /**< Glyph table. */
+    u32 GlyphCount;             /**< Number of glyphs. */
+    const FontKerning *Kerning; /**< Kerning table. */
+    u32 KerningCount;           /**< Number of kerning pairs. */
+    const FontGlyph *StoredGlyphs; /**< Stored glyph table, X and Y are unused. */
+    u32 StoredGlyphCount;       /**< Number of stored glyphs. */
+    const u32 *StoredOffsets;   /**< Start of each field in Store, plus the end of the last one. */
+    const u8 *Store;            /**< Compressed distance fields, one byte per pixel. */
+};
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
@@ -0,0 +1,170 @@
+// source/framearena.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include "framearena.h"
+
+alignas(32) static char Buffer[FrameArena::CAPACITY];
+static size_t Used{0};      /**< Bytes used in the current frame. */
+static size_t Peak{0};      /**< Highest number of bytes used in a frame. */
+static u32 Overflows{0};    /**< Requests that did not fit. */
+static std::atomic<u32> HeapAllocations{0}; /**< Heap allocations in the current frame. */
+static u32 LastHeapAllocations{0};          /**< Heap allocations in the previous frame. */
+
+/**
+ * Allocate memory until the end of the frame.
+ * @param[in] Bytes Size of the block.
+ * @param[in] Alignment Alignment of the block, a power of two.
+ * @return The block, or nullptr if the arena is full.
+ */
+void* FrameArena::Allocate(size_t Bytes, size_t Alignment)
+{
+    const size_t Start = (Used + Alignment - 1) & ~(Alignment - 1);
+    if(Start + Bytes > CAPACITY)
+    {
+        ++Overflows;
+        return nullptr;
+    }
+    Used = Start + Bytes;
+    Peak = std::max(Peak, Used);
+    return Buffer + Start;
+}
+
+/**
+ * Copy a text into the arena.
+ * The text is truncated if the arena is full.
+ * @param[in] Text The text to copy.
+ * @return The copy, valid until the next Screen::Render.
+ */
+std::string_view FrameArena::Copy(std::string_view Text)
+{
+    const std::span<char> Free = GetFree();
+    const size_t Length = std::min(Text.size(), Free.size());
+    std::memcpy(Free.data(), Text.data(), Length);
+    Commit(Length, Text.size());
+    return std::string_view(Free.data(), Length);
+}
+
+/**
+ * Get the unused part of the arena, to write into it directly.
+ * Commit must be called with the number of bytes written.
+ * @return The free bytes.
+ */
+std::span<char> FrameArena::GetFree()
+{
+    return std::span<char>(Buffer + Used, CAPACITY - Used);
+}
+
+/**
+ * Keep bytes written in the span returned by GetFree.
+ * @param[in] Bytes Number of bytes written.
+ * @param[in] Wanted Number of bytes that were needed, more than Bytes if the arena was full.
+ */
+void FrameArena::Commit(size_t Bytes, size_t Wanted)
+{
+    Used = std::min(Used + Bytes, CAPACITY);
+    Peak = std::max(Peak, Used);
+    if(Wanted > Bytes)
+    {
+        ++Overflows;
+    }
+}
+
+/**
+ * Release everything allocated during the frame.
+ * Called by Screen::Render once the frame is shown.
+ */
+void FrameArena::Reset()
+{
+    Used = 0;
+    LastHeapAllocations = HeapAllocations.exchange(0, std::memory_order_relaxed);
+}
+
+/**
+ * Get the number of bytes used in the current frame.
+ * @return The size in bytes.
+ */
+size_t FrameArena::GetUsed()
+{
+    return Used;
+}
+
+/**
+ * Get the highest number of bytes used in a frame.
+ * @return The size in bytes.
+ */
+size_t FrameArena::GetPeak()
+{
+    return Peak;
+}
+
+/**
+ * Get the number of requests that did not fit in the arena.
+ * @return The number of overflows since the start.
+ */
+u32 FrameArena::GetOverflows()
+{
+    return Overflows;
+}
+
+/**
+ * Get the number of general heap allocations made during the previous frame.
+ * They are only counted in debug builds.
+ * @return The number of calls to operator new, always 0 in release builds.
+ */
+u32 FrameArena::GetHeapAllocations()
+{
+    return LastHeapAllocations;
+}
+
+#ifdef DEBUG
+// Counting allocator, a steady frame is expected to make no heap allocation
+
+void* operator new(size_t Bytes)
+{
+    HeapAllocations.fetch_add(1, std::memory_order_relaxed);
+    if(void *Block = std::malloc(Bytes != 0 ? Bytes : 1))
+    {
+        return Block;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t Bytes)
+{
+    return operator new(Bytes);
+}
+
+void operator delete(void *Block) noexcept
+{
+    std::free(Block);
+}
+
+void operator delete[](void *Block) noexcept
+{
+    std::free(Block);
+}
+
+void operator delete(void *Block, size_t) noexcept
+{
+    std::free(Block);
+}
+
+void operator delete[](void *Block, size_t) noexcept
+{
+    std::free(Block);
+}
+#endif
+
+// EOF
@@ -0,0 +1,72 @@
+// source/framearena.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#ifndef FrameArenaH
+#define FrameArenaH
+//---------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <gctypes.h>
+#if __has_include(<format>) // Not available to every host compiler of the headless build
+#include <format>
+#endif
+
+/**
+ * Namespace containing the per-frame arena.
+ * Memory for things that only live until the frame is shown, like formatted
+ * texts, is taken from a fixed buffer by moving a pointer. Everything is
+ * released at once by Screen::Render, so drawing a frame does not need the
+ * general heap.
+ * @author Crayon
+ */
+namespace FrameArena
+{
+    /**
+     * Size of the arena in bytes.
+     */
+    inline constexpr size_t CAPACITY = 16 * 1024;
+
+    [[nodiscard]] void* Allocate(size_t Bytes, size_t Alignment = alignof(std::max_align_t));
+    [[nodiscard]] std::string_view Copy(std::string_view Text);
+    [[nodiscard]] std::span<char> GetFree();
+    void Commit(size_t Bytes, size_t Wanted);
+    void Reset();
+    [[nodiscard]] size_t GetUsed();
+    [[nodiscard]] size_t GetPeak();
+    [[nodiscard]] u32 GetOverflows();
+    [[nodiscard]] u32 GetHeapAllocations();
+
+#if __has_include(<format>)
+    /**
+     * Format a text into the arena.
+     * The text is truncated if the arena is full.
+     * @param[in] Fmt The format string.
+     * @param[in] Arguments The values to format.
+     * @return The text, valid until the next Screen::Render.
+     */
+    template <typename... Args>
+    [[nodiscard]] std::string_view Format(std::format_string<Args...> Fmt, Args&&... Arguments)
+    {
+        const std::span<char> Free = GetFree();
+        const auto Result = std::format_to_n(Free.data(), Free.size(), Fmt, std::forward<Args>(Arguments)...);
+        const size_t Length = std::min<size_t>(Result.size, Free.size());
+        Commit(Length, Result.size);
+        return std::string_view(Free.data(), Length);
+    }
+#endif
+}   /* namespace FrameArena */
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
@@ -9,10 +9,11 @@
 // it under the terms of the MIT License. A copy of the license is
 // located in the LICENSE file included with this distribution.
 
+#include <algorithm>
 #include <array>
+#include <bit>
 #include <cstdio>
 #include <cstdlib>
-#include <ctime>
 #include <chrono>
 #include <charconv>
 #include <limits>
@@ -25,10 +26,20 @@
 #include "tools.h"
 #include "grid.h"
 #include "audio.h"
+#include "musicstream.h"
 #include "button.h"
 #include "cursor.h"
 #include "player.h"
 #include "language.h"
+#include "font.h"
+#include "framearena.h"
+#include "textlayout.h"
+#include "textlabel.h"
+#include "compositor.h"
+#include "input.h"
+#include "memtrack.h"
+#include "profiler.h"
+#include "trace.h"
 #include "types.h"
 #include "game.h"
 
@@ -40,7 +51,7 @@
 #include "hover.h"
 
 // Font
-#include "../fonts/Swis721_Ex_BT.h"
+#include "Swis721_Ex_BT_sdf.h"
 
 /**
  * Array to hold the position of each zone.
@@ -59,10 +70,14 @@ static constexpr size_t MaxScoreLength = std::numeric_limits<u16>::digits10 + 2;
  * Constructor for the Game class.
  * @param[in] GameScreenWidth Screen width.
  * @param[in] GameScreenHeight Screen height.
+ * @param[in] GamePads Source of the Wii Remote state.
+ * @param[in] Seed Random seed, a session replays identically with the same seed and input.
  */
-Game::Game(u16 GameScreenWidth, u16 GameScreenHeight) :
+Game::Game(u16 GameScreenWidth, u16 GameScreenHeight, const Input &GamePads, u32 Seed) :
+    Pads(GamePads),
     FPS(0),
     ShowFPS(false),
+    Overlay(overlayPage::None),
     FrameCount(0),
     LastFrameTime(0),
     ScreenWidth(GameScreenWidth),
@@ -70,15 +85,50 @@ Game::Game(u16 GameScreenWidth, u16 GameScreenHeight) :
     GameMode(gameMode::VsHuman1),
     SymbolAlpha(5),
     AlphaDirection(false),
-    AIThinkLoop(0),
-    Copied(false)
+    AIThinkLoop(0)
 {
-    std::srand(std::time(nullptr));  // Initialize random seed
+    std::srand(Seed);  // Initialize random seed
 
-    GameGrid = std::make_unique<Grid>();
-    Lang = std::make_unique<Language>();
+    GameGrid = std::make_unique<Grid>(Seed);
+    DefaultFont = std::make_unique<Font>(Swis721_Ex_BT_sdf);
+    Lang = std::make_unique<Language>(Seed, *DefaultFont);
+    TextWrap = std::make_unique<TextLayout>(*DefaultFont);
 
-    DefaultFont = GRRLIB_LoadTTF(Swis721_Ex_BT, Swis721_Ex_BT_size);
+    // Initialize labels, the score shadow is under the text on the right
+    struct ScoreStyle
+    {
+        f32 Top;
+        u32 Color;
+        u32 ShadowColor;
+    };
+    static constexpr std::array<ScoreStyle, 3> ScoreStyles = {{
+        {PLAYER1_SCORE_TOP, PLAYER1_NAME_COLOR, NAME_TEXT_COLOR},
+        {PLAYER2_SCORE_TOP, PLAYER2_NAME_COLOR, NAME_TEXT_COLOR},
+        {TIE_SCORE_TOP, NAME_TEXT_COLOR, TIE_NAME_COLOR}}};
+    for(size_t i = 0; i < ScoreLabel.size(); ++i)
+    {
+        ScoreLabel[i] = std::make_unique<TextLabel>(*DefaultFont);
+        ScoreLabel[i]->SetLocation(SCORE_CENTER_X - (SCORE_WIDTH / 2) - SCORE_SHADOW_OFFSET, ScoreStyles[i].Top);
+        ScoreLabel[i]->SetWidth(SCORE_WIDTH);
+        ScoreLabel[i]->SetStyle(SCORE_FONT_SIZE, ScoreStyles[i].Color);
+        ScoreLabel[i]->SetShadow(ScoreStyles[i].ShadowColor, SCORE_SHADOW_OFFSET, SCORE_SHADOW_OFFSET);
+    }
+
+    MessageLabel = std::make_unique<TextLabel>(*DefaultFont, TextWrap.get());
+    MessageLabel->SetLocation(BOTTOM_TEXT_LEFT, BOTTOM_TEXT_TOP);
+    MessageLabel->SetWidth(BOTTOM_TEXT_WIDTH);
+    MessageLabel->SetStyle(BOTTOM_TEXT_FONT_SIZE, BOTTOM_TEXT_COLOR);
+    MessageLabel->SetShadow(BOTTOM_TEXT_SHADOW_COLOR, BOTTOM_TEXT_SHADOW_X, BOTTOM_TEXT_SHADOW_Y);
+
+    HomeTitleLabel = std::make_unique<TextLabel>(*DefaultFont);
+    HomeTitleLabel->SetLocation(HOME_TITLE_LEFT, HOME_TITLE_TOP);
+    HomeTitleLabel->SetStyle(HOME_TITLE_FONT_SIZE, 0xFFFFFFFF);
+    HomeTitleLabel->SetText(Lang->String("HOME Menu"));
+
+    VersionLabel = std::make_unique<TextLabel>(*DefaultFont);
+    VersionLabel->SetLocation(MENU_VERSION_LEFT, MENU_VERSION_TOP);
+    VersionLabel->SetStyle(MENU_VERSION_FONT_SIZE, 0xFFFFFFFF);
+    VersionLabel->SetText(Lang->Format("Ver. {}", MessageBuffer, {"1.1.0"}));
 
     // Initialize GridSigns using the Table positions
     for(u8 x = 0; x < 3; ++x)
@@ -98,38 +148,38 @@ Game::Game(u16 GameScreenWidth, u16 GameScreenHeight) :
 
     // Initialize Exit and Menu buttons
     ExitButton[0] = std::make_unique<Button>(buttonType::Home);
-    ExitButton[0]->SetFont(DefaultFont);
+    ExitButton[0]->SetFont(DefaultFont.get());
     ExitButton[0]->SetLeft(EXIT_BUTTON_HOME_LEFT);
     ExitButton[0]->SetTop(EXIT_BUTTON_HOME_TOP);
     ExitButton[0]->SetTextHeight(EXIT_BUTTON_HOME_TEXT_HEIGHT);
     ExitButton[0]->SetCaption(Lang->String("Close"));
 
     ExitButton[1] = std::make_unique<Button>(buttonType::HomeMenu);
-    ExitButton[1]->SetFont(DefaultFont);
+    ExitButton[1]->SetFont(DefaultFont.get());
     ExitButton[1]->SetLeft((ScreenWidth / 2.0f) + EXIT_BUTTON_MENU_OFFSET);
     ExitButton[1]->SetTop(EXIT_BUTTON_MENU_TOP);
     ExitButton[1]->SetCaption(Lang->String("Reset"));
 
     ExitButton[2] = std::make_unique<Button>(buttonType::HomeMenu);
-    ExitButton[2]->SetFont(DefaultFont);
+    ExitButton[2]->SetFont(DefaultFont.get());
     ExitButton[2]->SetLeft((ScreenWidth / 2.0f) - ExitButton[1]->GetWidth() - EXIT_BUTTON_MENU_OFFSET);
     ExitButton[2]->SetTop(EXIT_BUTTON_MENU_TOP);
     ExitButton[2]->SetCaption(Lang->String("Return to Loader"));
 
     MenuButton[0] = std::make_unique<Button>();
-    MenuButton[0]->SetFont(DefaultFont);
+    MenuButton[0]->SetFont(DefaultFont.get());
     MenuButton[0]->SetLeft((ScreenWidth / 2.0f) - (MenuButton[0]->GetWidth() / 2.0f));
     MenuButton[0]->SetTop(MENU_BUTTON_TOP_FIRST);
     MenuButton[0]->SetCaption(Lang->String("2 Players (1 Wiimote)"));
 
     MenuButton[1] = std::make_unique<Button>();
-    MenuButton[1]->SetFont(DefaultFont);
+    MenuButton[1]->SetFont(DefaultFont.get());
     MenuButton[1]->SetLeft((ScreenWidth / 2.0f) - (MenuButton[1]->GetWidth() / 2.0f));
     MenuButton[1]->SetTop(MENU_BUTTON_TOP_SECOND);
     MenuButton[1]->SetCaption(Lang->String("1 Player (Vs AI)"));
 
     MenuButton[2] = std::make_unique<Button>();
-    MenuButton[2]->SetFont(DefaultFont);
+    MenuButton[2]->SetFont(DefaultFont.get());
     MenuButton[2]->SetLeft((ScreenWidth / 2.0f) - (MenuButton[2]->GetWidth() / 2.0f));
     MenuButton[2]->SetTop(MENU_BUTTON_TOP_THIRD);
     MenuButton[2]->SetCaption(Lang->String("2 Players (2 Wiimotes)"));
@@ -143,52 +193,202 @@ Game::Game(u16 GameScreenWidth, u16 GameScreenHeight) :
     // Load textures
     GameImg = Texture::CreateFromPNG(backg);
     GameHoverImg = Texture::CreateFromPNG(backg_hover);
-    SplashImg = Texture::CreateFromPNG(splash);
     SplashArmImg = Texture::CreateFromPNG(splash_arm);
     HoverImg = Texture::CreateFromPNG(hover);
-    CopiedImg = std::make_unique<Texture>(ScreenWidth, ScreenHeight);
     GameText = std::make_unique<Texture>(ScreenWidth, ScreenHeight);
 
+    BuildGameText();
+    BuildSplash();
+
+    // Set handle for arm rotation
+    SplashArmImg->SetHandle(8, 70);
+
+    // Static layers of each screen, painted again only where they change
+    GameLayers = std::make_unique<Compositor>(ScreenWidth, ScreenHeight);
+    GameLayers->AddLayer(0, ScreenHeight, [this]()
+    {
+        GameText->Draw(0, 0); // Background image with some text
+    });
+    ScoreLayer[0] = GameLayers->AddLayer(PLAYER1_SCORE_TOP, SCORE_HEIGHT, [this]() { ScoreLabel[0]->Paint(); });
+    ScoreLayer[1] = GameLayers->AddLayer(PLAYER2_SCORE_TOP, SCORE_HEIGHT, [this]() { ScoreLabel[1]->Paint(); });
+    ScoreLayer[2] = GameLayers->AddLayer(TIE_SCORE_TOP, SCORE_HEIGHT, [this]() { ScoreLabel[2]->Paint(); });
+    MessageLayer = GameLayers->AddLayer(BOTTOM_TEXT_TOP, BOTTOM_TEXT_HEIGHT, [this]() { MessageLabel->Paint(); });
+    for(u8 y = 0; y < 3; ++y)
+    {   // One layer per row of cells, a move only repaints its row
+        GameLayers->AddLayer(Table[0][y].y, GRID_CELL_HEIGHT, [this, y]()
+        {
+            for(u8 x = 0; x < 3; ++x)
+            {
+                if(BoardCells[x][y] != ' ')
+                {
+                    GridSign[x][y].SetColor(0xFFFFFFFF);
+                    GridSign[x][y].Paint();
+                    ++BoardDraws;
+                }
+            }
+        });
+    }
+
+    MenuLayers = std::make_unique<Compositor>(ScreenWidth, ScreenHeight);
+    MenuLayers->AddLayer(0, ScreenHeight, [this]()
+    {
+        FillScreen(0x000000FF); // Clear screen
+        DrawStripeBackground(MENU_STRIPE_COLOR, MENU_STRIPE_SPACING, MENU_STRIPE_THICKNESS);
+
+        Rectangle(0, 0, ScreenWidth, MENU_TOP_BAR_HEIGHT, MENU_BAR_COLOR, 1);
+        Rectangle(0, MENU_SEPARATOR_TOP, ScreenWidth, MENU_STRIPE_THICKNESS, MENU_SEPARATOR_COLOR, 1);
+        Rectangle(0, MENU_SEPARATOR_BOTTOM, ScreenWidth, MENU_STRIPE_THICKNESS, MENU_SEPARATOR_COLOR, 1);
+        Rectangle(0, HOME_BOTTOM_BAR_TOP, ScreenWidth, HOME_BOTTOM_BAR_HEIGHT, MENU_BAR_COLOR, 1);
+    });
+    VersionLayer = MenuLayers->AddLayer(MENU_VERSION_TOP, MENU_VERSION_FONT_SIZE * 2, [this]() { VersionLabel->Paint(); });
+
+    HomeLayers = std::make_unique<Compositor>(ScreenWidth, ScreenHeight);
+    HomeLayers->AddLayer(0, ScreenHeight, [this]()
+    {
+        if(HomeSource != nullptr)
+        {
+            HomeSource->Paint();
+        }
+        Rectangle(0, 0, ScreenWidth, ScreenHeight, HOME_OVERLAY_COLOR, 1); // Draw a black rectangle over it
+        Rectangle(0, HOME_SEPARATOR_TOP, ScreenWidth, HOME_SEPARATOR_HEIGHT, HOME_SEPARATOR_COLOR, 1);
+        Rectangle(0, HOME_SEPARATOR_BOTTOM, ScreenWidth, HOME_SEPARATOR_HEIGHT, HOME_SEPARATOR_COLOR, 1);
+        Rectangle(0, HOME_BOTTOM_BAR_TOP, ScreenWidth, HOME_BOTTOM_BAR_HEIGHT, HOME_BAR_COLOR, 1);
+    });
+
+    // Initialize Audio and Rumble
+    GameAudio = std::make_unique<Audio>();
+    RUMBLE_Init();
+
+    // Initialize frame timing
+    LastFrameTime = ticks_to_millisecs(gettime());
+
+    NewGame();
+}
+
+/**
+ * Destructor for the Game class.
+ */
+Game::~Game() = default;
+
+/**
+ * Draw the game background with the player names into GameText.
+ * GameText should only be modified when player names changed.
+ */
+void Game::BuildGameText()
+{
     // Player name with a shadow offset of -2, 2 (includes game background)
-    // GameText should only be modified when player names changed.
     GameImg->Draw(0, 0);
     PrintWrapText(PLAYER_NAME_LEFT, PLAYER1_NAME_TOP, PLAYER_NAME_WIDTH, WTTPlayer[0].GetName(), PLAYER_NAME_FONT_SIZE, NAME_TEXT_COLOR, PLAYER1_NAME_COLOR, PLAYER_NAME_SHADOW_X, PLAYER_NAME_SHADOW_Y);
     PrintWrapText(PLAYER_NAME_LEFT, PLAYER2_NAME_TOP, PLAYER_NAME_WIDTH, WTTPlayer[1].GetName(), PLAYER_NAME_FONT_SIZE, NAME_TEXT_COLOR, PLAYER2_NAME_COLOR, PLAYER_NAME_SHADOW_X, PLAYER_NAME_SHADOW_Y);
     PrintWrapText(PLAYER_NAME_LEFT, TIE_NAME_TOP, PLAYER_NAME_WIDTH, Lang->String("TIE GAME"), PLAYER_NAME_FONT_SIZE, NAME_TEXT_COLOR, TIE_NAME_COLOR, PLAYER_NAME_SHADOW_X, PLAYER_NAME_SHADOW_Y);
     GameText->CopyScreen(0, 0, true);
+    GameTextDirty = false;
+}
 
-    // Build Start Screen background
+/**
+ * Draw the credits and the invitation to press A into SplashImg.
+ * The splash image is decoded again, the text is drawn over it.
+ */
+void Game::BuildSplash()
+{
+    SplashImg = Texture::CreateFromPNG(splash);
     SplashImg->Draw(0, 0);
-    GRRLIB_PrintfTTF(CREDITS_LEFT, CREDITS_PROGRAMMER_TOP, DefaultFont,
-        std::format(std::runtime_format(Lang->String("Programmer: {}")), "Crayon").c_str(),
+    DefaultFont->Print(CREDITS_LEFT, CREDITS_PROGRAMMER_TOP,
+        Lang->Format("Programmer: {}", MessageBuffer, {"Crayon"}),
         CREDITS_FONT_SIZE, CREDITS_TEXT_COLOR);
-    GRRLIB_PrintfTTF(CREDITS_LEFT, CREDITS_GRAPHICS_TOP, DefaultFont,
-        std::format(std::runtime_format(Lang->String("Graphics: {}")), "Mr_Nick666").c_str(),
+    DefaultFont->Print(CREDITS_LEFT, CREDITS_GRAPHICS_TOP,
+        Lang->Format("Graphics: {}", MessageBuffer, {"Mr_Nick666"}),
         CREDITS_FONT_SIZE, CREDITS_TEXT_COLOR);
-    text = Lang->String("Press The A Button");
-    GRRLIB_PrintfTTF((ScreenWidth / 2) - (GRRLIB_WidthTTF(DefaultFont, text.c_str(), START_TEXT_FONT_SIZE) / 2),
-                    START_TEXT_TOP, DefaultFont, text.c_str(), START_TEXT_FONT_SIZE, START_TEXT_COLOR);
+    const std::string_view PressA = Lang->String("Press The A Button");
+    DefaultFont->Print((ScreenWidth / 2) - (DefaultFont->GetWidth(PressA, START_TEXT_FONT_SIZE) / 2),
+                    START_TEXT_TOP, PressA, START_TEXT_FONT_SIZE, START_TEXT_COLOR);
     SplashImg->CopyScreen(0, 0, true);
+    SplashDirty = false;
+}
 
-    // Set handle for arm rotation
-    SplashArmImg->SetHandle(8, 70);
+/**
+ * Show the texts of a new language.
+ * Only the texts that changed are set again, a label or a layer is painted
+ * again only if its text changed. The textures with baked text are built at
+ * the start of the next frame, before anything is drawn on the screen.
+ */
+void Game::ApplyLanguage()
+{
+    TRACE_SCOPE("Game::ApplyLanguage");
+    if(Lang->HasChanged("HOME Menu"))
+    {
+        HomeTitleLabel->SetText(Lang->String("HOME Menu"));
+    }
+    if(VersionLabel->SetText(Lang->Format("Ver. {}", MessageBuffer, {"1.1.0"})))
+    {
+        MenuLayers->Invalidate(VersionLayer);
+    }
 
-    // Initialize Audio and Rumble
-    GameAudio = std::make_unique<Audio>();
-    RUMBLE_Init();
+    struct Caption
+    {
+        Button *Target;
+        TextKey Key;
+    };
+    const Caption Captions[] = {
+        {ExitButton[0].get(), "Close"},
+        {ExitButton[1].get(), "Reset"},
+        {ExitButton[2].get(), "Return to Loader"},
+        {MenuButton[0].get(), "2 Players (1 Wiimote)"},
+        {MenuButton[1].get(), "1 Player (Vs AI)"},
+        {MenuButton[2].get(), "2 Players (2 Wiimotes)"}
+    };
+    for(const auto &[Target, Key] : Captions)
+    {
+        if(Lang->HasChanged(Key))
+        {
+            Target->SetCaption(Lang->String(Key));
+        }
+    }
 
-    // Initialize frame timing
-    LastFrameTime = ticks_to_millisecs(gettime());
+    if(Lang->HasChanged("PLAYER 1") || Lang->HasChanged("PLAYER 2") || Lang->HasChanged("TIE GAME"))
+    {
+        WTTPlayer[0].SetName(Lang->String("PLAYER 1"));
+        WTTPlayer[1].SetName(Lang->String("PLAYER 2"));
+        GameTextDirty = true;
+    }
+    if(Lang->HasChanged("Programmer: {}") || Lang->HasChanged("Graphics: {}") ||
+       Lang->HasChanged("Press The A Button"))
+    {
+        SplashDirty = true;
+    }
 
-    NewGame();
+    // The message may point to the texts of the previous language
+    ShowRoundMessage();
 }
 
 /**
- * Destructor for the Game class.
+ * Describe the state of the game, for diagnostic reports.
+ * @return A few lines of text.
  */
-Game::~Game()
+std::string Game::GetState() const
 {
-    GRRLIB_FreeTTF(DefaultFont);
+    static constexpr const char *ScreenNames[] = {"Start", "Game", "Home", "Menu"};
+    static constexpr const char *ModeNames[] = {"VsAI", "VsHuman1", "VsHuman2"};
+
+    std::string State = std::format("Screen: {}, last: {}\nMode: {}\n",
+        ScreenNames[static_cast<u8>(CurrentScreen)], ScreenNames[static_cast<u8>(LastScreen)],
+        ModeNames[static_cast<u8>(GameMode)]);
+    State += std::format("Player: {}, round finished: {}, AI think loop: {}\n",
+        static_cast<int>(CurrentPlayer), RoundFinished, AIThinkLoop);
+    State += std::format("Scores: {} / {} / {} tie\n",
+        WTTPlayer[0].GetScore(), WTTPlayer[1].GetScore(), TieGame);
+    for(u8 y = 0; y < 3; ++y)
+    {
+        State += "Board: ";
+        for(u8 x = 0; x < 3; ++x)
+        {
+            const u8 Sign = GameGrid->GetPlayerAtPos(x, y);
+            State += (Sign == 'X' || Sign == 'O') ? static_cast<char>(Sign) : '.';
+        }
+        State += '\n';
+    }
+    State += std::format("Hand: {} {}, focused button: {}", HandX, HandY, FocusedButton);
+    return State;
 }
 
 /**
@@ -196,24 +396,49 @@ Game::~Game()
  */
 void Game::Paint()
 {
+    TRACE_SCOPE("Game::Paint");
+    if(GameTextDirty)
+    {   // Nothing is drawn yet, the screen can be used to build the texture
+        BuildGameText();
+        GameLayers->InvalidateAll();
+    }
+    if(SplashDirty)
+    {
+        BuildSplash();
+    }
+    SyncBoard();
+
     switch(CurrentScreen)
     {
         case gameScreen::Start:
+        {
+            ScopedTimer Timer(Profiler::Phase::PaintStart);
             StartScreen();
             break;
+        }
         case gameScreen::Menu:
-            MenuScreen(true);
+        {
+            ScopedTimer Timer(Profiler::Phase::PaintMenu);
+            MenuScreen();
             break;
+        }
         case gameScreen::Home:
+        {
+            ScopedTimer Timer(Profiler::Phase::PaintHome);
             ExitScreen();
             break;
+        }
         case gameScreen::Game:
-            GameScreen(true);
+            {
+                ScopedTimer Timer(Profiler::Phase::PaintGame);
+                GameScreen();
+            }
             // AI
             if(!RoundFinished && WTTPlayer[CurrentPlayer].GetType() == playerType::CPU)
             {   // AI
                 if(AIThinkLoop > (std::rand() % AI_THINK_VARIANCE + AI_THINK_MIN_FRAMES))
                 {
+                    ScopedTimer Timer(Profiler::Phase::AI);
                     GameGrid->SetPlayerAI(WTTPlayer[CurrentPlayer].GetSign());
                     TurnIsOver();
                     AIThinkLoop = 0;
@@ -225,11 +450,11 @@ void Game::Paint()
             }
             break;
         default:
-            GRRLIB_FillScreen(0x000000FF);
+            Screen::FillScreen(0x000000FF);
     }
 
     if(CurrentScreen != gameScreen::Start &&
-        WPAD_Probe(WPAD_CHAN_0, nullptr) == WPAD_ERR_NO_CONTROLLER)
+        !Pads.GetPad(WPAD_CHAN_0).Connected)
     {   // Controller is disconnected
         Rectangle(0, 0, ScreenWidth, ScreenHeight, 0x000000 | ALPHA_DISCONNECT_OVERLAY, 1);
     }
@@ -244,16 +469,154 @@ void Game::Paint()
     if(ShowFPS)
     {
         CalculateFrameRate();
-        const auto strFPS = std::format("FPS: {}", FPS);
+        const auto strFPS = (CurrentScreen == gameScreen::Game) ?
+            FrameArena::Format("FPS: {}  Draws saved: {}", FPS, BoardDrawsSaved) :
+            FrameArena::Format("FPS: {}", FPS);
 
         // Draw shadows first, then the main text highlight on top
         // Gray sub-shadow
-        GRRLIB_PrintfTTF(FPS_LEFT_MARGIN + FPS_SHADOW_OFFSET, FPS_BOTTOM_MARGIN + FPS_SHADOW_OFFSET, DefaultFont, strFPS.c_str(), FPS_FONT_SIZE, FPS_SHADOW_COLOR_2);
+        DefaultFont->Print(FPS_LEFT_MARGIN + FPS_SHADOW_OFFSET, FPS_BOTTOM_MARGIN + FPS_SHADOW_OFFSET, strFPS, FPS_FONT_SIZE, FPS_SHADOW_COLOR_2);
         // Black main shadow
-        GRRLIB_PrintfTTF(FPS_LEFT_MARGIN, FPS_BOTTOM_MARGIN, DefaultFont, strFPS.c_str(), FPS_FONT_SIZE, FPS_SHADOW_COLOR_1);
+        DefaultFont->Print(FPS_LEFT_MARGIN, FPS_BOTTOM_MARGIN, strFPS, FPS_FONT_SIZE, FPS_SHADOW_COLOR_1);
         // White highlight text
-        GRRLIB_PrintfTTF(FPS_LEFT_MARGIN - FPS_SHADOW_OFFSET, FPS_BOTTOM_MARGIN - FPS_SHADOW_OFFSET, DefaultFont, strFPS.c_str(), FPS_FONT_SIZE, FPS_TEXT_COLOR);
+        DefaultFont->Print(FPS_LEFT_MARGIN - FPS_SHADOW_OFFSET, FPS_BOTTOM_MARGIN - FPS_SHADOW_OFFSET, strFPS, FPS_FONT_SIZE, FPS_TEXT_COLOR);
+    }
+
+    switch(Overlay)
+    {
+        case overlayPage::Profile:
+            DrawProfile();
+            break;
+        case overlayPage::Memory:
+            DrawMemory();
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * Draw the frame time of each phase and a graph of the last frames.
+ * Times are those of the frames already shown, the overlay itself is counted
+ * in the paint phase of the current screen.
+ */
+void Game::DrawProfile()
+{
+    using Profiler::Phase;
+    static constexpr Phase Rows[] = {
+        Phase::Frame, Phase::PaintStart, Phase::PaintMenu, Phase::PaintHome, Phase::PaintGame,
+        Phase::AI, Phase::Text, Phase::ScanPads, Phase::Controller, Phase::Render, Phase::Music
+    };
+    static constexpr Phase Stacked[] = {
+        Phase::PaintStart, Phase::PaintMenu, Phase::PaintHome, Phase::PaintGame, Phase::AI,
+        Phase::ScanPads, Phase::Controller, Phase::Render
+    };
+    static constexpr u32 StackedColor[] = {
+        0x6BB6DEFF, 0x6BB6DEFF, 0x6BB6DEFF, 0x6BB6DEFF, 0xE6313AFF,
+        0xF0C040FF, 0x109642FF, 0x808080FF
+    };
+
+    Rectangle(PROFILE_LEFT, PROFILE_TOP, PROFILE_WIDTH, PROFILE_HEIGHT, PROFILE_BACK_COLOR, true);
+
+    f32 y = PROFILE_TOP + PROFILE_MARGIN;
+    DefaultFont->Print(PROFILE_LEFT + PROFILE_MARGIN, y, "ms   min / avg / p99",
+        PROFILE_FONT_SIZE, PROFILE_TEXT_COLOR);
+    for(const Phase Row : Rows)
+    {
+        const Profiler::Stats Stats = Profiler::GetStats(Row);
+        if(Stats.Samples == 0)
+        {
+            continue;
+        }
+        y += PROFILE_LINE_HEIGHT;
+        const auto Line = FrameArena::Format("{}: {:.2f} / {:.2f} / {:.2f}", Profiler::GetName(Row),
+            Stats.Min / 1000.0f, Stats.Avg / 1000.0f, Stats.P99 / 1000.0f);
+        DefaultFont->Print(PROFILE_LEFT + PROFILE_MARGIN, y, Line, PROFILE_FONT_SIZE, PROFILE_TEXT_COLOR);
+    }
+
+    // One bar per frame, oldest on the left, phases stacked from the bottom
+    const f32 GraphBottom = PROFILE_TOP + PROFILE_HEIGHT - PROFILE_MARGIN;
+    const f32 Scale = PROFILE_GRAPH_HEIGHT / PROFILE_GRAPH_RANGE;
+    for(size_t Age = 0; Age < Profiler::HISTORY_SIZE; ++Age)
+    {
+        const f32 x = PROFILE_LEFT + PROFILE_MARGIN + (Profiler::HISTORY_SIZE - 1 - Age) * PROFILE_BAR_WIDTH;
+        f32 Bottom = GraphBottom;
+        for(size_t i = 0; i < std::size(Stacked); ++i)
+        {
+            const f32 Height = std::min(static_cast<f32>(Profiler::GetSample(Stacked[i], Age)) * Scale,
+                Bottom - (GraphBottom - PROFILE_GRAPH_HEIGHT));
+            if(Height >= 1.0f)
+            {
+                Bottom -= Height;
+                Rectangle(x, Bottom, PROFILE_BAR_WIDTH, Height, StackedColor[i], true);
+            }
+        }
+    }
+    // Frame budget at 60 Hz
+    Rectangle(PROFILE_LEFT + PROFILE_MARGIN, GraphBottom - PROFILE_FRAME_BUDGET * Scale,
+        Profiler::HISTORY_SIZE * PROFILE_BAR_WIDTH, 1, PROFILE_BUDGET_COLOR, true);
+}
+
+/**
+ * Draw the memory used by each subsystem.
+ * A line is red when the category went over its budget.
+ */
+void Game::DrawMemory()
+{
+    Rectangle(PROFILE_LEFT, PROFILE_TOP, PROFILE_WIDTH, PROFILE_HEIGHT, PROFILE_BACK_COLOR, true);
+
+    f32 y = PROFILE_TOP + PROFILE_MARGIN;
+    DefaultFont->Print(PROFILE_LEFT + PROFILE_MARGIN, y, "KB   live / peak / budget",
+        PROFILE_FONT_SIZE, PROFILE_TEXT_COLOR);
+    for(u8 i = 0; i < static_cast<u8>(MemTrack::Category::Count); ++i)
+    {
+        const auto Which = static_cast<MemTrack::Category>(i);
+        const MemTrack::Usage &Usage = MemTrack::Get(Which);
+        y += PROFILE_LINE_HEIGHT;
+        const auto Line = FrameArena::Format("{}: {} / {} / {}", MemTrack::GetName(Which),
+            Usage.Live / 1024, Usage.Peak / 1024, Usage.Budget / 1024);
+        DefaultFont->Print(PROFILE_LEFT + PROFILE_MARGIN, y, Line, PROFILE_FONT_SIZE,
+            MemTrack::IsOverBudget(Which) ? MEMORY_OVER_BUDGET_COLOR : PROFILE_TEXT_COLOR);
+    }
+    y += PROFILE_LINE_HEIGHT * 2;
+    const auto Heap = FrameArena::Format("Heap in use: {} KB", MemTrack::GetHeapInUse() / 1024);
+    DefaultFont->Print(PROFILE_LEFT + PROFILE_MARGIN, y, Heap, PROFILE_FONT_SIZE, PROFILE_TEXT_COLOR);
+    y += PROFILE_LINE_HEIGHT;
+    const auto Strings = FrameArena::Format("String allocations: {} ({} KB copied)",
+        MemTrack::Get(MemTrack::Category::Strings).Allocations,
+        MemTrack::Get(MemTrack::Category::Strings).Transient / 1024);
+    DefaultFont->Print(PROFILE_LEFT + PROFILE_MARGIN, y, Strings, PROFILE_FONT_SIZE, PROFILE_TEXT_COLOR);
+    y += PROFILE_LINE_HEIGHT;
+    const auto Arena = FrameArena::Format("Frame arena: {} / {} B, {} overflows",
+        FrameArena::GetUsed(), FrameArena::GetPeak(), FrameArena::GetOverflows());
+    DefaultFont->Print(PROFILE_LEFT + PROFILE_MARGIN, y, Arena, PROFILE_FONT_SIZE, PROFILE_TEXT_COLOR);
+    if(const GlyphCache *Cache = DefaultFont->GetCache(); Cache != nullptr)
+    {
+        y += PROFILE_LINE_HEIGHT;
+        const GlyphCache::Stats &Glyphs = Cache->GetStats();
+        const auto CacheLine = FrameArena::Format("Glyph cache: {} / {}, {} misses, {} evictions",
+            Cache->GetUsedCells(), Cache->GetCellCount(), Glyphs.Misses, Glyphs.Evictions);
+        DefaultFont->Print(PROFILE_LEFT + PROFILE_MARGIN, y, CacheLine, PROFILE_FONT_SIZE, PROFILE_TEXT_COLOR);
+    }
+    y += PROFILE_LINE_HEIGHT;
+    // The counters are published by the audio thread, the refresh shows in the next frame
+    GameAudio->RefreshStats();
+    const Audio::VoiceStats Voices = GameAudio->GetVoiceStats();
+    const auto VoiceLine = FrameArena::Format("Voices: {} / {}, {} steals, {} dropped, {} lost commands",
+        Voices.Active, Voices.Count, Voices.Steals, Voices.Dropped, GameAudio->GetOverflows());
+    DefaultFont->Print(PROFILE_LEFT + PROFILE_MARGIN, y, VoiceLine, PROFILE_FONT_SIZE, PROFILE_TEXT_COLOR);
+    if(const MusicStream *Stream = GameAudio->GetMusicStream(); Stream != nullptr)
+    {
+        y += PROFILE_LINE_HEIGHT;
+        const auto StreamLine = FrameArena::Format("Music stream: {} tracks, {} underruns",
+            Stream->GetTrackCount(), Stream->GetUnderruns());
+        DefaultFont->Print(PROFILE_LEFT + PROFILE_MARGIN, y, StreamLine, PROFILE_FONT_SIZE, PROFILE_TEXT_COLOR);
     }
+#ifdef DEBUG
+    y += PROFILE_LINE_HEIGHT;
+    const auto Allocations = FrameArena::Format("Heap allocations last frame: {}", FrameArena::GetHeapAllocations());
+    DefaultFont->Print(PROFILE_LEFT + PROFILE_MARGIN, y, Allocations, PROFILE_FONT_SIZE, PROFILE_TEXT_COLOR);
+#endif
 }
 
 /**
@@ -288,58 +651,24 @@ void Game::StartScreen()
             ArmDirection = false;
         }
     }
-    GRRLIB_ClipDrawing(ARM_CLIP_X, ARM_CLIP_Y, ARM_CLIP_W, ARM_CLIP_H);
+    Screen::ClipDrawing(ARM_CLIP_X, ARM_CLIP_Y, ARM_CLIP_W, ARM_CLIP_H);
     SplashArmImg->Draw(START_ARM_X, START_ARM_Y, ArmRotation); // Arm
-    GRRLIB_ClipReset();
+    Screen::ClipReset();
 }
 
 /**
  * Draw the game screen.
- * @param[in] CopyScreen If true the screen is copied to a buffer.
  */
-void Game::GameScreen(bool CopyScreen)
+void Game::GameScreen()
 {
-    if(Copied == false)
-    {   // Copy static element
-        GameText->Draw(0, 0); // Background image with some text
-
-        // Function to draw the score with a shadow
-        auto DrawScore = [&](int playerIndex, int yPos, u32 color)
-        {
-            char ScoreText[MaxScoreLength] = {};
-            std::to_chars(ScoreText, ScoreText + MaxScoreLength, WTTPlayer[playerIndex].GetScore());
-            const auto TextLeft = SCORE_CENTER_X - GRRLIB_WidthTTF(DefaultFont, ScoreText, SCORE_FONT_SIZE) / 2;
-            GRRLIB_PrintfTTF(TextLeft, yPos + SCORE_SHADOW_OFFSET, DefaultFont, ScoreText, SCORE_FONT_SIZE, NAME_TEXT_COLOR);
-            GRRLIB_PrintfTTF(TextLeft - SCORE_SHADOW_OFFSET, yPos, DefaultFont, ScoreText, SCORE_FONT_SIZE, color);
-        };
-
-        DrawScore(0, PLAYER1_SCORE_TOP, PLAYER1_NAME_COLOR); // Player 1
-        DrawScore(1, PLAYER2_SCORE_TOP, PLAYER2_NAME_COLOR); // Player 2
-
-        // Draw tie score
-        char TieScoreText[MaxScoreLength] = {};
-        std::to_chars(TieScoreText, TieScoreText + MaxScoreLength, TieGame);
-        const auto TieTextLeft = SCORE_CENTER_X - GRRLIB_WidthTTF(DefaultFont, TieScoreText, SCORE_FONT_SIZE) / 2;
-        GRRLIB_PrintfTTF(TieTextLeft, TIE_SCORE_TOP + SCORE_SHADOW_OFFSET, DefaultFont, TieScoreText, SCORE_FONT_SIZE, TIE_NAME_COLOR);
-        GRRLIB_PrintfTTF(TieTextLeft - SCORE_SHADOW_OFFSET, TIE_SCORE_TOP, DefaultFont, TieScoreText, SCORE_FONT_SIZE, NAME_TEXT_COLOR);
-
-        // Draw text at the bottom with a shadow offset of 1, 1
-        PrintWrapText(BOTTOM_TEXT_LEFT, BOTTOM_TEXT_TOP, BOTTOM_TEXT_WIDTH, text, BOTTOM_TEXT_FONT_SIZE, BOTTOM_TEXT_COLOR, BOTTOM_TEXT_SHADOW_COLOR, BOTTOM_TEXT_SHADOW_X, BOTTOM_TEXT_SHADOW_Y);
-
-        if(CopyScreen)
-        {
-            CopiedImg->CopyScreen();
-            Copied = true;
-        }
-    }
-    if(CopyScreen)
-    {
-        CopiedImg->Draw(0, 0);
-    }
+    BoardDraws = 0;
+    GameLayers->Paint(); // Background, scores, text and board
+    // A sign is drawn more than once when a frame repaints several bands of its row
+    BoardDrawsSaved = (BoardFilled > BoardDraws) ? BoardFilled - BoardDraws : 0;
 
     const u32 HoverColor = (WTTPlayer[CurrentPlayer].GetSign() == 'X') ? 0x0093DDFF : 0xDA251DFF;
 
-    // Draw grid content
+    // Draw the winning line over the board
     if(RoundFinished)
     {
         SymbolAlpha = (AlphaDirection) ? SymbolAlpha + SYMBOL_ALPHA_STEP : SymbolAlpha - SYMBOL_ALPHA_STEP;
@@ -347,52 +676,35 @@ void Game::GameScreen(bool CopyScreen)
         {
             AlphaDirection = !AlphaDirection;
         }
-    }
 
-    for(u8 x = 0; x < 3; ++x)
-    {
-        for(u8 y = 0; y < 3; ++y)
+        for(u8 x = 0; x < 3; ++x)
         {
-            GridSign[x][y].SetPlayer(GameGrid->GetPlayerAtPos(x, y));
-            GridSign[x][y].SetColor(0xFFFFFFFF);
-            GridSign[x][y].Paint();
-            if(GameGrid->IsWinningPosition(x, y))
+            for(u8 y = 0; y < 3; ++y)
             {
-                GridSign[x][y].SetColor(HoverColor);
-                GridSign[x][y].SetAlpha(SymbolAlpha);
-                GridSign[x][y].Paint();
+                if(GameGrid->IsWinningPosition(x, y))
+                {
+                    GridSign[x][y].SetColor(HoverColor);
+                    GridSign[x][y].SetAlpha(SymbolAlpha);
+                    GridSign[x][y].Paint();
+                }
             }
         }
     }
 
-    if(SelectZone())
+    if(HandX > -1 && GameGrid->GetPlayerAtPos(HandX, HandY) == ' ')
+    {   // Draw selection box
+        const auto& [hoverX, hoverY] = Table[HandX][HandY];
+        HoverImg->Draw(hoverX, hoverY, 0, 1, 1, HoverColor);
+    }
+
+    // 40 = radius, 52 = half of image size
+    if(FocusedButton == 0)
     {
-        // Draw selection box
-        if(GameGrid->GetPlayerAtPos(HandX, HandY) == ' ')
-        {
-            const auto& [hoverX, hoverY] = Table[HandX][HandY];
-            HoverImg->Draw(hoverX, hoverY, 0, 1, 1, HoverColor);
-        }
+        GameHoverImg->Draw(HOME_CIRCLE_X-HOVER_IMAGE_OFFSET, HOME_CIRCLE_Y-HOVER_IMAGE_OFFSET, 0, 1, 1, 0xFFFFFFFF);
     }
-    else
+    else if(FocusedButton == 1)
     {
-        // 40 = radius, 52 = half of image size
-        if(PtInCircle(HOME_CIRCLE_X, HOME_CIRCLE_Y, HOVER_CIRCLE_RADIUS, Hand[0].GetLeft(), Hand[0].GetTop()))
-        {
-            GameHoverImg->Draw(HOME_CIRCLE_X-HOVER_IMAGE_OFFSET, HOME_CIRCLE_Y-HOVER_IMAGE_OFFSET, 0, 1, 1, 0xFFFFFFFF);
-            ButtonOn(0);
-            FocusedButton = 0;
-        }
-        else if(PtInCircle(MENU_CIRCLE_X, MENU_CIRCLE_Y, HOVER_CIRCLE_RADIUS, Hand[0].GetLeft(), Hand[0].GetTop()))
-        {
-            GameHoverImg->Draw(MENU_CIRCLE_X-HOVER_IMAGE_OFFSET, MENU_CIRCLE_Y-HOVER_IMAGE_OFFSET, 0, 1, 1, 0xFFFFFFFF);
-            ButtonOn(1);
-            FocusedButton = 1;
-        }
-        else
-        {
-            FocusedButton = -1;
-        }
+        GameHoverImg->Draw(MENU_CIRCLE_X-HOVER_IMAGE_OFFSET, MENU_CIRCLE_Y-HOVER_IMAGE_OFFSET, 0, 1, 1, 0xFFFFFFFF);
     }
 }
 
@@ -401,69 +713,28 @@ void Game::GameScreen(bool CopyScreen)
  */
 void Game::ExitScreen()
 {
-    GameAudio->PauseMusic(true);
-    if(Copied == false)
-    {   // Copy static element
-        switch(LastScreen)
-        {
-            case gameScreen::Game:
-                GameScreen(false);
-                break;
-            case gameScreen::Menu:
-                MenuScreen(false);
-                break;
-            default:
-                break;
-        }
-
-        Rectangle(0, 0, ScreenWidth, ScreenHeight, HOME_OVERLAY_COLOR, 1); // Draw a black rectangle over it
-        Rectangle(0, HOME_SEPARATOR_TOP, ScreenWidth, HOME_SEPARATOR_HEIGHT, HOME_SEPARATOR_COLOR, 1);
-        Rectangle(0, HOME_SEPARATOR_BOTTOM, ScreenWidth, HOME_SEPARATOR_HEIGHT, HOME_SEPARATOR_COLOR, 1);
-        Rectangle(0, HOME_BOTTOM_BAR_TOP, ScreenWidth, HOME_BOTTOM_BAR_HEIGHT, HOME_BAR_COLOR, 1);
-
-        CopiedImg->CopyScreen();
-        Copied = true;
-    }
-    else
-    {
-        CopiedImg->Draw(0, 0);
+    GameAudio->SetMuffled(true);
+    if(HomeSource != nullptr && HomeSource->IsDirty())
+    {   // The screen under the HOME screen changed
+        HomeSource->Update();
+        HomeLayers->InvalidateAll();
     }
-
-    if(GRRLIB_PtInRect(0, 0, ScreenWidth, HOME_TOP_BAR_HEIGHT, Hand[0].GetLeft(), Hand[0].GetTop()))
-    {
-        Rectangle(0, 0, ScreenWidth, HOME_TOP_BAR_HEIGHT, HOME_HIGHLIGHT_COLOR, 1);
-    }
-    else
-    {
-        Rectangle(0, 0, ScreenWidth, HOME_TOP_BAR_HEIGHT, HOME_BAR_COLOR, 1);
+    HomeLayers->Paint();
+
+    const bool BarFocused = FocusedButton == 0;
+    if(BarFocused != HomeBarFocused)
+    {   // Texts on the top bar must be rendered over the new color
+        HomeBarFocused = BarFocused;
+        HomeTitleLabel->Invalidate();
+        ExitButton[0]->Invalidate();
     }
+    Rectangle(0, 0, ScreenWidth, HOME_TOP_BAR_HEIGHT, BarFocused ? HOME_HIGHLIGHT_COLOR : HOME_BAR_COLOR, 1);
 
-    GRRLIB_PrintfTTF(HOME_TITLE_LEFT, HOME_TITLE_TOP, DefaultFont, Lang->String("HOME Menu").c_str(), HOME_TITLE_FONT_SIZE, 0xFFFFFFFF);
+    HomeTitleLabel->Paint();
 
-    ExitButton[0]->SetFocused(false);
-    ExitButton[1]->SetFocused(false);
-    ExitButton[2]->SetFocused(false);
-    if(GRRLIB_PtInRect(0, 0, ScreenWidth, HOME_TOP_BAR_HEIGHT, Hand[0].GetLeft(), Hand[0].GetTop()))
-    {
-        ExitButton[0]->SetFocused(true);
-        ButtonOn(0);
-        FocusedButton = 0;
-    }
-    else if(ExitButton[1]->IsInside(Hand[0].GetLeft(), Hand[0].GetTop()))
-    {
-        ExitButton[1]->SetFocused(true);
-        ButtonOn(1);
-        FocusedButton = 1;
-    }
-    else if(ExitButton[2]->IsInside(Hand[0].GetLeft(), Hand[0].GetTop()))
-    {
-        ExitButton[2]->SetFocused(true);
-        ButtonOn(2);
-        FocusedButton = 2;
-    }
-    else
+    for(s8 i = 0; i < 3; ++i)
     {
-        FocusedButton = -1;
+        ExitButton[i]->SetFocused(i == FocusedButton);
     }
 
     ExitButton[0]->Paint();
@@ -473,54 +744,14 @@ void Game::ExitScreen()
 
 /**
  * Draw the menu screen.
- * @param[in] CopyScreen If true the screen is copied to a buffer.
  */
-void Game::MenuScreen(bool CopyScreen)
+void Game::MenuScreen()
 {
-    if(!Copied)
-    {   // Copy static element
-        FillScreen(0x000000FF); // Clear screen
-        DrawStripeBackground(MENU_STRIPE_COLOR, MENU_STRIPE_SPACING, MENU_STRIPE_THICKNESS);
-
-        Rectangle(0, 0, ScreenWidth, MENU_TOP_BAR_HEIGHT, MENU_BAR_COLOR, 1);
-        Rectangle(0, MENU_SEPARATOR_TOP, ScreenWidth, MENU_STRIPE_THICKNESS, MENU_SEPARATOR_COLOR, 1);
-        Rectangle(0, MENU_SEPARATOR_BOTTOM, ScreenWidth, MENU_STRIPE_THICKNESS, MENU_SEPARATOR_COLOR, 1);
-        Rectangle(0, HOME_BOTTOM_BAR_TOP, ScreenWidth, HOME_BOTTOM_BAR_HEIGHT, MENU_BAR_COLOR, 1);
-
-        GRRLIB_PrintfTTF(MENU_VERSION_LEFT, MENU_VERSION_TOP, DefaultFont,
-            std::format(std::runtime_format(Lang->String("Ver. {}")), "1.1.0").c_str(),
-            MENU_VERSION_FONT_SIZE, 0xFFFFFFFF);
-
-        if(CopyScreen)
-        {
-            CopiedImg->CopyScreen();
-            Copied = true;
-        }
-    }
-    else
-    {
-        CopiedImg->Draw(0, 0);
-    }
-
-    for(int i = 0; i < 3; ++i)
-    {
-        MenuButton[i]->SetFocused(false);
-    }
-
-    for(int i = 0; i < 3; ++i)
-    {
-        if(MenuButton[i]->IsInside(Hand[0].GetLeft(), Hand[0].GetTop()))
-        {
-            MenuButton[i]->SetFocused(true);
-            ButtonOn(i);
-            FocusedButton = i;
-            break;
-        }
-    }
+    MenuLayers->Paint();
 
-    if(FocusedButton == -1)
+    for(s8 i = 0; i < 3; ++i)
     {
-        FocusedButton = -1;
+        MenuButton[i]->SetFocused(i == FocusedButton);
     }
 
     for(int i = 0; i < 3; ++i)
@@ -543,192 +774,519 @@ void Game::DrawStripeBackground(u32 color, u32 spacing, u32 thickness)
     }
 }
 
+/**
+ * Handlers called on every screen: the pointers and the shortcuts.
+ */
+const Game::ScreenInput Game::AnyScreenInput = {
+    {
+        &Game::PressAnyScreen,  // Press
+        nullptr,                // Release
+        &Game::MovePointer,     // PointerMove
+        nullptr,                // ZoneEnter
+        nullptr                 // ZoneLeave
+    },
+    nullptr
+};
+
+/**
+ * Handlers of each screen, in the order of gameScreen.
+ */
+const std::array<Game::ScreenInput, 4> Game::ScreenInputs = {{
+    {   // Start
+        {&Game::PressStart, nullptr, nullptr, nullptr, nullptr},
+        nullptr
+    },
+    {   // Game
+        {&Game::PressGame, nullptr, nullptr, &Game::EnterGameZone, &Game::LeaveGameZone},
+        &Game::FindGameZone
+    },
+    {   // Home
+        {&Game::PressHome, nullptr, nullptr, &Game::EnterButton, &Game::LeaveButton},
+        &Game::FindHomeZone
+    },
+    {   // Menu
+        {&Game::PressMenu, nullptr, nullptr, &Game::EnterButton, &Game::LeaveButton},
+        &Game::FindMenuZone
+    }
+}};
+
 /**
  * Controls all inputs.
+ * The changes of the Wii Remotes are turned into events, handled by the
+ * tables of the current screen, so a frame without input costs nothing.
  * @return True to exit to loader, false otherwise.
  */
 bool Game::ControllerManager()
 {
     RUMBLE_Verify();
-    WPADData *WPadData[4] = {
-        WPAD_Data(WPAD_CHAN_0),
-        WPAD_Data(WPAD_CHAN_1),
-        WPAD_Data(WPAD_CHAN_2),
-        WPAD_Data(WPAD_CHAN_3)
-    };
 
-    const u32 Buttons[4] = {
-        WPadData[0]->btns_d,
-        WPadData[1]->btns_d,
-        WPadData[2]->btns_d,
-        WPadData[3]->btns_d
-    };
+    Events.Scan(Pads.GetPads());
+    if(DispatchEvents())
+    {
+        return true;
+    }
 
-    for(int i = 0; i < 4; ++i)
+    // The zones under the pointers at their new position; a zone also
+    // appears or goes away without moving, when a turn ends for instance
+    const ScreenInput &Screen = ScreenInputs[static_cast<u8>(CurrentScreen)];
+    std::array<s8, MAX_PADS> Zones;
+    for(u8 Chan = 0; Chan < MAX_PADS; ++Chan)
     {
-        if(WPadData[i]->ir.valid)
+        Zones[Chan] = (Screen.FindZone != nullptr) ? (this->*Screen.FindZone)(Chan) : InputQueue::NO_ZONE;
+    }
+    Events.SetZones(Zones);
+    return DispatchEvents();
+}
+
+/**
+ * Handle the queued input events.
+ * @return True to exit to loader, false otherwise.
+ */
+bool Game::DispatchEvents()
+{
+    InputEvent Event;
+    while(Events.Pop(Event))
+    {
+        const auto Type = static_cast<size_t>(Event.What);
+        const InputHandler AnyHandler = AnyScreenInput.Handlers[Type];
+        if(AnyHandler != nullptr && (this->*AnyHandler)(Event))
         {
-            Hand[i].SetLeft((WPadData[i]->ir.x / ScreenWidth * (ScreenWidth + Hand[i].GetWidth() * 2)) - Hand[i].GetWidth());
-            Hand[i].SetTop((WPadData[i]->ir.y / ScreenHeight * (ScreenHeight + Hand[i].GetHeight() * 2)) - Hand[i].GetHeight());
-            Hand[i].SetAngle(WPadData[i]->orient.roll);
-            Hand[i].SetVisible(true);
+            return true;
         }
-        else
+        // Looked up for each event, a handler may change the screen
+        const InputHandler ScreenHandler = ScreenInputs[static_cast<u8>(CurrentScreen)].Handlers[Type];
+        if(ScreenHandler != nullptr && (this->*ScreenHandler)(Event))
         {
-            Hand[i].SetVisible(false);
+            return true;
         }
     }
+    return false;
+}
+
+/**
+ * Handle the shortcuts available on every screen, from any Wii Remote.
+ * @param[in] Event The button pressed.
+ * @return Always false.
+ */
+bool Game::PressAnyScreen(const InputEvent &Event)
+{
+    const PadState &Pad = Pads.GetPad(Event.Chan);
+    constexpr u32 ScreenShotButtons = WPAD_BUTTON_1 | WPAD_BUTTON_2;
 
-    if(Buttons[0] || Buttons[1])
+    switch(Event.Button)
     {
-        switch(CurrentScreen)
-        {
-            case gameScreen::Start:
-                if(Buttons[0] & WPAD_BUTTON_A)
+        case WPAD_BUTTON_1:
+        case WPAD_BUTTON_2:
+            if((Pad.Held & ScreenShotButtons) == ScreenShotButtons)
+            {   // Hold 1 and 2, only once when both are pressed in the same frame
+                if(Event.Button != std::bit_floor(Pad.Down & ScreenShotButtons))
                 {
-                    ChangeScreen(gameScreen::Menu);
+                    break;
                 }
-                break;
-            case gameScreen::Menu:
-                if(Buttons[0] & WPAD_BUTTON_A)
-                {
-                    switch(FocusedButton)
-                    {
-                        case 0:
-                            WTTPlayer[1].SetType(playerType::Human);
-                            GameMode = gameMode::VsHuman1;
-                            ChangeScreen(gameScreen::Game);
-                            break;
-                        case 1:
-                            WTTPlayer[1].SetType(playerType::CPU);
-                            GameMode = gameMode::VsAI;
-                            ChangeScreen(gameScreen::Game);
-                            break;
-                        case 2:
-                            WTTPlayer[1].SetType(playerType::Human);
-                            GameMode = gameMode::VsHuman2;
-                            ChangeScreen(gameScreen::Game);
-                            break;
-                    }
-                }
-                else if(Buttons[0] & WPAD_BUTTON_B)
-                {
-                    ChangeScreen(gameScreen::Start);
-                }
-                else if(Buttons[0] & WPAD_BUTTON_HOME || Buttons[1] & WPAD_BUTTON_HOME)
-                {
-                    ChangeScreen(gameScreen::Home);
-                }
-                break;
-            case gameScreen::Home:
-                if(Buttons[0] & WPAD_BUTTON_HOME || Buttons[1] & WPAD_BUTTON_HOME)
+                WPAD_Rumble(WPAD_CHAN_ALL, 1); // Rumble on
+                WIILIGHT_TurnOn();
+
+                const auto now = std::chrono::time_point_cast<std::chrono::seconds>(std::chrono::system_clock::now());
+                const auto path = std::format("sd:/Screenshot {:%F %H%M%S}.png", now);
+
+                text = (ScreenShot(path)) ? "A screenshot was taken!!!" : "Screenshot did not work!!!";
+
+                WIILIGHT_TurnOff();
+                WPAD_Rumble(WPAD_CHAN_ALL, 0); // Rumble off
+                UpdateLabels();
+            }
+            else if(Pad.Held & WPAD_BUTTON_B && Event.Button == WPAD_BUTTON_2)
+            {   // Hold B and press 2 to save the last events
+                const auto now = std::chrono::time_point_cast<std::chrono::seconds>(std::chrono::system_clock::now());
+                const auto path = std::format("sd:/Trace {:%F %H%M%S}.json", now);
+
+                text = (Trace::Save(path.c_str())) ? "A trace was saved!!!" : "Trace did not work!!!";
+                UpdateLabels();
+            }
+            else if(Pad.Held & WPAD_BUTTON_B)
+            {   // Hold B and press 1 to save the memory usage
+                const auto now = std::chrono::time_point_cast<std::chrono::seconds>(std::chrono::system_clock::now());
+                const auto path = std::format("sd:/Memory {:%F %H%M%S}.txt", now);
+
+                std::FILE *File = std::fopen(path.c_str(), "w");
+                if(File != nullptr)
                 {
-                    GameAudio->PauseMusic(false);
-                    ChangeScreen(LastScreen);
+                    MemTrack::Dump(File);
                 }
-                else if(Buttons[0] & WPAD_BUTTON_A)
-                {
-                    switch(FocusedButton)
-                    {
-                        case 0:
-                            GameAudio->PauseMusic(false);
-                            ChangeScreen(LastScreen);
-                            break;
-                        case 1:
-                            NewGame();
-                            break;
-                        case 2:
-                            ExitScreen();
-                            Hand[3].Paint();
-                            Hand[2].Paint();
-                            Hand[1].Paint();
-                            Hand[0].Paint();
-                            CopiedImg->CopyScreen();
-                            WPAD_Rumble(WPAD_CHAN_ALL, 0); // Rumble off, just in case
-                            Draw_FadeOut(CopiedImg.get(), 1, 1, 3);
-                            return true; // Exit to loader
-                    }
+                text = (File != nullptr && std::fclose(File) == 0) ? "Memory usage was saved!!!" : "Memory dump did not work!!!";
+                UpdateLabels();
+            }
+            break;
+        case WPAD_BUTTON_PLUS:
+            if(Pad.Held & WPAD_BUTTON_B)
+            {   // Hold B and press PLUS to reload the language file from the SD card
+                const bool Loaded = Lang->Reload();
+                ApplyLanguage();
+                if(!Lang->GetError().empty())
+                {   // Malformed, or some texts cannot be drawn
+                    text = Lang->GetError();
                 }
-                break;
-            default:
-                if(Buttons[0] & WPAD_BUTTON_HOME || Buttons[1] & WPAD_BUTTON_HOME)
+                else
                 {
-                    ChangeScreen(gameScreen::Home);
+                    text = Loaded ? "The language file was loaded!!!" : "No language file was found!!!";
                 }
+                UpdateLabels();
+            }
+            else
+            {
+                ShowFPS = !ShowFPS;
+            }
+            break;
+        case WPAD_BUTTON_MINUS:
+            Overlay = static_cast<overlayPage>((static_cast<u8>(Overlay) + 1) % static_cast<u8>(overlayPage::Count));
+            break;
+    }
+    return false;
+}
 
-                if(Buttons[0] & WPAD_BUTTON_A)
-                {
-                    if(FocusedButton > -1)
-                    {
-                        ChangeScreen(gameScreen::Home);
-                    }
-                    else if(RoundFinished)
-                    {
-                        Clear();
-                    }
-                    else if(GameMode == gameMode::VsHuman2 && CurrentPlayer == 0)
-                    {
-                        if(GameGrid->SetPlayer(WTTPlayer[0].GetSign(), HandX, HandY))
-                        {
-                            TurnIsOver();
-                        }
-                        else
-                        {   // Position is invalid
-                            RUMBLE_Wiimote(WPAD_CHAN_0, RUMBLE_INVALID_MOVE);
-                        }
-                    }
-                    else if(GameGrid->SetPlayer(WTTPlayer[CurrentPlayer].GetSign(), HandX, HandY))
-                    {
-                        TurnIsOver();
-                    }
-                    else
-                    {
-                        RUMBLE_Wiimote(WPAD_CHAN_0, RUMBLE_INVALID_MOVE);
-                    }
-                }
+/**
+ * Move the cursor of a Wii Remote.
+ * @param[in] Event The new position of the pointer.
+ * @return Always false.
+ */
+bool Game::MovePointer(const InputEvent &Event)
+{
+    Cursor &Pointer = Hand[Event.Chan];
+    if(Event.Pointing)
+    {
+        Pointer.SetLeft((Event.X / ScreenWidth * (ScreenWidth + Pointer.GetWidth() * 2)) - Pointer.GetWidth());
+        Pointer.SetTop((Event.Y / ScreenHeight * (ScreenHeight + Pointer.GetHeight() * 2)) - Pointer.GetHeight());
+        Pointer.SetAngle(Event.Roll);
+        Pointer.SetVisible(true);
+    }
+    else
+    {
+        Pointer.SetVisible(false);
+    }
+    return false;
+}
 
-                if(Buttons[1] & WPAD_BUTTON_A && GameMode == gameMode::VsHuman2 && !RoundFinished)
-                {
-                    if(GameGrid->SetPlayer(WTTPlayer[1].GetSign(), HandX, HandY))
-                    {
-                        TurnIsOver();
-                    }
-                    else
-                    {   // Position is invalid
-                        RUMBLE_Wiimote(WPAD_CHAN_1, RUMBLE_INVALID_MOVE);
-                    }
-                }
-                break;
+/**
+ * Handle a button pressed on the start screen.
+ * @param[in] Event The button pressed.
+ * @return Always false.
+ */
+bool Game::PressStart(const InputEvent &Event)
+{
+    if(Event.Chan == MENU_CHAN && Event.Button == WPAD_BUTTON_A)
+    {
+        ChangeScreen(gameScreen::Menu);
+    }
+    return false;
+}
+
+/**
+ * Handle a button pressed on the menu screen.
+ * @param[in] Event The button pressed.
+ * @return Always false.
+ */
+bool Game::PressMenu(const InputEvent &Event)
+{
+    if(Event.Button == WPAD_BUTTON_HOME && Event.Chan < HOME_CHANS)
+    {
+        ChangeScreen(gameScreen::Home);
+        return false;
+    }
+    if(Event.Chan != MENU_CHAN)
+    {
+        return false;
+    }
+
+    switch(Event.Button)
+    {
+        case WPAD_BUTTON_A:
+            switch(FocusedButton)
+            {
+                case 0:
+                    WTTPlayer[1].SetType(playerType::Human);
+                    GameMode = gameMode::VsHuman1;
+                    ChangeScreen(gameScreen::Game);
+                    break;
+                case 1:
+                    WTTPlayer[1].SetType(playerType::CPU);
+                    GameMode = gameMode::VsAI;
+                    ChangeScreen(gameScreen::Game);
+                    break;
+                case 2:
+                    WTTPlayer[1].SetType(playerType::Human);
+                    GameMode = gameMode::VsHuman2;
+                    ChangeScreen(gameScreen::Game);
+                    break;
+            }
+            break;
+        case WPAD_BUTTON_B:
+            ChangeScreen(gameScreen::Start);
+            break;
+        case WPAD_BUTTON_LEFT:
+        case WPAD_BUTTON_RIGHT:
+            // Previous or next language
+            Lang->SelectNext((Event.Button == WPAD_BUTTON_LEFT) ? -1 : 1);
+            ApplyLanguage();
+            break;
+    }
+    return false;
+}
+
+/**
+ * Handle a button pressed on the HOME screen.
+ * @param[in] Event The button pressed.
+ * @return True to exit to loader, false otherwise.
+ */
+bool Game::PressHome(const InputEvent &Event)
+{
+    if(Event.Button == WPAD_BUTTON_HOME && Event.Chan < HOME_CHANS)
+    {
+        GameAudio->SetMuffled(false);
+        ChangeScreen(LastScreen);
+        return false;
+    }
+    if(Event.Chan != MENU_CHAN || Event.Button != WPAD_BUTTON_A)
+    {
+        return false;
+    }
+
+    switch(FocusedButton)
+    {
+        case 0:
+            GameAudio->SetMuffled(false);
+            ChangeScreen(LastScreen);
+            break;
+        case 1:
+            NewGame();
+            break;
+        case 2:
+        {
+            ExitScreen();
+            Hand[3].Paint();
+            Hand[2].Paint();
+            Hand[1].Paint();
+            Hand[0].Paint();
+            auto LastFrame = std::make_unique<Texture>(ScreenWidth, ScreenHeight);
+            LastFrame->CopyScreen();
+            WPAD_Rumble(WPAD_CHAN_ALL, 0); // Rumble off, just in case
+            Draw_FadeOut(LastFrame.get(), 1, 1, 3);
+            return true; // Exit to loader
         }
     }
+    return false;
+}
 
-    if((WPadData[0]->btns_h & WPAD_BUTTON_1 && WPadData[0]->btns_h & WPAD_BUTTON_2) ||
-       (WPadData[1]->btns_h & WPAD_BUTTON_1 && WPadData[1]->btns_h & WPAD_BUTTON_2) ||
-       (WPadData[2]->btns_h & WPAD_BUTTON_1 && WPadData[2]->btns_h & WPAD_BUTTON_2) ||
-       (WPadData[3]->btns_h & WPAD_BUTTON_1 && WPadData[3]->btns_h & WPAD_BUTTON_2))
+/**
+ * Handle a button pressed on the game screen.
+ * @param[in] Event The button pressed.
+ * @return Always false.
+ */
+bool Game::PressGame(const InputEvent &Event)
+{
+    if(Event.Button == WPAD_BUTTON_HOME && Event.Chan < HOME_CHANS)
+    {
+        ChangeScreen(gameScreen::Home);
+        return false;
+    }
+    if(Event.Button != WPAD_BUTTON_A)
     {
-        WPAD_Rumble(WPAD_CHAN_ALL, 1); // Rumble on
-        WIILIGHT_TurnOn();
+        return false;
+    }
 
-        const auto now = std::chrono::time_point_cast<std::chrono::seconds>(std::chrono::system_clock::now());
-        const auto path = std::format("sd:/Screenshot {:%F %H%M%S}.png", now);
+    if(Event.Chan == MENU_CHAN && FocusedButton > -1)
+    {
+        ChangeScreen(gameScreen::Home);
+    }
+    else if(RoundFinished)
+    {
+        if(Event.Chan == MENU_CHAN)
+        {
+            Clear();
+        }
+    }
+    else if(Event.Chan == GetPlayerChan(CurrentPlayer) &&
+        GameGrid->SetPlayer(WTTPlayer[CurrentPlayer].GetSign(), HandX, HandY))
+    {
+        TurnIsOver();
+    }
+    else if(Event.Chan == GetPlayerChan(0) || Event.Chan == GetPlayerChan(1))
+    {   // Position is invalid, or not the turn of this Wii Remote
+        RUMBLE_Wiimote(Event.Chan, RUMBLE_INVALID_MOVE);
+    }
+    return false;
+}
 
-        text = (ScreenShot(path)) ? "A screenshot was taken!!!" : "Screenshot did not work!!!";
+/**
+ * Focus the button entered by the pointer, on the menu and HOME screens.
+ * @param[in] Event The zone entered, the index of the button.
+ * @return Always false.
+ */
+bool Game::EnterButton(const InputEvent &Event)
+{
+    ButtonOn(Event.Zone, Event.Chan);
+    return false;
+}
 
-        WIILIGHT_TurnOff();
-        WPAD_Rumble(WPAD_CHAN_ALL, 0); // Rumble off
-        Copied = false;
+/**
+ * Remove the focus from the button left by the pointer.
+ * @param[in] Event The zone left, the index of the button.
+ * @return Always false.
+ */
+bool Game::LeaveButton(const InputEvent &Event)
+{
+    if(FocusedButton == Event.Zone)
+    {
+        FocusedButton = -1;
     }
+    return false;
+}
 
-    if(Buttons[0] & WPAD_BUTTON_PLUS || Buttons[1] & WPAD_BUTTON_PLUS ||
-       Buttons[2] & WPAD_BUTTON_PLUS || Buttons[3] & WPAD_BUTTON_PLUS)
+/**
+ * Select the cell or focus the button entered by the pointer, on the game screen.
+ * @param[in] Event The zone entered, a cell or a button from GAME_BUTTON_ZONE.
+ * @return Always false.
+ */
+bool Game::EnterGameZone(const InputEvent &Event)
+{
+    if(Event.Zone >= GAME_BUTTON_ZONE)
     {
-        ShowFPS = !ShowFPS;
+        ButtonOn(Event.Zone - GAME_BUTTON_ZONE, Event.Chan);
+        return false;
     }
 
+    HandX = Event.Zone / 3;
+    HandY = Event.Zone % 3;
+    if(GameGrid->GetPlayerAtPos(HandX, HandY) == ' ')
+    {   // Zone is empty, the sound comes from the side of the column
+        GameAudio->Play(SoundId::ButtonRollOver, 90, (HandX - 1) * 0.5f);
+        RUMBLE_Wiimote(Event.Chan, RUMBLE_ZONE_SELECT);
+    }
     return false;
 }
 
+/**
+ * Unselect the cell or the button left by the pointer, on the game screen.
+ * @param[in] Event The zone left.
+ * @return Always false.
+ */
+bool Game::LeaveGameZone(const InputEvent &Event)
+{
+    if(Event.Zone < GAME_BUTTON_ZONE)
+    {
+        HandX = -1;
+        HandY = -1;
+    }
+    else if(FocusedButton == Event.Zone - GAME_BUTTON_ZONE)
+    {
+        FocusedButton = -1;
+    }
+    return false;
+}
+
+/**
+ * Find the button under a pointer, on the menu screen.
+ * @param[in] Chan The Wii Remote channel.
+ * @return The index of the button, InputQueue::NO_ZONE if none.
+ */
+s8 Game::FindMenuZone(u8 Chan) const
+{
+    if(Chan != MENU_CHAN)
+    {
+        return InputQueue::NO_ZONE;
+    }
+    for(s8 i = 0; i < 3; ++i)
+    {
+        if(MenuButton[i]->IsInside(Hand[Chan].GetLeft(), Hand[Chan].GetTop()))
+        {
+            return i;
+        }
+    }
+    return InputQueue::NO_ZONE;
+}
+
+/**
+ * Find the button under a pointer, on the HOME screen.
+ * The whole top bar is the first button.
+ * @param[in] Chan The Wii Remote channel.
+ * @return The index of the button, InputQueue::NO_ZONE if none.
+ */
+s8 Game::FindHomeZone(u8 Chan) const
+{
+    if(Chan != MENU_CHAN)
+    {
+        return InputQueue::NO_ZONE;
+    }
+    if(PtInRect(0, 0, ScreenWidth, HOME_TOP_BAR_HEIGHT, Hand[Chan].GetLeft(), Hand[Chan].GetTop()))
+    {
+        return 0;
+    }
+    for(s8 i = 1; i < 3; ++i)
+    {
+        if(ExitButton[i]->IsInside(Hand[Chan].GetLeft(), Hand[Chan].GetTop()))
+        {
+            return i;
+        }
+    }
+    return InputQueue::NO_ZONE;
+}
+
+/**
+ * Find the zone under a pointer, on the game screen.
+ * The cells, numbered x * 3 + y, are zones for the Wii Remote of the
+ * current player while it can play, the HOME and menu buttons are zones
+ * for the Wii Remote pointing at the buttons.
+ * @param[in] Chan The Wii Remote channel.
+ * @return The zone, InputQueue::NO_ZONE if none.
+ */
+s8 Game::FindGameZone(u8 Chan) const
+{
+    const Cursor &Pointer = Hand[Chan];
+    if(!RoundFinished && AIThinkLoop == 0 && Chan == GetPlayerChan(CurrentPlayer))
+    {
+        for(s8 x = 0; x < 3; ++x)
+        {
+            for(s8 y = 0; y < 3; ++y)
+            {
+                const auto& [cellX, cellY] = Table[x][y];
+                if (Pointer.GetLeft() > cellX &&
+                    Pointer.GetLeft() < (cellX + GRID_CELL_WIDTH) &&
+                    Pointer.GetTop() > cellY &&
+                    Pointer.GetTop() < (cellY + GRID_CELL_HEIGHT))
+                {
+                    return x * 3 + y;
+                }
+            }
+        }
+    }
+    if(Chan == MENU_CHAN)
+    {
+        if(PtInCircle(HOME_CIRCLE_X, HOME_CIRCLE_Y, HOVER_CIRCLE_RADIUS, Pointer.GetLeft(), Pointer.GetTop()))
+        {
+            return GAME_BUTTON_ZONE;
+        }
+        if(PtInCircle(MENU_CIRCLE_X, MENU_CIRCLE_Y, HOVER_CIRCLE_RADIUS, Pointer.GetLeft(), Pointer.GetTop()))
+        {
+            return GAME_BUTTON_ZONE + 1;
+        }
+    }
+    return InputQueue::NO_ZONE;
+}
+
+/**
+ * Get the Wii Remote of a player.
+ * @param[in] Player The player, 0 or 1.
+ * @return The Wii Remote channel, -1 for the CPU.
+ */
+s8 Game::GetPlayerChan(u8 Player) const
+{
+    if(WTTPlayer[Player].GetType() == playerType::CPU)
+    {
+        return -1;
+    }
+    // Each player has a Wii Remote, or they share the first one
+    return (GameMode == gameMode::VsHuman2) ? Player : 0;
+}
+
 /**
  * Start a new round.
  */
@@ -737,9 +1295,8 @@ void Game::Clear()
     GameGrid->Clear();
     CurrentPlayer = PlayerToStart;
     PlayerToStart = !PlayerToStart; // Next other player will start
-    text = std::format(std::runtime_format(Lang->GetTurnOverMessage()), WTTPlayer[CurrentPlayer].GetName());
     RoundFinished = false;
-    Copied = false;
+    ShowRoundMessage();
     ChangeCursor();
 }
 
@@ -753,8 +1310,6 @@ void Game::TurnIsOver()
     {   // A winner is declare
         GameWinner = (GameWinner == WTTPlayer[0].GetSign()) ? 0 : 1;
         WTTPlayer[GameWinner].IncScore();
-        text = std::format(std::runtime_format(Lang->GetWinningMessage()),
-            WTTPlayer[GameWinner].GetName(), WTTPlayer[!GameWinner].GetName());
         RoundFinished = true;
         SymbolAlpha = SYMBOL_ALPHA_MIN;
         AlphaDirection = false;
@@ -762,25 +1317,48 @@ void Game::TurnIsOver()
     else if(GameGrid->IsFilled() == true)
     {   // Tie game
         ++TieGame;
-        text = Lang->GetTieMessage();
         RoundFinished = true;
     }
     else
     {
         CurrentPlayer = !CurrentPlayer; // Change player's turn
-        text = std::format(std::runtime_format(Lang->GetTurnOverMessage()), WTTPlayer[CurrentPlayer].GetName());
     }
 
-    Copied = false;
+    ShowRoundMessage();
     ChangeCursor();
 }
 
+/**
+ * Show the message of the round: whose turn it is, who won or a tie.
+ * A message is picked at random.
+ */
+void Game::ShowRoundMessage()
+{
+    const u8 GameWinner = GameGrid->GetWinner();
+    if(!RoundFinished)
+    {
+        text = Lang->GetTurnOverMessage().Render(MessageBuffer, {WTTPlayer[CurrentPlayer].GetName()});
+    }
+    else if(GameWinner != ' ')
+    {
+        const u8 Winner = (GameWinner == WTTPlayer[0].GetSign()) ? 0 : 1;
+        text = Lang->GetWinningMessage().Render(MessageBuffer,
+            {WTTPlayer[Winner].GetName(), WTTPlayer[!Winner].GetName()});
+    }
+    else
+    {
+        text = Lang->GetTieMessage();
+    }
+    UpdateLabels();
+}
+
 /**
  * Start a new game, initialize variables.
  */
 void Game::NewGame()
 {
     GameAudio->LoadMusic();
+    GameAudio->SetMuffled(false);
 
     PlayerToStart = rand() & 1; // 0 or 1
 
@@ -795,6 +1373,61 @@ void Game::NewGame()
     Clear();
 }
 
+/**
+ * Update the labels with the current scores and text.
+ * Only the layers of the labels that changed are painted again.
+ */
+void Game::UpdateLabels()
+{
+    auto SetScore = [this](u8 Index, u16 Score)
+    {
+        char ScoreText[MaxScoreLength] = {};
+        const auto Result = std::to_chars(ScoreText, ScoreText + MaxScoreLength, Score);
+        if(ScoreLabel[Index]->SetText(std::string_view(ScoreText, Result.ptr)))
+        {
+            GameLayers->Invalidate(ScoreLayer[Index]);
+        }
+    };
+    SetScore(0, WTTPlayer[0].GetScore());
+    SetScore(1, WTTPlayer[1].GetScore());
+    SetScore(2, TieGame);
+    if(MessageLabel->SetText(text))
+    {
+        GameLayers->Invalidate(MessageLayer);
+    }
+}
+
+/**
+ * Invalidate the cells that changed since the board layers were painted.
+ */
+void Game::SyncBoard()
+{
+    if(GameGrid->GetRevision() == BoardRevision)
+    {
+        return;
+    }
+    BoardRevision = GameGrid->GetRevision();
+
+    BoardFilled = 0;
+    for(u8 x = 0; x < 3; ++x)
+    {
+        for(u8 y = 0; y < 3; ++y)
+        {
+            const u8 Sign = GameGrid->GetPlayerAtPos(x, y);
+            if(Sign != BoardCells[x][y])
+            {
+                BoardCells[x][y] = Sign;
+                GridSign[x][y].SetPlayer(Sign);
+                GameLayers->Invalidate(Table[x][y].y, GRID_CELL_HEIGHT);
+            }
+            if(Sign != ' ')
+            {
+                ++BoardFilled;
+            }
+        }
+    }
+}
+
 /**
  * Print the text with multiple lines if needed.
  * @param[in] x Specifies the x-coordinate of the upper-left corner of the text.
@@ -811,53 +1444,21 @@ void Game::PrintWrapText(u16 x, u16 y, u16 maxLineWidth,
     std::string_view input, u32 fontSize, u32 TextColor,
     u32 ShadowColor, s8 OffsetX, s8 OffsetY)
 {
+    TRACE_SCOPE("Game::PrintWrapText");
     const int stepSize = static_cast<int>(fontSize * LINE_HEIGHT_MULTIPLIER);
     int ypos = y;
 
-    size_t lineStart = 0;
-    size_t lastSpace = 0;
-
-    // Add space to handle word boundary at end
-    std::string text(input);
-    text += ' ';
-
-    for (size_t i = 0; i < text.length(); ++i)
+    const auto& Layout = TextWrap->Wrap(input, fontSize, maxLineWidth);
+    for(const auto& Line : Layout.Lines)
     {
-        if (text[i] == ' ')
-        {
-            std::string_view word(text.data() + lineStart, i - lineStart);
-            const int wordWidth = GRRLIB_WidthTTF(DefaultFont, std::string(word).c_str(), fontSize);
-
-            if (wordWidth >= maxLineWidth && lineStart < i)
-            {
-                // Line is too wide, print accumulated text
-                text[lastSpace] = '\0';
-                const char* lineText = text.c_str() + lineStart;
-                const int textWidth = GRRLIB_WidthTTF(DefaultFont, lineText, fontSize);
-                const int textLeft = x + (maxLineWidth - textWidth) / 2;
-
-                // Draw shadow then text
-                GRRLIB_PrintfTTF(textLeft + OffsetX, ypos + OffsetY, DefaultFont, lineText,
-                    fontSize, ShadowColor);
-                GRRLIB_PrintfTTF(textLeft, ypos, DefaultFont, lineText, fontSize, TextColor);
-
-                lineStart = lastSpace + 1;
-                ypos += stepSize;
-            }
-            lastSpace = i;
-        }
-    }
+        const std::string_view lineText = Layout.GetText(Line);
+        const int textLeft = x + (maxLineWidth - Line.Width) / 2;
 
-    // Print remaining text
-    if (lineStart < text.length())
-    {
-        const char* lineText = text.c_str() + lineStart;
-        const int textWidth = GRRLIB_WidthTTF(DefaultFont, lineText, fontSize);
-        const int textLeft = x + (maxLineWidth - textWidth) / 2;
+        // Draw shadow then text
+        DefaultFont->Print(textLeft + OffsetX, ypos + OffsetY, lineText, fontSize, ShadowColor);
+        DefaultFont->Print(textLeft, ypos, lineText, fontSize, TextColor);
 
-        GRRLIB_PrintfTTF(textLeft + OffsetX, ypos + OffsetY, DefaultFont, lineText,
-            fontSize, ShadowColor);
-        GRRLIB_PrintfTTF(textLeft, ypos, DefaultFont, lineText, fontSize, TextColor);
+        ypos += stepSize;
     }
 }
 
@@ -870,10 +1471,13 @@ void Game::ChangeScreen(gameScreen NewScreen, bool PlaySound)
 {
     if(PlaySound)
     {
-        GameAudio->PlaySoundScreenChange(100);
+        GameAudio->Play(SoundId::ScreenChange, 100);
     }
 
     FocusedButton = -1;
+    HandX = -1;
+    HandY = -1;
+    Events.ClearZones(); // Entered again on the new screen
     LastScreen = CurrentScreen;
     CurrentScreen = NewScreen;
 
@@ -881,64 +1485,46 @@ void Game::ChangeScreen(gameScreen NewScreen, bool PlaySound)
     {
         ResetStartScreen();
     }
+    else if(NewScreen == gameScreen::Home)
+    {   // The HOME screen is built over the last screen
+        switch(LastScreen)
+        {
+            case gameScreen::Game:
+                HomeSource = GameLayers.get();
+                break;
+            case gameScreen::Menu:
+                HomeSource = MenuLayers.get();
+                break;
+            default:
+                HomeSource = nullptr;
+                break;
+        }
+        HomeLayers->InvalidateAll();
+        HomeTitleLabel->Invalidate();
+        for(auto& ExitBtn : ExitButton)
+        {
+            ExitBtn->Invalidate();
+        }
+    }
 
-    Copied = false;
     ChangeCursor();
 }
 
 /**
- * Rumble if on button.
+ * Focus a button, with a sound and a rumble.
  * @param[in] NewFocusedButton New button to select.
+ * @param[in] Chan The Wii Remote pointing at it.
  */
-void Game::ButtonOn(s8 NewFocusedButton)
+void Game::ButtonOn(s8 NewFocusedButton, u8 Chan)
 {
     if(FocusedButton != NewFocusedButton)
     {
-        GameAudio->PlaySoundButton(80);
-        RUMBLE_Wiimote(WPAD_CHAN_0, RUMBLE_BUTTON_HOVER);
+        GameAudio->Play(SoundId::ButtonRollOver, 80);
+        RUMBLE_Wiimote(Chan, RUMBLE_BUTTON_HOVER);
+        FocusedButton = NewFocusedButton;
     }
 }
 
-/**
- * Check if a zone is selected.
- * @return true if in a zone, false otherwise.
- */
-bool Game::SelectZone()
-{
-    u8 HandID = (GameMode == gameMode::VsHuman2 && CurrentPlayer == 1) ? 1 : 0;
-
-    if(!RoundFinished && AIThinkLoop == 0)
-    {
-        for(s8 x = 0; x < 3; ++x)
-        {
-            for(s8 y = 0; y < 3; ++y)
-            {
-                const auto& [cellX, cellY] = Table[x][y];
-                if (Hand[HandID].GetLeft() > cellX &&
-                    Hand[HandID].GetLeft() < (cellX + GRID_CELL_WIDTH) &&
-                    Hand[HandID].GetTop() > cellY &&
-                    Hand[HandID].GetTop() < (cellY + GRID_CELL_HEIGHT))
-                {
-                    if(HandX != x || HandY != y)
-                    {
-                        HandX = x;
-                        HandY = y;
-                        if(GameGrid->GetPlayerAtPos(HandX, HandY) == ' ')
-                        {   // Zone is empty
-                            GameAudio->PlaySoundButton(90);
-                            RUMBLE_Wiimote(HandID, RUMBLE_ZONE_SELECT);
-                        }
-                    }
-                    return true;
-                }
-            }
-        }
-    }
-    HandX = -1;
-    HandY = -1;
-    return false;
-}
-
 /**
  * Change the cursor.
  */
@@ -20,12 +20,17 @@
 #include "player.h"
 #include "button.h"
 #include "symbol.h"
+#include "inputqueue.h"
 
 // Forward declarations
 class Grid;
 class Language;
 class Audio;
-struct GRRLIB_Font;
+class Font;
+class TextLayout;
+class TextLabel;
+class Compositor;
+class Input;
 
 /**
  * This is the main class of this project. This is where the magic happens.
@@ -34,12 +39,13 @@ struct GRRLIB_Font;
 class Game
 {
 public:
-    Game(u16 GameScreenWidth, u16 GameScreenHeight);
+    Game(u16 GameScreenWidth, u16 GameScreenHeight, const Input &GamePads, u32 Seed);
     Game(Game const&) = delete;
     ~Game();
     Game& operator=(Game const&) = delete;
     void Paint();
     bool ControllerManager();
+    [[nodiscard]] std::string GetState() const;
 private:
     /**
      * Types of game.
@@ -60,6 +66,16 @@ private:
         Menu    /**< Menu screen. */
     };
 
+    /**
+     * Diagnostic overlays, MINUS shows the next one.
+     */
+    enum class overlayPage : u8 {
+        None,    /**< No overlay. */
+        Profile, /**< Frame time of each phase. */
+        Memory,  /**< Memory used by each subsystem. */
+        Count    /**< Number of pages. */
+    };
+
     // Layout constants
     static constexpr f32 EXIT_BUTTON_HOME_LEFT = 430.0f;
     static constexpr f32 EXIT_BUTTON_HOME_TOP = 20.0f;
@@ -95,6 +111,8 @@ private:
     static constexpr f32 TIE_SCORE_TOP = 280.0f;
     static constexpr u32 SCORE_FONT_SIZE = 35;
     static constexpr f32 SCORE_SHADOW_OFFSET = 2.0f;
+    static constexpr u16 SCORE_WIDTH = 100;
+    static constexpr u16 SCORE_HEIGHT = 50;
 
     // Bottom text display
     static constexpr f32 BOTTOM_TEXT_LEFT = 130.0f;
@@ -105,6 +123,8 @@ private:
     static constexpr u32 BOTTOM_TEXT_SHADOW_COLOR = 0x111111FF;
     static constexpr s8 BOTTOM_TEXT_SHADOW_X = 1;
     static constexpr s8 BOTTOM_TEXT_SHADOW_Y = 1;
+    static constexpr u16 BOTTOM_TEXT_HEIGHT = 60;
+    static constexpr size_t BOTTOM_TEXT_BUFFER_SIZE = 256; // Bytes for a formatted message
 
     // Game hover circles (for home/menu button areas)
     static constexpr f32 HOME_CIRCLE_X = 65.0f;
@@ -176,29 +196,94 @@ private:
     static constexpr u32 FPS_TEXT_COLOR = 0xFFFFFFFF;     // White (Highlight)
     static constexpr u32 FPS_SHADOW_COLOR_2 = 0x808080FF; // Gray
 
+    // Profiler overlay
+    static constexpr f32 PROFILE_LEFT = 20.0f;
+    static constexpr f32 PROFILE_TOP = 20.0f;
+    static constexpr f32 PROFILE_WIDTH = 260.0f;
+    static constexpr f32 PROFILE_HEIGHT = 270.0f;
+    static constexpr f32 PROFILE_MARGIN = 10.0f;
+    static constexpr f32 PROFILE_LINE_HEIGHT = 14.0f;
+    static constexpr u32 PROFILE_FONT_SIZE = 12;
+    static constexpr f32 PROFILE_BAR_WIDTH = 2.0f;
+    static constexpr f32 PROFILE_GRAPH_HEIGHT = 60.0f;
+    static constexpr f32 PROFILE_GRAPH_RANGE = 33333.0f;  // Microseconds for the whole graph height
+    static constexpr f32 PROFILE_FRAME_BUDGET = 16667.0f; // Microseconds per frame at 60 Hz
+    static constexpr u32 PROFILE_BACK_COLOR = 0x000000C0;
+    static constexpr u32 PROFILE_TEXT_COLOR = 0xFFFFFFFF;
+    static constexpr u32 PROFILE_BUDGET_COLOR = 0xFFFFFFFF;
+
+    // Memory overlay, drawn in the same box as the profiler
+    static constexpr u32 MEMORY_OVER_BUDGET_COLOR = 0xE6313AFF;
+
     // Text wrapping
     static constexpr f32 LINE_HEIGHT_MULTIPLIER = 1.2f;
 
+    // Input
+    static constexpr u8 MENU_CHAN = 0; /**< The Wii Remote pointing at the buttons. */
+    static constexpr u8 HOME_CHANS = 2; /**< The Wii Remotes that open and close the HOME screen, from the first. */
+    static constexpr s8 GAME_BUTTON_ZONE = 9; /**< Zone of the HOME button of the game screen, after the cells; the menu button follows. */
+
+    /**
+     * Handler of an input event.
+     * @return true to exit to loader, false otherwise.
+     */
+    using InputHandler = bool (Game::*)(const InputEvent &Event);
+
+    /**
+     * Input handlers of a screen, indexed by event type, nullptr for the
+     * events it ignores, and how it finds the zone under a pointer.
+     */
+    struct ScreenInput
+    {
+        std::array<InputHandler, static_cast<size_t>(InputEvent::Type::Count)> Handlers;
+        s8 (Game::*FindZone)(u8 Chan) const;
+    };
+    static const ScreenInput AnyScreenInput; /**< Handlers called on every screen, before the ones of the screen. */
+    static const std::array<ScreenInput, 4> ScreenInputs; /**< Handlers of each screen, in the order of gameScreen. */
+
     void ResetStartScreen();
     void StartScreen();
-    void MenuScreen(bool CopyScreen);
-    void GameScreen(bool CopyScreen);
+    void MenuScreen();
+    void GameScreen();
     void ExitScreen();
     void Clear();
     void TurnIsOver();
+    void ShowRoundMessage();
+    void ApplyLanguage();
+    void BuildGameText();
+    void BuildSplash();
     void NewGame();
+    void UpdateLabels();
+    void SyncBoard();
+    void DrawProfile();
+    void DrawMemory();
     void PrintWrapText(u16 x, u16 y, u16 maxLineWidth, std::string_view input,
         u32 fontSize, u32 TextColor, u32 ShadowColor, s8 OffsetX, s8 OffsetY);
     void ChangeScreen(gameScreen NewScreen, bool PlaySound = true);
-    void ButtonOn(s8 NewFocusedButton);
-    bool SelectZone();
+    void ButtonOn(s8 NewFocusedButton, u8 Chan);
+    bool DispatchEvents();
+    bool PressAnyScreen(const InputEvent &Event);
+    bool MovePointer(const InputEvent &Event);
+    bool PressStart(const InputEvent &Event);
+    bool PressMenu(const InputEvent &Event);
+    bool PressHome(const InputEvent &Event);
+    bool PressGame(const InputEvent &Event);
+    bool EnterButton(const InputEvent &Event);
+    bool LeaveButton(const InputEvent &Event);
+    bool EnterGameZone(const InputEvent &Event);
+    bool LeaveGameZone(const InputEvent &Event);
+    [[nodiscard]] s8 FindMenuZone(u8 Chan) const;
+    [[nodiscard]] s8 FindHomeZone(u8 Chan) const;
+    [[nodiscard]] s8 FindGameZone(u8 Chan) const;
+    [[nodiscard]] s8 GetPlayerChan(u8 Player) const;
     void ChangeCursor();
     void CalculateFrameRate();
     void DrawStripeBackground(u32 color, u32 spacing, u32 thickness);
 
     std::array<Cursor, 4> Hand;
-    s8 HandX;
-    s8 HandY;
+    s8 HandX; /**< Column of the cell under the pointer of the current player, -1 if none. */
+    s8 HandY; /**< Row of the cell under the pointer of the current player, -1 if none. */
+    InputQueue Events; /**< Input events of the frame. */
 
     bool CurrentPlayer;
     bool PlayerToStart;
@@ -206,18 +291,21 @@ private:
     gameScreen CurrentScreen;
     gameScreen LastScreen;
     s8 FocusedButton;
-    std::string text;
+    std::string_view text;
+    std::array<char, BOTTOM_TEXT_BUFFER_SIZE> MessageBuffer{}; /**< Where translated messages are formatted. */
 
     // Start screen animation state
     f32 ArmRotation{0.0f};
     bool ArmDirection{false};
 
-    u16 TieGame;
+    u16 TieGame{0};
     bool RoundFinished;
 
     /* Initialize in the same order as in the constructor */
+    const Input &Pads; /**< State of the Wii Remotes, live or replayed. */
     u8 FPS;
     bool ShowFPS;
+    overlayPage Overlay;
     u8 FrameCount{0};
     u32 LastFrameTime{0};
 
@@ -230,7 +318,7 @@ private:
     bool AlphaDirection;
 
     u8 AIThinkLoop;
-    bool Copied;
+    bool HomeBarFocused{false};
 
     // AI timing constants
     static constexpr u8 AI_THINK_MIN_FRAMES = 20;
@@ -265,10 +353,30 @@ private:
     std::unique_ptr<Texture> SplashImg; /**< Splash screen texture. */
     std::unique_ptr<Texture> SplashArmImg; /**< Arm texture for splash screen. */
     std::unique_ptr<Texture> HoverImg; /**< Texture to put over a symbol when selected. */
-    std::unique_ptr<Texture> CopiedImg; /**< Texture to store a temporary copy of the screen. */
     std::unique_ptr<Texture> GameText; /**< Game text that does not change including background. */
 
-    GRRLIB_Font *DefaultFont;
+    std::unique_ptr<Font> DefaultFont; /**< Font used for every text. */
+    std::unique_ptr<TextLayout> TextWrap; /**< Line breaks of the wrapped texts. */
+    std::array<std::unique_ptr<TextLabel>, 3> ScoreLabel; /**< Scores of player 1, player 2 and tie games. */
+    std::unique_ptr<TextLabel> MessageLabel; /**< Text at the bottom of the game screen. */
+    std::unique_ptr<TextLabel> VersionLabel; /**< Version in the menu screen. */
+    std::unique_ptr<TextLabel> HomeTitleLabel; /**< Title of the HOME screen. */
+
+    std::unique_ptr<Compositor> GameLayers; /**< Static part of the game screen. */
+    std::unique_ptr<Compositor> MenuLayers; /**< Static part of the menu screen. */
+    std::unique_ptr<Compositor> HomeLayers; /**< Static part of the HOME screen. */
+    Compositor *HomeSource{nullptr}; /**< Layers of the screen under the HOME screen. */
+    std::array<u8, 3> ScoreLayer{};
+    u8 MessageLayer{0};
+    u8 VersionLayer{0};
+    bool GameTextDirty{false}; /**< GameText must be built again, for a new language. */
+    bool SplashDirty{false};   /**< SplashImg must be built again, for a new language. */
+
+    std::array<std::array<u8, 3>, 3> BoardCells{}; /**< Signs painted in the board layers. */
+    u32 BoardRevision{0}; /**< Grid revision painted in the board layers. */
+    u8 BoardFilled{0};     /**< Number of signs on the board. */
+    u8 BoardDraws{0};      /**< Signs painted again during the current frame. */
+    u8 BoardDrawsSaved{0}; /**< Draw calls avoided by the board layers during the last frame. */
 };
 //---------------------------------------------------------------------------
 #endif
@@ -0,0 +1,250 @@
+// source/glyphcache.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#include <algorithm>
+#include <cmath>
+#include "glyphcache.h"
+#include "trace.h"
+
+/**
+ * Frame counter, a cell drawn during the current frame cannot be replaced:
+ * the GPU reads the texture after every glyph of the frame was queued.
+ */
+static u32 CurrentFrame = 1;
+
+/**
+ * Constructor for the GlyphCache class.
+ * The cells are as large as the largest stored glyph, plus a pixel so
+ * filtering does not read the neighbour cell.
+ * @param[in] AData Font data generated by fontbake, it must outlive the cache.
+ * @param[in] ACellCount Number of glyphs kept at the same time.
+ */
+GlyphCache::GlyphCache(const FontData &AData, u16 ACellCount) :
+    Data(AData),
+    CellSize(4),
+    Columns(std::max<u16>(1, std::ceil(std::sqrt(static_cast<f32>(ACellCount))))),
+    Cells(ACellCount),
+    CellOfGlyph(AData.StoredGlyphCount, NO_CELL),
+    Cache(std::make_unique<Texture>())
+{
+    for(u32 i = 0; i < Data.StoredGlyphCount; ++i)
+    {
+        const FontGlyph &Glyph = Data.StoredGlyphs[i];
+        CellSize = std::max<u16>(CellSize, std::max(Glyph.Width, Glyph.Height) + 1);
+    }
+    CellSize = (CellSize + 3) & ~3; // Whole 4x4 tiles
+    Field.resize(CellSize * CellSize);
+
+    const u16 Rows = (ACellCount + Columns - 1) / Columns;
+    const u32 Width = Columns * CellSize;
+    const u32 Height = Rows * CellSize;
+    const std::vector<u8> Clear(Width * Height * 2, 0);
+    Cache->SetMemCategory(MemTrack::Category::Font);
+    Cache->LoadRaw(Clear.data(), Clear.size(), Width, Height, GX_TF_IA8);
+}
+
+/**
+ * Get the position of a stored glyph in the texture.
+ * The glyph is decompressed if it is not in the cache.
+ * @param[in] Index Index of the glyph in FontData::StoredGlyphs.
+ * @param[out] X Left of the glyph in the texture.
+ * @param[out] Y Top of the glyph in the texture.
+ * @return true if the glyph can be drawn, false if every cell was used in the frame.
+ */
+bool GlyphCache::Acquire(u32 Index, u16 &X, u16 &Y)
+{
+    u16 Slot = CellOfGlyph[Index];
+    if(Slot != NO_CELL)
+    {
+        ++Counters.Hits;
+        Unlink(Slot);
+    }
+    else
+    {
+        if(UsedCells < Cells.size())
+        {
+            Slot = UsedCells++;
+        }
+        else if(Cells[Tail].LastFrame == CurrentFrame)
+        {
+            ++Counters.Overflows;
+            return false;
+        }
+        else
+        {
+            Slot = Tail;
+            Unlink(Slot);
+            CellOfGlyph[Cells[Slot].Glyph] = NO_CELL;
+            ++Counters.Evictions;
+        }
+        ++Counters.Misses;
+        Cells[Slot].Glyph = Index;
+        CellOfGlyph[Index] = Slot;
+        Decompress(Index, (Slot % Columns) * CellSize, (Slot / Columns) * CellSize);
+    }
+    PushFront(Slot);
+    Cells[Slot].LastFrame = CurrentFrame;
+    X = (Slot % Columns) * CellSize;
+    Y = (Slot / Columns) * CellSize;
+    return true;
+}
+
+/**
+ * Decompress the field of a glyph into a cell.
+ * The whole cell is written, so nothing is left from the previous glyph.
+ * @return false if the data is corrupted, the cell is then left empty.
+ */
+bool GlyphCache::Decompress(u32 Glyph, u16 X, u16 Y)
+{
+    TRACE_SCOPE("GlyphCache::Decompress");
+    const FontGlyph &Metrics = Data.StoredGlyphs[Glyph];
+    const u8 *Source = Data.Store + Data.StoredOffsets[Glyph];
+    const u8 *End = Data.Store + Data.StoredOffsets[Glyph + 1];
+    const size_t Size = Metrics.Width * Metrics.Height;
+
+    // PackBits: 0-127 is followed by n + 1 literals, 129-255 by a byte repeated 257 - n times
+    size_t Length = 0;
+    bool Valid = true;
+    while(Source < End && Length < Size && Valid)
+    {
+        const u8 Header = *Source++;
+        if(Header < 128)
+        {
+            const size_t Count = Header + 1;
+            Valid = (Source + Count <= End && Length + Count <= Size);
+            if(Valid)
+            {
+                std::copy_n(Source, Count, Field.begin() + Length);
+                Source += Count;
+                Length += Count;
+            }
+        }
+        else if(Header > 128)
+        {
+            const size_t Count = 257 - Header;
+            Valid = (Source < End && Length + Count <= Size);
+            if(Valid)
+            {
+                std::fill_n(Field.begin() + Length, Count, *Source++);
+                Length += Count;
+            }
+        }
+    }
+    Valid = Valid && (Length == Size);
+
+    // Spread the rows to the width of a cell, from the end so nothing is overwritten before it is read
+    if(Valid)
+    {
+        for(s32 Row = CellSize - 1; Row >= 0; --Row)
+        {
+            for(s32 Column = CellSize - 1; Column >= 0; --Column)
+            {
+                Field[Row * CellSize + Column] = (Row < Metrics.Height && Column < Metrics.Width) ?
+                    Field[Row * Metrics.Width + Column] : 0;
+            }
+        }
+    }
+    else
+    {
+        std::fill(Field.begin(), Field.end(), 0);
+    }
+    Cache->SetAlphaRect(X, Y, CellSize, CellSize, Field.data());
+    return Valid;
+}
+
+/**
+ * Remove a cell from the least recently used list.
+ */
+void GlyphCache::Unlink(u16 Index)
+{
+    Cell &Item = Cells[Index];
+    if(Item.Previous != NO_CELL)
+    {
+        Cells[Item.Previous].Next = Item.Next;
+    }
+    else if(Head == Index)
+    {
+        Head = Item.Next;
+    }
+    if(Item.Next != NO_CELL)
+    {
+        Cells[Item.Next].Previous = Item.Previous;
+    }
+    else if(Tail == Index)
+    {
+        Tail = Item.Previous;
+    }
+    Item.Previous = Item.Next = NO_CELL;
+}
+
+/**
+ * Put a cell at the front of the least recently used list.
+ */
+void GlyphCache::PushFront(u16 Index)
+{
+    Cells[Index].Next = Head;
+    if(Head != NO_CELL)
+    {
+        Cells[Head].Previous = Index;
+    }
+    Head = Index;
+    if(Tail == NO_CELL)
+    {
+        Tail = Index;
+    }
+}
+
+/**
+ * Get the texture holding the cells.
+ * @return The IA8 texture, the distance is in the alpha channel.
+ */
+Texture& GlyphCache::GetTexture()
+{
+    return *Cache;
+}
+
+/**
+ * Get the number of glyphs the cache can hold.
+ * @return The number of cells.
+ */
+u16 GlyphCache::GetCellCount() const
+{
+    return Cells.size();
+}
+
+/**
+ * Get the number of cells holding a glyph.
+ * @return The number of used cells.
+ */
+u16 GlyphCache::GetUsedCells() const
+{
+    return UsedCells;
+}
+
+/**
+ * Get the counters of the cache.
+ * @return The counters.
+ */
+const GlyphCache::Stats& GlyphCache::GetStats() const
+{
+    return Counters;
+}
+
+/**
+ * Start a new frame, cells drawn before can be replaced again.
+ * It is called once the frame is shown.
+ */
+void GlyphCache::EndFrame()
+{
+    ++CurrentFrame;
+}
+
+// EOF
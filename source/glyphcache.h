@@ -0,0 +1,87 @@
+// source/glyphcache.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#ifndef GlyphCacheH
+#define GlyphCacheH
+//---------------------------------------------------------------------------
+
+#include <memory>
+#include <vector>
+#include "fontdata.h"
+#include "grrlib_class.h"
+
+/**
+ * Texture holding the stored glyphs of a font drawn recently.
+ * Stored glyphs are decompressed into a free cell the first time they are
+ * drawn, the least recently used one is replaced when every cell is taken.
+ * The memory used does not depend on the number of glyphs of the font.
+ * @author Crayon
+ */
+class GlyphCache
+{
+public:
+    /**
+     * Counters since the cache was created.
+     */
+    struct Stats
+    {
+        u32 Hits{0};       /**< Glyphs found in the cache. */
+        u32 Misses{0};     /**< Glyphs decompressed into the cache. */
+        u32 Evictions{0};  /**< Glyphs replaced by another one. */
+        u32 Overflows{0};  /**< Glyphs not drawn, every cell was used in the frame. */
+    };
+
+    GlyphCache(const FontData &AData, u16 ACellCount);
+    GlyphCache(GlyphCache const&) = delete;
+    ~GlyphCache() = default;
+    GlyphCache& operator=(GlyphCache const&) = delete;
+
+    bool Acquire(u32 Index, u16 &X, u16 &Y);
+    [[nodiscard]] Texture& GetTexture();
+    [[nodiscard]] u16 GetCellCount() const;
+    [[nodiscard]] u16 GetUsedCells() const;
+    [[nodiscard]] const Stats& GetStats() const;
+
+    static void EndFrame();
+private:
+    static constexpr u16 NO_CELL = 0xFFFF;
+
+    /**
+     * A cell of the texture, linked in least recently used order.
+     */
+    struct Cell
+    {
+        u32 Glyph{0};          /**< Index of the stored glyph in the cell. */
+        u32 LastFrame{0};      /**< Frame where the cell was last drawn. */
+        u16 Previous{NO_CELL}; /**< Cell used more recently. */
+        u16 Next{NO_CELL};     /**< Cell used less recently. */
+    };
+
+    const FontData &Data;
+    u16 CellSize;         /**< Width and height of a cell in pixels. */
+    u16 Columns;          /**< Number of cells on a row of the texture. */
+    std::vector<Cell> Cells;
+    std::vector<u16> CellOfGlyph; /**< Cell of each stored glyph, NO_CELL if not cached. */
+    std::vector<u8> Field;        /**< Decompressed field of a glyph. */
+    u16 Head{NO_CELL};    /**< Most recently used cell. */
+    u16 Tail{NO_CELL};    /**< Least recently used cell. */
+    u16 UsedCells{0};
+    Stats Counters;
+    std::unique_ptr<Texture> Cache;
+
+    void Unlink(u16 Index);
+    void PushFront(u16 Index);
+    bool Decompress(u32 Glyph, u16 X, u16 Y);
+};
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
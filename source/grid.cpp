@@ -14,12 +14,14 @@
 #include <algorithm> // For std::fill, std::copy
 #include <array> // For std::array
 #include "grid.h"
+#include "trace.h"
 
 /**
  * Constructor for the Grid class.
+ * @param[in] Seed Seed of the generator used by the AI.
  */
-Grid::Grid() :
-    Generator(std::random_device{}()),
+Grid::Grid(u32 Seed) :
+    Generator(Seed),
     Distribution(std::uniform_int_distribution<u8>(0, 2))
 {
     for(auto& row : WinningBoard)
@@ -42,6 +44,7 @@ bool Grid::SetPlayer(u8 Player, u8 X, u8 Y)
         (Player == 'X' || Player == 'O'))
     {
         Board[X][Y] = Player;
+        ++Revision;
         for(auto& row : WinningBoard)
         {
             row.fill(false);
@@ -61,6 +64,7 @@ bool Grid::SetPlayer(u8 Player, u8 X, u8 Y)
  */
 void Grid::SetPlayerAI(u8 Player)
 {
+    TRACE_SCOPE("Grid::SetPlayerAI");
     std::array<std::array<u8, 3>, 3> TestBoard;
 
     // Test win or block opponent's win
@@ -123,6 +127,17 @@ void Grid::Clear()
     {
         row.fill(' ');
     }
+    ++Revision;
+}
+
+/**
+ * Return the revision of the board.
+ * It can be compared with a previous value to know if the board changed.
+ * @return The revision number.
+ */
+u32 Grid::GetRevision() const
+{
+    return Revision;
 }
 
 /**
@@ -25,7 +25,7 @@
 class Grid
 {
 public:
-    Grid();
+    explicit Grid(u32 Seed);
     Grid(Grid const&) = delete;
     /**
      * Destructor for the Grid class.
@@ -39,6 +39,7 @@ public:
     void Clear();
     [[nodiscard]] bool IsFilled();
     [[nodiscard]] bool IsWinningPosition(u8 X, u8 Y) const;
+    [[nodiscard]] u32 GetRevision() const;
 private:
     // Win condition patterns: 8 winning lines, each with 3 positions [x][y]
     static constexpr std::array<std::array<std::pair<u8, u8>, 3>, 8> WinPatterns = {{
@@ -57,6 +58,7 @@ private:
 
     std::array<std::array<u8, 3>, 3> Board;
     u8 Winner;
+    u32 Revision{0}; /**< Incremented every time the board changes. */
     std::mt19937 Generator;
     std::uniform_int_distribution<u8> Distribution;
     std::array<std::array<bool, 3>, 3> WinningBoard; /**< A board filled with the winning position. */
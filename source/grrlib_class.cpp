@@ -9,7 +9,56 @@
 // it under the terms of the MIT License. A copy of the license is
 // located in the LICENSE file included with this distribution.
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
 #include "grrlib_class.h"
+#include "framearena.h"
+#include "glyphcache.h"
+#include "trace.h"
+
+/**
+ * The backend used by every texture and by the screen.
+ */
+static std::unique_ptr<RenderBackend> CurrentBackend;
+
+static Screen::ClipRect CurrentClip{}; /**< Rectangle given to ClipDrawing. */
+static bool Clipped{false};            /**< Drawing is restricted to CurrentClip. */
+
+/**
+ * Return the offset of a texel in an RGBA8 texture.
+ * Texels are stored in 4x4 tiles, the AR pairs of a tile come before its GB pairs.
+ * @param x Specifies the x-coordinate of the texel.
+ * @param y Specifies the y-coordinate of the texel.
+ * @param w Width of the texture.
+ * @return The offset of the alpha byte, the green byte is 32 bytes later.
+ */
+static inline u32 TexelOffset(u32 x, u32 y, u32 w)
+{
+    return (((y & ~3u) << 2) * w) + ((x & ~3u) << 4) + ((((y & 3) << 2) + (x & 3)) << 1);
+}
+
+/**
+ * Set the backend used to draw.
+ * It must be set before the screen is initialized and before any texture is loaded.
+ * @param Backend The new backend.
+ */
+void GRRLIBpp::SetRenderBackend(std::unique_ptr<RenderBackend> Backend)
+{
+    CurrentBackend = std::move(Backend);
+}
+
+/**
+ * Return the backend used to draw.
+ * @return The backend.
+ */
+RenderBackend& GRRLIBpp::GetRenderBackend()
+{
+    return *CurrentBackend;
+}
 
 /**
  * Constructor for the Texture class.
@@ -20,6 +69,8 @@ Texture::Texture() :
     _ScaleY(1.0f),
     _Angle(0.0f)
 {
+    w = 0;
+    h = 0;
     data = nullptr;
 }
 
@@ -70,7 +121,47 @@ Texture::Texture(const u32 w, const u32 h) : Texture()
  */
 Texture::~Texture()
 {
-    free(data);
+    Account(0);
+    FreeData();
+}
+
+/**
+ * Free the texels, unless the texture only points at them.
+ */
+void Texture::FreeData()
+{
+    if(_OwnsData)
+    {
+        free(data);
+    }
+    data = nullptr;
+    _OwnsData = true;
+}
+
+/**
+ * Report the size of the texels to MemTrack, replacing the previous size.
+ * @param Bytes Size of the texels, 0 when there are none.
+ */
+void Texture::Account(size_t Bytes)
+{
+    MemTrack::Remove(_TrackedCategory, _TrackedBytes);
+    _TrackedBytes = Bytes;
+    if(Bytes != 0)
+    {
+        MemTrack::Add(_TrackedCategory, Bytes);
+    }
+}
+
+/**
+ * Set the category the texels are reported under. By default it is Texture.
+ * @param Which The category.
+ */
+void Texture::SetMemCategory(MemTrack::Category Which)
+{
+    const size_t Bytes = _TrackedBytes;
+    Account(0);
+    _TrackedCategory = Which;
+    Account(Bytes);
 }
 
 /**
@@ -101,8 +192,10 @@ void Texture::Assign(GRRLIB_texImg *other)
     ofnormaltexx = other->ofnormaltexx;
     ofnormaltexy = other->ofnormaltexy;
 
-    free(data);
+    FreeData();
     data = other->data;
+    // Loaded images are RGBA8, padded to whole 4x4 tiles
+    Account(data != nullptr ? ((w + 3) & ~3u) * ((h + 3) & ~3u) * (format == GX_TF_IA8 ? 2 : 4) : 0);
 
     free(other);
 }
@@ -114,28 +207,14 @@ void Texture::Assign(GRRLIB_texImg *other)
  */
 void Texture::Load(const u8 *Buffer, const u32 Size)
 {
+    TRACE_SCOPE("Texture::Load");
     if(Buffer[0]==0x00 && Buffer[1]==0x20 && Buffer[2]==0xAF && Buffer[3]==0x30)
     {   // TPL file
         //Assign(GRRLIB_LoadTextureTPL(Buffer, 0));
     }
-    else if(Buffer[0]==0xFF && Buffer[1]==0xD8 && Buffer[2]==0xFF)
-    {   // JPEG image
-        if(Size > 0)
-        {
-            Assign(GRRLIB_LoadTextureJPGEx(Buffer, Size));
-        }
-        else
-        {
-            Assign(GRRLIB_LoadTextureJPG(Buffer));
-        }
-    }
-    else if(Buffer[0]=='B' && Buffer[1]=='M')
-    {   // Bitmap image
-        Assign(GRRLIB_LoadTextureBMP(Buffer));
-    }
     else
-    {   // PNG image
-        Assign(GRRLIB_LoadTexturePNG(Buffer));
+    {   // JPEG, Bitmap or PNG image
+        Assign(GetRenderBackend().LoadTexture(Buffer, Size));
     }
 }
 
@@ -145,8 +224,9 @@ void Texture::Load(const u8 *Buffer, const u32 Size)
  */
 std::unique_ptr<Texture> Texture::CreateFromPNG(const u8 *Buffer)
 {
+    TRACE_SCOPE("Texture::CreateFromPNG");
     auto texture = std::make_unique<Texture>();
-    texture->Assign(GRRLIB_LoadTexturePNG(Buffer));
+    texture->Assign(GetRenderBackend().LoadTexture(Buffer, 0));
     return texture;
 }
 
@@ -156,18 +236,15 @@ std::unique_ptr<Texture> Texture::CreateFromPNG(const u8 *Buffer)
  */
 void Texture::Load(const char *filename)
 {
-    u8 *mydata;
-
-    const int FileLength = GRRLIB_LoadFile(filename, &mydata);
-    if(FileLength <= 0)
+    TRACE_SCOPE("Texture::Load file");
+    std::ifstream File(filename, std::ios::binary);
+    const std::vector<u8> FileData{std::istreambuf_iterator<char>(File), std::istreambuf_iterator<char>()};
+    if(FileData.empty())
     {   // Loading the file failed
         return;
     }
 
-    Load(mydata, FileLength);
-
-    // Free up the buffer
-    free(mydata);
+    Load(FileData.data(), FileData.size());
 }
 
 /**
@@ -179,6 +256,77 @@ void Texture::Load(std::string_view filename)
     Load(std::string(filename).c_str());
 }
 
+/**
+ * Load a texture from texels already in a GX format.
+ * @param Buffer The texels, tiled as expected by GX.
+ * @param Size The size of the buffer in bytes.
+ * @param w Width of the texture.
+ * @param h Height of the texture.
+ * @param Format The GX texture format of the buffer, for example GX_TF_IA8.
+ */
+void Texture::LoadRaw(const u8 *Buffer, const u32 Size, const u32 w, const u32 h, const u8 Format)
+{
+    TRACE_SCOPE("Texture::LoadRaw");
+    // Delete texture if already filled
+    FreeData();
+
+    data = memalign(32, Size);
+    memcpy(data, Buffer, Size);
+    SetRaw(Size, w, h, Format);
+    Account(Size);
+}
+
+/**
+ * Use texels already in a GX format in place, without copying them.
+ * The texture does not free them, they must outlive it and must not be
+ * changed through it.
+ * @param Buffer The texels, tiled as expected by GX and 32-byte aligned.
+ * @param Size The size of the buffer in bytes.
+ * @param w Width of the texture.
+ * @param h Height of the texture.
+ * @param Format The GX texture format of the buffer, for example GX_TF_IA8.
+ */
+void Texture::UseRaw(const u8 *Buffer, const u32 Size, const u32 w, const u32 h, const u8 Format)
+{
+    TRACE_SCOPE("Texture::UseRaw");
+    FreeData();
+
+    data = const_cast<u8*>(Buffer);
+    _OwnsData = false;
+    SetRaw(Size, w, h, Format);
+    Account(0);
+}
+
+/**
+ * Set up the texture for the texels of data, then flush them.
+ * @param Size The size of the texels in bytes.
+ * @param w Width of the texture.
+ * @param h Height of the texture.
+ * @param Format The GX texture format of the texels.
+ */
+void Texture::SetRaw(const u32 Size, const u32 w, const u32 h, const u8 Format)
+{
+    this->w = w;
+    this->h = h;
+    format  = Format;
+    handlex = 0;
+    handley = 0;
+    offsetx = 0;
+    offsety = 0;
+
+    tiledtex = 0;
+    tilew = 0;
+    tileh = 0;
+    nbtilew = 0;
+    nbtileh = 0;
+    tilestart = 0;
+    ofnormaltexx = 0.0f;
+    ofnormaltexy = 0.0f;
+
+    SetHandle(0, 0);
+    GetRenderBackend().FlushTexture(data, Size);
+}
+
 /**
  * Create an empty texture.
  * @param w Width of the new texture to create.
@@ -188,9 +336,10 @@ void Texture::Load(std::string_view filename)
 void Texture::Create(const u32 w, const u32 h, const u32 Color)
 {
     // Delete texture if already filled
-    free(data);
+    FreeData();
 
     data = memalign(32, h * w * 4);
+    Account(h * w * 4);
     this->w = w;
     this->h = h;
     format  = GX_TF_RGBA8;
@@ -209,26 +358,23 @@ void Texture::Create(const u32 w, const u32 h, const u32 Color)
     ofnormaltexy = 0.0f;
 
     // Initialize the texture with a color
-    u8* bp = static_cast<u8*>(data);
     for(u32 y = 0; y < h; ++y)
     {
         for(u32 x = 0; x < w; ++x)
-        {   // Code taken from GRRLIB_SetPixelTotexImg
-            u32 offs = (((y&(~3))<<2)*w) + ((x&(~3))<<4) + ((((y&3)<<2) + (x&3)) <<1);
-            *((u16*)(bp+offs   )) = (u16)((Color <<8) | (Color >>24));
-            *((u16*)(bp+offs+32)) = (u16) (Color >>8);
+        {
+            SetPixel(x, y, Color);
         }
     }
 
-    GRRLIB_SetHandle(this, 0, 0);
-    GRRLIB_FlushTex(this);
+    SetHandle(0, 0);
+    Refresh();
 }
 
 /**
  * Return the width of the texture in pixels.
  * @return The width in pixels.
  */
-u32 Texture::GetWidth()
+u32 Texture::GetWidth() const
 {
     return w;
 }
@@ -237,7 +383,7 @@ u32 Texture::GetWidth()
  * Return the height of the texture in pixels.
  * @return The height in pixels.
  */
-u32 Texture::GetHeight()
+u32 Texture::GetHeight() const
 {
     return h;
 }
@@ -324,7 +470,41 @@ u32 Texture::GetHandleY()
  */
 void Texture::SetHandle(u32 X, u32 Y)
 {
-    GRRLIB_SetHandle(this, X, Y);
+    if(tiledtex)
+    {
+        handlex = -(static_cast<int>(tilew) / 2) + X;
+        handley = -(static_cast<int>(tileh) / 2) + Y;
+    }
+    else
+    {
+        handlex = -(static_cast<int>(w) / 2) + X;
+        handley = -(static_cast<int>(h) / 2) + Y;
+    }
+}
+
+/**
+ * Split the texture in tiles drawn with DrawTile.
+ * @param tilew Width of a tile.
+ * @param tileh Height of a tile.
+ * @param tilestart Offset of the first tile.
+ */
+void Texture::InitTileSet(const u32 tilew, const u32 tileh, const u32 tilestart)
+{
+    this->tilew = tilew;
+    this->tileh = tileh;
+    if(tilew != 0)
+    {
+        nbtilew = w / tilew;
+    }
+    if(tileh != 0)
+    {
+        nbtileh = h / tileh;
+    }
+    this->tilestart = tilestart;
+    tiledtex = true;
+    ofnormaltexx = 1.0f / nbtilew;
+    ofnormaltexy = 1.0f / nbtileh;
+    SetHandle(0, 0);
 }
 
 /**
@@ -333,9 +513,10 @@ void Texture::SetHandle(u32 X, u32 Y)
  * @param y Specifies the y-coordinate of the pixel in the texture.
  * @return The color of a pixel in RGBA format.
  */
-u32 Texture::GetPixel(const s32 x, const s32 y)
+u32 Texture::GetPixel(const s32 x, const s32 y) const
 {
-    return GRRLIB_GetPixelFromtexImg(x, y, this);
+    const u8 *Texel = static_cast<const u8*>(data) + TexelOffset(x, y, w);
+    return RGBA(Texel[1], Texel[32], Texel[33], Texel[0]);
 }
 
 /**
@@ -347,7 +528,41 @@ u32 Texture::GetPixel(const s32 x, const s32 y)
  */
 void Texture::SetPixel(const s32 x, const s32 y, const u32 color)
 {
-    GRRLIB_SetPixelTotexImg(x, y, this, color);
+    u8 *Texel = static_cast<u8*>(data) + TexelOffset(x, y, w);
+    Texel[0] = A(color);
+    Texel[1] = R(color);
+    Texel[32] = G(color);
+    Texel[33] = B(color);
+}
+
+/**
+ * Set the alpha channel of a rectangle of an IA8 texture.
+ * The intensity is set to white and the rows of tiles written are flushed,
+ * so no call to Refresh is needed.
+ * @param x Left of the rectangle, a multiple of 4.
+ * @param y Top of the rectangle, a multiple of 4.
+ * @param Width Width of the rectangle.
+ * @param Height Height of the rectangle.
+ * @param Alpha Alpha values, Width bytes per row.
+ */
+void Texture::SetAlphaRect(u32 x, u32 y, u32 Width, u32 Height, const u8 *Alpha)
+{
+    // IA8 textures are made of 4x4 tiles of 32 bytes, alpha then intensity
+    u8 *Texels = static_cast<u8*>(data);
+    for(u32 Row = 0; Row < Height; ++Row)
+    {
+        const u32 ty = y + Row;
+        for(u32 Column = 0; Column < Width; ++Column)
+        {
+            const u32 tx = x + Column;
+            u8 *Texel = Texels + ((ty / 4) * (w / 4) + tx / 4) * 32 + (((ty & 3) << 2) + (tx & 3)) * 2;
+            Texel[0] = Alpha[Row * Width + Column];
+            Texel[1] = 0xFF;
+        }
+    }
+    const u32 First = (y / 4) * (w / 4) * 32;
+    const u32 Last = ((y + Height + 3) / 4) * (w / 4) * 32;
+    GetRenderBackend().FlushTexture(Texels + First, Last - First);
 }
 
 /**
@@ -356,7 +571,7 @@ void Texture::SetPixel(const s32 x, const s32 y, const u32 color)
  */
 void Texture::Refresh()
 {
-    DCFlushRange(data, w * h * 4);
+    GetRenderBackend().FlushTexture(data, w * h * 4);
 }
 
 /**
@@ -371,7 +586,7 @@ void Texture::Refresh()
 void Texture::Draw(const f32 xpos, const f32 ypos, const f32 degrees,
                    const f32 scaleX, const f32 scaleY, const u32 color)
 {
-    GRRLIB_DrawImg(xpos, ypos, this, degrees, scaleX, scaleY, color);
+    GetRenderBackend().DrawImg(xpos, ypos, this, degrees, scaleX, scaleY, color);
 }
 
 /**
@@ -412,6 +627,26 @@ void Texture::Draw(const f32 xpos, const f32 ypos)
     Draw(xpos, ypos, _Angle, _ScaleX, _ScaleY, _Color);
 }
 
+/**
+ * Draw a part of the texture.
+ * @param xpos Specifies the x-coordinate of the upper-left corner.
+ * @param ypos Specifies the y-coordinate of the upper-left corner.
+ * @param partx Specifies the x-coordinate of the upper-left corner in the texture.
+ * @param party Specifies the y-coordinate of the upper-left corner in the texture.
+ * @param partw Specifies the width in the texture.
+ * @param parth Specifies the height in the texture.
+ * @param degrees Angle of rotation.
+ * @param scaleX Specifies the x-coordinate scale. -1 could be used for flipping the texture horizontally.
+ * @param scaleY Specifies the y-coordinate scale. -1 could be used for flipping the texture vertically.
+ * @param color Color in RGBA format.
+ */
+void Texture::DrawPart(const f32 xpos, const f32 ypos, const f32 partx, const f32 party,
+                       const f32 partw, const f32 parth, const f32 degrees,
+                       const f32 scaleX, const f32 scaleY, const u32 color)
+{
+    GetRenderBackend().DrawPart(xpos, ypos, partx, party, partw, parth, this, degrees, scaleX, scaleY, color);
+}
+
 /**
  * Draw a tile.
  * @param xpos Specifies the x-coordinate of the upper-left corner.
@@ -425,7 +660,7 @@ void Texture::Draw(const f32 xpos, const f32 ypos)
 void Texture::DrawTile(const f32 xpos, const f32 ypos, const f32 degrees,
                    const f32 scaleX, const f32 scaleY, const u32 color, int frame)
 {
-    GRRLIB_DrawTile(xpos, ypos, this, degrees, scaleX, scaleY, color, frame);
+    GetRenderBackend().DrawTile(xpos, ypos, this, degrees, scaleX, scaleY, color, frame);
 }
 
 /**
@@ -436,7 +671,23 @@ void Texture::DrawTile(const f32 xpos, const f32 ypos, const f32 degrees,
  */
 void Texture::CopyScreen(u16 posx, u16 posy, bool clear)
 {
-    GRRLIB_Screen2Texture(posx, posy, this, clear);
+    GetRenderBackend().CopyScreen(posx, posy, this, clear);
+}
+
+/**
+ * Copy rows of the screen into the same rows of an RGBA8 texture.
+ * The texture must be as wide as the screen. The rest of the texture is kept,
+ * so only the part of the screen that changed has to be copied.
+ * @param posy Top of the rows, a multiple of 4.
+ * @param height Height of the rows, a multiple of 4.
+ */
+void Texture::CopyScreenRows(u16 posy, u16 height)
+{
+    if(data == nullptr)
+    {
+        return;
+    }
+    GetRenderBackend().CopyScreenRows(this, posy, height);
 }
 
 /**
@@ -488,7 +739,7 @@ u8 Texture::GetAlpha()
  */
 s32 Screen::Initialize()
 {
-    return GRRLIB_Init();
+    return GetRenderBackend().Initialize();
 }
 
 /**
@@ -498,7 +749,7 @@ s32 Screen::Initialize()
  */
 void Screen::Exit()
 {
-    GRRLIB_Exit();
+    GetRenderBackend().Exit();
 }
 
 /**
@@ -510,7 +761,7 @@ void Screen::Exit()
  */
 void Screen::SetBackgroundColor(u8 r, u8 g, u8 b, u8 a)
 {
-    GRRLIB_SetBackgroundColour(r, g, b, a);
+    GetRenderBackend().SetBackgroundColor(RGBA(r, g, b, a));
 }
 
 /**
@@ -519,7 +770,7 @@ void Screen::SetBackgroundColor(u8 r, u8 g, u8 b, u8 a)
  */
 void Screen::SetBackgroundColor(const u32 color)
 {
-    GRRLIB_SetBackgroundColour(R(color), G(color), B(color), A(color));
+    GetRenderBackend().SetBackgroundColor(color);
 }
 
 /**
@@ -528,15 +779,19 @@ void Screen::SetBackgroundColor(const u32 color)
  */
 void Screen::FillScreen(const u32 color)
 {
-    GRRLIB_FillScreen(color);
+    GetRenderBackend().FillScreen(color);
 }
 
 /**
  * Call this function after drawing.
+ * Memory of the FrameArena is released once the frame is shown, and the
+ * glyphs drawn from a GlyphCache can be replaced again.
  */
 void Screen::Render()
 {
-    GRRLIB_Render();
+    GetRenderBackend().Render();
+    FrameArena::Reset();
+    GlyphCache::EndFrame();
 }
 
 /**
@@ -547,7 +802,7 @@ void Screen::Render()
  */
 void Screen::SetPixel(const f32 x, const f32 y, const u32 color)
 {
-    GRRLIB_Plot(x, y, color);
+    GetRenderBackend().Plot(x, y, color);
 }
 
 /**
@@ -560,7 +815,7 @@ void Screen::SetPixel(const f32 x, const f32 y, const u32 color)
  */
 void Screen::Line(const f32 x1, const f32 y1, const f32 x2, const f32 y2, const u32 color)
 {
-    GRRLIB_Line(x1, y1, x2, y2, color);
+    GetRenderBackend().Line(x1, y1, x2, y2, color);
 }
 
 /**
@@ -574,7 +829,7 @@ void Screen::Line(const f32 x1, const f32 y1, const f32 x2, const f32 y2, const
  */
 void Screen::Rectangle(const f32 x, const f32 y, const f32 width, const f32 height, const u32 color, const bool filled)
 {
-    GRRLIB_Rectangle(x, y, width,  height, color, filled);
+    GetRenderBackend().Rectangle(x, y, width, height, color, filled);
 }
 
 /**
@@ -587,7 +842,49 @@ void Screen::Rectangle(const f32 x, const f32 y, const f32 width, const f32 heig
  */
 void Screen::Circle(const f32 x, const f32 y, const f32 radius, const u32 color, const u8 filled)
 {
-    GRRLIB_Circle(x, y, radius, color, filled);
+    GetRenderBackend().Circle(x, y, radius, color, filled);
+}
+
+/**
+ * Discard the pixels with an alpha lower or equal to a threshold.
+ * Used to get sharp edges from a signed distance field.
+ * @param threshold The alpha threshold. Set to 0 to restore the default behavior.
+ */
+void Screen::SetAlphaTest(const u8 threshold)
+{
+    GetRenderBackend().SetAlphaTest(threshold);
+}
+
+/**
+ * Restrict drawing to a rectangle.
+ * @param x Specifies the x-coordinate of the upper-left corner of the rectangle.
+ * @param y Specifies the y-coordinate of the upper-left corner of the rectangle.
+ * @param width The width of the rectangle.
+ * @param height The height of the rectangle.
+ */
+void Screen::ClipDrawing(const int x, const int y, const int width, const int height)
+{
+    GetRenderBackend().ClipDrawing(x, y, width, height);
+    CurrentClip = {x, y, width, height};
+    Clipped = true;
+}
+
+/**
+ * Allow drawing on the whole screen again.
+ */
+void Screen::ClipReset()
+{
+    GetRenderBackend().ClipReset();
+    Clipped = false;
+}
+
+/**
+ * Get the rectangle where drawing is allowed.
+ * @return The rectangle given to ClipDrawing, the whole screen after ClipReset.
+ */
+Screen::ClipRect Screen::GetClip()
+{
+    return Clipped ? CurrentClip : ClipRect{0, 0, GetWidth(), GetHeight()};
 }
 
 /**
@@ -599,7 +896,7 @@ void Screen::Circle(const f32 x, const f32 y, const f32 radius, const u32 color,
  */
 bool Screen::ScreenShot(const char* filename)
 {
-    return GRRLIB_ScrShot(filename);
+    return GetRenderBackend().ScreenShot(filename);
 }
 
 /**
@@ -611,7 +908,7 @@ bool Screen::ScreenShot(const char* filename)
  */
 bool Screen::ScreenShot(std::string_view filename)
 {
-    return GRRLIB_ScrShot(std::string(filename).c_str());
+    return GetRenderBackend().ScreenShot(std::string(filename).c_str());
 }
 
 /**
@@ -620,7 +917,7 @@ bool Screen::ScreenShot(std::string_view filename)
  */
 u16 Screen::GetWidth()
 {
-    return rmode->fbWidth;
+    return GetRenderBackend().GetWidth();
 }
 
 /**
@@ -629,7 +926,7 @@ u16 Screen::GetWidth()
  */
 u16 Screen::GetHeight()
 {
-    return rmode->efbHeight;
+    return GetRenderBackend().GetHeight();
 }
 
 
@@ -642,7 +939,14 @@ u16 Screen::GetHeight()
  */
 void FX::FlipH(const Texture *texsrc, Texture *texdest)
 {
-    GRRLIB_BMFX_FlipH(texsrc->AsGRRLIB(), texdest->AsGRRLIB());
+    const u32 txtWidth = texsrc->GetWidth() - 1;
+    for(u32 y = 0; y < texsrc->GetHeight(); ++y)
+    {
+        for(u32 x = 0; x <= txtWidth; ++x)
+        {
+            texdest->SetPixel(txtWidth - x, y, texsrc->GetPixel(x, y));
+        }
+    }
 }
 /**
  * Flip texture vertical.
@@ -652,7 +956,14 @@ void FX::FlipH(const Texture *texsrc, Texture *texdest)
  */
 void FX::FlipV(const Texture *texsrc, Texture *texdest)
 {
-    GRRLIB_BMFX_FlipV(texsrc->AsGRRLIB(), texdest->AsGRRLIB());
+    const u32 texHeight = texsrc->GetHeight() - 1;
+    for(u32 y = 0; y <= texHeight; ++y)
+    {
+        for(u32 x = 0; x < texsrc->GetWidth(); ++x)
+        {
+            texdest->SetPixel(x, texHeight - y, texsrc->GetPixel(x, y));
+        }
+    }
 }
 /**
  * Change a texture to gray scale.
@@ -662,7 +973,15 @@ void FX::FlipV(const Texture *texsrc, Texture *texdest)
  */
 void FX::Grayscale(const Texture *texsrc, Texture *texdest)
 {
-    GRRLIB_BMFX_Grayscale(texsrc->AsGRRLIB(), texdest->AsGRRLIB());
+    for(u32 y = 0; y < texsrc->GetHeight(); ++y)
+    {
+        for(u32 x = 0; x < texsrc->GetWidth(); ++x)
+        {
+            const u32 color = texsrc->GetPixel(x, y);
+            const u8 gray = ((R(color) * 77 + G(color) * 150 + B(color) * 28) / 255);
+            texdest->SetPixel(x, y, (gray << 24) | (gray << 16) | (gray << 8) | A(color));
+        }
+    }
 }
 /**
  * Change a texture to sepia (old photo style).
@@ -672,7 +991,18 @@ void FX::Grayscale(const Texture *texsrc, Texture *texdest)
  */
 void FX::Sepia(const Texture *texsrc, Texture *texdest)
 {
-    GRRLIB_BMFX_Sepia(texsrc->AsGRRLIB(), texdest->AsGRRLIB());
+    for(u32 y = 0; y < texsrc->GetHeight(); ++y)
+    {
+        for(u32 x = 0; x < texsrc->GetWidth(); ++x)
+        {
+            const u32 color = texsrc->GetPixel(x, y);
+            const u16 sr = R(color) * 0.393 + G(color) * 0.769 + B(color) * 0.189;
+            const u16 sg = R(color) * 0.349 + G(color) * 0.686 + B(color) * 0.168;
+            const u16 sb = R(color) * 0.272 + G(color) * 0.534 + B(color) * 0.131;
+            texdest->SetPixel(x, y, RGBA(std::min<u16>(sr, 255), std::min<u16>(sg, 255),
+                                         std::min<u16>(sb, 255), A(color)));
+        }
+    }
 }
 /**
  * Invert colors of the texture.
@@ -682,7 +1012,14 @@ void FX::Sepia(const Texture *texsrc, Texture *texdest)
  */
 void FX::Invert(const Texture *texsrc, Texture *texdest)
 {
-    GRRLIB_BMFX_Invert(texsrc->AsGRRLIB(), texdest->AsGRRLIB());
+    for(u32 y = 0; y < texsrc->GetHeight(); ++y)
+    {
+        for(u32 x = 0; x < texsrc->GetWidth(); ++x)
+        {
+            const u32 color = texsrc->GetPixel(x, y);
+            texdest->SetPixel(x, y, ((0xFFFFFF00 - (color & 0xFFFFFF00)) | (color & 0xFF)));
+        }
+    }
 }
 /**
  * A texture effect (Blur).
@@ -693,7 +1030,48 @@ void FX::Invert(const Texture *texsrc, Texture *texdest)
  */
 void FX::Blur(const Texture *texsrc, Texture *texdest, const u32 factor)
 {
-    GRRLIB_BMFX_Blur(texsrc->AsGRRLIB(), texdest->AsGRRLIB(), factor);
+    const s32 numba = (1 + (factor << 1)) * (1 + (factor << 1));
+    std::vector<u32> colours(numba);
+    const s32 width = texsrc->GetWidth();
+    const s32 height = texsrc->GetHeight();
+
+    for(s32 x = 0; x < width; ++x)
+    {
+        for(s32 y = 0; y < height; ++y)
+        {
+            s32 newr = 0;
+            s32 newg = 0;
+            s32 newb = 0;
+            s32 newa = 0;
+            s32 tmp = 0;
+
+            for(s32 k = x - factor; k <= x + static_cast<s32>(factor); ++k)
+            {
+                for(s32 l = y - factor; l <= y + static_cast<s32>(factor); ++l)
+                {
+                    if(k < 0 || k >= width || l < 0 || l >= height)
+                    {
+                        colours[tmp] = texsrc->GetPixel(x, y);
+                    }
+                    else
+                    {
+                        colours[tmp] = texsrc->GetPixel(k, l);
+                    }
+                    ++tmp;
+                }
+            }
+
+            for(const u32 thiscol : colours)
+            {
+                newr += R(thiscol);
+                newg += G(thiscol);
+                newb += B(thiscol);
+                newa += A(thiscol);
+            }
+
+            texdest->SetPixel(x, y, RGBA(newr / numba, newg / numba, newb / numba, newa / numba));
+        }
+    }
 }
 /**
  * A texture effect (Scatter).
@@ -704,7 +1082,26 @@ void FX::Blur(const Texture *texsrc, Texture *texdest, const u32 factor)
  */
 void FX::Scatter(const Texture *texsrc, Texture *texdest, const u32 factor)
 {
-    GRRLIB_BMFX_Scatter(texsrc->AsGRRLIB(), texdest->AsGRRLIB(), factor);
+    const s32 factorx2 = factor * 2;
+    const s32 width = texsrc->GetWidth();
+    const s32 height = texsrc->GetHeight();
+
+    for(s32 y = 0; y < height; ++y)
+    {
+        for(s32 x = 0; x < width; ++x)
+        {
+            const s32 val1 = x + static_cast<s32>(factorx2 * (std::rand() / (RAND_MAX + 1.0))) - factor;
+            const s32 val2 = y + static_cast<s32>(factorx2 * (std::rand() / (RAND_MAX + 1.0))) - factor;
+
+            if(val1 >= 0 && val1 < width && val2 >= 0 && val2 < height)
+            {
+                const u32 val3 = texsrc->GetPixel(x, y);
+                const u32 val4 = texsrc->GetPixel(val1, val2);
+                texdest->SetPixel(x, y, val4);
+                texdest->SetPixel(val1, val2, val3);
+            }
+        }
+    }
 }
 /**
  * A texture effect (Pixelate).
@@ -715,7 +1112,23 @@ void FX::Scatter(const Texture *texsrc, Texture *texdest, const u32 factor)
  */
 void FX::Pixelate(const Texture *texsrc, Texture *texdest, const u32 factor)
 {
-    GRRLIB_BMFX_Pixelate(texsrc->AsGRRLIB(), texdest->AsGRRLIB(), factor);
+    const u32 width = texsrc->GetWidth();
+    const u32 height = texsrc->GetHeight();
+
+    for(u32 x = 0; x < width - 1 - factor; x += factor)
+    {
+        for(u32 y = 0; y < height - 1 - factor; y += factor)
+        {
+            const u32 rgb = texsrc->GetPixel(x, y);
+            for(u32 xx = x; xx < x + factor; ++xx)
+            {
+                for(u32 yy = y; yy < y + factor; ++yy)
+                {
+                    texdest->SetPixel(xx, yy, rgb);
+                }
+            }
+        }
+    }
 }
 
 // EOF
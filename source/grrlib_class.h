@@ -16,6 +16,8 @@
 #include <grrlib.h>
 #include <string>
 #include <memory>
+#include "memtrack.h"
+#include "renderbackend.h"
 
 /**
  * Namespace containing all GRRLIB code.
@@ -38,8 +40,8 @@ public:
     Texture(const u32 w, const u32 h);
     ~Texture();
 
-    [[nodiscard]] u32 GetWidth();
-    [[nodiscard]] u32 GetHeight();
+    [[nodiscard]] u32 GetWidth() const;
+    [[nodiscard]] u32 GetHeight() const;
     [[nodiscard]] u32 GetFormat();
     [[nodiscard]] u32 GetOffsetX();
     [[nodiscard]] u32 GetOffsetY();
@@ -49,12 +51,16 @@ public:
     [[nodiscard]] u32 GetHandleX();
     [[nodiscard]] u32 GetHandleY();
     void SetHandle(u32 X, u32 Y);
-    [[nodiscard]] u32 GetPixel(const s32 x, const s32 y);
+    void InitTileSet(const u32 tilew, const u32 tileh, const u32 tilestart);
+    [[nodiscard]] u32 GetPixel(const s32 x, const s32 y) const;
     void SetPixel(const s32 x, const s32 y, const u32 color);
+    void SetAlphaRect(u32 x, u32 y, u32 Width, u32 Height, const u8 *Alpha);
     void Refresh();
     void Load(const u8 *Buffer, const u32 Size = 0);
     void Load(const char *filename);
     void Load(std::string_view filename);
+    void LoadRaw(const u8 *Buffer, const u32 Size, const u32 w, const u32 h, const u8 Format);
+    void UseRaw(const u8 *Buffer, const u32 Size, const u32 w, const u32 h, const u8 Format);
     void Create(const u32 w, const u32 h, const u32 Color = 0x00000000);
     void Draw(const f32 xpos, const f32 ypos, const f32 degrees,
               const f32 scaleX, const f32 scaleY, const u32 color);
@@ -62,13 +68,18 @@ public:
               const f32 scaleX, const f32 scaleY);
     void Draw(const f32 xpos, const f32 ypos, const f32 degrees);
     void Draw(const f32 xpos, const f32 ypos);
+    void DrawPart(const f32 xpos, const f32 ypos, const f32 partx, const f32 party,
+                  const f32 partw, const f32 parth, const f32 degrees,
+                  const f32 scaleX, const f32 scaleY, const u32 color);
     void DrawTile(const f32 xpos, const f32 ypos, const f32 degrees,
                   const f32 scaleX, const f32 scaleY, const u32 color, int frame);
     void CopyScreen(u16 posx = 0, u16 posy = 0, bool clear = false);
+    void CopyScreenRows(u16 posy, u16 height);
     void SetColor(u32);
     [[nodiscard]] u32 GetColor();
     void SetAlpha(u8);
     [[nodiscard]] u8 GetAlpha();
+    void SetMemCategory(MemTrack::Category Which);
 
     [[nodiscard]] static std::unique_ptr<Texture> CreateFromPNG(const u8 *Buffer);
 
@@ -85,10 +96,16 @@ public:
 
 private:
     void Assign(GRRLIB_texImg *other);
+    void Account(size_t Bytes);
+    void FreeData();
+    void SetRaw(const u32 Size, const u32 w, const u32 h, const u8 Format);
     u32 _Color;  /**< The color used to draw the texture. By default it is set to 0xFFFFFFFF. */
     f32 _ScaleX; /**< The X scale used to draw the texture. By default it is set to 1.0. */
     f32 _ScaleY; /**< The Y scale used to draw the texture. By default it is set to 1.0. */
     f32 _Angle;  /**< The angle used to draw the texture. By default it is set to 0. */
+    bool _OwnsData{true};    /**< false when data points at texels the texture must not free. */
+    size_t _TrackedBytes{0}; /**< Size of the texels reported to MemTrack. */
+    MemTrack::Category _TrackedCategory{MemTrack::Category::Texture}; /**< Category of the texels in MemTrack. */
 };
 
 /**
@@ -97,6 +114,17 @@ private:
  */
 namespace Screen
 {
+    /**
+     * Rectangle where drawing is allowed.
+     */
+    struct ClipRect
+    {
+        int X;
+        int Y;
+        int Width;
+        int Height;
+    };
+
     s32 Initialize();
     void Exit();
     void Render();
@@ -108,6 +136,10 @@ namespace Screen
     void Line(const f32 x1, const f32 y1, const f32 x2, const f32 y2, const u32 color);
     void Rectangle(const f32 x, const f32 y, const f32 width, const f32 height, const u32 color, const bool filled);
     void Circle(const f32 x, const f32 y, const f32 radius, const u32 color, const u8 filled);
+    void SetAlphaTest(const u8 threshold);
+    void ClipDrawing(const int x, const int y, const int width, const int height);
+    void ClipReset();
+    [[nodiscard]] ClipRect GetClip();
 
     [[nodiscard]] u16 GetWidth();
     [[nodiscard]] u16 GetHeight();
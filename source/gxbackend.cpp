@@ -0,0 +1,282 @@
+// source/gxbackend.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#include "gxbackend.h"
+
+using namespace GRRLIBpp;
+
+/**
+ * Initialize the video library.
+ * @return 0 if the operation completed successfully, a negative value otherwise.
+ */
+s32 GXBackend::Initialize()
+{
+    return GRRLIB_Init();
+}
+
+/**
+ * Release the video library.
+ */
+void GXBackend::Exit()
+{
+    GRRLIB_Exit();
+}
+
+/**
+ * Show the frame and clear the EFB.
+ */
+void GXBackend::Render()
+{
+    GRRLIB_Render();
+}
+
+/**
+ * Return the width of the screen in pixels.
+ * @return The width in pixels.
+ */
+u16 GXBackend::GetWidth() const
+{
+    return rmode->fbWidth;
+}
+
+/**
+ * Return the height of the screen in pixels.
+ * @return The height in pixels.
+ */
+u16 GXBackend::GetHeight() const
+{
+    return rmode->efbHeight;
+}
+
+/**
+ * Set the color used to clear the screen.
+ * @param color The color in RGBA format.
+ */
+void GXBackend::SetBackgroundColor(u32 color)
+{
+    GRRLIB_SetBackgroundColour(R(color), G(color), B(color), A(color));
+}
+
+/**
+ * Fill the screen with a color.
+ * @param color The color in RGBA format.
+ */
+void GXBackend::FillScreen(u32 color)
+{
+    GRRLIB_FillScreen(color);
+}
+
+/**
+ * Draw a dot.
+ * @param x Specifies the x-coordinate of the dot.
+ * @param y Specifies the y-coordinate of the dot.
+ * @param color The color of the dot in RGBA format.
+ */
+void GXBackend::Plot(f32 x, f32 y, u32 color)
+{
+    GRRLIB_Plot(x, y, color);
+}
+
+/**
+ * Draw a line.
+ * @param x1 Starting point for the x-coordinate.
+ * @param y1 Starting point for the y-coordinate.
+ * @param x2 Ending point for the x-coordinate.
+ * @param y2 Ending point for the y-coordinate.
+ * @param color Line color in RGBA format.
+ */
+void GXBackend::Line(f32 x1, f32 y1, f32 x2, f32 y2, u32 color)
+{
+    GRRLIB_Line(x1, y1, x2, y2, color);
+}
+
+/**
+ * Draw a rectangle.
+ * @param x Specifies the x-coordinate of the upper-left corner.
+ * @param y Specifies the y-coordinate of the upper-left corner.
+ * @param width The width of the rectangle.
+ * @param height The height of the rectangle.
+ * @param color The color of the rectangle in RGBA format.
+ * @param filled Set to true to fill the rectangle.
+ */
+void GXBackend::Rectangle(f32 x, f32 y, f32 width, f32 height, u32 color, bool filled)
+{
+    GRRLIB_Rectangle(x, y, width, height, color, filled);
+}
+
+/**
+ * Draw a circle.
+ * @param x Specifies the x-coordinate of the center.
+ * @param y Specifies the y-coordinate of the center.
+ * @param radius The radius of the circle.
+ * @param color The color of the circle in RGBA format.
+ * @param filled Set to true to fill the circle.
+ */
+void GXBackend::Circle(f32 x, f32 y, f32 radius, u32 color, bool filled)
+{
+    GRRLIB_Circle(x, y, radius, color, filled);
+}
+
+/**
+ * Discard the pixels with an alpha lower or equal to a threshold.
+ * @param threshold The alpha threshold, 0 to keep every visible pixel.
+ */
+void GXBackend::SetAlphaTest(u8 threshold)
+{
+    GX_SetAlphaCompare(GX_GREATER, threshold, GX_AOP_AND, GX_ALWAYS, 0);
+}
+
+/**
+ * Restrict drawing to a rectangle.
+ * @param x Specifies the x-coordinate of the upper-left corner.
+ * @param y Specifies the y-coordinate of the upper-left corner.
+ * @param width The width of the rectangle.
+ * @param height The height of the rectangle.
+ */
+void GXBackend::ClipDrawing(int x, int y, int width, int height)
+{
+    GRRLIB_ClipDrawing(x, y, width, height);
+}
+
+/**
+ * Allow drawing on the whole screen.
+ */
+void GXBackend::ClipReset()
+{
+    GRRLIB_ClipReset();
+}
+
+/**
+ * Make a PNG screenshot.
+ * @param filename Name of the file to write.
+ * @return true if everything worked, false otherwise.
+ */
+bool GXBackend::ScreenShot(const char *filename)
+{
+    return GRRLIB_ScrShot(filename);
+}
+
+/**
+ * Decode a JPEG, PNG or Bitmap image.
+ * @param Buffer The image file in memory.
+ * @param Size The size of the buffer, only required for JPEG images.
+ * @return A texture allocated with malloc, or nullptr.
+ */
+GRRLIB_texImg* GXBackend::LoadTexture(const u8 *Buffer, u32 Size)
+{
+    if(Buffer[0]==0xFF && Buffer[1]==0xD8 && Buffer[2]==0xFF)
+    {   // JPEG image
+        return (Size > 0) ? GRRLIB_LoadTextureJPGEx(Buffer, Size) : GRRLIB_LoadTextureJPG(Buffer);
+    }
+    if(Buffer[0]=='B' && Buffer[1]=='M')
+    {   // Bitmap image
+        return GRRLIB_LoadTextureBMP(Buffer);
+    }
+    return GRRLIB_LoadTexturePNG(Buffer);
+}
+
+/**
+ * Write texels from the data cache down to main memory so the GPU can read them.
+ * The texture cache of the GPU is invalidated too, a texture may be updated
+ * after it was drawn.
+ * @param data The texels.
+ * @param size The size in bytes.
+ */
+void GXBackend::FlushTexture(void *data, u32 size)
+{
+    DCFlushRange(data, size);
+    GX_InvalidateTexAll();
+}
+
+/**
+ * Draw a texture.
+ * @param xpos Specifies the x-coordinate of the upper-left corner.
+ * @param ypos Specifies the y-coordinate of the upper-left corner.
+ * @param tex The texture to draw.
+ * @param degrees Angle of rotation.
+ * @param scaleX Specifies the x-coordinate scale.
+ * @param scaleY Specifies the y-coordinate scale.
+ * @param color Color in RGBA format.
+ */
+void GXBackend::DrawImg(f32 xpos, f32 ypos, const GRRLIB_texImg *tex,
+                        f32 degrees, f32 scaleX, f32 scaleY, u32 color)
+{
+    GRRLIB_DrawImg(xpos, ypos, tex, degrees, scaleX, scaleY, color);
+}
+
+/**
+ * Draw a part of a texture.
+ * @param xpos Specifies the x-coordinate of the upper-left corner.
+ * @param ypos Specifies the y-coordinate of the upper-left corner.
+ * @param partx Specifies the x-coordinate of the upper-left corner in the texture.
+ * @param party Specifies the y-coordinate of the upper-left corner in the texture.
+ * @param partw Specifies the width in the texture.
+ * @param parth Specifies the height in the texture.
+ * @param tex The texture to draw.
+ * @param degrees Angle of rotation.
+ * @param scaleX Specifies the x-coordinate scale.
+ * @param scaleY Specifies the y-coordinate scale.
+ * @param color Color in RGBA format.
+ */
+void GXBackend::DrawPart(f32 xpos, f32 ypos, f32 partx, f32 party, f32 partw, f32 parth,
+                         const GRRLIB_texImg *tex, f32 degrees, f32 scaleX, f32 scaleY, u32 color)
+{
+    GRRLIB_DrawPart(xpos, ypos, partx, party, partw, parth, tex, degrees, scaleX, scaleY, color);
+}
+
+/**
+ * Draw a tile of a texture.
+ * @param xpos Specifies the x-coordinate of the upper-left corner.
+ * @param ypos Specifies the y-coordinate of the upper-left corner.
+ * @param tex The tile set.
+ * @param degrees Angle of rotation.
+ * @param scaleX Specifies the x-coordinate scale.
+ * @param scaleY Specifies the y-coordinate scale.
+ * @param color Color in RGBA format.
+ * @param frame Specifies the frame to draw.
+ */
+void GXBackend::DrawTile(f32 xpos, f32 ypos, const GRRLIB_texImg *tex,
+                         f32 degrees, f32 scaleX, f32 scaleY, u32 color, int frame)
+{
+    GRRLIB_DrawTile(xpos, ypos, tex, degrees, scaleX, scaleY, color, frame);
+}
+
+/**
+ * Copy a part of the EFB into a texture, without alpha.
+ * @param posx Specifies the x-coordinate of the upper-left corner of the copy.
+ * @param posy Specifies the y-coordinate of the upper-left corner of the copy.
+ * @param tex The destination, its size is the size of the copy.
+ * @param clear Set to true to clear the EFB after the copy.
+ */
+void GXBackend::CopyScreen(int posx, int posy, GRRLIB_texImg *tex, bool clear)
+{
+    GRRLIB_Screen2Texture(posx, posy, tex, clear);
+}
+
+/**
+ * Copy rows of the EFB into the same rows of an RGBA8 texture.
+ * @param tex The destination, as wide as the screen.
+ * @param posy Top of the rows, a multiple of 4.
+ * @param height Height of the rows, a multiple of 4.
+ */
+void GXBackend::CopyScreenRows(GRRLIB_texImg *tex, u16 posy, u16 height)
+{
+    // RGBA8 textures are made of 4x4 tiles of 64 bytes, stored row by row
+    u8 *Dest = static_cast<u8*>(tex->data) + (posy / 4) * (tex->w / 4) * 64;
+    GX_SetTexCopySrc(0, posy, tex->w, height);
+    GX_SetTexCopyDst(tex->w, height, GX_TF_RGBA8, GX_FALSE);
+    GX_CopyTex(Dest, GX_FALSE);
+    GX_PixModeSync();
+    DCFlushRange(Dest, tex->w * height * 4);
+    GX_InvalidateTexAll();
+}
+
+// EOF
@@ -0,0 +1,60 @@
+// source/gxbackend.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#ifndef GXBackendH
+#define GXBackendH
+//---------------------------------------------------------------------------
+
+#include "renderbackend.h"
+
+namespace GRRLIBpp
+{
+
+/**
+ * Render backend drawing with GRRLIB on the Wii GPU.
+ * @author Crayon
+ */
+class GXBackend : public RenderBackend
+{
+public:
+    s32 Initialize() override;
+    void Exit() override;
+    void Render() override;
+    [[nodiscard]] u16 GetWidth() const override;
+    [[nodiscard]] u16 GetHeight() const override;
+    void SetBackgroundColor(u32 color) override;
+    void FillScreen(u32 color) override;
+    void Plot(f32 x, f32 y, u32 color) override;
+    void Line(f32 x1, f32 y1, f32 x2, f32 y2, u32 color) override;
+    void Rectangle(f32 x, f32 y, f32 width, f32 height, u32 color, bool filled) override;
+    void Circle(f32 x, f32 y, f32 radius, u32 color, bool filled) override;
+    void SetAlphaTest(u8 threshold) override;
+    void ClipDrawing(int x, int y, int width, int height) override;
+    void ClipReset() override;
+    bool ScreenShot(const char *filename) override;
+
+    [[nodiscard]] GRRLIB_texImg* LoadTexture(const u8 *Buffer, u32 Size) override;
+    void FlushTexture(void *data, u32 size) override;
+    void DrawImg(f32 xpos, f32 ypos, const GRRLIB_texImg *tex,
+                 f32 degrees, f32 scaleX, f32 scaleY, u32 color) override;
+    void DrawPart(f32 xpos, f32 ypos, f32 partx, f32 party, f32 partw, f32 parth,
+                  const GRRLIB_texImg *tex, f32 degrees, f32 scaleX, f32 scaleY, u32 color) override;
+    void DrawTile(f32 xpos, f32 ypos, const GRRLIB_texImg *tex,
+                  f32 degrees, f32 scaleX, f32 scaleY, u32 color, int frame) override;
+    void CopyScreen(int posx, int posy, GRRLIB_texImg *tex, bool clear) override;
+    void CopyScreenRows(GRRLIB_texImg *tex, u16 posy, u16 height) override;
+};
+
+}   /* namespace GRRLIBpp */
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
@@ -0,0 +1,100 @@
+// source/hitch.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#include <cstdint>
+#include <cstdio>
+#include <ogc/system.h>
+#include "memtrack.h"
+#include "profiler.h"
+#include "hitch.h"
+
+/**
+ * Constructor for the HitchDetector class.
+ * @param[in] ABudget Time of a frame at the refresh rate, in microseconds.
+ */
+HitchDetector::HitchDetector(u32 ABudget) :
+    Budget(ABudget),
+    IntervalFrames(MIN_INTERVAL / ABudget), // A frame lasts at least one refresh, on PAL as on NTSC
+    FramesSinceReport(IntervalFrames)
+{
+}
+
+/**
+ * Check the last frame.
+ * @return true if it was a hitch and a report should be written, false otherwise.
+ */
+bool HitchDetector::Update()
+{
+    if(FramesSinceReport < IntervalFrames)
+    {
+        ++FramesSinceReport;
+    }
+    if(Profiler::GetSample(Profiler::Phase::Frame, 0) * 100 <= Budget * HITCH_PERCENT)
+    {
+        return false;
+    }
+    ++Hitches;
+    if(FramesSinceReport < IntervalFrames || Reports >= MAX_REPORTS)
+    {
+        return false;
+    }
+    FramesSinceReport = 0;
+    ++Reports;
+    return true;
+}
+
+/**
+ * Write a diagnostic report of the last frame.
+ * @param[in] filename Name of the text file to write.
+ * @param[in] State Description of the game state.
+ * @return true if the file was written, false otherwise.
+ */
+bool HitchDetector::WriteReport(const char *filename, std::string_view State) const
+{
+    std::FILE *File = std::fopen(filename, "w");
+    if(File == nullptr)
+    {
+        return false;
+    }
+
+    std::fprintf(File, "Frame time: %u us, budget: %u us\n",
+        Profiler::GetSample(Profiler::Phase::Frame, 0), Budget);
+    std::fprintf(File, "Hitches: %u, reports: %u\n", Hitches, Reports);
+
+    std::fprintf(File, "\n[State]\n%.*s\n", static_cast<int>(State.size()), State.data());
+
+    std::fputs("\n[Memory]\n", File);
+    MemTrack::Dump(File);
+    std::fprintf(File, "Arena free: MEM1 %u bytes, MEM2 %u bytes\n",
+        static_cast<u32>(reinterpret_cast<uintptr_t>(SYS_GetArena1Hi()) - reinterpret_cast<uintptr_t>(SYS_GetArena1Lo())),
+        static_cast<u32>(reinterpret_cast<uintptr_t>(SYS_GetArena2Hi()) - reinterpret_cast<uintptr_t>(SYS_GetArena2Lo())));
+
+    // Phase times of the last frames, newest first, in microseconds
+    static_assert(REPORT_FRAMES <= Profiler::HISTORY_SIZE);
+    std::fputs("\n[Frames]\nAge", File);
+    for(size_t i = 0; i < static_cast<size_t>(Profiler::Phase::Count); ++i)
+    {
+        std::fprintf(File, "\t%s", Profiler::GetName(static_cast<Profiler::Phase>(i)));
+    }
+    for(size_t Age = 0; Age < REPORT_FRAMES; ++Age)
+    {
+        std::fprintf(File, "\n%zu", Age);
+        for(size_t i = 0; i < static_cast<size_t>(Profiler::Phase::Count); ++i)
+        {
+            std::fprintf(File, "\t%u", Profiler::GetSample(static_cast<Profiler::Phase>(i), Age));
+        }
+    }
+    std::fputs("\n", File);
+
+    return std::fclose(File) == 0;
+}
+
+// EOF
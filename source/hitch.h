@@ -0,0 +1,52 @@
+// source/hitch.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#ifndef HitchH
+#define HitchH
+//---------------------------------------------------------------------------
+
+#include <cstddef>
+#include <string_view>
+#include <gctypes.h>
+
+/**
+ * Detect frames that miss their vsync budget.
+ * It reads the frame times of the profiler, so Update must be called after
+ * Profiler::EndFrame. Reports are rate limited: writing one to the SD card
+ * makes the following frames long too, and a burst of stalls must not turn
+ * into a burst of writes.
+ * @author Crayon
+ */
+class HitchDetector
+{
+public:
+    explicit HitchDetector(u32 ABudget);
+    HitchDetector(HitchDetector const&) = delete;
+    HitchDetector& operator=(HitchDetector const&) = delete;
+
+    bool Update();
+    bool WriteReport(const char *filename, std::string_view State) const;
+private:
+    static constexpr u32 HITCH_PERCENT = 150;     /**< A hitch is a frame longer than this part of the budget. */
+    static constexpr u32 MIN_INTERVAL = 10000000; /**< Minimum time between two reports, in microseconds. */
+    static constexpr u32 MAX_REPORTS = 20;        /**< Maximum number of reports per session. */
+    static constexpr size_t REPORT_FRAMES = 30;   /**< Number of frames of phase times in a report. */
+
+    u32 Budget;                        /**< Frame budget in microseconds. */
+    u32 IntervalFrames;                /**< MIN_INTERVAL in frames at the refresh rate. */
+    u32 FramesSinceReport;
+    u32 Hitches{0};                    /**< Number of hitches detected. */
+    u32 Reports{0};                    /**< Number of reports written. */
+};
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
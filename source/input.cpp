@@ -0,0 +1,124 @@
+// source/input.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#include <wiiuse/wpad.h>
+#include "input.h"
+
+/**
+ * Record the live input to a file.
+ * @param[in] filename Name of the file to write.
+ * @param[in] Seed Random seed used by the session.
+ * @return true if the file was created, false otherwise.
+ */
+bool Input::Record(const char *filename, u32 Seed)
+{
+    return Writer.Open(filename, Seed);
+}
+
+/**
+ * Stop recording, the file is complete after this call.
+ */
+void Input::StopRecording()
+{
+    Writer.Close();
+}
+
+/**
+ * Replace the live input with a recorded session.
+ * @param[in] filename Name of the file to read.
+ * @return true if the file is a valid recording, false otherwise.
+ */
+bool Input::Replay(const char *filename)
+{
+    Replaying = Reader.Open(filename);
+    Finished = false;
+    return Replaying;
+}
+
+/**
+ * Read the state of every Wii Remote for a new frame.
+ */
+void Input::Scan()
+{
+    if(Replaying)
+    {
+        if(!Reader.Read(Pads))
+        {   // Nothing is pressed once the recording is over
+            Pads = PadFrame{};
+            Finished = true;
+        }
+        return;
+    }
+
+    WPAD_ScanPads();
+    for(u8 i = 0; i < MAX_PADS; ++i)
+    {
+        const WPADData *Data = WPAD_Data(i);
+        PadState &Pad = Pads[i];
+        Pad.Down = Data->btns_d;
+        Pad.Held = Data->btns_h;
+        Pad.IRValid = Data->ir.valid;
+        Pad.IRX = Data->ir.x;
+        Pad.IRY = Data->ir.y;
+        Pad.Roll = Data->orient.roll;
+        Pad.Connected = WPAD_Probe(i, nullptr) != WPAD_ERR_NO_CONTROLLER;
+        QuantizePad(Pad);
+    }
+    Writer.Write(Pads);
+}
+
+/**
+ * Get the state of a Wii Remote for the current frame.
+ * @param[in] Chan The Wii Remote channel, from 0 to 3.
+ * @return The state of the Wii Remote.
+ */
+const PadState& Input::GetPad(u8 Chan) const
+{
+    return Pads[Chan];
+}
+
+/**
+ * Get the state of every Wii Remote for the current frame.
+ * @return The state of the Wii Remotes, indexed by channel.
+ */
+const PadFrame& Input::GetPads() const
+{
+    return Pads;
+}
+
+/**
+ * Get the random seed of the replayed session.
+ * @return The seed, 0 if nothing is replayed.
+ */
+u32 Input::GetSeed() const
+{
+    return Replaying ? Reader.GetSeed() : 0;
+}
+
+/**
+ * Check if the input comes from a recording.
+ * @return true if a session is replayed, false otherwise.
+ */
+bool Input::IsReplaying() const
+{
+    return Replaying;
+}
+
+/**
+ * Check if a replayed session is over.
+ * @return true once every frame of the recording was used, false otherwise.
+ */
+bool Input::IsFinished() const
+{
+    return Finished;
+}
+
+// EOF
@@ -0,0 +1,51 @@
+// source/input.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#ifndef InputH
+#define InputH
+//---------------------------------------------------------------------------
+
+#include "inputstream.h"
+
+/**
+ * Source of the Wii Remote state of each frame.
+ * The state comes from WPAD, or from a stream when a session is replayed.
+ * Live input can be recorded at the same time.
+ * @author Crayon
+ */
+class Input
+{
+public:
+    Input() = default;
+    Input(Input const&) = delete;
+    ~Input() = default;
+    Input& operator=(Input const&) = delete;
+
+    bool Record(const char *filename, u32 Seed);
+    void StopRecording();
+    bool Replay(const char *filename);
+    void Scan();
+    [[nodiscard]] const PadState& GetPad(u8 Chan) const;
+    [[nodiscard]] const PadFrame& GetPads() const;
+    [[nodiscard]] u32 GetSeed() const;
+    [[nodiscard]] bool IsReplaying() const;
+    [[nodiscard]] bool IsFinished() const;
+private:
+    PadFrame Pads{};
+    InputWriter Writer;
+    InputReader Reader;
+    bool Replaying{false};
+    bool Finished{false};
+};
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
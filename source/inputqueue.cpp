@@ -0,0 +1,124 @@
+// source/inputqueue.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#include "inputqueue.h"
+
+/**
+ * Queue the events of a new frame.
+ * The pointer moves come first, so a press is handled with every pointer
+ * at its new position, then the presses and the releases of each Wii
+ * Remote, each button in the order of its bit.
+ * @param[in] Frame The state of every Wii Remote.
+ */
+void InputQueue::Scan(const PadFrame &Frame)
+{
+    for(u8 Chan = 0; Chan < MAX_PADS; ++Chan)
+    {
+        const PadState &Pad = Frame[Chan];
+        const PadState &Last = Previous[Chan];
+        if(Pad.IRValid != Last.IRValid ||
+            (Pad.IRValid && (Pad.IRX != Last.IRX || Pad.IRY != Last.IRY || Pad.Roll != Last.Roll)))
+        {
+            Push({.What = InputEvent::Type::PointerMove, .Chan = Chan, .Pointing = Pad.IRValid,
+                .X = Pad.IRX, .Y = Pad.IRY, .Roll = Pad.Roll});
+        }
+    }
+
+    for(u8 Chan = 0; Chan < MAX_PADS; ++Chan)
+    {   // Only the buttons that changed are visited
+        for(u32 Buttons = Frame[Chan].Down; Buttons != 0; Buttons &= Buttons - 1)
+        {
+            Push({.What = InputEvent::Type::Press, .Chan = Chan, .Button = Buttons & (~Buttons + 1)});
+        }
+        for(u32 Buttons = Previous[Chan].Held & ~Frame[Chan].Held; Buttons != 0; Buttons &= Buttons - 1)
+        {
+            Push({.What = InputEvent::Type::Release, .Chan = Chan, .Button = Buttons & (~Buttons + 1)});
+        }
+    }
+    Previous = Frame;
+}
+
+/**
+ * Give the zone under each pointer, and queue the zones left and entered.
+ * Every zone left is queued before any zone entered, so a handler sees a
+ * zone left by a Wii Remote before the same zone is entered by another.
+ * @param[in] NewZones The zone of each Wii Remote, NO_ZONE if none.
+ */
+void InputQueue::SetZones(const std::array<s8, MAX_PADS> &NewZones)
+{
+    for(u8 Chan = 0; Chan < MAX_PADS; ++Chan)
+    {
+        if(Zones[Chan] != NewZones[Chan] && Zones[Chan] != NO_ZONE)
+        {
+            Push({.What = InputEvent::Type::ZoneLeave, .Chan = Chan, .Zone = Zones[Chan]});
+        }
+    }
+    for(u8 Chan = 0; Chan < MAX_PADS; ++Chan)
+    {
+        if(Zones[Chan] != NewZones[Chan] && NewZones[Chan] != NO_ZONE)
+        {
+            Push({.What = InputEvent::Type::ZoneEnter, .Chan = Chan, .Zone = NewZones[Chan]});
+        }
+    }
+    Zones = NewZones;
+}
+
+/**
+ * Remove the oldest event.
+ * @param[out] Event The event removed.
+ * @return true if an event was removed, false if the queue is empty.
+ */
+bool InputQueue::Pop(InputEvent &Event)
+{
+    if(Head == Count)
+    {
+        Head = 0;
+        Count = 0;
+        return false;
+    }
+    Event = Events[Head++];
+    return true;
+}
+
+/**
+ * Forget the zones, for a new screen whose zones are numbered differently.
+ * The zones under the pointers are entered again by the next SetZones,
+ * without leaving the ones of the old screen.
+ */
+void InputQueue::ClearZones()
+{
+    Zones.fill(NO_ZONE);
+}
+
+/**
+ * Get the number of events lost because the queue was full.
+ * @return The number of events, since the start.
+ */
+u32 InputQueue::GetDropped() const
+{
+    return Dropped;
+}
+
+/**
+ * Add an event at the end of the queue.
+ * @param[in] Event The event to add, dropped if the queue is full.
+ */
+void InputQueue::Push(const InputEvent &Event)
+{
+    if(Count == Events.size())
+    {
+        ++Dropped;
+        return;
+    }
+    Events[Count++] = Event;
+}
+
+// EOF
@@ -0,0 +1,85 @@
+// source/inputqueue.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#ifndef InputQueueH
+#define InputQueueH
+//---------------------------------------------------------------------------
+
+#include <array>
+#include "inputstream.h"
+
+/**
+ * Something that happened to a Wii Remote during a frame.
+ */
+struct InputEvent
+{
+    /**
+     * Types of event, in the order of the handler tables.
+     */
+    enum class Type : u8 {
+        Press,       /**< A button was pressed. */
+        Release,     /**< A button was released. */
+        PointerMove, /**< The pointer moved, or started or stopped pointing at the screen. */
+        ZoneEnter,   /**< The pointer entered a zone of the screen. */
+        ZoneLeave,   /**< The pointer left a zone of the screen. */
+        Count        /**< Number of types. */
+    };
+
+    Type What{Type::Press};
+    u8 Chan{0};            /**< The Wii Remote channel, from 0 to 3. */
+    s8 Zone{-1};           /**< The zone entered or left. */
+    bool Pointing{false};  /**< The remote points at the screen, for a pointer move. */
+    u32 Button{0};         /**< The WPAD_BUTTON_* of a press or a release. */
+    f32 X{0.0f};           /**< Pointer x-coordinate, for a pointer move. */
+    f32 Y{0.0f};           /**< Pointer y-coordinate, for a pointer move. */
+    f32 Roll{0.0f};        /**< Rotation of the remote in degrees, for a pointer move. */
+};
+
+/**
+ * Queue of the input events of a frame.
+ * Scan compares the state of each Wii Remote with the previous frame and
+ * queues an event for each button pressed or released and for each pointer
+ * that moved, so a frame where nothing happens queues nothing. Zones are
+ * parts of the screen, numbered by the screen showing them; SetZones is
+ * given the zone under each pointer and queues the zones left and entered.
+ * The events are removed in the order they were queued.
+ * @author Crayon
+ */
+class InputQueue
+{
+public:
+    static constexpr s8 NO_ZONE = -1;     /**< The pointer is not over a zone. */
+    static constexpr size_t CAPACITY = 128; /**< Events kept at most, more than a frame can make. */
+
+    InputQueue() = default;
+    InputQueue(InputQueue const&) = delete;
+    ~InputQueue() = default;
+    InputQueue& operator=(InputQueue const&) = delete;
+
+    void Scan(const PadFrame &Frame);
+    void SetZones(const std::array<s8, MAX_PADS> &NewZones);
+    bool Pop(InputEvent &Event);
+    void ClearZones();
+    [[nodiscard]] u32 GetDropped() const;
+private:
+    void Push(const InputEvent &Event);
+
+    std::array<InputEvent, CAPACITY> Events;
+    size_t Head{0};     /**< Next event to remove. */
+    size_t Count{0};    /**< Events queued, including the removed ones until the queue is empty. */
+    u32 Dropped{0};     /**< Events lost because the queue was full. */
+    PadFrame Previous{};
+    std::array<s8, MAX_PADS> Zones{NO_ZONE, NO_ZONE, NO_ZONE, NO_ZONE};
+};
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
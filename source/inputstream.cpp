@@ -0,0 +1,307 @@
+// source/inputstream.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include "inputstream.h"
+
+/**
+ * File signature followed by the format version.
+ */
+static constexpr char STREAM_MAGIC[4] = {'W', 'T', 'T', 'I'};
+static constexpr u8 STREAM_VERSION = 1;
+static constexpr size_t HEADER_SIZE = sizeof(STREAM_MAGIC) + 1 + 4;
+
+/**
+ * Bits of the flags written before a pad state.
+ */
+enum PadFlags : u8
+{
+    FLAG_CONNECTED = 0x01, /**< The remote is connected. */
+    FLAG_IR_VALID  = 0x02, /**< IR position and roll follow. */
+    FLAG_DOWN      = 0x04, /**< Pressed buttons follow. */
+    FLAG_HELD      = 0x08  /**< Held buttons follow. */
+};
+
+/**
+ * Steps per pixel of the pointer and per degree of roll.
+ */
+static constexpr f32 IR_STEPS = 4.0f;
+static constexpr f32 ROLL_STEPS = 100.0f;
+
+/**
+ * Convert a value to the fixed point stored in a stream.
+ */
+static s16 ToFixed(f32 Value, f32 Steps)
+{
+    return std::clamp<long>(std::lround(Value * Steps), INT16_MIN, INT16_MAX);
+}
+
+/**
+ * Round the analog values of a pad to the precision of a stream.
+ * It is applied to live input too, so the game sees exactly the same values
+ * when a recording is replayed.
+ * @param[in,out] Pad The pad state.
+ */
+void QuantizePad(PadState &Pad)
+{
+    if(!Pad.IRValid)
+    {
+        Pad.IRX = Pad.IRY = Pad.Roll = 0.0f;
+        return;
+    }
+    Pad.IRX = ToFixed(Pad.IRX, IR_STEPS) / IR_STEPS;
+    Pad.IRY = ToFixed(Pad.IRY, IR_STEPS) / IR_STEPS;
+    Pad.Roll = ToFixed(Pad.Roll, ROLL_STEPS) / ROLL_STEPS;
+}
+
+/**
+ * Append a little-endian integer to a buffer.
+ */
+template <typename T>
+static void Put(std::vector<u8> &Buffer, T Value)
+{
+    for(size_t i = 0; i < sizeof(T); ++i)
+    {
+        Buffer.push_back(static_cast<u8>(static_cast<u32>(Value) >> (i * 8)));
+    }
+}
+
+/**
+ * Read a little-endian integer from a buffer.
+ * @return false if the buffer is too short.
+ */
+template <typename T>
+static bool Get(const std::vector<u8> &Buffer, size_t &Position, T &Value)
+{
+    if(Position + sizeof(T) > Buffer.size())
+    {
+        return false;
+    }
+    u32 Result = 0;
+    for(size_t i = 0; i < sizeof(T); ++i)
+    {
+        Result |= static_cast<u32>(Buffer[Position++]) << (i * 8);
+    }
+    Value = static_cast<T>(Result);
+    return true;
+}
+
+/**
+ * Destructor for the InputWriter class.
+ */
+InputWriter::~InputWriter()
+{
+    Close();
+}
+
+/**
+ * Create a stream.
+ * @param[in] filename Name of the file to write.
+ * @param[in] Seed Random seed used by the recorded session.
+ * @return true if the file was created, false otherwise.
+ */
+bool InputWriter::Open(const char *filename, u32 Seed)
+{
+    Close();
+    File = std::fopen(filename, "wb");
+    if(File == nullptr)
+    {
+        return false;
+    }
+    Buffer.assign(std::begin(STREAM_MAGIC), std::end(STREAM_MAGIC));
+    Put<u8>(Buffer, STREAM_VERSION);
+    Put<u32>(Buffer, Seed);
+    std::fwrite(Buffer.data(), 1, Buffer.size(), File);
+    Previous = PadFrame{};
+    return true;
+}
+
+/**
+ * Append a frame to the stream.
+ * @param[in] Frame The quantized state of every pad.
+ */
+void InputWriter::Write(const PadFrame &Frame)
+{
+    if(File == nullptr)
+    {
+        return;
+    }
+
+    Buffer.assign(1, 0);
+    for(u8 i = 0; i < MAX_PADS; ++i)
+    {
+        const PadState &Pad = Frame[i];
+        if(Pad == Previous[i])
+        {
+            continue;
+        }
+        Buffer[0] |= 1 << i;
+
+        const u8 Flags = (Pad.Connected ? FLAG_CONNECTED : 0) |
+                         (Pad.IRValid ? FLAG_IR_VALID : 0) |
+                         (Pad.Down != 0 ? FLAG_DOWN : 0) |
+                         (Pad.Held != 0 ? FLAG_HELD : 0);
+        Put<u8>(Buffer, Flags);
+        if(Flags & FLAG_DOWN)
+        {
+            Put<u32>(Buffer, Pad.Down);
+        }
+        if(Flags & FLAG_HELD)
+        {
+            Put<u32>(Buffer, Pad.Held);
+        }
+        if(Flags & FLAG_IR_VALID)
+        {
+            Put<u16>(Buffer, ToFixed(Pad.IRX, IR_STEPS));
+            Put<u16>(Buffer, ToFixed(Pad.IRY, IR_STEPS));
+            Put<u16>(Buffer, ToFixed(Pad.Roll, ROLL_STEPS));
+        }
+    }
+    std::fwrite(Buffer.data(), 1, Buffer.size(), File);
+    Previous = Frame;
+}
+
+/**
+ * Close the stream, the file is complete after this call.
+ */
+void InputWriter::Close()
+{
+    if(File != nullptr)
+    {
+        std::fclose(File);
+        File = nullptr;
+    }
+}
+
+/**
+ * Load a stream.
+ * @param[in] filename Name of the file to read.
+ * @return true if the file is a valid stream, false otherwise.
+ */
+bool InputReader::Open(const char *filename)
+{
+    Data.clear();
+    Position = 0;
+    Previous = PadFrame{};
+
+    std::FILE *File = std::fopen(filename, "rb");
+    if(File == nullptr)
+    {
+        return false;
+    }
+    u8 Chunk[4096];
+    size_t Count;
+    while((Count = std::fread(Chunk, 1, sizeof(Chunk), File)) > 0)
+    {
+        Data.insert(Data.end(), Chunk, Chunk + Count);
+    }
+    std::fclose(File);
+
+    u8 Version = 0;
+    if(Data.size() < HEADER_SIZE ||
+       std::memcmp(Data.data(), STREAM_MAGIC, sizeof(STREAM_MAGIC)) != 0)
+    {
+        Data.clear();
+        return false;
+    }
+    Position = sizeof(STREAM_MAGIC);
+    if(!Get(Data, Position, Version) || Version != STREAM_VERSION || !Get(Data, Position, Seed))
+    {
+        Data.clear();
+        Position = 0;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Read the next frame.
+ * @param[out] Frame The state of every pad.
+ * @return false at the end of the stream or if it is truncated.
+ */
+bool InputReader::Read(PadFrame &Frame)
+{
+    // A truncated frame is not consumed, so IsFinished stays false
+    const size_t Start = Position;
+    auto Truncated = [this, Start]()
+    {
+        Position = Start;
+        return false;
+    };
+
+    u8 Changed = 0;
+    if(!Get(Data, Position, Changed))
+    {
+        return false;
+    }
+    PadFrame Next = Previous;
+    for(u8 i = 0; i < MAX_PADS; ++i)
+    {
+        if((Changed & (1 << i)) == 0)
+        {
+            continue;
+        }
+        PadState Pad;
+        u8 Flags = 0;
+        if(!Get(Data, Position, Flags))
+        {
+            return Truncated();
+        }
+        Pad.Connected = Flags & FLAG_CONNECTED;
+        Pad.IRValid = Flags & FLAG_IR_VALID;
+        if((Flags & FLAG_DOWN) && !Get(Data, Position, Pad.Down))
+        {
+            return Truncated();
+        }
+        if((Flags & FLAG_HELD) && !Get(Data, Position, Pad.Held))
+        {
+            return Truncated();
+        }
+        if(Flags & FLAG_IR_VALID)
+        {
+            u16 X, Y, Roll;
+            if(!Get(Data, Position, X) || !Get(Data, Position, Y) || !Get(Data, Position, Roll))
+            {
+                return Truncated();
+            }
+            Pad.IRX = static_cast<s16>(X) / IR_STEPS;
+            Pad.IRY = static_cast<s16>(Y) / IR_STEPS;
+            Pad.Roll = static_cast<s16>(Roll) / ROLL_STEPS;
+        }
+        Next[i] = Pad;
+    }
+    Previous = Next;
+    Frame = Next;
+    return true;
+}
+
+/**
+ * Get the random seed of the recorded session.
+ * @return The seed.
+ */
+u32 InputReader::GetSeed() const
+{
+    return Seed;
+}
+
+/**
+ * Check if every frame was read.
+ * @return true at the end of the stream, false otherwise.
+ */
+bool InputReader::IsFinished() const
+{
+    return Position >= Data.size();
+}
+
+// EOF
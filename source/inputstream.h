@@ -0,0 +1,93 @@
+// source/inputstream.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#ifndef InputStreamH
+#define InputStreamH
+//---------------------------------------------------------------------------
+
+#include <array>
+#include <cstdio>
+#include <vector>
+#include <gctypes.h>
+
+/**
+ * State of a Wii Remote for one frame.
+ */
+struct PadState
+{
+    u32 Down{0};            /**< Buttons pressed since the previous frame. */
+    u32 Held{0};            /**< Buttons held down. */
+    f32 IRX{0.0f};          /**< Pointer x-coordinate, only set if IRValid is true. */
+    f32 IRY{0.0f};          /**< Pointer y-coordinate, only set if IRValid is true. */
+    f32 Roll{0.0f};         /**< Rotation of the remote in degrees, only set if IRValid is true. */
+    bool IRValid{false};    /**< The remote points at the screen. */
+    bool Connected{false};  /**< The remote is connected. */
+
+    bool operator==(const PadState&) const = default;
+};
+
+/**
+ * Number of Wii Remotes recorded in a frame.
+ */
+inline constexpr u8 MAX_PADS = 4;
+
+/**
+ * State of every Wii Remote for one frame.
+ */
+using PadFrame = std::array<PadState, MAX_PADS>;
+
+void QuantizePad(PadState &Pad);
+
+/**
+ * Write the input of each frame to a file.
+ * A frame only stores the remotes that changed since the previous frame,
+ * an idle frame takes a single byte.
+ * @author Crayon
+ */
+class InputWriter
+{
+public:
+    InputWriter() = default;
+    InputWriter(InputWriter const&) = delete;
+    ~InputWriter();
+    InputWriter& operator=(InputWriter const&) = delete;
+
+    bool Open(const char *filename, u32 Seed);
+    void Write(const PadFrame &Frame);
+    void Close();
+private:
+    std::FILE *File{nullptr};
+    PadFrame Previous{};
+    std::vector<u8> Buffer;
+};
+
+/**
+ * Read the input written by InputWriter.
+ * The whole file is loaded when opened, no file access is done while playing.
+ * @author Crayon
+ */
+class InputReader
+{
+public:
+    bool Open(const char *filename);
+    bool Read(PadFrame &Frame);
+    [[nodiscard]] u32 GetSeed() const;
+    [[nodiscard]] bool IsFinished() const;
+private:
+    std::vector<u8> Data;
+    size_t Position{0};
+    u32 Seed{0};
+    PadFrame Previous{};
+};
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
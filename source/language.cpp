@@ -9,100 +9,267 @@
 // it under the terms of the MIT License. A copy of the license is
 // located in the LICENSE file included with this distribution.
 
-#include <mxml.h>
+#include <algorithm>
+#include <cstdio>
+#include <string>
 #include <ogc/conf.h>
 #include <random>  // Add for random number generator
+#include "font.h"
+#include "memtrack.h"
+#include "trace.h"
+#include "xmlreader.h"
 #include "language.h"
 
-// Languages
-constexpr char english_xml[] = {
-    #embed "../languages/english.xml"
-};
-constexpr char french_xml[] = {
-    #embed "../languages/french.xml"
-};
-constexpr char german_xml[] = {
-    #embed "../languages/german.xml"
-};
-constexpr char dutch_xml[] = {
-    #embed "../languages/dutch.xml"
-};
-constexpr char spanish_xml[] = {
-    #embed "../languages/spanish.xml"
-};
-constexpr char italian_xml[] = {
-    #embed "../languages/italian.xml"
-};
-constexpr char japanese_xml[] = {
-    #embed "../languages/japanese.xml"
-};
+/**
+ * Folder where a language file replacing the compiled texts is looked for,
+ * named like the file of the languages folder, e.g. english.xml.
+ */
+static constexpr const char *LANGUAGES_PATH = "sd:/apps/Wii-Tac-Toe/languages/";
 
 /**
- * Constructor for the Language class.
+ * Elements holding a list of messages, in the order of LanguageData.
+ */
+static constexpr std::string_view MESSAGE_GROUPS[] = {"winning_game", "tie_game", "turn_over"};
+
+/**
+ * A language read from the SD card.
+ * Texts missing from the file keep their compiled translation, so a file
+ * may only contain the texts being worked on.
  */
-Language::Language() :
-    rng(std::random_device{}())  // Initialize random number generator once
+struct Language::LoadedLanguage
 {
-    SetLanguage(CONF_GetLanguage());
+    LoadedLanguage() = default;
+    LoadedLanguage(LoadedLanguage const&) = delete;
+    ~LoadedLanguage();
+    LoadedLanguage& operator=(LoadedLanguage const&) = delete;
 
-    mxml_node_t *Message_Node;
-    mxml_node_t *Up_Node;
+    bool Read(const LanguageData &Compiled, const Font &Glyphs, std::string &Error);
+
+    std::array<std::string, Languages::TEXT_COUNT> Translations;      /**< Texts of the file. */
+    std::bitset<Languages::TEXT_COUNT> Found;                        /**< Texts present in the file. */
+    std::array<std::vector<std::string>, 3> Messages;                /**< Messages of each group. */
+    std::array<std::string_view, Languages::TEXT_COUNT> Texts;        /**< Views given to LanguageData. */
+    std::array<std::vector<std::string_view>, 3> MessageViews;       /**< Views given to LanguageData. */
+    LanguageData Data{};                                             /**< The language, as if compiled. */
+    size_t Bytes{0};                                                 /**< Memory used, counted as Strings. */
+};
 
-    Up_Node = mxmlFindElement(First_Node, First_Node, "tie_game", nullptr, nullptr, MXML_DESCEND);
-    for(Message_Node = mxmlFindElement(Up_Node, Up_Node, "message", nullptr, nullptr, MXML_DESCEND);
-        Message_Node != nullptr;
-        Message_Node = mxmlFindElement(Message_Node, Up_Node, "message", nullptr, nullptr, MXML_DESCEND))
+/**
+ * Find a character that a font cannot draw.
+ * Spaces and control characters need no glyph.
+ * @param[in] Glyphs The font.
+ * @param[in] Text UTF-8 text.
+ * @return The first code point missing from the font, 0 if none.
+ */
+static u32 FindMissingGlyph(const Font &Glyphs, std::string_view Text)
+{
+    for(size_t Pos = 0; Pos < Text.size();)
     {
-        TieMessage.push_back(mxmlElementGetAttr(Message_Node, "text"));
+        const u32 Code = Font::NextCodePoint(Text, Pos);
+        if(Code > ' ' && Glyphs.FindGlyph(Code) == nullptr)
+        {
+            return Code;
+        }
     }
+    return 0;
+}
 
-    Up_Node = mxmlFindElement(First_Node, First_Node, "winning_game", nullptr, nullptr, MXML_DESCEND);
-    for(Message_Node = mxmlFindElement(Up_Node, Up_Node, "message", nullptr, nullptr, MXML_DESCEND);
-        Message_Node != nullptr;
-        Message_Node = mxmlFindElement(Message_Node, Up_Node, "message", nullptr, nullptr, MXML_DESCEND))
+/**
+ * Find a character of a language that a font cannot draw.
+ * @param[in] Glyphs The font.
+ * @param[in] Texts Texts and messages of the language.
+ * @return The first code point missing from the font, 0 if none.
+ */
+static u32 FindMissingGlyph(const Font &Glyphs, const LanguageData &Texts)
+{
+    const std::string_view *Messages[] = {Texts.WinningMessages, Texts.TieMessages, Texts.TurnOverMessages};
+    const u16 Counts[] = {Texts.WinningCount, Texts.TieCount, Texts.TurnOverCount};
+    u32 Code = 0;
+    for(u16 i = 0; i < Languages::TEXT_COUNT && Code == 0; ++i)
     {
-        WinningMessage.push_back(mxmlElementGetAttr(Message_Node, "text"));
+        Code = FindMissingGlyph(Glyphs, Texts.Texts[i]);
     }
-
-    Up_Node = mxmlFindElement(First_Node, First_Node, "turn_over", nullptr, nullptr, MXML_DESCEND);
-    for(Message_Node = mxmlFindElement(Up_Node, Up_Node, "message", nullptr, nullptr, MXML_DESCEND);
-        Message_Node != nullptr;
-        Message_Node = mxmlFindElement(Message_Node, Up_Node, "message", nullptr, nullptr, MXML_DESCEND))
+    for(size_t Group = 0; Group < std::size(Messages); ++Group)
     {
-        TurnOverMessage.push_back(mxmlElementGetAttr(Message_Node, "text"));
+        for(u16 i = 0; i < Counts[Group] && Code == 0; ++i)
+        {
+            Code = FindMissingGlyph(Glyphs, Messages[Group][i]);
+        }
     }
+    return Code;
+}
+
+/**
+ * Constructor for the Language class.
+ * @param[in] Seed Seed of the generator used to pick random messages.
+ * @param[in] AFont Font of the texts, it must outlive the object.
+ */
+Language::Language(u32 Seed, const Font &AFont) :
+    TextFont(AFont),
+    rng(Seed)  // Initialize random number generator once
+{
+    static_assert(std::size(MESSAGE_GROUPS) == 3);
+    SetLanguage(CONF_GetLanguage());
 }
 
 /**
  * Destructor for the Language class.
  */
-Language::~Language()
+Language::~Language() = default;
+
+/**
+ * Destructor for the LoadedLanguage struct.
+ */
+Language::LoadedLanguage::~LoadedLanguage()
 {
-    if(First_Node != nullptr)
-    {
-        mxmlDelete(First_Node);
-    }
+    MemTrack::Remove(MemTrack::Category::Strings, Bytes);
 }
 
 /**
- * Load a text from an XML file in memory.
- * @param[in] From Original string to translate.
- * @return Translated string.
+ * Read the file replacing a compiled language.
+ * Unknown texts are ignored, a group without message keeps the compiled
+ * messages. A text with a character the font cannot draw is skipped, so
+ * the compiled one is kept. Arguments are not checked like langc does: a
+ * text with invalid arguments is shown as is, see MessageTemplate.
+ * @param[in] Compiled The compiled language.
+ * @param[in] Glyphs The font of the texts.
+ * @param[out] Error Why the file is malformed, or which texts were skipped.
+ * @return true if the file was read, false if there is no file or it is malformed.
  */
-std::string Language::String(std::string_view From)
+bool Language::LoadedLanguage::Read(const LanguageData &Compiled, const Font &Glyphs, std::string &Error)
 {
-    if(From.empty() == true)
+    const std::string Path = std::string(LANGUAGES_PATH) + Compiled.Name + ".xml";
+    std::FILE *File = std::fopen(Path.c_str(), "rb");
+    if(File == nullptr)
     {
-        return "";
+        return false;
+    }
+    std::string Document;
+    char Chunk[4096];
+    size_t Count;
+    while((Count = std::fread(Chunk, 1, sizeof(Chunk), File)) > 0)
+    {
+        Document.append(Chunk, Count);
     }
+    std::fclose(File);
 
-    mxml_node_t *Text_Node = mxmlFindElement(First_Node, First_Node, "translation", "from", From.data(), MXML_DESCEND);
-    if(Text_Node == nullptr)
+    const std::string FileName = std::string(Compiled.Name) + ".xml";
+    u32 Skipped = 0;
+    u32 MissingCode = 0;
+    auto CanDraw = [&](const std::string &Text)
     {
-        return "";
+        const u32 Code = FindMissingGlyph(Glyphs, Text);
+        if(Code != 0)
+        {
+            MissingCode = (Skipped++ == 0) ? Code : MissingCode;
+        }
+        return Code == 0;
+    };
+
+    XmlReader Reader(Document);
+    while(Reader.Next())
+    {
+        const std::string_view Parent = Reader.GetParent();
+        if(Reader.GetName() == "translation" && Parent == "language")
+        {
+            const std::string *From = Reader.GetAttribute("from");
+            const std::string *To = Reader.GetAttribute("to");
+            const auto Key = (From != nullptr) ?
+                std::find(Languages::Keys.begin(), Languages::Keys.end(), *From) : Languages::Keys.end();
+            if(Key != Languages::Keys.end() && To != nullptr && CanDraw(*To))
+            {
+                const size_t Id = Key - Languages::Keys.begin();
+                Translations[Id] = *To;
+                Found.set(Id);
+            }
+        }
+        else if(Reader.GetName() == "message")
+        {
+            const auto Group = std::find(std::begin(MESSAGE_GROUPS), std::end(MESSAGE_GROUPS), Parent);
+            const std::string *Text = Reader.GetAttribute("text");
+            if(Group != std::end(MESSAGE_GROUPS) && Text != nullptr && CanDraw(*Text))
+            {
+                Messages[Group - std::begin(MESSAGE_GROUPS)].push_back(*Text);
+            }
+        }
+    }
+    if(Reader.HasError())
+    {
+        Error = FileName + ":" + std::to_string(Reader.GetLine()) + ": " + Reader.GetError();
+        return false;
+    }
+    if(Skipped > 0)
+    {
+        char Reason[64];
+        std::snprintf(Reason, sizeof(Reason), ": %u text(s) skipped, U+%04X is not in the font",
+            static_cast<unsigned>(Skipped), static_cast<unsigned>(MissingCode));
+        Error = FileName + Reason;
     }
 
-    return mxmlElementGetAttr(Text_Node, "to");
+    // Every string is stored, views can be taken
+    for(u16 i = 0; i < Languages::TEXT_COUNT; ++i)
+    {
+        Texts[i] = Found[i] ? std::string_view(Translations[i]) : Compiled.Texts[i];
+    }
+    const std::string_view *CompiledMessages[] = {Compiled.WinningMessages, Compiled.TieMessages, Compiled.TurnOverMessages};
+    const u16 CompiledCounts[] = {Compiled.WinningCount, Compiled.TieCount, Compiled.TurnOverCount};
+    for(size_t Group = 0; Group < Messages.size(); ++Group)
+    {
+        if(Messages[Group].empty())
+        {
+            MessageViews[Group].assign(CompiledMessages[Group], CompiledMessages[Group] + CompiledCounts[Group]);
+        }
+        else
+        {
+            MessageViews[Group].assign(Messages[Group].begin(), Messages[Group].end());
+        }
+    }
+    Data = {
+        Compiled.Name, Texts.data(),
+        MessageViews[0].data(), static_cast<u16>(MessageViews[0].size()),
+        MessageViews[1].data(), static_cast<u16>(MessageViews[1].size()),
+        MessageViews[2].data(), static_cast<u16>(MessageViews[2].size())
+    };
+    return true;
+}
+
+/**
+ * Translate a text.
+ * @param[in] Key Original text to translate.
+ * @return Translated text.
+ */
+std::string_view Language::String(TextKey Key) const
+{
+    return Data->Texts[Key.Id];
+}
+
+/**
+ * Translate a text with arguments.
+ * @param[in] Key Original text to translate.
+ * @param[out] Buffer Where the text is written.
+ * @param[in] Arguments Texts replacing the arguments.
+ * @return Translated text, it points to the buffer.
+ */
+std::string_view Language::Format(TextKey Key, std::span<char> Buffer, std::initializer_list<std::string_view> Arguments) const
+{
+    return TextTemplates[Key.Id].Render(Buffer, Arguments);
+}
+
+/**
+ * Parse a list of messages as templates.
+ * @param[in] Messages Texts of the messages.
+ * @param[in] Count Number of messages.
+ * @param[in] ArgumentCount Number of arguments of each message.
+ * @param[out] Templates The parsed messages.
+ */
+static void ParseMessages(const std::string_view *Messages, u16 Count, u8 ArgumentCount,
+    std::vector<MessageTemplate> &Templates)
+{
+    Templates.resize(Count);
+    for(u16 i = 0; i < Count; ++i)
+    {
+        Templates[i].Parse(Messages[i], ArgumentCount);
+    }
 }
 
 /**
@@ -111,57 +278,186 @@ std::string Language::String(std::string_view From)
  */
 void Language::SetLanguage(s32 Conf_Lang)
 {
-    mxml_node_t *Root_Node;
+    const LanguageData *Compiled;
     switch(Conf_Lang)
     {
         case CONF_LANG_FRENCH:
-            Root_Node = mxmlLoadString(nullptr, french_xml, MXML_TEXT_CALLBACK);
+            Compiled = &Languages::French;
             break;
         case CONF_LANG_GERMAN:
-            Root_Node = mxmlLoadString(nullptr, german_xml, MXML_TEXT_CALLBACK);
+            Compiled = &Languages::German;
             break;
         case CONF_LANG_DUTCH:
-            Root_Node = mxmlLoadString(nullptr, dutch_xml, MXML_TEXT_CALLBACK);
+            Compiled = &Languages::Dutch;
             break;
         case CONF_LANG_SPANISH:
-            Root_Node = mxmlLoadString(nullptr, spanish_xml, MXML_TEXT_CALLBACK);
+            Compiled = &Languages::Spanish;
             break;
         case CONF_LANG_ITALIAN:
-            Root_Node = mxmlLoadString(nullptr, italian_xml, MXML_TEXT_CALLBACK);
+            Compiled = &Languages::Italian;
             break;
         case CONF_LANG_JAPANESE:
-#ifdef DEBUG
-            Root_Node = mxmlLoadString(nullptr, japanese_xml, MXML_TEXT_CALLBACK);
+            // The baked font only has kana and kanji when built with WTT_CJK_FONT
+            Compiled = CanShow(Languages::Japanese) ? &Languages::Japanese : &Languages::English;
             break;
-#endif
         case CONF_LANG_KOREAN:
         case CONF_LANG_SIMP_CHINESE:
         case CONF_LANG_TRAD_CHINESE:
         default:    // CONF_LANG_ENGLISH
-            Root_Node = mxmlLoadString(nullptr, english_xml, MXML_TEXT_CALLBACK);
+            Compiled = &Languages::English;
             break;
     }
-    First_Node = mxmlFindElement(Root_Node, Root_Node, "language", nullptr, nullptr, MXML_DESCEND);
+    Select(std::find(Languages::All.begin(), Languages::All.end(), Compiled) - Languages::All.begin());
+}
+
+/**
+ * Check if the font has a glyph for every character of a language.
+ * @param[in] Texts Texts and messages of the language.
+ * @return true if the language can be drawn, false otherwise.
+ */
+bool Language::CanShow(const LanguageData &Texts) const
+{
+    return FindMissingGlyph(TextFont, Texts) == 0;
+}
+
+/**
+ * Change the language.
+ * A file of the same name on the SD card replaces the compiled texts, see
+ * Reload.
+ * @param[in] NewIndex Index of the language in Languages::All.
+ */
+void Language::Select(size_t NewIndex)
+{
+    Index = NewIndex % Languages::All.size();
+    Reload();
+}
+
+/**
+ * Change to a following or preceding language, in the order of Languages::All.
+ * The languages the font cannot draw are skipped.
+ * @param[in] Step Number of languages to move by, negative to go back.
+ */
+void Language::SelectNext(s32 Step)
+{
+    const s32 Count = Languages::All.size();
+    const s32 Direction = (Step < 0) ? -1 : 1;
+    s32 NewIndex = (static_cast<s32>(Index) + Step % Count + Count) % Count;
+    for(s32 Tries = 1; Tries < Count && !CanShow(*Languages::All[NewIndex]); ++Tries)
+    {
+        NewIndex = (NewIndex + Direction + Count) % Count;
+    }
+    Select(NewIndex);
+}
+
+/**
+ * Read again the language file of the SD card.
+ * The compiled texts are used when there is no file, or when it is
+ * malformed, see GetError. The game must be told to refresh its texts,
+ * see HasChanged.
+ * @return true if the texts come from the SD card, false otherwise.
+ */
+bool Language::Reload()
+{
+    TRACE_SCOPE("Language::Reload");
+    const LanguageData *Compiled = Languages::All[Index];
+    auto NewLoaded = std::make_unique<LoadedLanguage>();
+    Error.clear();
+    bool Found;
+    {
+        MemTrack::HeapScope Scope(MemTrack::Category::Strings, &NewLoaded->Bytes);
+        Found = NewLoaded->Read(*Compiled, TextFont, Error);
+    }
+    if(!Found)
+    {
+        NewLoaded.reset();
+    }
+
+    // The previous texts are freed once compared
+    Use(Found ? &NewLoaded->Data : Compiled);
+    Loaded = std::move(NewLoaded);
+    return Found;
+}
+
+/**
+ * Use the texts of a language.
+ * Texts with arguments are parsed here, once, instead of every time they
+ * are shown.
+ * @param[in] NewData Texts of the language.
+ */
+void Language::Use(const LanguageData *NewData)
+{
+    for(u16 i = 0; i < Languages::TEXT_COUNT; ++i)
+    {
+        Changed[i] = (Data == nullptr || Data->Texts[i] != NewData->Texts[i]);
+    }
+    Data = NewData;
+
+    for(u16 i = 0; i < Languages::TEXT_COUNT; ++i)
+    {
+        TextTemplates[i].Parse(Data->Texts[i], MessageTemplate::MAX_ARGUMENTS);
+    }
+    ParseMessages(Data->WinningMessages, Data->WinningCount, 2, WinningMessages);
+    ParseMessages(Data->TurnOverMessages, Data->TurnOverCount, 1, TurnOverMessages);
+}
+
+/**
+ * Get the name of the language in use.
+ * @return The name of its file, e.g. english.
+ */
+std::string_view Language::GetName() const
+{
+    return Data->Name;
+}
+
+/**
+ * Check if a text differs from the one of the previous language.
+ * Only the texts that changed need to be drawn again after a change of
+ * language or a reload.
+ * @param[in] Key Original text.
+ * @return true if the translation changed, false otherwise.
+ */
+bool Language::HasChanged(TextKey Key) const
+{
+    return Changed[Key.Id];
+}
+
+/**
+ * Check if the texts come from the SD card.
+ * @return true if a language file was loaded, false for the compiled texts.
+ */
+bool Language::IsLoaded() const
+{
+    return Loaded != nullptr;
+}
+
+/**
+ * Get why the last language file read was rejected or partly used.
+ * @return The file name and the reason, empty if the file was fully used or not found.
+ */
+std::string_view Language::GetError() const
+{
+    return Error;
 }
 
 /**
  * Get a winning message.
  * @param[in] Index The index of the message to get.
  *            If the value is under 0, a random message will be returned.
- * @return A winning message.
+ * @return A winning message, {0} is the winner and {1} the loser.
  */
-std::string Language::GetWinningMessage(s32 Index)
+const MessageTemplate& Language::GetWinningMessage(s32 Index)
 {
-    const s32 WinningCount = WinningMessage.size();
+    static const MessageTemplate Empty;
+    const s32 WinningCount = WinningMessages.size();
     if(Index < 0)
     {
         Index = rng() % WinningCount;
     }
     else if(Index >= WinningCount)
     {
-        return "";
+        return Empty;
     }
-    return WinningMessage[Index];
+    return WinningMessages[Index];
 }
 
 /**
@@ -170,9 +466,9 @@ std::string Language::GetWinningMessage(s32 Index)
  *            If the value is under 0, a random message will be returned.
  * @return A tie message.
  */
-std::string Language::GetTieMessage(s32 Index)
+std::string_view Language::GetTieMessage(s32 Index)
 {
-    const s32 TieCount = TieMessage.size();
+    const s32 TieCount = Data->TieCount;
     if(Index < 0)
     {
         Index = rng() % TieCount;
@@ -181,27 +477,28 @@ std::string Language::GetTieMessage(s32 Index)
     {
         return "";
     }
-    return TieMessage[Index];
+    return Data->TieMessages[Index];
 }
 
 /**
  * Get a turn over message.
  * @param[in] Index The index of the message to get.
  *            If the value is under 0, a random message will be returned.
- * @return A turn over message.
+ * @return A turn over message, {} is the player.
  */
-std::string Language::GetTurnOverMessage(s32 Index)
+const MessageTemplate& Language::GetTurnOverMessage(s32 Index)
 {
-    const s32 TurnOverCount = TurnOverMessage.size();
+    static const MessageTemplate Empty;
+    const s32 TurnOverCount = TurnOverMessages.size();
     if(Index < 0)
     {
         Index = rng() % TurnOverCount;
     }
     else if(Index >= TurnOverCount)
     {
-        return "";
+        return Empty;
     }
-    return TurnOverMessage[Index];
+    return TurnOverMessages[Index];
 }
 
 // EOF
@@ -13,14 +13,37 @@
 #define LanguageH
 //---------------------------------------------------------------------------
 
+#include <array>
+#include <bitset>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <vector>
 #include <gctypes.h>
 #include <random>  // Include for std::mt19937
+#include "languages.h"
+#include "messagetemplate.h"
 
-// Forward declarations
-struct _mxml_node_s;
+class Font;
+
+/**
+ * Text to translate, checked when the game is compiled.
+ * It is built from the original English text, which must be translated in
+ * every file of the languages folder.
+ */
+class TextKey
+{
+public:
+    /**
+     * Constructor for the TextKey class.
+     * @param[in] From Original text.
+     */
+    consteval TextKey(const char *From) :
+        Id(Languages::TextId(From))
+    {
+    }
+    u16 Id;  /**< Index of the text in LanguageData::Texts. */
+};
 
 /**
  * This is a class to manage different languages.
@@ -29,24 +52,41 @@ struct _mxml_node_s;
 class Language
 {
 public:
-    Language();
+    Language(u32 Seed, const Font &AFont);
     Language(Language const&) = delete;
     ~Language();
     Language& operator=(Language const&) = delete;
-    std::string String(std::string_view From);
-    std::string GetWinningMessage(s32 Index = -1);
-    std::string GetTieMessage(s32 Index = -1);
-    std::string GetTurnOverMessage(s32 Index = -1);
+    [[nodiscard]] std::string_view String(TextKey Key) const;
+    std::string_view Format(TextKey Key, std::span<char> Buffer, std::initializer_list<std::string_view> Arguments) const;
+    const MessageTemplate& GetWinningMessage(s32 Index = -1);
+    std::string_view GetTieMessage(s32 Index = -1);
+    const MessageTemplate& GetTurnOverMessage(s32 Index = -1);
+    void Select(size_t Index);
+    void SelectNext(s32 Step = 1);
+    bool Reload();
+    [[nodiscard]] std::string_view GetName() const;
+    [[nodiscard]] bool HasChanged(TextKey Key) const;
+    [[nodiscard]] bool IsLoaded() const;
+    [[nodiscard]] std::string_view GetError() const;
 private:
-    _mxml_node_s *First_Node;
+    struct LoadedLanguage;
+
+    const Font &TextFont;                    /**< Font of the texts, a language it cannot draw is skipped. */
+    size_t Index{0};                         /**< Index of the language in Languages::All. */
+    const LanguageData *Data{nullptr};       /**< Texts of the language in use. */
+    std::unique_ptr<LoadedLanguage> Loaded;  /**< Texts read from the SD card, nullptr if none. */
+    std::string Error;                       /**< Why the file was rejected or partly used, empty if it was not. */
+    std::bitset<Languages::TEXT_COUNT> Changed;  /**< Texts that differ from the previous language. */
 
-    std::vector<std::string> WinningMessage;
-    std::vector<std::string> TieMessage;
-    std::vector<std::string> TurnOverMessage;
+    std::array<MessageTemplate, Languages::TEXT_COUNT> TextTemplates;  /**< Texts parsed as templates. */
+    std::vector<MessageTemplate> WinningMessages;   /**< {0} is the winner, {1} the loser. */
+    std::vector<MessageTemplate> TurnOverMessages;  /**< {} is the player. */
 
     std::mt19937 rng;  // Random number generator
 
     void SetLanguage(s32 Conf_Lang);
+    [[nodiscard]] bool CanShow(const LanguageData &Texts) const;
+    void Use(const LanguageData *NewData);
 };
 //---------------------------------------------------------------------------
 #endif
@@ -0,0 +1,38 @@
+// source/languagedata.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#ifndef LanguageDataH
+#define LanguageDataH
+//---------------------------------------------------------------------------
+
+#include <string_view>
+#include <gctypes.h>
+
+/**
+ * Language compiled at build time by the langc tool.
+ * Every language has the same texts, in the same order, so a text is found
+ * by its index.
+ */
+struct LanguageData
+{
+    const char *Name;                         /**< Name of the language file, e.g. english. */
+    const std::string_view *Texts;            /**< Translations indexed by text ID. */
+    const std::string_view *WinningMessages;  /**< Messages when a player wins, {0} is the winner, {1} the loser. */
+    u16 WinningCount;                         /**< Number of winning messages. */
+    const std::string_view *TieMessages;      /**< Messages when nobody wins. */
+    u16 TieCount;                             /**< Number of tie messages. */
+    const std::string_view *TurnOverMessages; /**< Messages when a turn starts, {} is the player. */
+    u16 TurnOverCount;                        /**< Number of turn over messages. */
+};
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
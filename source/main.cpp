@@ -20,9 +20,21 @@
 //------------------------------------------------------------------------------
 // Headers
 //------------------------------------------------------------------------------
+#include <chrono>
 #include <cstdlib>
+#include <ctime>
+#include <format>
+#include <string_view>
+#include <ogc/video.h>
 #include <wiiuse/wpad.h>
 #include "grrlib_class.h"
+#include "gxbackend.h"
+#include "audiobackend.h"
+#include "aesndbackend.h"
+#include "input.h"
+#include "profiler.h"
+#include "trace.h"
+#include "hitch.h"
 #include "game.h"
 
 #define SYS_NOTSET          -1
@@ -61,33 +73,94 @@ void WiimotePowerPressed([[maybe_unused]] s32 chan)
 
 /**
  * Entry point.
+ * Options:
+ *  - --record <file>: Record the Wii Remote input of the session.
+ *  - --replay <file>: Play a recorded session instead of reading the Wii Remotes,
+ *                     the game exits at the end of the recording.
+ *  - --music <mode>: Mix the music module in stereo (default), mono or not at
+ *                    all (off), to save CPU time.
  * @param[in] argc The number of arguments invoked with the program.
  * @param[in] argv The array containing the arguments.
  * @return 0 on clean exit, an error code otherwise.
  */
-int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+int main(int argc, char **argv)
 {
+    const char *RecordFile = nullptr;
+    const char *ReplayFile = nullptr;
+    AesndBackend::ModuleMode MusicMode = AesndBackend::ModuleMode::Stereo;
+    for(int i = 1; i + 1 < argc; ++i)
+    {
+        const std::string_view Option = argv[i];
+        if(Option == "--record")
+        {
+            RecordFile = argv[++i];
+        }
+        else if(Option == "--replay")
+        {
+            ReplayFile = argv[++i];
+        }
+        else if(Option == "--music")
+        {
+            const std::string_view Mode = argv[++i];
+            if(Mode == "mono")
+            {
+                MusicMode = AesndBackend::ModuleMode::Mono;
+            }
+            else if(Mode == "off")
+            {
+                MusicMode = AesndBackend::ModuleMode::Off;
+            }
+        }
+    }
+
     // Video initialization
+    SetRenderBackend(std::make_unique<GXBackend>());
     Initialize();
 
+    // Audio is initialized by the game, through this backend
+    SetAudioBackend(std::make_unique<AesndBackend>(MusicMode));
+
     // Wiimote initialization
     WPAD_Init();
     WPAD_SetDataFormat(WPAD_CHAN_ALL, WPAD_FMT_BTNS_ACC_IR);
     WPAD_SetVRes(WPAD_CHAN_ALL, Screen::GetWidth(), Screen::GetHeight());
 
+    // Input initialization, a replayed session reuses its recorded seed
+    Input Pads;
+    if(ReplayFile != nullptr)
+    {
+        Pads.Replay(ReplayFile);
+    }
+    const u32 Seed = Pads.IsReplaying() ? Pads.GetSeed() : static_cast<u32>(std::time(nullptr));
+    if(RecordFile != nullptr)
+    {
+        Pads.Record(RecordFile, Seed);
+    }
+
     // Game initialization
-    Game *MyGame = new Game(Screen::GetWidth(), Screen::GetHeight());
+    Game *MyGame = new Game(Screen::GetWidth(), Screen::GetHeight(), Pads, Seed);
 
     SYS_SetResetCallback(WiiResetPressed);
     SYS_SetPowerCallback(WiiPowerPressed);
     WPAD_SetPowerButtonCallback(WiimotePowerPressed);
 
+    // A frame is 20 ms in 50 Hz PAL, 16.7 ms in the other modes
+    HitchDetector Hitches((VIDEO_GetCurrentTvMode() == VI_PAL) ? 20000 : 16667);
+
     while(true)
     {
         MyGame->Paint();
 
-        WPAD_ScanPads();
-        if(MyGame->ControllerManager() == true)
+        {
+            ScopedTimer Timer(Profiler::Phase::ScanPads);
+            Pads.Scan();
+        }
+        bool Quit;
+        {
+            ScopedTimer Timer(Profiler::Phase::Controller);
+            Quit = MyGame->ControllerManager();
+        }
+        if(Quit == true || Pads.IsFinished())
         {
             break;
         }
@@ -96,9 +169,29 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
             break;
         }
 
-        Render();
+        {
+            ScopedTimer Timer(Profiler::Phase::Render);
+            Render();
+        }
+        if(const u32 MusicTicks = GetAudioBackend().TakeModuleTicks(); MusicTicks != 0)
+        {   // Spent in the audio interrupt, while the other phases ran
+            Profiler::Add(Profiler::Phase::Music, MusicTicks);
+        }
+        Profiler::EndFrame();
+        TRACE_INSTANT("Frame");
+
+        if(Hitches.Update())
+        {   // The screen still shows the frame that was late
+            const auto now = std::chrono::time_point_cast<std::chrono::seconds>(std::chrono::system_clock::now());
+            const auto path = std::format("sd:/Hitch {:%F %H%M%S}", now);
+            ScreenShot(path + ".png");
+            Hitches.WriteReport((path + ".txt").c_str(), MyGame->GetState());
+            Trace::Save((path + ".json").c_str());
+        }
     }
 
+    // SYS_ResetSystem does not return, the recording is completed before it
+    Pads.StopRecording();
     delete MyGame;
     WPAD_Shutdown();
     Exit();
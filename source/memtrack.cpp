@@ -0,0 +1,168 @@
+// source/memtrack.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#include <algorithm>
+#include <array>
+#include <malloc.h>
+#include "memtrack.h"
+
+static constexpr size_t CATEGORY_COUNT = static_cast<size_t>(MemTrack::Category::Count);
+
+/**
+ * Memory budget of each category, in bytes.
+ */
+static constexpr std::array<size_t, CATEGORY_COUNT> Budgets = {
+    6 * 1024 * 1024,    // Texture
+    512 * 1024,         // Font
+    32 * 1024,          // Strings
+    1024 * 1024,        // Music
+    256 * 1024          // Audio
+};
+
+static std::array<MemTrack::Usage, CATEGORY_COUNT> Categories = []()
+{
+    std::array<MemTrack::Usage, CATEGORY_COUNT> Result{};
+    for(size_t i = 0; i < CATEGORY_COUNT; ++i)
+    {
+        Result[i].Budget = Budgets[i];
+    }
+    return Result;
+}();
+
+/**
+ * Account for memory allocated by a category.
+ * @param[in] Which The category.
+ * @param[in] Bytes Size of the allocation.
+ */
+void MemTrack::Add(Category Which, size_t Bytes)
+{
+    Usage &Item = Categories[static_cast<size_t>(Which)];
+    Item.Live += Bytes;
+    Item.Peak = std::max(Item.Peak, Item.Live);
+    ++Item.Allocations;
+}
+
+/**
+ * Account for memory freed by a category.
+ * @param[in] Which The category.
+ * @param[in] Bytes Size given to Add when it was allocated.
+ */
+void MemTrack::Remove(Category Which, size_t Bytes)
+{
+    Usage &Item = Categories[static_cast<size_t>(Which)];
+    Item.Live -= std::min(Item.Live, Bytes);
+}
+
+/**
+ * Account for an allocation freed soon after, like a returned string.
+ * @param[in] Which The category.
+ * @param[in] Bytes Size of the allocation.
+ */
+void MemTrack::AddTransient(Category Which, size_t Bytes)
+{
+    Usage &Item = Categories[static_cast<size_t>(Which)];
+    Item.Transient += Bytes;
+    ++Item.Allocations;
+}
+
+/**
+ * Get the memory used by a category.
+ * @param[in] Which The category.
+ * @return The usage.
+ */
+const MemTrack::Usage& MemTrack::Get(Category Which)
+{
+    return Categories[static_cast<size_t>(Which)];
+}
+
+/**
+ * Check if a category went over its budget.
+ * The peak is used, so a short spike is not missed.
+ * @param[in] Which The category.
+ * @return true if over budget, false otherwise.
+ */
+bool MemTrack::IsOverBudget(Category Which)
+{
+    const Usage &Item = Get(Which);
+    return Item.Budget != 0 && Item.Peak > Item.Budget;
+}
+
+/**
+ * Get the name of a category.
+ * @param[in] Which The category.
+ * @return A short name.
+ */
+const char* MemTrack::GetName(Category Which)
+{
+    static constexpr std::array<const char*, CATEGORY_COUNT> Names = {
+        "Texture", "Font", "Strings", "Music", "Audio"
+    };
+    return Names[static_cast<size_t>(Which)];
+}
+
+/**
+ * Get the number of bytes allocated on the heap, by anyone.
+ * @return The size in bytes.
+ */
+size_t MemTrack::GetHeapInUse()
+{
+#ifdef __GLIBC__
+    const struct mallinfo2 Info = mallinfo2(); // Large blocks are mapped apart from the heap
+    return Info.uordblks + Info.hblkhd;
+#else
+    return mallinfo().uordblks;
+#endif
+}
+
+/**
+ * Write the usage of every category as text.
+ * @param[in] File An open file.
+ */
+void MemTrack::Dump(std::FILE *File)
+{
+    std::fprintf(File, "Heap in use: %zu bytes\n", GetHeapInUse());
+    std::fputs("Category\tLive\tPeak\tBudget\tAllocations\tTransient\n", File);
+    for(size_t i = 0; i < CATEGORY_COUNT; ++i)
+    {
+        const Category Which = static_cast<Category>(i);
+        const Usage &Item = Get(Which);
+        std::fprintf(File, "%s\t%zu\t%zu\t%zu\t%u\t%zu%s\n", GetName(Which), Item.Live, Item.Peak,
+            Item.Budget, Item.Allocations, Item.Transient, IsOverBudget(Which) ? "\tOVER BUDGET" : "");
+    }
+}
+
+/**
+ * Constructor for the HeapScope class.
+ * @param[in] AWhich The category to add the growth to.
+ * @param[out] AResult If not nullptr, receives the growth at the end of the scope.
+ */
+MemTrack::HeapScope::HeapScope(Category AWhich, size_t *AResult) :
+    Which(AWhich),
+    Result(AResult),
+    Start(GetHeapInUse())
+{
+}
+
+/**
+ * Destructor for the HeapScope class.
+ */
+MemTrack::HeapScope::~HeapScope()
+{
+    const size_t End = GetHeapInUse();
+    const size_t Growth = (End > Start) ? End - Start : 0;
+    Add(Which, Growth);
+    if(Result != nullptr)
+    {
+        *Result = Growth;
+    }
+}
+
+// EOF
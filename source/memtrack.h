@@ -0,0 +1,82 @@
+// source/memtrack.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#ifndef MemTrackH
+#define MemTrackH
+//---------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdio>
+#include <gctypes.h>
+
+/**
+ * Namespace containing the memory accounting per subsystem.
+ * Subsystems report what they allocate and free. Memory allocated inside
+ * libraries (GRRMOD, AESND) is measured as the growth of the heap
+ * around the call, with a HeapScope.
+ * @author Crayon
+ */
+namespace MemTrack
+{
+    /**
+     * Subsystems that own memory.
+     */
+    enum class Category : u8 {
+        Texture, /**< Texels of the textures. */
+        Font,    /**< Font atlases. */
+        Strings, /**< Strings built at runtime. */
+        Music,   /**< Module player and the module. */
+        Audio,   /**< Sound effects mixer and voices. */
+        Count    /**< Number of categories. */
+    };
+
+    /**
+     * Memory used by a category, in bytes.
+     */
+    struct Usage
+    {
+        size_t Live{0};        /**< Currently allocated. */
+        size_t Peak{0};        /**< Highest value of Live. */
+        size_t Budget{0};      /**< Expected maximum of Live, 0 if there is none. */
+        u32 Allocations{0};    /**< Number of allocations, including transient ones. */
+        size_t Transient{0};   /**< Total size of short-lived allocations. */
+    };
+
+    void Add(Category Which, size_t Bytes);
+    void Remove(Category Which, size_t Bytes);
+    void AddTransient(Category Which, size_t Bytes);
+    [[nodiscard]] const Usage& Get(Category Which);
+    [[nodiscard]] bool IsOverBudget(Category Which);
+    [[nodiscard]] const char* GetName(Category Which);
+    [[nodiscard]] size_t GetHeapInUse();
+    void Dump(std::FILE *File);
+
+    /**
+     * Add the growth of the heap during a scope to a category.
+     * The growth is returned so it can be removed when the memory is freed.
+     */
+    class HeapScope
+    {
+    public:
+        explicit HeapScope(Category AWhich, size_t *AResult = nullptr);
+        HeapScope(HeapScope const&) = delete;
+        ~HeapScope();
+        HeapScope& operator=(HeapScope const&) = delete;
+    private:
+        Category Which;
+        size_t *Result;
+        size_t Start;
+    };
+}   /* namespace MemTrack */
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
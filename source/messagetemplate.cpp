@@ -0,0 +1,165 @@
+// source/messagetemplate.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#include <algorithm>
+#include <cstring>
+#include "messagetemplate.h"
+
+/**
+ * Parse a template.
+ * When the text is not valid, the template renders it unchanged, so a bad
+ * translation shows its text instead of stopping the game.
+ * @param[in] AFormat Text of the template, it must outlive the template.
+ * @param[in] ArgumentCount Number of arguments given when rendering.
+ * @return true if the text is valid, false otherwise.
+ */
+bool MessageTemplate::Parse(std::string_view AFormat, u8 ArgumentCount)
+{
+    Format = AFormat;
+    SegmentCount = 0;
+    Valid = false;
+
+    bool Automatic = false; // {} was used
+    bool Manual = false;    // {0} was used
+    u8 NextArgument = 0;
+    size_t Start = 0;
+    auto Fail = [this]()
+    {
+        SegmentCount = 0;
+        AddLiteral(0, Format.size());
+        return false;
+    };
+
+    for(size_t i = 0; i < Format.size(); ++i)
+    {
+        const char c = Format[i];
+        if(c != '{' && c != '}')
+        {
+            continue;
+        }
+        if(i + 1 < Format.size() && Format[i + 1] == c)
+        {   // Escaped brace, the first one is kept
+            if(!AddLiteral(Start, i + 1 - Start))
+            {
+                return Fail();
+            }
+            Start = ++i + 1;
+            continue;
+        }
+        if(c == '}')
+        {
+            return Fail();
+        }
+        const size_t End = Format.find('}', i);
+        if(End == std::string_view::npos || !AddLiteral(Start, i - Start))
+        {
+            return Fail();
+        }
+        const std::string_view Index = Format.substr(i + 1, End - i - 1);
+        u8 Argument;
+        if(Index.empty())
+        {
+            Automatic = true;
+            Argument = NextArgument++;
+        }
+        else if(Index.size() == 1 && Index[0] >= '0' && Index[0] <= '9')
+        {
+            Manual = true;
+            Argument = Index[0] - '0';
+        }
+        else
+        {   // Format specifications are not supported
+            return Fail();
+        }
+        if((Automatic && Manual) || Argument >= ArgumentCount || Argument >= MAX_ARGUMENTS ||
+           SegmentCount >= MAX_SEGMENTS)
+        {
+            return Fail();
+        }
+        Segments[SegmentCount++] = {0, 0, static_cast<s8>(Argument)};
+        Start = End + 1;
+        i = End;
+    }
+    if(!AddLiteral(Start, Format.size() - Start))
+    {
+        return Fail();
+    }
+    Valid = true;
+    return true;
+}
+
+/**
+ * Add a literal segment, empty ones are skipped.
+ * @return false if there is no room left.
+ */
+bool MessageTemplate::AddLiteral(size_t Offset, size_t Length)
+{
+    if(Length == 0)
+    {
+        return true;
+    }
+    if(SegmentCount >= MAX_SEGMENTS || Offset + Length > UINT16_MAX)
+    {
+        return false;
+    }
+    Segments[SegmentCount++] = {static_cast<u16>(Offset), static_cast<u16>(Length), -1};
+    return true;
+}
+
+/**
+ * Render the template into a buffer, nothing is allocated.
+ * A text too long for the buffer is cut, without splitting a UTF-8 character.
+ * @param[out] Buffer Where the text is written.
+ * @param[in] Arguments Texts replacing the arguments, a missing one is empty.
+ * @return The text, it points to the buffer.
+ */
+std::string_view MessageTemplate::Render(std::span<char> Buffer, std::initializer_list<std::string_view> Arguments) const
+{
+    size_t Length = 0;
+    for(u8 i = 0; i < SegmentCount; ++i)
+    {
+        const Segment &Item = Segments[i];
+        std::string_view Text;
+        if(Item.Argument < 0)
+        {
+            Text = Format.substr(Item.Offset, Item.Length);
+        }
+        else if(static_cast<size_t>(Item.Argument) < Arguments.size())
+        {
+            Text = Arguments.begin()[Item.Argument];
+        }
+        size_t Count = std::min(Text.size(), Buffer.size() - Length);
+        if(Count < Text.size())
+        {
+            while(Count > 0 && (static_cast<u8>(Text[Count]) & 0xC0) == 0x80)
+            {
+                --Count;
+            }
+            std::memcpy(Buffer.data() + Length, Text.data(), Count);
+            Length += Count;
+            break;
+        }
+        std::memcpy(Buffer.data() + Length, Text.data(), Count);
+        Length += Count;
+    }
+    return std::string_view(Buffer.data(), Length);
+}
+
+/**
+ * Check if the text of the template was valid.
+ * @return true if it was valid, false if it is rendered unchanged.
+ */
+bool MessageTemplate::IsValid() const
+{
+    return Valid;
+}
+
+// EOF
@@ -0,0 +1,64 @@
+// source/messagetemplate.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#ifndef MessageTemplateH
+#define MessageTemplateH
+//---------------------------------------------------------------------------
+
+#include <array>
+#include <initializer_list>
+#include <span>
+#include <string_view>
+#include <gctypes.h>
+
+/**
+ * Translated text with arguments, parsed once when the language is loaded.
+ * The syntax is the one of std::format without format specifications:
+ * {} or {0} and {1}, with {{ and }} for braces. The template points to its
+ * text, which must outlive it.
+ * @author Crayon
+ */
+class MessageTemplate
+{
+public:
+    /**
+     * Maximum number of arguments in a template.
+     */
+    static constexpr u8 MAX_ARGUMENTS = 2;
+
+    MessageTemplate() = default;
+
+    bool Parse(std::string_view AFormat, u8 ArgumentCount);
+    std::string_view Render(std::span<char> Buffer, std::initializer_list<std::string_view> Arguments) const;
+    [[nodiscard]] bool IsValid() const;
+private:
+    /**
+     * Part of a template, a piece of the text or an argument.
+     */
+    struct Segment
+    {
+        u16 Offset;   /**< Start of the text, for a literal. */
+        u16 Length;   /**< Length of the text, for a literal. */
+        s8 Argument;  /**< Index of the argument, -1 for a literal. */
+    };
+    static constexpr u8 MAX_SEGMENTS = 8;
+
+    std::string_view Format;                   /**< Text of the template. */
+    std::array<Segment, MAX_SEGMENTS> Segments{};
+    u8 SegmentCount{0};
+    bool Valid{false};
+
+    bool AddLiteral(size_t Offset, size_t Length);
+};
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
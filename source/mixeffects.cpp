@@ -0,0 +1,99 @@
+// source/mixeffects.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#include <algorithm>
+#include <cmath>
+#include "mixeffects.h"
+
+/**
+ * Constructor for the MixEffects class.
+ * @param[in] SampleRate The sample rate of the output.
+ */
+MixEffects::MixEffects(u32 SampleRate) :
+    MuffledCoefficient(MixKernels::GetLowPassCoefficient(MUFFLED_CUTOFF, SampleRate))
+{
+}
+
+/**
+ * Set the volume of the mix.
+ * @param[in] AVolume The volume, between 0.0 and 1.0.
+ */
+void MixEffects::SetVolume(f32 AVolume)
+{
+    Volume.store(std::clamp(AVolume, 0.0f, 1.0f), std::memory_order_relaxed);
+}
+
+/**
+ * Set the balance of the mix.
+ * @param[in] ABalance From -1.0 (left only) to 1.0 (right only), 0.0 is the center.
+ */
+void MixEffects::SetBalance(f32 ABalance)
+{
+    Balance.store(std::clamp(ABalance, -1.0f, 1.0f), std::memory_order_relaxed);
+}
+
+/**
+ * Muffle the mix, as heard through a wall, or make it clear again.
+ * @param[in] AMuffled On or off.
+ */
+void MixEffects::SetMuffled(bool AMuffled)
+{
+    Muffled.store(AMuffled, std::memory_order_relaxed);
+}
+
+/**
+ * Apply the effects to a block of the output.
+ * The gain ramps to its new value over the block, the filter glides to
+ * its new cutoff over the next blocks.
+ * @param[in,out] Frames The interleaved 16-bit stereo samples.
+ */
+void MixEffects::Process(std::span<s16> Frames)
+{
+    if(Frames.size() < 2)
+    {
+        return;
+    }
+    const bool IsMuffled = Muffled.load(std::memory_order_relaxed);
+
+    const f32 Target = IsMuffled ? MuffledCoefficient : 1.0f;
+    Coefficient += (Target - Coefficient) * GLIDE;
+    if(std::abs(Target - Coefficient) < 0.001f)
+    {
+        Coefficient = Target;
+    }
+    if(Coefficient < 1.0f)
+    {
+        MixKernels::LowPass(Frames, Coefficient, Filter);
+    }
+    else
+    {   // Start from the last frame when the filter is turned on
+        Filter.Left = Frames[Frames.size() - 2];
+        Filter.Right = Frames[Frames.size() - 1];
+    }
+
+    const f32 Level = Volume.load(std::memory_order_relaxed) * (IsMuffled ? MUFFLED_VOLUME : 1.0f);
+    const f32 Pan = Balance.load(std::memory_order_relaxed);
+    const MixKernels::StereoGain NewGain = {
+        static_cast<s32>(Level * std::min(1.0f, 1.0f - Pan) * MixKernels::GAIN_ONE),
+        static_cast<s32>(Level * std::min(1.0f, 1.0f + Pan) * MixKernels::GAIN_ONE)
+    };
+    if(NewGain != Gain)
+    {
+        MixKernels::GainRamp(Frames, Gain, NewGain);
+        Gain = NewGain;
+    }
+    else if(Gain != MixKernels::StereoGain{})
+    {
+        MixKernels::Gain(Frames, Gain);
+    }
+}
+
+// EOF
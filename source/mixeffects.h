@@ -0,0 +1,60 @@
+// source/mixeffects.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#ifndef MixEffectsH
+#define MixEffectsH
+//---------------------------------------------------------------------------
+
+#include <atomic>
+#include <span>
+#include <gctypes.h>
+#include "mixkernels.h"
+
+/**
+ * Effects applied to the output, after the voices are mixed.
+ * The volume and the balance of the whole mix, and a muffled state where
+ * the mix goes through a low-pass filter. The settings can be changed
+ * from any thread; they are picked up by Process, which glides to them
+ * over a few blocks so nothing clicks. The backend calls Process on each
+ * block it outputs, in the audio interrupt on the Wii.
+ * @author Crayon
+ */
+class MixEffects
+{
+public:
+    static constexpr f32 MUFFLED_CUTOFF = 700.0f; /**< Low-pass cutoff when muffled, in Hz. */
+    static constexpr f32 MUFFLED_VOLUME = 0.7f;   /**< Volume factor when muffled. */
+
+    explicit MixEffects(u32 SampleRate);
+    MixEffects(MixEffects const&) = delete;
+    MixEffects& operator=(MixEffects const&) = delete;
+
+    void SetVolume(f32 AVolume);
+    void SetBalance(f32 ABalance);
+    void SetMuffled(bool AMuffled);
+    void Process(std::span<s16> Frames);
+private:
+    static constexpr f32 GLIDE = 0.25f; /**< Part of the way to the filter target made per block. */
+
+    std::atomic<f32> Volume{1.0f};
+    std::atomic<f32> Balance{0.0f};
+    std::atomic<bool> Muffled{false};
+
+    // Only used by Process
+    const f32 MuffledCoefficient;
+    f32 Coefficient{1.0f};  /**< Current low-pass coefficient, 1.0 when off. */
+    MixKernels::StereoGain Gain;
+    MixKernels::LowPassState Filter;
+};
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
@@ -0,0 +1,273 @@
+// source/mixkernels.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#include <cmath>
+#include <cstring>
+#include <numbers>
+#include "mixkernels.h"
+
+// 2 stereo frames, for the low-pass filter, whose frames depend on each other
+using VecS16 = s16 __attribute__((vector_size(8)));
+using VecS32 = s32 __attribute__((vector_size(16)));
+using VecF32 = f32 __attribute__((vector_size(16)));
+// 4 stereo frames, for the gains
+using WideS16 = s16 __attribute__((vector_size(16)));
+using WideS32 = s32 __attribute__((vector_size(32)));
+
+static constexpr u32 RAMP_SHIFT = 8; /**< Fraction bits of the gain while it ramps. */
+static constexpr f32 LOW_PASS_FLOOR = 1.0f / 1024.0f; /**< Smaller filter outputs are flushed to 0. */
+
+/**
+ * Ramp the gain of frames, by a fixed step per frame.
+ * @param[in,out] Frames The interleaved samples.
+ * @param[in] Left The left gain, with RAMP_SHIFT fraction bits.
+ * @param[in] Right The right gain, with RAMP_SHIFT fraction bits.
+ * @param[in] LeftStep Added to the left gain after each frame.
+ * @param[in] RightStep Added to the right gain after each frame.
+ */
+static void RampFrames(std::span<s16> Frames, s32 Left, s32 Right, s32 LeftStep, s32 RightStep)
+{
+    for(size_t i = 0; i + 1 < Frames.size(); i += 2)
+    {
+        Frames[i] = static_cast<s16>((Frames[i] * (Left >> RAMP_SHIFT)) >> 15);
+        Frames[i + 1] = static_cast<s16>((Frames[i + 1] * (Right >> RAMP_SHIFT)) >> 15);
+        Left += LeftStep;
+        Right += RightStep;
+    }
+}
+
+/**
+ * Get the step of a gain ramp.
+ * @param[in] From The gain of the first frame.
+ * @param[in] To The gain reached after the last frame.
+ * @param[in] Count Number of frames, not 0.
+ * @return The step per frame, with RAMP_SHIFT fraction bits.
+ */
+static s32 GetRampStep(s32 From, s32 To, size_t Count)
+{
+    return ((To - From) * (1 << RAMP_SHIFT)) / static_cast<s32>(Count);
+}
+
+/**
+ * Scale frames by a constant gain, which also pans them.
+ * @param[in,out] Frames The interleaved samples.
+ * @param[in] Level The gain of each channel.
+ */
+void MixKernels::Scalar::Gain(std::span<s16> Frames, StereoGain Level)
+{
+    for(size_t i = 0; i + 1 < Frames.size(); i += 2)
+    {
+        Frames[i] = static_cast<s16>((Frames[i] * Level.Left) >> 15);
+        Frames[i + 1] = static_cast<s16>((Frames[i + 1] * Level.Right) >> 15);
+    }
+}
+
+/**
+ * Scale frames by a gain moving linearly from one value to another, so a
+ * change of volume does not click.
+ * @param[in,out] Frames The interleaved samples.
+ * @param[in] From The gain of the first frame.
+ * @param[in] To The gain reached after the last frame.
+ */
+void MixKernels::Scalar::GainRamp(std::span<s16> Frames, StereoGain From, StereoGain To)
+{
+    const size_t Count = Frames.size() / 2;
+    if(Count == 0)
+    {
+        return;
+    }
+    RampFrames(Frames, From.Left << RAMP_SHIFT, From.Right << RAMP_SHIFT,
+        GetRampStep(From.Left, To.Left, Count), GetRampStep(From.Right, To.Right, Count));
+}
+
+/**
+ * Filter frames with a one-pole low-pass filter:
+ * y[n] = a * x[n] + (1 - a) * y[n - 1].
+ * The output is a weighted mean of samples, so it cannot overflow.
+ * @param[in,out] Frames The interleaved samples.
+ * @param[in] Coefficient The coefficient a, see GetLowPassCoefficient.
+ * @param[in,out] State The output for the frame before the first one.
+ */
+void MixKernels::Scalar::LowPass(std::span<s16> Frames, f32 Coefficient, LowPassState &State)
+{
+    const f32 Keep = 1.0f - Coefficient;
+    f32 Left = State.Left;
+    f32 Right = State.Right;
+    for(size_t i = 0; i + 1 < Frames.size(); i += 2)
+    {
+        Left = Coefficient * Frames[i] + Keep * Left;
+        Right = Coefficient * Frames[i + 1] + Keep * Right;
+        Frames[i] = static_cast<s16>(Left);
+        Frames[i + 1] = static_cast<s16>(Right);
+    }
+    // In silence the output decays towards 0, through denormal numbers,
+    // which are slow on most CPUs
+    State.Left = (std::abs(Left) < LOW_PASS_FLOOR) ? 0.0f : Left;
+    State.Right = (std::abs(Right) < LOW_PASS_FLOOR) ? 0.0f : Right;
+}
+
+/**
+ * Scale frames by a constant gain, four frames at a time.
+ * Same result as Scalar::Gain.
+ * @param[in,out] Frames The interleaved samples.
+ * @param[in] Level The gain of each channel.
+ */
+void MixKernels::Vector::Gain(std::span<s16> Frames, StereoGain Level)
+{
+    const WideS32 Gains = {Level.Left, Level.Right, Level.Left, Level.Right,
+        Level.Left, Level.Right, Level.Left, Level.Right};
+    size_t i = 0;
+    for(; i + 8 <= Frames.size(); i += 8)
+    {
+        WideS16 In;
+        std::memcpy(&In, &Frames[i], sizeof(In));
+        const WideS32 Out = (__builtin_convertvector(In, WideS32) * Gains) >> 15;
+        const WideS16 Narrow = __builtin_convertvector(Out, WideS16);
+        std::memcpy(&Frames[i], &Narrow, sizeof(Narrow));
+    }
+    Scalar::Gain(Frames.subspan(i), Level);
+}
+
+/**
+ * Scale frames by a gain ramp, four frames at a time.
+ * Same result as Scalar::GainRamp.
+ * @param[in,out] Frames The interleaved samples.
+ * @param[in] From The gain of the first frame.
+ * @param[in] To The gain reached after the last frame.
+ */
+void MixKernels::Vector::GainRamp(std::span<s16> Frames, StereoGain From, StereoGain To)
+{
+    const size_t Count = Frames.size() / 2;
+    if(Count == 0)
+    {
+        return;
+    }
+    const s32 LeftStep = GetRampStep(From.Left, To.Left, Count);
+    const s32 RightStep = GetRampStep(From.Right, To.Right, Count);
+    const s32 Left = From.Left << RAMP_SHIFT;
+    const s32 Right = From.Right << RAMP_SHIFT;
+    WideS32 Levels = {Left, Right, Left + LeftStep, Right + RightStep,
+        Left + LeftStep * 2, Right + RightStep * 2, Left + LeftStep * 3, Right + RightStep * 3};
+    const WideS32 Steps = {LeftStep * 4, RightStep * 4, LeftStep * 4, RightStep * 4,
+        LeftStep * 4, RightStep * 4, LeftStep * 4, RightStep * 4};
+    size_t i = 0;
+    for(; i + 8 <= Frames.size(); i += 8)
+    {
+        WideS16 In;
+        std::memcpy(&In, &Frames[i], sizeof(In));
+        const WideS32 Out = (__builtin_convertvector(In, WideS32) * (Levels >> RAMP_SHIFT)) >> 15;
+        const WideS16 Narrow = __builtin_convertvector(Out, WideS16);
+        std::memcpy(&Frames[i], &Narrow, sizeof(Narrow));
+        Levels += Steps;
+    }
+    RampFrames(Frames.subspan(i), Levels[0], Levels[1], LeftStep, RightStep);
+}
+
+/**
+ * Filter frames with a one-pole low-pass filter, two frames at a time.
+ * The second frame is computed from the inputs of both frames and the
+ * output before them, y[n + 1] = a * x[n + 1] + a * (1 - a) * x[n] +
+ * (1 - a)^2 * y[n - 1], so the two frames do not wait for each other.
+ * The result may differ from Scalar::LowPass by 1 from rounding.
+ * @param[in,out] Frames The interleaved samples.
+ * @param[in] Coefficient The coefficient a, see GetLowPassCoefficient.
+ * @param[in,out] State The output for the frame before the first one.
+ */
+void MixKernels::Vector::LowPass(std::span<s16> Frames, f32 Coefficient, LowPassState &State)
+{
+    const f32 Keep = 1.0f - Coefficient;
+    const VecF32 Current = {Coefficient, Coefficient, Coefficient, Coefficient};
+    const VecF32 Previous = {0.0f, 0.0f, Coefficient * Keep, Coefficient * Keep};
+    const VecF32 Carried = {Keep, Keep, Keep * Keep, Keep * Keep};
+    const VecS32 FirstFrame = {0, 1, 0, 1};
+    const VecS32 SecondFrame = {2, 3, 2, 3};
+    VecF32 Last = {State.Left, State.Right, State.Left, State.Right};
+    size_t i = 0;
+    for(; i + 4 <= Frames.size(); i += 4)
+    {
+        VecS16 In;
+        std::memcpy(&In, &Frames[i], sizeof(In));
+        const VecF32 Input = __builtin_convertvector(In, VecF32);
+        const VecF32 Out = Current * Input + Previous * __builtin_shuffle(Input, FirstFrame) + Carried * Last;
+        Last = __builtin_shuffle(Out, SecondFrame);
+        const VecS16 Narrow = __builtin_convertvector(__builtin_convertvector(Out, VecS32), VecS16);
+        std::memcpy(&Frames[i], &Narrow, sizeof(Narrow));
+    }
+    State.Left = Last[0];
+    State.Right = Last[1];
+    Scalar::LowPass(Frames.subspan(i), Coefficient, State); // Also flushes the state
+}
+
+/**
+ * Scale frames by a constant gain, with the kernel best for this CPU.
+ * @param[in,out] Frames The interleaved samples.
+ * @param[in] Level The gain of each channel.
+ */
+void MixKernels::Gain(std::span<s16> Frames, StereoGain Level)
+{
+    if constexpr(HAS_VECTOR_UNIT)
+    {
+        Vector::Gain(Frames, Level);
+    }
+    else
+    {
+        Scalar::Gain(Frames, Level);
+    }
+}
+
+/**
+ * Scale frames by a gain ramp, with the kernel best for this CPU.
+ * @param[in,out] Frames The interleaved samples.
+ * @param[in] From The gain of the first frame.
+ * @param[in] To The gain reached after the last frame.
+ */
+void MixKernels::GainRamp(std::span<s16> Frames, StereoGain From, StereoGain To)
+{
+    if constexpr(HAS_VECTOR_UNIT)
+    {
+        Vector::GainRamp(Frames, From, To);
+    }
+    else
+    {
+        Scalar::GainRamp(Frames, From, To);
+    }
+}
+
+/**
+ * Filter frames with a one-pole low-pass filter, with the kernel best for this CPU.
+ * @param[in,out] Frames The interleaved samples.
+ * @param[in] Coefficient The coefficient, see GetLowPassCoefficient.
+ * @param[in,out] State The output for the frame before the first one.
+ */
+void MixKernels::LowPass(std::span<s16> Frames, f32 Coefficient, LowPassState &State)
+{
+    if constexpr(HAS_VECTOR_UNIT)
+    {
+        Vector::LowPass(Frames, Coefficient, State);
+    }
+    else
+    {
+        Scalar::LowPass(Frames, Coefficient, State);
+    }
+}
+
+/**
+ * Get the coefficient of a one-pole low-pass filter.
+ * @param[in] Cutoff The frequency where the filter starts to cut, in Hz.
+ * @param[in] SampleRate The sample rate of the frames.
+ * @return The coefficient, 1.0 lets everything through.
+ */
+f32 MixKernels::GetLowPassCoefficient(f32 Cutoff, u32 SampleRate)
+{
+    return 1.0f - std::exp(-2.0f * std::numbers::pi_v<f32> * Cutoff / static_cast<f32>(SampleRate));
+}
+
+// EOF
@@ -0,0 +1,80 @@
+// source/mixkernels.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#ifndef MixKernelsH
+#define MixKernelsH
+//---------------------------------------------------------------------------
+
+#include <span>
+#include <gctypes.h>
+
+/**
+ * Namespace containing the kernels processing blocks of mixed audio.
+ * Blocks are interleaved 16-bit stereo frames, processed in place. Each
+ * kernel has a scalar version, the reference, and a version written with
+ * the vector extensions of GCC, which process several samples at a time
+ * where the CPU has vector registers. The Wii CPU has none, so the game
+ * uses the scalar kernels there; see HAS_VECTOR_UNIT.
+ * @author Crayon
+ */
+namespace MixKernels
+{
+    inline constexpr s32 GAIN_ONE = 1 << 15;  /**< Gain of 1.0, gains are 1.15 fixed point. */
+
+#if !defined(WTT_SCALAR_MIX) && (defined(__SSE2__) || defined(__ARM_NEON) || defined(__ALTIVEC__))
+    inline constexpr bool HAS_VECTOR_UNIT = true;
+#else
+    inline constexpr bool HAS_VECTOR_UNIT = false;
+#endif
+
+    /**
+     * Gain of each channel, from 0 to GAIN_ONE.
+     */
+    struct StereoGain
+    {
+        s32 Left{GAIN_ONE};
+        s32 Right{GAIN_ONE};
+
+        bool operator==(const StereoGain&) const = default;
+    };
+
+    /**
+     * Output of a low-pass filter for the last frame, carried to the next block.
+     */
+    struct LowPassState
+    {
+        f32 Left{0.0f};
+        f32 Right{0.0f};
+    };
+
+    namespace Scalar
+    {
+        void Gain(std::span<s16> Frames, StereoGain Level);
+        void GainRamp(std::span<s16> Frames, StereoGain From, StereoGain To);
+        void LowPass(std::span<s16> Frames, f32 Coefficient, LowPassState &State);
+    }   /* namespace Scalar */
+
+    namespace Vector
+    {
+        void Gain(std::span<s16> Frames, StereoGain Level);
+        void GainRamp(std::span<s16> Frames, StereoGain From, StereoGain To);
+        void LowPass(std::span<s16> Frames, f32 Coefficient, LowPassState &State);
+    }   /* namespace Vector */
+
+    void Gain(std::span<s16> Frames, StereoGain Level);
+    void GainRamp(std::span<s16> Frames, StereoGain From, StereoGain To);
+    void LowPass(std::span<s16> Frames, f32 Coefficient, LowPassState &State);
+    [[nodiscard]] f32 GetLowPassCoefficient(f32 Cutoff, u32 SampleRate);
+}   /* namespace MixKernels */
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
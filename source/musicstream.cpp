@@ -0,0 +1,371 @@
+// source/musicstream.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#include <algorithm>
+#include <dirent.h>
+#include <strings.h>
+#include "musicstream.h"
+
+/**
+ * Size of the header of a .dsp file.
+ */
+static constexpr size_t DSP_HEADER_SIZE = 0x60;
+
+/**
+ * Read a big-endian 16-bit value.
+ */
+static u16 ReadU16(const u8 *Data)
+{
+    return static_cast<u16>((Data[0] << 8) | Data[1]);
+}
+
+/**
+ * Read a big-endian 32-bit value.
+ */
+static u32 ReadU32(const u8 *Data)
+{
+    return (static_cast<u32>(ReadU16(Data)) << 16) | ReadU16(Data + 2);
+}
+
+/**
+ * Constructor for the MusicStream class.
+ * The audio backend must be initialized. Nothing plays before Start is
+ * called.
+ * @param[in] Directory Folder of the tracks, ending with a slash.
+ */
+MusicStream::MusicStream(const char *Directory)
+{
+    if(DIR *Folder = opendir(Directory); Folder != nullptr)
+    {
+        while(const dirent *Entry = readdir(Folder))
+        {
+            const std::string Name = Entry->d_name;
+            if(Name.size() > 4 && strcasecmp(Name.c_str() + Name.size() - 4, ".dsp") == 0)
+            {
+                Playlist.push_back(Directory + Name);
+            }
+        }
+        closedir(Folder);
+    }
+    std::sort(Playlist.begin(), Playlist.end());
+    if(Playlist.empty())
+    {
+        return;
+    }
+
+    AudioBackend &Backend = GetAudioBackend();
+    Backend.FlushBuffer(Silence.data(), sizeof(Silence));
+    Voice = Backend.AllocateVoice(VoiceCallback, this);
+    if(Voice == AudioBackend::NO_VOICE)
+    {
+        Playlist.clear();
+        return;
+    }
+
+    LWP_SemInit(&Requests, 0, 16);
+    Running.store(true, std::memory_order_release);
+    LWP_CreateThread(&Thread, ThreadEntry, this, nullptr, THREAD_STACK_SIZE, THREAD_PRIORITY);
+}
+
+/**
+ * Destructor for the MusicStream class.
+ */
+MusicStream::~MusicStream()
+{
+    if(Voice == AudioBackend::NO_VOICE)
+    {
+        return;
+    }
+    // The refill thread may still give the voice a buffer, so it is
+    // joined before the voice is freed
+    GetAudioBackend().SetVoiceStop(Voice, true);
+    Running.store(false, std::memory_order_release);
+    LWP_SemPost(Requests);
+    LWP_JoinThread(Thread, nullptr);
+    LWP_SemDestroy(Requests);
+    GetAudioBackend().FreeVoice(Voice);
+    if(File != nullptr)
+    {
+        std::fclose(File);
+    }
+}
+
+/**
+ * Play the playlist from its first track.
+ * The buffers are filled by the refill thread, the music starts when they
+ * are ready.
+ * @param[in] AVolume The volume, between 0 and 255.
+ */
+void MusicStream::Start(u16 AVolume)
+{
+    if(Voice == AudioBackend::NO_VOICE)
+    {
+        return;
+    }
+    GetAudioBackend().SetVoiceStop(Voice, true);
+    Paused.store(false, std::memory_order_release);
+    Volume.store(AVolume, std::memory_order_relaxed);
+    Restart.store(true, std::memory_order_release);
+    LWP_SemPost(Requests);
+}
+
+/**
+ * Pause or resume the music.
+ * @param[in] APaused On or off.
+ */
+void MusicStream::Pause(bool APaused)
+{
+    if(Voice != AudioBackend::NO_VOICE)
+    {
+        Paused.store(APaused, std::memory_order_release);
+        GetAudioBackend().SetVoiceStop(Voice, APaused);
+    }
+}
+
+/**
+ * Get the number of tracks found on the SD card.
+ * @return The number of tracks, 0 if the module must be played instead.
+ */
+size_t MusicStream::GetTrackCount() const
+{
+    return Playlist.size();
+}
+
+/**
+ * Get the number of times a buffer was not decoded in time.
+ * @return The number of underruns.
+ */
+u32 MusicStream::GetUnderruns() const
+{
+    return Underruns.load(std::memory_order_relaxed);
+}
+
+/**
+ * Open the next track of the playlist that can be read.
+ * After the last track, the playlist starts again.
+ * @return true if a track was opened, false if no track can be read.
+ */
+bool MusicStream::OpenNext()
+{
+    for(size_t Tries = 0; Tries < Playlist.size(); ++Tries)
+    {
+        if(File != nullptr)
+        {
+            std::fclose(File);
+        }
+        File = std::fopen(Playlist[Current].c_str(), "rb");
+        Current = (Current + 1) % Playlist.size();
+
+        u8 Header[DSP_HEADER_SIZE];
+        if(File == nullptr || std::fread(Header, 1, sizeof(Header), File) != sizeof(Header))
+        {
+            continue;
+        }
+        const u32 SampleCount = ReadU32(Header);
+        const u32 SampleRate = ReadU32(Header + 0x08);
+        const u16 Format = ReadU16(Header + 0x0E);
+        if(SampleCount == 0 || SampleRate == 0 || Format != 0)
+        {   // Format 0 is ADPCM
+            continue;
+        }
+        for(u32 i = 0; i < Adpcm::COEFFICIENT_COUNT; ++i)
+        {
+            Coefficients[i] = static_cast<s16>(ReadU16(Header + 0x1C + i * 2));
+        }
+        History.Previous = static_cast<s16>(ReadU16(Header + 0x40));
+        History.Before = static_cast<s16>(ReadU16(Header + 0x42));
+        Remaining = SampleCount;
+        TrackRate = static_cast<f32>(SampleRate);
+        CarryCount = 0;
+        return true;
+    }
+    if(File != nullptr)
+    {
+        std::fclose(File);
+        File = nullptr;
+    }
+    Remaining = 0;
+    return false;
+}
+
+/**
+ * Go back to the first track and start the voice once both buffers are
+ * filled, unless the music was paused in the meantime. The voice is
+ * stopped.
+ */
+void MusicStream::Rewind()
+{
+    Current = 0;
+    Remaining = 0;
+    CarryCount = 0;
+    Playing = NO_BUFFER;
+    Next = 1;
+    for(u8 Half = 0; Half < 2; ++Half)
+    {
+        Fill(Half);
+        Ready[Half].store(true, std::memory_order_release);
+    }
+    Playing = 0;
+    const u16 Level = Volume.load(std::memory_order_relaxed);
+    AudioBackend &Backend = GetAudioBackend();
+    Backend.SetVoiceVolume(Voice, Level, Level);
+    Backend.SetVoiceBuffer(Voice, Buffers[0], Rates[0]);
+    Backend.SetVoiceStop(Voice, Paused.load(std::memory_order_acquire));
+}
+
+/**
+ * Decode the next part of the playlist into a buffer.
+ * A new track that has another sample rate starts in the next buffer, the
+ * end of this one is silent.
+ * @param[in] Half The buffer to fill.
+ */
+void MusicStream::Fill(u8 Half)
+{
+    s16 *Out = Buffers[Half].data();
+    u32 Written = 0;
+    if(Remaining > 0 || CarryCount > 0)
+    {
+        Rates[Half] = TrackRate;
+    }
+    while(Written < BUFFER_SAMPLES)
+    {
+        if(CarryCount > 0)
+        {
+            const u32 Count = std::min(CarryCount, BUFFER_SAMPLES - Written);
+            std::copy_n(Carry.begin() + CarryStart, Count, Out + Written);
+            Written += Count;
+            CarryStart += Count;
+            CarryCount -= Count;
+            continue;
+        }
+        if(Remaining == 0 && !OpenNext())
+        {
+            break;
+        }
+        if(Written == 0)
+        {
+            Rates[Half] = TrackRate;
+        }
+        else if(TrackRate != Rates[Half])
+        {
+            break;
+        }
+
+        const u32 Wanted = std::min((BUFFER_SAMPLES - Written + Adpcm::SAMPLES_PER_FRAME - 1) / Adpcm::SAMPLES_PER_FRAME,
+            (Remaining + Adpcm::SAMPLES_PER_FRAME - 1) / Adpcm::SAMPLES_PER_FRAME);
+        const size_t Frames = std::fread(Chunk.data(), Adpcm::FRAME_SIZE, Wanted, File);
+        if(Frames == 0)
+        {   // Truncated file, the next track starts in the next buffer
+            Remaining = 0;
+            break;
+        }
+        for(size_t Frame = 0; Frame < Frames; ++Frame)
+        {
+            const std::span<const u8> Data(Chunk.data() + Frame * Adpcm::FRAME_SIZE, Adpcm::FRAME_SIZE);
+            const u32 Count = std::min(Remaining, Adpcm::SAMPLES_PER_FRAME);
+            const u32 Room = BUFFER_SAMPLES - Written;
+            if(Count <= Room)
+            {
+                Adpcm::Decode(Data, Coefficients.data(), History, {Out + Written, Count});
+                Written += Count;
+            }
+            else
+            {
+                Adpcm::Decode(Data, Coefficients.data(), History, {Carry.data(), Count});
+                std::copy_n(Carry.begin(), Room, Out + Written);
+                Written += Room;
+                CarryStart = Room;
+                CarryCount = Count - Room;
+            }
+            Remaining -= Count;
+        }
+    }
+    std::fill(Out + Written, Out + BUFFER_SAMPLES, 0);
+    GetAudioBackend().FlushBuffer(Out, sizeof(Buffers[Half]));
+}
+
+/**
+ * Give the voice its next buffer, in the audio interrupt.
+ * The buffer that was playing is handed back to the refill thread.
+ */
+void MusicStream::NextBuffer()
+{
+    if(Playing != NO_BUFFER)
+    {
+        Ready[Playing].store(false, std::memory_order_release);
+    }
+    if(Ready[Next].load(std::memory_order_acquire))
+    {
+        GetAudioBackend().SetVoiceBuffer(Voice, Buffers[Next], Rates[Next]);
+        Playing = Next;
+        Next ^= 1;
+    }
+    else
+    {
+        GetAudioBackend().SetVoiceBuffer(Voice, Silence, SILENCE_RATE);
+        Playing = NO_BUFFER;
+        Underruns.fetch_add(1, std::memory_order_relaxed);
+    }
+    LWP_SemPost(Requests);
+}
+
+/**
+ * Loop of the refill thread: decode into the free buffers, then wait for
+ * the voice to free another one.
+ * A semaphore counts the requests, so one posted by the interrupt while
+ * a buffer is decoded is not lost.
+ */
+void MusicStream::Run()
+{
+    while(true)
+    {
+        LWP_SemWait(Requests);
+        if(!Running.load(std::memory_order_acquire))
+        {
+            break;
+        }
+        if(Restart.exchange(false, std::memory_order_acq_rel))
+        {
+            Rewind();
+            continue;
+        }
+        for(u8 Half = 0; Half < 2; ++Half)
+        {
+            if(!Ready[Half].load(std::memory_order_acquire))
+            {
+                Fill(Half);
+                Ready[Half].store(true, std::memory_order_release);
+            }
+        }
+    }
+}
+
+/**
+ * Entry point of the refill thread.
+ * @param[in] Arg The MusicStream object.
+ * @return Always nullptr.
+ */
+void* MusicStream::ThreadEntry(void *Arg)
+{
+    static_cast<MusicStream*>(Arg)->Run();
+    return nullptr;
+}
+
+/**
+ * Called by the audio backend when the voice needs its next buffer.
+ * @param[in] User The MusicStream object.
+ */
+void MusicStream::VoiceCallback(void *User)
+{
+    static_cast<MusicStream*>(User)->NextBuffer();
+}
+
+// EOF
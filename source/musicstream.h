@@ -0,0 +1,98 @@
+// source/musicstream.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#ifndef MusicStreamH
+#define MusicStreamH
+//---------------------------------------------------------------------------
+
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <gctypes.h>
+#include <ogc/lwp.h>
+#include <ogc/semaphore.h>
+#include "adpcm.h"
+#include "audiobackend.h"
+
+/**
+ * Music played from DSP-ADPCM files on the SD card.
+ * The tracks (.dsp files, mono) of a folder play one after the other, in
+ * the order of their names. Only two small buffers are in memory whatever
+ * the length of the tracks: the voice plays one while a thread decodes the
+ * next part of the track into the other. When a buffer is not ready in
+ * time, silence is played and an underrun is counted.
+ * @author Crayon
+ */
+class MusicStream
+{
+public:
+    static constexpr u32 FRAMES_PER_BUFFER = 292;  /**< About 85 ms at 48 kHz. */
+    static constexpr u32 BUFFER_SAMPLES = FRAMES_PER_BUFFER * Adpcm::SAMPLES_PER_FRAME;
+
+    explicit MusicStream(const char *Directory);
+    MusicStream(MusicStream const&) = delete;
+    ~MusicStream();
+    MusicStream& operator=(MusicStream const&) = delete;
+
+    void Start(u16 Volume);
+    void Pause(bool APaused);
+    [[nodiscard]] size_t GetTrackCount() const;
+    [[nodiscard]] u32 GetUnderruns() const;
+private:
+    static constexpr u8 NO_BUFFER = 2;              /**< Silence is playing. */
+    static constexpr f32 SILENCE_RATE = 48000.0f;   /**< Rate of a buffer when no track can be read. */
+    static constexpr u8 THREAD_PRIORITY = 72;       /**< Above the game, below the audio commands. */
+    static constexpr u32 THREAD_STACK_SIZE = 16 * 1024;
+
+    bool OpenNext();
+    void Rewind();
+    void Fill(u8 Half);
+    void NextBuffer();
+    void Run();
+    static void* ThreadEntry(void *Arg);
+    static void VoiceCallback(void *User);
+
+    alignas(32) std::array<std::array<s16, BUFFER_SAMPLES>, 2> Buffers{};  /**< Read by the DSP. */
+    alignas(32) std::array<s16, BUFFER_SAMPLES> Silence{};                  /**< Played on an underrun. */
+    std::array<f32, 2> Rates{SILENCE_RATE, SILENCE_RATE};  /**< Sample rate of each buffer. */
+    std::array<std::atomic<bool>, 2> Ready{};   /**< Decoded and not played yet. */
+    // Used by the voice callback, and by Rewind while the voice is stopped
+    u8 Playing{NO_BUFFER};  /**< Buffer the voice plays. */
+    u8 Next{0};             /**< Buffer queued after it. */
+
+    // Only used by the refill thread
+    std::vector<std::string> Playlist;
+    size_t Current{0};          /**< Next track to open. */
+    std::FILE *File{nullptr};
+    std::array<u8, FRAMES_PER_BUFFER * Adpcm::FRAME_SIZE> Chunk{};  /**< Frames read from the file. */
+    std::array<s16, Adpcm::COEFFICIENT_COUNT> Coefficients{};
+    Adpcm::History History;
+    u32 Remaining{0};           /**< Samples of the track not decoded yet. */
+    f32 TrackRate{0.0f};
+    std::array<s16, Adpcm::SAMPLES_PER_FRAME> Carry{};  /**< End of a frame cut by a buffer. */
+    u32 CarryStart{0};
+    u32 CarryCount{0};
+
+    AudioBackend::VoiceId Voice{AudioBackend::NO_VOICE};
+    lwp_t Thread{LWP_THREAD_NULL};  /**< Refill thread, it decodes the buffers. */
+    sem_t Requests{LWP_SEM_NULL};   /**< Posted when a buffer is free, or to restart. */
+    std::atomic<bool> Running{false};
+    std::atomic<bool> Restart{false};
+    std::atomic<bool> Paused{false};
+    std::atomic<u16> Volume{255};
+    std::atomic<u32> Underruns{0};
+};
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
@@ -24,7 +24,7 @@ void Player::SetName(std::string_view AName)
  * Return the player name.
  * @return The name of the player.
  */
-std::string Player::GetName() const
+const std::string& Player::GetName() const
 {
     return Name;
 }
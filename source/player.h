@@ -40,7 +40,7 @@ public:
     Player& operator=(Player const&) = delete;
 
     void SetName(std::string_view AName);
-    [[nodiscard]] std::string GetName() const;
+    [[nodiscard]] const std::string& GetName() const;
 
     void SetSign(u8 ASign);
     [[nodiscard]] u8 GetSign() const;
@@ -0,0 +1,143 @@
+// source/profiler.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#include <algorithm>
+#include <array>
+#include <ogc/lwp_watchdog.h>
+#include "profiler.h"
+#include "trace.h"
+
+static constexpr size_t PHASE_COUNT = static_cast<size_t>(Profiler::Phase::Count);
+static_assert(PHASE_COUNT <= 16, "RanMask holds one bit per phase");
+
+static std::array<u64, PHASE_COUNT> Current{}; /**< Ticks of the frame in progress. */
+static u16 CurrentRan{0};                      /**< Phases that ran in the frame in progress. */
+static std::array<std::array<u32, Profiler::HISTORY_SIZE>, PHASE_COUNT> History{}; /**< Microseconds. */
+static std::array<u16, Profiler::HISTORY_SIZE> RanMask{}; /**< Phases that ran in each frame. */
+static size_t Newest{Profiler::HISTORY_SIZE - 1}; /**< Index of the last completed frame. */
+static u64 FrameStart{0};
+
+/**
+ * Add time to a phase of the current frame.
+ * @param[in] Which The phase.
+ * @param[in] Ticks Time spent, in time base ticks.
+ */
+void Profiler::Add(Phase Which, u64 Ticks)
+{
+    const size_t Index = static_cast<size_t>(Which);
+    Current[Index] += Ticks;
+    CurrentRan |= 1 << Index;
+}
+
+/**
+ * Close the current frame and keep its times.
+ * Called once per frame, after the frame is shown.
+ */
+void Profiler::EndFrame()
+{
+    const u64 Now = gettime();
+    if(FrameStart != 0)
+    {
+        Add(Phase::Frame, diff_ticks(FrameStart, Now));
+    }
+    FrameStart = Now;
+
+    Newest = (Newest + 1) % HISTORY_SIZE;
+    for(size_t i = 0; i < PHASE_COUNT; ++i)
+    {
+        History[i][Newest] = ticks_to_microsecs(Current[i]);
+    }
+    RanMask[Newest] = CurrentRan;
+    Current.fill(0);
+    CurrentRan = 0;
+}
+
+/**
+ * Get the statistics of a phase over the kept frames.
+ * @param[in] Which The phase.
+ * @return The statistics, all 0 if the phase did not run.
+ */
+Profiler::Stats Profiler::GetStats(Phase Which)
+{
+    const size_t Index = static_cast<size_t>(Which);
+    std::array<u32, HISTORY_SIZE> Samples;
+    size_t Count = 0;
+    u64 Total = 0;
+    for(size_t i = 0; i < HISTORY_SIZE; ++i)
+    {
+        if(RanMask[i] & (1 << Index))
+        {
+            Samples[Count++] = History[Index][i];
+            Total += History[Index][i];
+        }
+    }
+
+    Stats Result;
+    if(Count == 0)
+    {
+        return Result;
+    }
+    const size_t Rank = (Count * 99 + 99) / 100 - 1;
+    std::nth_element(Samples.begin(), Samples.begin() + Rank, Samples.begin() + Count);
+    Result.P99 = Samples[Rank];
+    Result.Min = *std::min_element(Samples.begin(), Samples.begin() + Count);
+    Result.Avg = Total / Count;
+    Result.Samples = Count;
+    return Result;
+}
+
+/**
+ * Get the time of a phase in a kept frame.
+ * @param[in] Which The phase.
+ * @param[in] Age 0 for the last completed frame, up to HISTORY_SIZE - 1.
+ * @return The time in microseconds, 0 if the phase did not run.
+ */
+u32 Profiler::GetSample(Phase Which, size_t Age)
+{
+    return History[static_cast<size_t>(Which)][(Newest + HISTORY_SIZE - Age) % HISTORY_SIZE];
+}
+
+/**
+ * Get the name of a phase.
+ * @param[in] Which The phase.
+ * @return A short name.
+ */
+const char* Profiler::GetName(Phase Which)
+{
+    static constexpr std::array<const char*, PHASE_COUNT> Names = {
+        "Frame", "Paint start", "Paint menu", "Paint home", "Paint game",
+        "Scan pads", "Controller", "AI", "Text", "Render", "Music"
+    };
+    return Names[static_cast<size_t>(Which)];
+}
+
+/**
+ * Constructor for the ScopedTimer class.
+ * The phase is also traced, under the name returned by Profiler::GetName.
+ * @param[in] AWhich The phase to add the time to.
+ */
+ScopedTimer::ScopedTimer(Profiler::Phase AWhich) :
+    Which(AWhich)
+{
+    TRACE_BEGIN(Profiler::GetName(Which));
+    Start = gettime();
+}
+
+/**
+ * Destructor for the ScopedTimer class.
+ */
+ScopedTimer::~ScopedTimer()
+{
+    Profiler::Add(Which, diff_ticks(Start, gettime()));
+    TRACE_END(Profiler::GetName(Which));
+}
+
+// EOF
@@ -0,0 +1,88 @@
+// source/profiler.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#ifndef ProfilerH
+#define ProfilerH
+//---------------------------------------------------------------------------
+
+#include <cstddef>
+#include <gctypes.h>
+
+/**
+ * Namespace containing the frame time profiler.
+ * Time spent in each phase is added up over a frame, the last frames are
+ * kept to compute statistics and draw a graph.
+ * @author Crayon
+ */
+namespace Profiler
+{
+    /**
+     * Parts of a frame that are timed.
+     * Paint phases include the text drawn while painting.
+     */
+    enum class Phase : u8 {
+        Frame,      /**< Whole frame, from one EndFrame to the next. */
+        PaintStart, /**< Paint of the start screen. */
+        PaintMenu,  /**< Paint of the menu screen. */
+        PaintHome,  /**< Paint of the home screen. */
+        PaintGame,  /**< Paint of the game screen. */
+        ScanPads,   /**< Reading the Wii Remotes. */
+        Controller, /**< Game::ControllerManager. */
+        AI,         /**< Computer player move. */
+        Text,       /**< Font::Print. */
+        Render,     /**< Screen::Render, including the wait for vsync. */
+        Music,      /**< Module mixing, in the audio interrupt: it overlaps the other phases. */
+        Count       /**< Number of phases. */
+    };
+
+    /**
+     * Statistics of a phase over the frames where it ran, in microseconds.
+     */
+    struct Stats
+    {
+        u32 Min{0};     /**< Shortest time. */
+        u32 Avg{0};     /**< Average time. */
+        u32 P99{0};     /**< 99th percentile. */
+        u32 Samples{0}; /**< Number of frames where the phase ran. */
+    };
+
+    /**
+     * Number of frames kept, 2 seconds at 60 Hz.
+     */
+    inline constexpr size_t HISTORY_SIZE = 120;
+
+    void Add(Phase Which, u64 Ticks);
+    void EndFrame();
+    [[nodiscard]] Stats GetStats(Phase Which);
+    [[nodiscard]] u32 GetSample(Phase Which, size_t Age);
+    [[nodiscard]] const char* GetName(Phase Which);
+}   /* namespace Profiler */
+
+/**
+ * Add the time spent in a scope to a phase of the profiler.
+ * The scope is traced too, see Trace::Scope.
+ * @author Crayon
+ */
+class ScopedTimer
+{
+public:
+    explicit ScopedTimer(Profiler::Phase AWhich);
+    ScopedTimer(ScopedTimer const&) = delete;
+    ~ScopedTimer();
+    ScopedTimer& operator=(ScopedTimer const&) = delete;
+private:
+    Profiler::Phase Which;
+    u64 Start;
+};
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
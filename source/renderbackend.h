@@ -0,0 +1,70 @@
+// source/renderbackend.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#ifndef RenderBackendH
+#define RenderBackendH
+//---------------------------------------------------------------------------
+
+#include <grrlib.h>
+#include <memory>
+
+namespace GRRLIBpp
+{
+
+/**
+ * Interface for everything Texture and Screen send to the hardware.
+ * Texels are always stored in GX formats (tiled RGBA8 or IA8), so textures
+ * built by the game are the same whatever backend draws them.
+ * @author Crayon
+ */
+class RenderBackend
+{
+public:
+    virtual ~RenderBackend() = default;
+
+    // Screen
+    virtual s32 Initialize() = 0;
+    virtual void Exit() = 0;
+    virtual void Render() = 0;
+    [[nodiscard]] virtual u16 GetWidth() const = 0;
+    [[nodiscard]] virtual u16 GetHeight() const = 0;
+    virtual void SetBackgroundColor(u32 color) = 0;
+    virtual void FillScreen(u32 color) = 0;
+    virtual void Plot(f32 x, f32 y, u32 color) = 0;
+    virtual void Line(f32 x1, f32 y1, f32 x2, f32 y2, u32 color) = 0;
+    virtual void Rectangle(f32 x, f32 y, f32 width, f32 height, u32 color, bool filled) = 0;
+    virtual void Circle(f32 x, f32 y, f32 radius, u32 color, bool filled) = 0;
+    virtual void SetAlphaTest(u8 threshold) = 0;
+    virtual void ClipDrawing(int x, int y, int width, int height) = 0;
+    virtual void ClipReset() = 0;
+    virtual bool ScreenShot(const char *filename) = 0;
+
+    // Textures
+    [[nodiscard]] virtual GRRLIB_texImg* LoadTexture(const u8 *Buffer, u32 Size) = 0;
+    virtual void FlushTexture(void *data, u32 size) = 0;
+    virtual void DrawImg(f32 xpos, f32 ypos, const GRRLIB_texImg *tex,
+                         f32 degrees, f32 scaleX, f32 scaleY, u32 color) = 0;
+    virtual void DrawPart(f32 xpos, f32 ypos, f32 partx, f32 party, f32 partw, f32 parth,
+                          const GRRLIB_texImg *tex, f32 degrees, f32 scaleX, f32 scaleY, u32 color) = 0;
+    virtual void DrawTile(f32 xpos, f32 ypos, const GRRLIB_texImg *tex,
+                          f32 degrees, f32 scaleX, f32 scaleY, u32 color, int frame) = 0;
+    virtual void CopyScreen(int posx, int posy, GRRLIB_texImg *tex, bool clear) = 0;
+    virtual void CopyScreenRows(GRRLIB_texImg *tex, u16 posy, u16 height) = 0;
+};
+
+void SetRenderBackend(std::unique_ptr<RenderBackend> Backend);
+[[nodiscard]] RenderBackend& GetRenderBackend();
+
+}   /* namespace GRRLIBpp */
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
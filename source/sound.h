@@ -15,6 +15,17 @@
 #include <gctypes.h>
 #include <span>
 
+/**
+ * Encoding of the samples of a sound.
+ */
+enum class SoundFormat : u8 {
+    Mono8,      /**< Signed 8-bit samples. */
+    Stereo8,    /**< Signed 8-bit samples, left then right. */
+    Mono16,     /**< Big-endian signed 16-bit samples. */
+    Stereo16,   /**< Big-endian signed 16-bit samples, left then right. */
+    MonoAdpcm   /**< GameCube DSP-ADPCM, decoded before it is played. */
+};
+
 /**
  * This is a class used for sound.
  * @author Crayon
@@ -22,18 +33,25 @@
 class Sound
 {
 private:
-    const u32 _format;
+    const SoundFormat _format;
     const std::span<const u8> _buffer;
     const f32 _freq;
+    const u32 _samples;
+    const s16 *_coefficients;
 public:
     /**
      * Constructor for the Sound class.
      * @param[in] format The sound format.
      * @param[in] buffer The sound buffer
      * @param[in] frequency The sound frequency.
+     * @param[in] samples The number of samples, only needed by ADPCM.
+     * @param[in] coefficients The 16 ADPCM coefficients, only needed by ADPCM.
      */
-    constexpr Sound(u32 format, std::span<const u8> buffer, f32 frequency) :
-        _format(format), _buffer(buffer), _freq(frequency)
+    constexpr Sound(SoundFormat format, std::span<const u8> buffer, f32 frequency,
+        u32 samples = 0, const s16 *coefficients = nullptr) :
+        _format(format), _buffer(buffer), _freq(frequency),
+        _samples((format == SoundFormat::MonoAdpcm) ? samples : buffer.size() / GetFrameSize(format)),
+        _coefficients(coefficients)
     {
     }
 
@@ -53,7 +71,7 @@ public:
      * Get the sound format.
      * @return Return the sound format.
      */
-    [[nodiscard]] constexpr u32 GetFormat() const
+    [[nodiscard]] constexpr SoundFormat GetFormat() const
     {
         return _format;
     }
@@ -66,6 +84,52 @@ public:
     {
         return _freq;
     }
+
+    /**
+     * Get the number of samples, per channel.
+     * @return Return the number of samples.
+     */
+    [[nodiscard]] constexpr u32 GetSampleCount() const
+    {
+        return _samples;
+    }
+
+    /**
+     * Get the ADPCM coefficients.
+     * @return Return the 16 coefficients, nullptr if the sound is not ADPCM.
+     */
+    [[nodiscard]] constexpr const s16* GetCoefficients() const
+    {
+        return _coefficients;
+    }
+
+    /**
+     * Get how long the sound plays.
+     * @return Return the duration in microseconds.
+     */
+    [[nodiscard]] constexpr u32 GetDuration() const
+    {
+        return static_cast<u32>(static_cast<u64>(_samples) * 1000000 / static_cast<u64>(_freq));
+    }
+
+    /**
+     * Get the size of a sample of every channel.
+     * @param[in] format The sound format.
+     * @return Return the size in bytes, 1 for ADPCM.
+     */
+    [[nodiscard]] static constexpr u32 GetFrameSize(SoundFormat format)
+    {
+        switch(format)
+        {
+            case SoundFormat::Stereo8:
+            case SoundFormat::Mono16:
+                return 2;
+            case SoundFormat::Stereo16:
+                return 4;
+            default:
+                return 1;
+        }
+    }
 };
 
 #endif /* SOUND_H_ */
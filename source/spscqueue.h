@@ -0,0 +1,102 @@
+// source/spscqueue.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#ifndef SpscQueueH
+#define SpscQueueH
+//---------------------------------------------------------------------------
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/**
+ * A bounded queue between one producer thread and one consumer thread.
+ * Neither side takes a lock or waits: Push fails when the queue is full and
+ * Pop fails when it is empty. Head is only written by the consumer and Tail
+ * by the producer, the release stores publish the items to the other side.
+ * It has no dependency on libogc, so it also builds for the host.
+ * @tparam T Type of the items, copied in and out.
+ * @tparam Capacity Number of slots, a power of two. One slot is kept empty.
+ * @author Crayon
+ */
+template <typename T, size_t Capacity>
+class SpscQueue
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+public:
+    SpscQueue() = default;
+    SpscQueue(SpscQueue const&) = delete;
+    ~SpscQueue() = default;
+    SpscQueue& operator=(SpscQueue const&) = delete;
+
+    /**
+     * Add an item, called by the producer only.
+     * @param[in] Item The item to add.
+     * @return true if the item was added, false if the queue is full.
+     */
+    bool Push(const T &Item)
+    {
+        const size_t CurrentTail = Tail.load(std::memory_order_relaxed);
+        const size_t NextTail = (CurrentTail + 1) & (Capacity - 1);
+        if(NextTail == Head.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        Items[CurrentTail] = Item;
+        Tail.store(NextTail, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Remove the oldest item, called by the consumer only.
+     * @param[out] Item The item removed.
+     * @return true if an item was removed, false if the queue is empty.
+     */
+    bool Pop(T &Item)
+    {
+        const size_t CurrentHead = Head.load(std::memory_order_relaxed);
+        if(CurrentHead == Tail.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        Item = Items[CurrentHead];
+        Head.store((CurrentHead + 1) & (Capacity - 1), std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Check if the queue is empty.
+     * The answer may be outdated as soon as it is returned, when called
+     * by the side that does not modify the queue.
+     * @return true if there is no item, false otherwise.
+     */
+    [[nodiscard]] bool IsEmpty() const
+    {
+        return Head.load(std::memory_order_acquire) == Tail.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Get the number of items the queue can hold.
+     * @return The capacity, one less than the number of slots.
+     */
+    [[nodiscard]] static constexpr size_t GetCapacity()
+    {
+        return Capacity - 1;
+    }
+private:
+    std::array<T, Capacity> Items{};
+    std::atomic<size_t> Head{0};  /**< Next item to pop. */
+    std::atomic<size_t> Tail{0};  /**< Next slot to fill. */
+};
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
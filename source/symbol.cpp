@@ -24,7 +24,7 @@ Symbol::Symbol() :
     Width = 136;
     Height = 100;
 
-    GRRLIB_InitTileSet(Img->AsGRRLIB(), Width, Height, 0);
+    Img->InitTileSet(Width, Height, 0);
 }
 
 /**
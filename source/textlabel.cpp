@@ -0,0 +1,199 @@
+// source/textlabel.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#include <algorithm>
+#include <cmath>
+#include "font.h"
+#include "textlayout.h"
+#include "textlabel.h"
+
+/**
+ * Constructor for the TextLabel class.
+ * @param[in] AFont Font used to draw the text.
+ * @param[in] ALayout Layout engine used to wrap the text, nullptr for a single line.
+ */
+TextLabel::TextLabel(Font &AFont, TextLayout *ALayout) :
+    TextFont(AFont),
+    Layout(ALayout)
+{
+}
+
+/**
+ * Set the position of the label.
+ * @param[in] Left Specifies the x-coordinate of the upper-left corner of the text.
+ * @param[in] Top Specifies the y-coordinate of the upper-left corner of the text.
+ */
+void TextLabel::SetLocation(f32 Left, f32 Top)
+{
+    this->Left = Left;
+    this->Top = Top;
+    Dirty = true;
+}
+
+/**
+ * Set the width used to center the text.
+ * The text is also wrapped to this width if the label has a layout.
+ * @param[in] Width Maximum width of a line, 0 to left align the text.
+ */
+void TextLabel::SetWidth(u16 Width)
+{
+    this->Width = Width;
+    Dirty = true;
+}
+
+/**
+ * Set the text style.
+ * @param[in] Size Size of the text in pixels.
+ * @param[in] Color Text color in RGBA format.
+ */
+void TextLabel::SetStyle(u32 Size, u32 Color)
+{
+    this->Size = Size;
+    this->Color = Color;
+    Dirty = true;
+}
+
+/**
+ * Set the shadow drawn under the text.
+ * @param[in] Color Shadow color in RGBA format.
+ * @param[in] OffsetX Shadow offset for the x-coordinate.
+ * @param[in] OffsetY Shadow offset for the y-coordinate.
+ */
+void TextLabel::SetShadow(u32 Color, s8 OffsetX, s8 OffsetY)
+{
+    ShadowColor = Color;
+    ShadowX = OffsetX;
+    ShadowY = OffsetY;
+    Dirty = true;
+}
+
+/**
+ * Set the text of the label.
+ * @param[in] NewText UTF-8 text to draw.
+ * @return true if the text changed and will be rendered again, false otherwise.
+ */
+bool TextLabel::SetText(std::string_view NewText)
+{
+    if(Text == NewText)
+    {
+        return false;
+    }
+    Text = NewText;
+    Dirty = true;
+    return true;
+}
+
+/**
+ * Get the text of the label.
+ * @return The text.
+ */
+std::string_view TextLabel::GetText() const
+{
+    return Text;
+}
+
+/**
+ * Render the label again on the next paint.
+ * Must be called when the background under the label changed.
+ */
+void TextLabel::Invalidate()
+{
+    Dirty = true;
+}
+
+/**
+ * Draw the label to screen.
+ */
+void TextLabel::Paint()
+{
+    if(Text.empty())
+    {
+        return;
+    }
+    if(Dirty || !Img)
+    {
+        Render();
+        Dirty = false;
+    }
+    else
+    {
+        Img->Draw(ImgLeft, ImgTop);
+    }
+}
+
+/**
+ * Draw the text and keep a copy of the screen area it covers.
+ */
+void TextLabel::Render()
+{
+    const s32 StepSize = static_cast<s32>(Size * LINE_HEIGHT_MULTIPLIER);
+    const bool HasShadow = A(ShadowColor) != 0;
+    f32 TextLeft = Left;
+    f32 TextRight = Left;
+    s32 LineCount = 0;
+
+    auto PrintLine = [&](std::string_view LineText, s32 LineWidth)
+    {
+        const f32 xpos = (Width > 0) ? Left + (Width - LineWidth) / 2 : Left;
+        const f32 ypos = Top + LineCount * StepSize;
+        if(HasShadow)
+        {
+            TextFont.Print(xpos + ShadowX, ypos + ShadowY, LineText, Size, ShadowColor);
+        }
+        TextFont.Print(xpos, ypos, LineText, Size, Color);
+        TextLeft = std::min(TextLeft, xpos);
+        TextRight = std::max(TextRight, xpos + LineWidth);
+        ++LineCount;
+    };
+
+    if(Width > 0 && Layout != nullptr)
+    {
+        const auto& Wrapped = Layout->Wrap(Text, Size, Width);
+        for(const auto& Line : Wrapped.Lines)
+        {
+            PrintLine(Wrapped.GetText(Line), Line.Width);
+        }
+    }
+    else
+    {
+        PrintLine(Text, TextFont.GetWidth(Text, Size));
+    }
+
+    // Area covered by the text and its shadow, aligned on texture tiles.
+    // Only what was drawn is kept, a label painted in a clipped layer can
+    // spill out of it.
+    const s32 ShadowLeft = HasShadow ? std::min<s32>(ShadowX, 0) : 0;
+    const s32 ShadowRight = HasShadow ? std::max<s32>(ShadowX, 0) : 0;
+    const s32 ShadowTop = HasShadow ? std::min<s32>(ShadowY, 0) : 0;
+    const s32 ShadowBottom = HasShadow ? std::max<s32>(ShadowY, 0) : 0;
+    const f32 TextBottom = Top + (LineCount - 1) * StepSize + Size * DESCENT_MULTIPLIER;
+    const Screen::ClipRect Clip = Screen::GetClip();
+
+    const s32 x0 = std::max<s32>((static_cast<s32>(std::floor(TextLeft)) + ShadowLeft) & ~3, (Clip.X + 3) & ~3);
+    const s32 y0 = std::max<s32>((static_cast<s32>(std::floor(Top)) + ShadowTop) & ~3, (Clip.Y + 3) & ~3);
+    const s32 x1 = std::min<s32>((static_cast<s32>(std::ceil(TextRight)) + ShadowRight + 3) & ~3, (Clip.X + Clip.Width) & ~3);
+    const s32 y1 = std::min<s32>((static_cast<s32>(std::ceil(TextBottom)) + ShadowBottom + 3) & ~3, (Clip.Y + Clip.Height) & ~3);
+    if(LineCount == 0 || x1 <= x0 || y1 <= y0)
+    {
+        Img.reset();
+        return;
+    }
+
+    if(!Img || Img->GetWidth() != static_cast<u32>(x1 - x0) || Img->GetHeight() != static_cast<u32>(y1 - y0))
+    {
+        Img = std::make_unique<Texture>(x1 - x0, y1 - y0);
+    }
+    ImgLeft = x0;
+    ImgTop = y0;
+    Img->CopyScreen(ImgLeft, ImgTop);
+}
+
+// EOF
@@ -0,0 +1,72 @@
+// source/textlabel.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#ifndef TextLabelH
+#define TextLabelH
+//---------------------------------------------------------------------------
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include "grrlib_class.h"
+
+// Forward declarations
+class Font;
+class TextLayout;
+
+/**
+ * A text rendered once and kept in a texture until it changes.
+ * The texture is a copy of the screen area under the text, so the label must
+ * be painted after its background. Call Invalidate() if the background changes.
+ * @author Crayon
+ */
+class TextLabel
+{
+public:
+    explicit TextLabel(Font &AFont, TextLayout *ALayout = nullptr);
+    TextLabel(TextLabel const&) = delete;
+    ~TextLabel() = default;
+    TextLabel& operator=(TextLabel const&) = delete;
+
+    void SetLocation(f32 Left, f32 Top);
+    void SetWidth(u16 Width);
+    void SetStyle(u32 Size, u32 Color);
+    void SetShadow(u32 Color, s8 OffsetX, s8 OffsetY);
+    bool SetText(std::string_view NewText);
+    [[nodiscard]] std::string_view GetText() const;
+    void Invalidate();
+    void Paint();
+private:
+    static constexpr f32 LINE_HEIGHT_MULTIPLIER = 1.2f;
+    static constexpr f32 DESCENT_MULTIPLIER = 1.3f;
+
+    void Render();
+
+    Font &TextFont;
+    TextLayout *Layout;
+    std::unique_ptr<Texture> Img;
+    std::string Text{};
+    f32 Left{0.0f};
+    f32 Top{0.0f};
+    u16 Width{0};          /**< When not 0, the text is centered in this width, and wrapped if a layout is set. */
+    u32 Size{15};
+    u32 Color{0xFFFFFFFF};
+    u32 ShadowColor{0};    /**< Shadow is not drawn when the color is fully transparent. */
+    s8 ShadowX{0};
+    s8 ShadowY{0};
+    u16 ImgLeft{0};        /**< Screen position of the copied area. */
+    u16 ImgTop{0};
+    bool Dirty{true};
+};
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
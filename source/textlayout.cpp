@@ -0,0 +1,192 @@
+// source/textlayout.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#include "font.h"
+#include "textlayout.h"
+
+/**
+ * Compute a FNV-1a hash of a text.
+ * @param[in] Text The text to hash.
+ * @return The hash value.
+ */
+static constexpr u32 HashText(std::string_view Text)
+{
+    u32 Hash = 2166136261u;
+    for(const char c : Text)
+    {
+        Hash = (Hash ^ static_cast<u8>(c)) * 16777619u;
+    }
+    return Hash;
+}
+
+/**
+ * Constructor for the TextLayout class.
+ * @param[in] AFont Font used to measure the texts, it must outlive the layout.
+ */
+TextLayout::TextLayout(const Font &AFont) :
+    LayoutFont(AFont)
+{
+}
+
+/**
+ * Break a text into lines no wider than a maximum width.
+ * A line always holds at least one word, even if the word is wider.
+ * @param[in] Text UTF-8 text to break, words are separated by spaces.
+ * @param[in] Size Size of the text in pixels.
+ * @param[in] MaxWidth Maximum width of a line in pixels.
+ * @return The layout. It stays valid until the next call.
+ */
+const TextLayout::Result& TextLayout::Wrap(std::string_view Text, u32 Size, u16 MaxWidth)
+{
+    const u32 Hash = HashText(Text);
+    Entry *Oldest = &Cache[0];
+    ++UseCounter;
+
+    for(auto &Item : Cache)
+    {
+        if(Item.LastUse != 0 && Item.Hash == Hash && Item.Size == Size &&
+           Item.MaxWidth == MaxWidth && Item.Layout.Text == Text)
+        {
+            Item.LastUse = UseCounter;
+            ++Hits;
+            return Item.Layout;
+        }
+        if(Item.LastUse < Oldest->LastUse)
+        {
+            Oldest = &Item;
+        }
+    }
+
+    ++Misses;
+    Build(*Oldest, Text, Size, MaxWidth);
+    Oldest->Hash = Hash;
+    Oldest->LastUse = UseCounter;
+    return Oldest->Layout;
+}
+
+/**
+ * Compute the layout of a text into a cache entry.
+ * @param[out] Item The entry to fill.
+ * @param[in] Text UTF-8 text to break.
+ * @param[in] Size Size of the text in pixels.
+ * @param[in] MaxWidth Maximum width of a line in pixels.
+ */
+void TextLayout::Build(Entry &Item, std::string_view Text, u32 Size, u16 MaxWidth)
+{
+    Item.Size = Size;
+    Item.MaxWidth = MaxWidth;
+    Item.Layout.Text.assign(Text);
+    Item.Layout.Lines.clear();
+
+    // Measure every word once, pen positions are in 26.6 at the base size
+    WordStarts.clear();
+    WordEnds.clear();
+    WordBytes.clear();
+    s32 Pen = 0;
+    u32 Previous = 0;
+    bool InWord = false;
+    for(size_t Pos = 0; Pos < Text.size();)
+    {
+        const size_t CharStart = Pos;
+        const u32 Code = Font::NextCodePoint(Text, Pos);
+        const FontGlyph *Glyph = LayoutFont.FindGlyph(Code);
+        if(Glyph != nullptr && Previous != 0)
+        {
+            Pen += LayoutFont.GetKerning(Previous, Code);
+        }
+
+        if(Code == ' ')
+        {
+            if(InWord)
+            {
+                WordEnds.push_back(Pen);
+                WordBytes.push_back(CharStart);
+                InWord = false;
+            }
+        }
+        else if(!InWord)
+        {
+            WordStarts.push_back(Pen);
+            WordBytes.push_back(CharStart);
+            InWord = true;
+        }
+
+        if(Glyph != nullptr)
+        {
+            Pen += Glyph->Advance;
+            Previous = Code;
+        }
+    }
+    if(InWord)
+    {
+        WordEnds.push_back(Pen);
+        WordBytes.push_back(Text.size());
+    }
+
+    const u32 BaseSize = LayoutFont.GetBaseSize();
+    auto ToPixels = [&](s32 Width) -> u16
+    {
+        return (Width * static_cast<s32>(Size) / static_cast<s32>(BaseSize)) >> 6;
+    };
+    auto AddLine = [&](size_t First, size_t Last)
+    {
+        Item.Layout.Lines.push_back({
+            WordBytes[First * 2],
+            static_cast<u16>(WordBytes[Last * 2 + 1] - WordBytes[First * 2]),
+            ToPixels(WordEnds[Last] - WordStarts[First])});
+    };
+
+    // Greedy line breaking
+    size_t First = 0;
+    for(size_t i = 0; i < WordEnds.size(); ++i)
+    {
+        if(i > First && ToPixels(WordEnds[i] - WordStarts[First]) >= MaxWidth)
+        {
+            AddLine(First, i - 1);
+            First = i;
+        }
+    }
+    if(First < WordEnds.size())
+    {
+        AddLine(First, WordEnds.size() - 1);
+    }
+}
+
+/**
+ * Forget every cached layout.
+ */
+void TextLayout::Clear()
+{
+    for(auto &Item : Cache)
+    {
+        Item.LastUse = 0;
+    }
+}
+
+/**
+ * Get the number of layouts found in the cache.
+ * @return The number of cache hits.
+ */
+u32 TextLayout::GetHits() const
+{
+    return Hits;
+}
+
+/**
+ * Get the number of layouts that had to be computed.
+ * @return The number of cache misses.
+ */
+u32 TextLayout::GetMisses() const
+{
+    return Misses;
+}
+
+// EOF
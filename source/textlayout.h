@@ -0,0 +1,101 @@
+// source/textlayout.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#ifndef TextLayoutH
+#define TextLayoutH
+//---------------------------------------------------------------------------
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <gctypes.h>
+
+// Forward declarations
+class Font;
+
+/**
+ * A line produced by the text layout.
+ */
+struct TextLine
+{
+    u16 Start;  /**< Offset of the first byte of the line in the text. */
+    u16 Length; /**< Length of the line in bytes, without the trailing space. */
+    u16 Width;  /**< Width of the line in pixels. */
+};
+
+/**
+ * This class breaks texts into lines and keeps the most recent results.
+ * Words are measured once with the glyph advances of the font, so wrapping a
+ * text is linear in its length. Drawing the same text again costs no layout.
+ * @author Crayon
+ */
+class TextLayout
+{
+public:
+    /**
+     * Result of a layout.
+     */
+    struct Result
+    {
+        std::string Text;            /**< Copy of the text, lines refer to it. */
+        std::vector<TextLine> Lines; /**< Lines in order. */
+
+        /**
+         * Get the text of a line.
+         * @param[in] Line A line of this result.
+         * @return The text of the line.
+         */
+        [[nodiscard]] std::string_view GetText(const TextLine &Line) const
+        {
+            return std::string_view(Text).substr(Line.Start, Line.Length);
+        }
+    };
+
+    explicit TextLayout(const Font &AFont);
+    TextLayout(TextLayout const&) = delete;
+    ~TextLayout() = default;
+    TextLayout& operator=(TextLayout const&) = delete;
+
+    const Result& Wrap(std::string_view Text, u32 Size, u16 MaxWidth);
+    void Clear();
+    [[nodiscard]] u32 GetHits() const;
+    [[nodiscard]] u32 GetMisses() const;
+private:
+    static constexpr size_t CACHE_SIZE = 16;
+
+    /**
+     * A cached layout.
+     */
+    struct Entry
+    {
+        u32 Hash{0};
+        u32 Size{0};
+        u16 MaxWidth{0};
+        u32 LastUse{0};
+        Result Layout;
+    };
+
+    void Build(Entry &Item, std::string_view Text, u32 Size, u16 MaxWidth);
+
+    const Font &LayoutFont;
+    std::array<Entry, CACHE_SIZE> Cache{};
+    std::vector<s32> WordEnds;   /**< Scratch buffer, pen position after each word. */
+    std::vector<s32> WordStarts; /**< Scratch buffer, pen position before each word. */
+    std::vector<u16> WordBytes;  /**< Scratch buffer, byte range of each word. */
+    u32 UseCounter{0};
+    u32 Hits{0};
+    u32 Misses{0};
+};
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
@@ -72,7 +72,9 @@ void RUMBLE_Verify()
  */
 void WIILIGHT_TurnOff()
 {
+#ifndef WTT_HEADLESS // No disc slot on the host
     *(u32*)0xCD0000C0 &= ~0x20;
+#endif
 }
 
 /**
@@ -80,7 +82,9 @@ void WIILIGHT_TurnOff()
  */
 void WIILIGHT_TurnOn()
 {
+#ifndef WTT_HEADLESS // No disc slot on the host
     *(u32*)0xCD0000C0 |= 0x20;
+#endif
 }
 
 /**
@@ -111,7 +115,7 @@ void Draw_FadeIn(Texture *tex, f32 scaleX, f32 scaleY, u16 speed)
     for(s16 alpha = 0; alpha < 255; alpha += speed)
     {
         tex->Draw(xpos, ypos, 0, scaleX, scaleY, 0xFFFFFF00 | (alpha > 255 ? 255 : alpha));
-        GRRLIB_Render();
+        Screen::Render();
     }
 }
 
@@ -130,7 +134,7 @@ void Draw_FadeOut(Texture *tex, f32 scaleX, f32 scaleY, u16 speed)
     for(s16 alpha = 255; alpha > 0; alpha -= speed)
     {
         tex->Draw(xpos, ypos, 0, scaleX, scaleY, 0xFFFFFF00 | (alpha < 0 ? 0 : alpha));
-        GRRLIB_Render();
+        Screen::Render();
     }
 }
 
@@ -156,4 +160,20 @@ bool PtInCircle(const int xo, const int yo, const int radius,
     return (dx + dy <= radius) || (dx * dx + dy * dy <= radius * radius);
 }
 
+/**
+ * Determine whether the specified point lies within the specified rectangle.
+ * @param hotx Specifies the x-coordinate of the upper-left corner of the rectangle.
+ * @param hoty Specifies the y-coordinate of the upper-left corner of the rectangle.
+ * @param hotw The width of the rectangle.
+ * @param hoth The height of the rectangle.
+ * @param wpadx Specifies the x-coordinate of the point.
+ * @param wpady Specifies the y-coordinate of the point.
+ * @return If the specified point lies within the rectangle, the return value is true otherwise it's false.
+ */
+bool PtInRect(const int hotx, const int hoty, const int hotw, const int hoth,
+              const int wpadx, const int wpady) {
+    return ((wpadx >= hotx) && (wpadx <= (hotx + hotw)) &&
+            (wpady >= hoty) && (wpady <= (hoty + hoth)));
+}
+
 // EOF
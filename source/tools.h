@@ -28,6 +28,8 @@ void Draw_FadeOut(Texture *tex, f32 scaleX, f32 scaleY, u16 speed);
 
 [[nodiscard]] bool PtInCircle(const int xo, const int yo, const int radius,
                 const int wpadx, const int wpady);
+[[nodiscard]] bool PtInRect(const int hotx, const int hoty, const int hotw, const int hoth,
+                const int wpadx, const int wpady);
 //---------------------------------------------------------------------------
 #endif
 
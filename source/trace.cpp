@@ -0,0 +1,83 @@
+// source/trace.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#include <array>
+#include <cstdio>
+#include <ogc/lwp_watchdog.h>
+#include "trace.h"
+
+static_assert((Trace::CAPACITY & (Trace::CAPACITY - 1)) == 0, "CAPACITY must be a power of two");
+
+static std::array<Trace::Event, Trace::CAPACITY> Events; /**< Ring buffer. */
+static u32 Recorded{0}; /**< Number of events recorded since the start. */
+
+/**
+ * Add an event to the ring buffer.
+ * @param[in] Kind Kind of event.
+ * @param[in] Name Name of the event, a string literal.
+ */
+void Trace::Record(Type Kind, const char *Name)
+{
+    Event &Slot = Events[Recorded++ & (CAPACITY - 1)];
+    Slot.Time = gettime();
+    Slot.Name = Name;
+    Slot.Kind = Kind;
+}
+
+/**
+ * Save the events in the ring buffer to a Chrome trace file.
+ * An end event whose begin was overwritten is skipped, so durations stay
+ * balanced. The buffer is not cleared.
+ * @param[in] filename Name of the JSON file to write.
+ * @return true if the file was written, false otherwise.
+ */
+bool Trace::Save(const char *filename)
+{
+    std::FILE *File = std::fopen(filename, "w");
+    if(File == nullptr)
+    {
+        return false;
+    }
+
+    const u32 Last = Recorded;
+    const u32 First = (Last > CAPACITY) ? Last - CAPACITY : 0;
+    const u64 Origin = (Last > First) ? Events[First & (CAPACITY - 1)].Time : 0;
+    static constexpr char Phases[] = {'B', 'E', 'i'};
+
+    std::fputs("{\"traceEvents\":[\n", File);
+    u32 Depth = 0;
+    bool NeedComma = false;
+    for(u32 i = First; i < Last; ++i)
+    {
+        const Event &Item = Events[i & (CAPACITY - 1)];
+        if(Item.Kind == Type::Begin)
+        {
+            ++Depth;
+        }
+        else if(Item.Kind == Type::End)
+        {
+            if(Depth == 0)
+            {
+                continue;
+            }
+            --Depth;
+        }
+        std::fprintf(File, "%s{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":1%s}",
+            NeedComma ? ",\n" : "", Item.Name, Phases[static_cast<u8>(Item.Kind)],
+            ticks_to_nanosecs(Item.Time - Origin) / 1000.0,
+            (Item.Kind == Type::Instant) ? ",\"s\":\"g\"" : "");
+        NeedComma = true;
+    }
+    std::fputs("\n],\"displayTimeUnit\":\"ms\"}\n", File);
+    return std::fclose(File) == 0;
+}
+
+// EOF
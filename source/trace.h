@@ -0,0 +1,83 @@
+// source/trace.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#ifndef TraceH
+#define TraceH
+//---------------------------------------------------------------------------
+
+#include <cstddef>
+#include <gctypes.h>
+
+/**
+ * Namespace containing the event tracer.
+ * Events are fixed-size records written to a preallocated ring buffer, so
+ * recording one costs a time base read and a few stores. The buffer is only
+ * formatted when it is saved, as a Chrome trace (chrome://tracing, Perfetto).
+ * @author Crayon
+ */
+namespace Trace
+{
+    /**
+     * Kinds of event.
+     */
+    enum class Type : u8 {
+        Begin,  /**< Start of a duration. */
+        End,    /**< End of the last duration started. */
+        Instant /**< A point in time. */
+    };
+
+    /**
+     * An event in the ring buffer.
+     */
+    struct Event
+    {
+        u64 Time;         /**< Time base ticks. */
+        const char *Name; /**< Static string, it is not copied. */
+        Type Kind;        /**< Kind of event. */
+    };
+
+    /**
+     * Number of events kept, the oldest are overwritten.
+     */
+    inline constexpr size_t CAPACITY = 4096;
+
+    void Record(Type Kind, const char *Name);
+    bool Save(const char *filename);
+
+    /**
+     * Trace the duration of a scope.
+     */
+    class Scope
+    {
+    public:
+        explicit Scope(const char *AName) : Name(AName) { Record(Type::Begin, Name); }
+        Scope(Scope const&) = delete;
+        ~Scope() { Record(Type::End, Name); }
+        Scope& operator=(Scope const&) = delete;
+    private:
+        const char *Name;
+    };
+}   /* namespace Trace */
+
+#define TRACE_CONCAT2(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT2(a, b)
+
+/**
+ * Event macros, the name must be a string literal.
+ */
+#define TRACE_BEGIN(name)   Trace::Record(Trace::Type::Begin, name)
+#define TRACE_END(name)     Trace::Record(Trace::Type::End, name)
+#define TRACE_INSTANT(name) Trace::Record(Trace::Type::Instant, name)
+#define TRACE_SCOPE(name)   Trace::Scope TRACE_CONCAT(TraceScope, __LINE__)(name)
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
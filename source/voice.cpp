@@ -11,14 +11,37 @@
 
 #include "voice.h"
 #include "sound.h"
-#include <aesndlib.h>
+
+/**
+ * The backend used by every voice.
+ */
+static std::unique_ptr<AudioBackend> CurrentBackend;
+
+/**
+ * Set the backend used to play sounds.
+ * It must be set before the Audio class is created.
+ * @param Backend The new backend.
+ */
+void SetAudioBackend(std::unique_ptr<AudioBackend> Backend)
+{
+    CurrentBackend = std::move(Backend);
+}
+
+/**
+ * Return the backend used to play sounds.
+ * @return The backend.
+ */
+AudioBackend& GetAudioBackend()
+{
+    return *CurrentBackend;
+}
 
 /**
  * Constructor for the Voice class.
  */
 Voice::Voice()
 {
-    _Voice = AESND_AllocateVoice(nullptr);
+    _Voice = GetAudioBackend().AllocateVoice();
 }
 
 /**
@@ -26,7 +49,7 @@ Voice::Voice()
  */
 Voice::~Voice()
 {
-    AESND_FreeVoice(_Voice);
+    GetAudioBackend().FreeVoice(_Voice);
 }
 
 /**
@@ -45,19 +68,18 @@ void Voice::SetVolume(u16 Volume)
  */
 void Voice::SetVolume(u16 LeftVolume, u16 RightVolume)
 {
-    AESND_SetVoiceVolume(_Voice, LeftVolume, RightVolume);
+    GetAudioBackend().SetVoiceVolume(_Voice, LeftVolume, RightVolume);
 }
 
 /**
  * Play a sound.
- * @param[in] sound The sound to play.
+ * @param[in] sound The sound to play, it cannot be ADPCM.
  * @param[in] delay A delay.
  * @param[in] looped Set true to make the sound loop, false otherwise.
  */
 void Voice::Play(const Sound& sound, u32 delay, bool looped)
 {
-    AESND_PlayVoice(_Voice, sound.GetFormat(), sound.GetBuffer().data(), sound.GetBuffer().size(),
-            sound.GetFrequency(), delay, looped);
+    GetAudioBackend().PlayVoice(_Voice, sound, delay, looped);
 }
 
 /**
@@ -66,7 +88,15 @@ void Voice::Play(const Sound& sound, u32 delay, bool looped)
  */
 void Voice::Mute(bool mute)
 {
-    AESND_SetVoiceMute(_Voice, mute);
+    GetAudioBackend().SetVoiceMute(_Voice, mute);
+}
+
+/**
+ * Stop the voice, it can be played again.
+ */
+void Voice::Stop()
+{
+    GetAudioBackend().SetVoiceStop(_Voice, true);
 }
 
 // EOF
@@ -14,9 +14,7 @@
 
 #include <gctypes.h>
 #include "sound.h"
-
-// Forward declarations
-struct aesndpb_t;
+#include "audiobackend.h"
 
 /**
  * This is a class used for voice.
@@ -25,7 +23,7 @@ struct aesndpb_t;
 class Voice
 {
 private:
-    aesndpb_t *_Voice;
+    AudioBackend::VoiceId _Voice;
 public:
     Voice();
     Voice(Voice const&) = delete;
@@ -36,6 +34,7 @@ public:
     void SetVolume(u16 LeftVolume, u16 RightVolume);
     void Play(const Sound& sound, u32 delay = 0, bool looped = false);
     void Mute(bool mute);
+    void Stop();
 };
 
 #endif /* VOICE_H_ */
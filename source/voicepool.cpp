@@ -0,0 +1,156 @@
+// source/voicepool.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#include <algorithm>
+#include <ogc/lwp_watchdog.h>
+#include "voice.h"
+#include "sound.h"
+#include "voicepool.h"
+
+/**
+ * Constructor for the VoicePool class.
+ * The audio backend must be initialized.
+ * @param[in] Count Number of voices.
+ * @param[in] APolicy Which voice is stolen among those of the same priority.
+ */
+VoicePool::VoicePool(u8 Count, StealPolicy APolicy) :
+    Slots(Count),
+    Policy(APolicy)
+{
+    for(Slot &Item : Slots)
+    {
+        Item.Channel = std::make_unique<Voice>();
+    }
+}
+
+/**
+ * Destructor for the VoicePool class.
+ */
+VoicePool::~VoicePool() = default;
+
+/**
+ * Play a sound on a free or stolen voice.
+ * @param[in] sound The sound to play.
+ * @param[in] Priority Priority of the sound, a higher one steals a voice from a lower one.
+ * @param[in] Volume The volume, between 0 and 255.
+ * @param[in] Pan Position from -1.0 (left) to 1.0 (right), 0.0 is the center.
+ * @param[in] Delay Time before the sound starts, in milliseconds.
+ * @return true if the sound plays, false if it was dropped.
+ */
+bool VoicePool::Play(const Sound &sound, u8 Priority, u16 Volume, f32 Pan, u32 Delay)
+{
+    const u64 Now = gettime();
+    Slot *Target = FindVoice(Priority, Now);
+    if(Target == nullptr)
+    {
+        ++Counters.Dropped;
+        return false;
+    }
+
+    Pan = std::clamp(Pan, -1.0f, 1.0f);
+    const u16 LeftVolume = static_cast<u16>(Volume * std::min(1.0f, 1.0f - Pan));
+    const u16 RightVolume = static_cast<u16>(Volume * std::min(1.0f, 1.0f + Pan));
+    Target->Channel->SetVolume(LeftVolume, RightVolume);
+    Target->Channel->Play(sound, Delay);
+    Target->Start = Now + millisecs_to_ticks(Delay);
+    Target->End = Target->Start + microsecs_to_ticks(sound.GetDuration());
+    Target->Volume = std::max(LeftVolume, RightVolume);
+    Target->Priority = Priority;
+    ++Counters.Plays;
+    return true;
+}
+
+/**
+ * Find the voice for a new sound.
+ * @param[in] Priority Priority of the new sound.
+ * @param[in] Now Current time, in ticks.
+ * @return A voice that is not playing, a stolen voice, or nullptr if every
+ *         voice plays a sound of higher priority.
+ */
+VoicePool::Slot* VoicePool::FindVoice(u8 Priority, u64 Now)
+{
+    Slot *Victim = nullptr;
+    for(Slot &Item : Slots)
+    {
+        if(Item.End <= Now)
+        {
+            return &Item;
+        }
+        if(Item.Priority > Priority)
+        {
+            continue;
+        }
+        if(Victim == nullptr || Item.Priority < Victim->Priority)
+        {
+            Victim = &Item;
+            continue;
+        }
+        if(Item.Priority > Victim->Priority)
+        {
+            continue;
+        }
+        const bool Quieter = (Item.Volume < Victim->Volume);
+        const bool SameVolume = (Item.Volume == Victim->Volume);
+        const bool Older = (Item.Start < Victim->Start);
+        if((Policy == StealPolicy::Quietest && (Quieter || (SameVolume && Older))) ||
+           (Policy == StealPolicy::Oldest && Older))
+        {
+            Victim = &Item;
+        }
+    }
+    if(Victim != nullptr)
+    {
+        ++Counters.Steals;
+    }
+    return Victim;
+}
+
+/**
+ * Stop every voice.
+ */
+void VoicePool::StopAll()
+{
+    for(Slot &Item : Slots)
+    {
+        Item.Channel->Stop();
+        Item.End = 0;
+    }
+}
+
+/**
+ * Get the number of voices playing a sound.
+ * @return The number of voices.
+ */
+u8 VoicePool::GetActiveCount() const
+{
+    const u64 Now = gettime();
+    return std::count_if(Slots.begin(), Slots.end(), [Now](const Slot &Item) { return Item.End > Now; });
+}
+
+/**
+ * Get the number of voices of the pool.
+ * @return The number of voices.
+ */
+u8 VoicePool::GetVoiceCount() const
+{
+    return Slots.size();
+}
+
+/**
+ * Get the counters of the pool.
+ * @return The counters.
+ */
+const VoicePool::Stats& VoicePool::GetStats() const
+{
+    return Counters;
+}
+
+// EOF
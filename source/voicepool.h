@@ -0,0 +1,83 @@
+// source/voicepool.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#ifndef VoicePoolH
+#define VoicePoolH
+//---------------------------------------------------------------------------
+
+#include <memory>
+#include <vector>
+#include <gctypes.h>
+
+class Sound;
+class Voice;
+
+/**
+ * A fixed set of voices shared by every sound effect.
+ * A sound takes a voice that is not playing. When every voice is busy, the
+ * voice playing the sound of lowest priority is stolen, the new sound is
+ * dropped if every voice plays a sound of higher priority.
+ * @author Crayon
+ */
+class VoicePool
+{
+public:
+    /**
+     * Which voice is stolen among those of the same priority.
+     */
+    enum class StealPolicy : u8 {
+        Oldest,     /**< The voice that started first. */
+        Quietest    /**< The voice of lowest volume, the oldest one if equal. */
+    };
+
+    /**
+     * Counters of the pool since it was created.
+     */
+    struct Stats
+    {
+        u32 Plays{0};    /**< Sounds started. */
+        u32 Steals{0};   /**< Sounds cut to start another one. */
+        u32 Dropped{0};  /**< Sounds not played, every voice had a higher priority. */
+    };
+
+    VoicePool(u8 Count, StealPolicy APolicy);
+    VoicePool(VoicePool const&) = delete;
+    ~VoicePool();
+    VoicePool& operator=(VoicePool const&) = delete;
+
+    bool Play(const Sound &sound, u8 Priority, u16 Volume, f32 Pan, u32 Delay = 0);
+    void StopAll();
+    [[nodiscard]] u8 GetActiveCount() const;
+    [[nodiscard]] u8 GetVoiceCount() const;
+    [[nodiscard]] const Stats& GetStats() const;
+private:
+    /**
+     * A voice and what it plays.
+     */
+    struct Slot
+    {
+        std::unique_ptr<Voice> Channel;
+        u64 Start{0};     /**< Time the sound starts, in ticks. */
+        u64 End{0};       /**< Time the sound ends, in ticks. */
+        u16 Volume{0};    /**< Loudest side of the sound. */
+        u8 Priority{0};   /**< Priority of the sound. */
+    };
+
+    [[nodiscard]] Slot* FindVoice(u8 Priority, u64 Now);
+
+    std::vector<Slot> Slots;
+    StealPolicy Policy;
+    Stats Counters;
+};
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
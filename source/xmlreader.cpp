@@ -0,0 +1,281 @@
+// source/xmlreader.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#include <algorithm>
+#include <charconv>
+#include "xmlreader.h"
+
+/**
+ * Characters separating names and attributes.
+ */
+static constexpr std::string_view WHITESPACE = " \t\r\n";
+
+/**
+ * Constructor for the XmlReader class.
+ * @param[in] ADocument Text of the document, it must outlive the reader.
+ */
+XmlReader::XmlReader(std::string_view ADocument) :
+    Document(ADocument)
+{
+}
+
+/**
+ * Move to the next start tag.
+ * End tags, comments and declarations are skipped; an end tag must match
+ * the element it closes.
+ * @return true if an element was found, false at the end of the document
+ *         or on error, see HasError.
+ */
+bool XmlReader::Next()
+{
+    if(!Error.empty())
+    {
+        return false;
+    }
+    Attributes.clear();
+    for(size_t Pos = Document.find('<', Position); Pos != std::string_view::npos; Pos = Document.find('<', Position))
+    {
+        if(Document.substr(Pos, 4) == "<!--")
+        {
+            const size_t End = Document.find("-->", Pos);
+            if(End == std::string_view::npos)
+            {
+                return Fail(Pos, "unterminated comment");
+            }
+            Position = End + 3;
+            continue;
+        }
+        const size_t End = Document.find('>', Pos);
+        if(End == std::string_view::npos)
+        {
+            return Fail(Pos, "unterminated tag");
+        }
+        std::string_view Tag = Document.substr(Pos + 1, End - Pos - 1);
+        Position = End + 1;
+
+        if(Tag.starts_with('?') || Tag.starts_with('!'))
+        {   // Declaration
+            continue;
+        }
+        if(Tag.starts_with('/'))
+        {
+            Tag.remove_prefix(1);
+            const std::string_view EndName = Tag.substr(0, Tag.find_last_not_of(WHITESPACE) + 1);
+            if(Stack.empty() || Stack.back() != EndName)
+            {
+                return Fail(Pos, "unexpected end tag </" + std::string(EndName) + ">");
+            }
+            Stack.pop_back();
+            continue;
+        }
+        const bool Empty = Tag.ends_with('/');
+        if(Empty)
+        {
+            Tag.remove_suffix(1);
+        }
+
+        // Name and attributes
+        TagPosition = Pos;
+        const size_t NameEnd = std::min(Tag.find_first_of(WHITESPACE), Tag.size());
+        Name = Tag.substr(0, NameEnd);
+        for(size_t AttrPos = Tag.find_first_not_of(WHITESPACE, NameEnd);
+            AttrPos != std::string_view::npos;
+            AttrPos = Tag.find_first_not_of(WHITESPACE, AttrPos))
+        {
+            const size_t Equal = Tag.find('=', AttrPos);
+            if(Equal == std::string_view::npos || Equal + 1 >= Tag.size() ||
+               (Tag[Equal + 1] != '"' && Tag[Equal + 1] != '\''))
+            {
+                return Fail(Pos, "malformed attribute in <" + std::string(Name) + ">");
+            }
+            const size_t ValueEnd = Tag.find(Tag[Equal + 1], Equal + 2);
+            if(ValueEnd == std::string_view::npos)
+            {
+                return Fail(Pos, "unterminated attribute in <" + std::string(Name) + ">");
+            }
+            std::string_view AttrName = Tag.substr(AttrPos, Equal - AttrPos);
+            AttrName = AttrName.substr(0, AttrName.find_last_not_of(WHITESPACE) + 1);
+            Attributes.emplace_back(AttrName, Unescape(Tag.substr(Equal + 2, ValueEnd - Equal - 2)));
+            AttrPos = ValueEnd + 1;
+        }
+
+        Parent = Stack.empty() ? std::string_view() : Stack.back();
+        if(!Empty)
+        {
+            Stack.push_back(Name);
+        }
+        return true;
+    }
+    if(!Stack.empty())
+    {
+        std::string Message("<");
+        Message.append(Stack.back()).append("> is not closed");
+        return Fail(Document.size(), std::move(Message));
+    }
+    return false;
+}
+
+/**
+ * Get the name of the current element.
+ * @return The name.
+ */
+std::string_view XmlReader::GetName() const
+{
+    return Name;
+}
+
+/**
+ * Get the name of the element containing the current one.
+ * @return The name, empty for the root element.
+ */
+std::string_view XmlReader::GetParent() const
+{
+    return Parent;
+}
+
+/**
+ * Get an attribute of the current element.
+ * @param[in] AttrName Name of the attribute.
+ * @return The decoded value, nullptr if the element has no such attribute.
+ */
+const std::string* XmlReader::GetAttribute(std::string_view AttrName) const
+{
+    for(const auto &[Key, Value] : Attributes)
+    {
+        if(Key == AttrName)
+        {
+            return &Value;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Check if the document is malformed.
+ * @return true if Next stopped on an error, false otherwise.
+ */
+bool XmlReader::HasError() const
+{
+    return !Error.empty();
+}
+
+/**
+ * Get the description of the error.
+ * @return The description, empty if there is no error.
+ */
+const std::string& XmlReader::GetError() const
+{
+    return Error;
+}
+
+/**
+ * Get the line of the current element, or of the error.
+ * @return The line number, starting at 1.
+ */
+size_t XmlReader::GetLine() const
+{
+    const size_t End = std::min(TagPosition, Document.size());
+    return 1 + std::count(Document.begin(), Document.begin() + End, '\n');
+}
+
+/**
+ * Stop parsing on an error.
+ * @param[in] Pos Where the error is.
+ * @param[in] Message Description of the error.
+ * @return Always false.
+ */
+bool XmlReader::Fail(size_t Pos, std::string Message)
+{
+    TagPosition = Pos;
+    Error = std::move(Message);
+    Name = Parent = std::string_view();
+    Attributes.clear();
+    return false;
+}
+
+/**
+ * Append a code point encoded as UTF-8.
+ */
+static void AppendUtf8(std::string &Result, unsigned long Code)
+{
+    if(Code < 0x80)
+    {
+        Result += static_cast<char>(Code);
+    }
+    else if(Code < 0x800)
+    {
+        Result += static_cast<char>(0xC0 | (Code >> 6));
+        Result += static_cast<char>(0x80 | (Code & 0x3F));
+    }
+    else if(Code < 0x10000)
+    {
+        Result += static_cast<char>(0xE0 | (Code >> 12));
+        Result += static_cast<char>(0x80 | ((Code >> 6) & 0x3F));
+        Result += static_cast<char>(0x80 | (Code & 0x3F));
+    }
+    else
+    {
+        Result += static_cast<char>(0xF0 | (Code >> 18));
+        Result += static_cast<char>(0x80 | ((Code >> 12) & 0x3F));
+        Result += static_cast<char>(0x80 | ((Code >> 6) & 0x3F));
+        Result += static_cast<char>(0x80 | (Code & 0x3F));
+    }
+}
+
+/**
+ * Replace the predefined XML entities and character references of a value.
+ * An unknown or malformed reference is kept as is.
+ * @param[in] Text The raw attribute value.
+ * @return The decoded UTF-8 text.
+ */
+std::string XmlReader::Unescape(std::string_view Text)
+{
+    static constexpr std::pair<std::string_view, char> Entities[] = {
+        {"&amp;", '&'}, {"&lt;", '<'}, {"&gt;", '>'}, {"&quot;", '"'}, {"&apos;", '\''}
+    };
+    std::string Result;
+    Result.reserve(Text.size());
+    for(size_t i = 0; i < Text.size(); ++i)
+    {
+        if(Text[i] != '&')
+        {
+            Result += Text[i];
+            continue;
+        }
+        const auto Entity = std::find_if(std::begin(Entities), std::end(Entities),
+            [Rest = Text.substr(i)](const auto &Item) { return Rest.starts_with(Item.first); });
+        if(Entity != std::end(Entities))
+        {
+            Result += Entity->second;
+            i += Entity->first.size() - 1;
+            continue;
+        }
+        const size_t End = Text.find(';', i);
+        if(Text.substr(i, 2) == "&#" && End != std::string_view::npos)
+        {   // Character reference, written back as UTF-8
+            const bool Hexadecimal = (i + 2 < End && Text[i + 2] == 'x');
+            const char *First = Text.data() + i + (Hexadecimal ? 3 : 2);
+            const char *Last = Text.data() + End;
+            unsigned long Code = 0;
+            const auto [Ptr, Status] = std::from_chars(First, Last, Code, Hexadecimal ? 16 : 10);
+            if(Status == std::errc() && Ptr == Last && First != Last && Code <= 0x10FFFF)
+            {
+                AppendUtf8(Result, Code);
+                i = End;
+                continue;
+            }
+        }
+        Result += '&';
+    }
+    return Result;
+}
+
+// EOF
@@ -0,0 +1,61 @@
+// source/xmlreader.h
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+#ifndef XmlReaderH
+#define XmlReaderH
+//---------------------------------------------------------------------------
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * A minimal XML pull parser for the language files.
+ * Only start tags and their attributes are reported, text content is
+ * skipped. It is shared by the langc tool and the game, which reloads the
+ * language files from the SD card.
+ * @author Crayon
+ */
+class XmlReader
+{
+public:
+    explicit XmlReader(std::string_view ADocument);
+    XmlReader(XmlReader const&) = delete;
+    ~XmlReader() = default;
+    XmlReader& operator=(XmlReader const&) = delete;
+
+    bool Next();
+    [[nodiscard]] std::string_view GetName() const;
+    [[nodiscard]] std::string_view GetParent() const;
+    [[nodiscard]] const std::string* GetAttribute(std::string_view AttrName) const;
+    [[nodiscard]] bool HasError() const;
+    [[nodiscard]] const std::string& GetError() const;
+    [[nodiscard]] size_t GetLine() const;
+
+    static std::string Unescape(std::string_view Text);
+private:
+    bool Fail(size_t Pos, std::string Message);
+
+    std::string_view Document;                 /**< Text of the document, it must outlive the reader. */
+    size_t Position{0};                        /**< Where the next tag is searched. */
+    size_t TagPosition{0};                     /**< Start of the current tag. */
+    std::vector<std::string_view> Stack;       /**< Names of the open elements. */
+    std::string_view Name;                     /**< Name of the current element. */
+    std::string_view Parent;                   /**< Name of the element containing the current one. */
+    std::vector<std::pair<std::string_view, std::string>> Attributes; /**< Decoded attributes of the current element. */
+    std::string Error;                         /**< Description of the error, empty if none. */
+};
+//---------------------------------------------------------------------------
+#endif
+
+// EOF
@@ -0,0 +1,666 @@
+// tools/fontbake.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+/**
+ * @file
+ * Host tool that bakes a TrueType font into a signed distance field atlas.
+ *
+ * The glyphs are rendered with FreeType at a large size, converted to a
+ * distance field and packed in a GX IA8 texture. The output is a C++ source
+ * file and header describing the atlas, the glyph metrics and the kerning
+ * pairs, ready to be used by the Font class of the game.
+ *
+ * Glyphs of large scripts (CJK by default) are not packed in the atlas: their
+ * fields are compressed one by one, and the game decompresses them into a
+ * small glyph cache the first time they are drawn. Only the code points
+ * given on the command line are baked, so the font is subset to the texts
+ * of the game.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include "../fonts/Swis721_Ex_BT.h"
+
+/**
+ * Options given on the command line.
+ */
+struct BakeOptions
+{
+    std::string FontFile;         /**< TrueType file to bake, the built-in font is used when empty. */
+    std::string FallbackFile;     /**< TrueType file used for the code points missing in the font. */
+    std::string OutputDir;        /**< Directory where the files are written. */
+    std::string Name;             /**< Symbol name, also used for the file names. */
+    unsigned int BaseSize{28};    /**< Size in pixels of the glyphs in the atlas. */
+    unsigned int Spread{4};       /**< Distance in pixels covered by the field outside a glyph. */
+    unsigned int Oversample{4};   /**< Supersampling factor used to compute the field. */
+    unsigned int AtlasWidth{512}; /**< Width of the atlas in pixels. */
+    char32_t StoreAbove{0x2E80};  /**< First code point stored compressed instead of in the atlas. */
+    std::set<char32_t> Charset;   /**< Code points to bake. */
+};
+
+/**
+ * A glyph once converted to a distance field.
+ */
+struct BakedGlyph
+{
+    char32_t Code{0};
+    FT_UInt Index{0};
+    int Width{0};
+    int Height{0};
+    int BearingX{0};
+    int BearingY{0};
+    int Advance{0}; // 26.6 fixed point
+    int X{0};
+    int Y{0};
+    std::vector<uint8_t> Field;
+};
+
+/**
+ * Print the command line usage.
+ */
+static void Usage()
+{
+    std::fputs(
+        "Usage: fontbake [options] <output_dir> <name>\n"
+        "  --font <file>       TrueType font to bake (default: Swis721 Ex BT)\n"
+        "  --fallback <file>   TrueType font for the code points missing in the font\n"
+        "  --size <pixels>     Glyph size in the atlas (default: 28)\n"
+        "  --spread <pixels>   Distance field spread (default: 4)\n"
+        "  --width <pixels>    Atlas width (default: 512)\n"
+        "  --store-above <hex> Compress the glyphs from this code point instead of\n"
+        "                      packing them in the atlas (default: 2E80)\n"
+        "  --range <a-b>       Add a range of code points, in hexadecimal\n"
+        "  --chars-from <file> Add every code point found in a UTF-8 file\n",
+        stderr);
+}
+
+/**
+ * Decode the next code point from a UTF-8 string.
+ * @param[in] Text The string to decode.
+ * @param[in,out] Pos Position in the string, moved after the code point.
+ * @return The code point, or U+FFFD for malformed sequences.
+ */
+static char32_t NextCodePoint(std::string_view Text, size_t &Pos)
+{
+    const auto Lead = static_cast<uint8_t>(Text[Pos++]);
+    int Extra = 0;
+    char32_t Code = Lead;
+    if(Lead >= 0xF0) { Extra = 3; Code = Lead & 0x07; }
+    else if(Lead >= 0xE0) { Extra = 2; Code = Lead & 0x0F; }
+    else if(Lead >= 0xC0) { Extra = 1; Code = Lead & 0x1F; }
+    else if(Lead >= 0x80) { return 0xFFFD; }
+
+    while(Extra-- > 0)
+    {
+        if(Pos >= Text.size())
+        {
+            return 0xFFFD;
+        }
+        Code = (Code << 6) | (static_cast<uint8_t>(Text[Pos++]) & 0x3F);
+    }
+    return Code;
+}
+
+/**
+ * Parse the command line.
+ * @param[in] argc The number of arguments.
+ * @param[in] argv The arguments.
+ * @param[out] Options The parsed options.
+ * @return true if the command line is valid.
+ */
+static bool ParseOptions(int argc, char **argv, BakeOptions &Options)
+{
+    std::vector<std::string> Positional;
+    bool HasRange = false;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        const std::string_view Arg = argv[i];
+        const bool HasValue = (i + 1 < argc);
+        if(Arg == "--font" && HasValue)
+        {
+            Options.FontFile = argv[++i];
+        }
+        else if(Arg == "--fallback" && HasValue)
+        {
+            Options.FallbackFile = argv[++i];
+        }
+        else if(Arg == "--store-above" && HasValue)
+        {
+            Options.StoreAbove = std::strtoul(argv[++i], nullptr, 16);
+        }
+        else if(Arg == "--size" && HasValue)
+        {
+            Options.BaseSize = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if(Arg == "--spread" && HasValue)
+        {
+            Options.Spread = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if(Arg == "--width" && HasValue)
+        {
+            Options.AtlasWidth = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if(Arg == "--range" && HasValue)
+        {
+            char *End = nullptr;
+            const char32_t First = std::strtoul(argv[++i], &End, 16);
+            const char32_t Last = (*End == '-') ? std::strtoul(End + 1, nullptr, 16) : First;
+            for(char32_t Code = First; Code <= Last; ++Code)
+            {
+                Options.Charset.insert(Code);
+            }
+            HasRange = true;
+        }
+        else if(Arg == "--chars-from" && HasValue)
+        {
+            std::ifstream File(argv[++i], std::ios::binary);
+            if(!File)
+            {
+                std::fprintf(stderr, "fontbake: cannot open %s\n", argv[i]);
+                return false;
+            }
+            std::stringstream Buffer;
+            Buffer << File.rdbuf();
+            const std::string Text = Buffer.str();
+            for(size_t Pos = 0; Pos < Text.size();)
+            {
+                const char32_t Code = NextCodePoint(Text, Pos);
+                if(Code >= 0x20 && Code != 0xFFFD)
+                {
+                    Options.Charset.insert(Code);
+                }
+            }
+        }
+        else if(Arg.starts_with("--"))
+        {
+            return false;
+        }
+        else
+        {
+            Positional.emplace_back(Arg);
+        }
+    }
+
+    if(Positional.size() != 2 || Options.BaseSize == 0 || Options.Oversample == 0)
+    {
+        return false;
+    }
+    Options.OutputDir = Positional[0];
+    Options.Name = Positional[1];
+
+    if(!HasRange)
+    {   // Printable ASCII and Latin-1 Supplement
+        for(char32_t Code = 0x20; Code <= 0x7E; ++Code)
+        {
+            Options.Charset.insert(Code);
+        }
+        for(char32_t Code = 0xA0; Code <= 0xFF; ++Code)
+        {
+            Options.Charset.insert(Code);
+        }
+    }
+    return true;
+}
+
+/**
+ * Convert a coverage bitmap to a signed distance field.
+ * The field is sampled at the center of each output pixel, with 128 on the
+ * outline, higher values inside the glyph and lower values outside.
+ * @param[in] Bitmap The 8-bit coverage bitmap rendered at the oversampled size.
+ * @param[in] Options The bake options.
+ * @param[out] Glyph The glyph receiving the field, its size and bearings.
+ */
+static void BuildDistanceField(const FT_Bitmap &Bitmap, int BitmapLeft, int BitmapTop,
+    const BakeOptions &Options, BakedGlyph &Glyph)
+{
+    const int OS = Options.Oversample;
+    const int Spread = Options.Spread;
+    const int SearchRadius = Spread * OS;
+    const int SrcW = Bitmap.width;
+    const int SrcH = Bitmap.rows;
+
+    // Align the hi-res bitmap on the low-res pixel grid
+    const int OriginX = static_cast<int>(std::floor(static_cast<float>(BitmapLeft) / OS));
+    const int OriginY = static_cast<int>(std::ceil(static_cast<float>(BitmapTop) / OS));
+    const int PadX = BitmapLeft - OriginX * OS;
+    const int PadY = OriginY * OS - BitmapTop;
+
+    Glyph.Width = (SrcW + PadX + OS - 1) / OS + Spread * 2;
+    Glyph.Height = (SrcH + PadY + OS - 1) / OS + Spread * 2;
+    Glyph.BearingX = OriginX - Spread;
+    Glyph.BearingY = OriginY + Spread;
+    Glyph.Field.assign(Glyph.Width * Glyph.Height, 0);
+
+    auto Inside = [&](int x, int y)
+    {
+        if(x < 0 || y < 0 || x >= SrcW || y >= SrcH)
+        {
+            return false;
+        }
+        return Bitmap.buffer[y * Bitmap.pitch + x] >= 128;
+    };
+
+    for(int y = 0; y < Glyph.Height; ++y)
+    {
+        for(int x = 0; x < Glyph.Width; ++x)
+        {
+            // Center of the output pixel in bitmap coordinates
+            const int CX = (x - Spread) * OS + OS / 2 - PadX;
+            const int CY = (y - Spread) * OS + OS / 2 - PadY;
+            const bool In = Inside(CX, CY);
+
+            int Best = SearchRadius * SearchRadius;
+            for(int dy = -SearchRadius; dy <= SearchRadius; ++dy)
+            {
+                for(int dx = -SearchRadius; dx <= SearchRadius; ++dx)
+                {
+                    const int Dist = dx * dx + dy * dy;
+                    if(Dist < Best && Inside(CX + dx, CY + dy) != In)
+                    {
+                        Best = Dist;
+                    }
+                }
+            }
+
+            float Distance = std::sqrt(static_cast<float>(Best)) / SearchRadius;
+            Distance = In ? Distance : -Distance;
+            const int Value = static_cast<int>(std::lround(128.0f + Distance * 127.0f));
+            Glyph.Field[y * Glyph.Width + x] = static_cast<uint8_t>(std::clamp(Value, 0, 255));
+        }
+    }
+}
+
+/**
+ * Pack the glyphs on shelves.
+ * @param[in,out] Glyphs The glyphs to place.
+ * @param[in] AtlasWidth Width of the atlas.
+ * @return The atlas height, rounded to a multiple of 4.
+ */
+static int PackGlyphs(std::vector<BakedGlyph> &Glyphs, int AtlasWidth)
+{
+    std::vector<BakedGlyph*> Order;
+    for(auto &Glyph : Glyphs)
+    {
+        Order.push_back(&Glyph);
+    }
+    std::stable_sort(Order.begin(), Order.end(),
+        [](const BakedGlyph *a, const BakedGlyph *b) { return a->Height > b->Height; });
+
+    int PenX = 0;
+    int PenY = 0;
+    int ShelfHeight = 0;
+    for(auto *Glyph : Order)
+    {
+        if(PenX + Glyph->Width > AtlasWidth)
+        {
+            PenX = 0;
+            PenY += ShelfHeight + 1;
+            ShelfHeight = 0;
+        }
+        Glyph->X = PenX;
+        Glyph->Y = PenY;
+        PenX += Glyph->Width + 1;
+        ShelfHeight = std::max(ShelfHeight, Glyph->Height);
+    }
+    return (PenY + ShelfHeight + 3) & ~3;
+}
+
+/**
+ * Convert a linear 8-bit field to a tiled GX IA8 texture.
+ * Intensity is always 255, the distance is stored in the alpha channel.
+ */
+static std::vector<uint8_t> ToTiledIA8(const std::vector<uint8_t> &Linear, int Width, int Height)
+{
+    std::vector<uint8_t> Tiled;
+    Tiled.reserve(Width * Height * 2);
+    for(int ty = 0; ty < Height; ty += 4)
+    {
+        for(int tx = 0; tx < Width; tx += 4)
+        {
+            for(int y = ty; y < ty + 4; ++y)
+            {
+                for(int x = tx; x < tx + 4; ++x)
+                {
+                    Tiled.push_back(Linear[y * Width + x]); // Alpha
+                    Tiled.push_back(0xFF);                  // Intensity
+                }
+            }
+        }
+    }
+    return Tiled;
+}
+
+/**
+ * Compress a field with PackBits.
+ * A header byte n from 0 to 127 is followed by n + 1 literal bytes, a header
+ * from 129 to 255 by one byte repeated 257 - n times. Fields are mostly made
+ * of runs of 0 outside the glyph.
+ * @param[in] Field The field to compress.
+ * @param[out] Output Receives the compressed bytes.
+ */
+static void PackBits(const std::vector<uint8_t> &Field, std::vector<uint8_t> &Output)
+{
+    size_t Pos = 0;
+    while(Pos < Field.size())
+    {
+        size_t Run = 1;
+        while(Pos + Run < Field.size() && Run < 128 && Field[Pos + Run] == Field[Pos])
+        {
+            ++Run;
+        }
+        if(Run >= 2)
+        {
+            Output.push_back(static_cast<uint8_t>(257 - Run));
+            Output.push_back(Field[Pos]);
+            Pos += Run;
+            continue;
+        }
+        // Literals up to the next run of at least 3 bytes
+        size_t Count = 1;
+        while(Pos + Count < Field.size() && Count < 128 &&
+              !(Pos + Count + 2 < Field.size() &&
+                Field[Pos + Count] == Field[Pos + Count + 1] && Field[Pos + Count] == Field[Pos + Count + 2]))
+        {
+            ++Count;
+        }
+        Output.push_back(static_cast<uint8_t>(Count - 1));
+        Output.insert(Output.end(), Field.begin() + Pos, Field.begin() + Pos + Count);
+        Pos += Count;
+    }
+}
+
+/**
+ * Write the generated header.
+ */
+static bool WriteHeader(const BakeOptions &Options)
+{
+    const std::string Path = Options.OutputDir + "/" + Options.Name + ".h";
+    FILE *File = std::fopen(Path.c_str(), "w");
+    if(File == nullptr)
+    {
+        return false;
+    }
+    std::fprintf(File,
+        "/**\n"
+        " * This file was autogenerated by fontbake. Do not edit.\n"
+        " */\n\n"
+        "#ifndef _%s_h_\n"
+        "#define _%s_h_\n\n"
+        "#include \"fontdata.h\"\n\n"
+        "extern const FontData %s;\n\n"
+        "#endif //_%s_h_\n",
+        Options.Name.c_str(), Options.Name.c_str(), Options.Name.c_str(), Options.Name.c_str());
+    return std::fclose(File) == 0;
+}
+
+/**
+ * Write the generated source file.
+ */
+static bool WriteSource(const BakeOptions &Options, const std::vector<BakedGlyph> &Glyphs,
+    const std::vector<BakedGlyph> &Stored,
+    const std::vector<std::pair<std::pair<char32_t, char32_t>, int>> &Kerning,
+    const std::vector<uint8_t> &Atlas, int AtlasHeight, int Ascender, int LineHeight)
+{
+    const std::string Path = Options.OutputDir + "/" + Options.Name + ".cpp";
+    FILE *File = std::fopen(Path.c_str(), "w");
+    if(File == nullptr)
+    {
+        return false;
+    }
+
+    std::fprintf(File,
+        "/**\n"
+        " * This file was autogenerated by fontbake. Do not edit.\n"
+        " */\n\n"
+        "#include \"%s.h\"\n\n"
+        "alignas(32) static const u8 Atlas[] = {",
+        Options.Name.c_str());
+    for(size_t i = 0; i < Atlas.size(); ++i)
+    {
+        std::fprintf(File, "%s0x%02X,", (i % 16 == 0) ? "\n\t" : " ", Atlas[i]);
+    }
+
+    std::fputs("\n};\n\nstatic const FontGlyph Glyphs[] = {\n", File);
+    for(const auto &Glyph : Glyphs)
+    {
+        std::fprintf(File, "\t{0x%04X, %d, %d, %d, %d, %d, %d, %d},\n",
+            static_cast<unsigned>(Glyph.Code), Glyph.X, Glyph.Y, Glyph.Width, Glyph.Height,
+            Glyph.BearingX, Glyph.BearingY, Glyph.Advance);
+    }
+
+    std::fputs("};\n\nstatic const FontKerning Kerning[] = {\n", File);
+    for(const auto &[Pair, Amount] : Kerning)
+    {
+        std::fprintf(File, "\t{0x%04X, 0x%04X, %d},\n",
+            static_cast<unsigned>(Pair.first), static_cast<unsigned>(Pair.second), Amount);
+    }
+    if(Kerning.empty())
+    {
+        std::fputs("\t{0, 0, 0},\n", File);
+    }
+    std::fputs("};\n", File);
+
+    if(!Stored.empty())
+    {
+        std::vector<uint8_t> Store;
+        std::vector<size_t> Offsets;
+        for(const auto &Glyph : Stored)
+        {
+            Offsets.push_back(Store.size());
+            PackBits(Glyph.Field, Store);
+        }
+        Offsets.push_back(Store.size());
+
+        std::fputs("\nstatic const FontGlyph StoredGlyphs[] = {\n", File);
+        for(const auto &Glyph : Stored)
+        {
+            std::fprintf(File, "\t{0x%04X, 0, 0, %d, %d, %d, %d, %d},\n",
+                static_cast<unsigned>(Glyph.Code), Glyph.Width, Glyph.Height,
+                Glyph.BearingX, Glyph.BearingY, Glyph.Advance);
+        }
+        std::fputs("};\n\nstatic const u32 StoredOffsets[] = {", File);
+        for(size_t i = 0; i < Offsets.size(); ++i)
+        {
+            std::fprintf(File, "%s%zu,", (i % 16 == 0) ? "\n\t" : " ", Offsets[i]);
+        }
+        std::fputs("\n};\n\nstatic const u8 Store[] = {", File);
+        for(size_t i = 0; i < Store.size(); ++i)
+        {
+            std::fprintf(File, "%s0x%02X,", (i % 16 == 0) ? "\n\t" : " ", Store[i]);
+        }
+        std::fputs("\n};\n", File);
+    }
+
+    std::fprintf(File,
+        "\n"
+        "const FontData %s = {\n"
+        "\t%u, %u, %d, %d,\n"
+        "\t%u, %d, Atlas, sizeof(Atlas),\n"
+        "\tGlyphs, %zu,\n"
+        "\tKerning, %zu,\n",
+        Options.Name.c_str(),
+        Options.BaseSize, Options.Spread, Ascender, LineHeight,
+        Options.AtlasWidth, AtlasHeight,
+        Glyphs.size(), Kerning.size());
+    if(Stored.empty())
+    {
+        std::fputs("\tnullptr, 0, nullptr, nullptr\n};\n", File);
+    }
+    else
+    {
+        std::fprintf(File, "\tStoredGlyphs, %zu, StoredOffsets, Store\n};\n", Stored.size());
+    }
+    return std::fclose(File) == 0;
+}
+
+/**
+ * Entry point.
+ * @param[in] argc The number of arguments invoked with the program.
+ * @param[in] argv The array containing the arguments.
+ * @return 0 on success, 1 otherwise.
+ */
+int main(int argc, char **argv)
+{
+    BakeOptions Options;
+    if(!ParseOptions(argc, argv, Options))
+    {
+        Usage();
+        return 1;
+    }
+
+    FT_Library Library;
+    FT_Face Face;
+    if(FT_Init_FreeType(&Library) != 0)
+    {
+        std::fputs("fontbake: cannot initialize FreeType\n", stderr);
+        return 1;
+    }
+    const FT_Error Error = Options.FontFile.empty() ?
+        FT_New_Memory_Face(Library, Swis721_Ex_BT, Swis721_Ex_BT_size, 0, &Face) :
+        FT_New_Face(Library, Options.FontFile.c_str(), 0, &Face);
+    if(Error != 0)
+    {
+        std::fputs("fontbake: cannot load the font\n", stderr);
+        return 1;
+    }
+    FT_Set_Pixel_Sizes(Face, 0, Options.BaseSize * Options.Oversample);
+
+    FT_Face Fallback = nullptr;
+    if(!Options.FallbackFile.empty())
+    {
+        if(FT_New_Face(Library, Options.FallbackFile.c_str(), 0, &Fallback) != 0)
+        {
+            std::fprintf(stderr, "fontbake: cannot load %s\n", Options.FallbackFile.c_str());
+            return 1;
+        }
+        FT_Set_Pixel_Sizes(Fallback, 0, Options.BaseSize * Options.Oversample);
+    }
+
+    std::vector<BakedGlyph> Glyphs;
+    std::vector<BakedGlyph> Stored;
+    size_t Missing = 0;
+    for(const char32_t Code : Options.Charset)
+    {
+        FT_Face Source = Face;
+        FT_UInt Index = FT_Get_Char_Index(Face, Code);
+        if(Index == 0 && Fallback != nullptr)
+        {
+            Source = Fallback;
+            Index = FT_Get_Char_Index(Fallback, Code);
+        }
+        if(Index == 0 && Code != ' ')
+        {   // Not in these fonts
+            ++Missing;
+            continue;
+        }
+        if(FT_Load_Glyph(Source, Index, FT_LOAD_RENDER) != 0)
+        {
+            continue;
+        }
+
+        BakedGlyph Glyph;
+        Glyph.Code = Code;
+        Glyph.Index = (Source == Face) ? Index : 0; // No kerning with the fallback font
+        Glyph.Advance = static_cast<int>(std::lround(
+            static_cast<float>(Source->glyph->advance.x) / Options.Oversample));
+        if(Source->glyph->bitmap.width > 0 && Source->glyph->bitmap.rows > 0)
+        {
+            BuildDistanceField(Source->glyph->bitmap, Source->glyph->bitmap_left,
+                Source->glyph->bitmap_top, Options, Glyph);
+        }
+        if(Code >= Options.StoreAbove)
+        {
+            Stored.push_back(std::move(Glyph));
+        }
+        else
+        {
+            Glyphs.push_back(std::move(Glyph));
+        }
+    }
+
+    // Kerning between every pair of baked glyphs, stored in 26.6 at the base size
+    std::vector<std::pair<std::pair<char32_t, char32_t>, int>> Kerning;
+    if(FT_HAS_KERNING(Face))
+    {
+        for(const auto &Left : Glyphs)
+        {
+            for(const auto &Right : Glyphs)
+            {
+                if(Left.Index == 0 || Right.Index == 0)
+                {
+                    continue;
+                }
+                FT_Vector Delta;
+                FT_Get_Kerning(Face, Left.Index, Right.Index, FT_KERNING_DEFAULT, &Delta);
+                const int Amount = static_cast<int>(std::lround(
+                    static_cast<float>(Delta.x) / Options.Oversample));
+                if(Amount != 0)
+                {
+                    Kerning.push_back({{Left.Code, Right.Code}, Amount});
+                }
+            }
+        }
+    }
+
+    const int AtlasHeight = PackGlyphs(Glyphs, Options.AtlasWidth);
+    std::vector<uint8_t> Linear(Options.AtlasWidth * AtlasHeight, 0);
+    for(const auto &Glyph : Glyphs)
+    {
+        for(int y = 0; y < Glyph.Height; ++y)
+        {
+            std::copy_n(&Glyph.Field[y * Glyph.Width], Glyph.Width,
+                &Linear[(Glyph.Y + y) * Options.AtlasWidth + Glyph.X]);
+        }
+    }
+
+    const int Ascender = static_cast<int>(Face->size->metrics.ascender / 64 / Options.Oversample);
+    const int LineHeight = static_cast<int>(Face->size->metrics.height / 64 / Options.Oversample);
+
+    if(Fallback != nullptr)
+    {
+        FT_Done_Face(Fallback);
+    }
+    FT_Done_Face(Face);
+    FT_Done_FreeType(Library);
+
+    if(!WriteHeader(Options) ||
+       !WriteSource(Options, Glyphs, Stored, Kerning, ToTiledIA8(Linear, Options.AtlasWidth, AtlasHeight),
+            AtlasHeight, Ascender, LineHeight))
+    {
+        std::fprintf(stderr, "fontbake: cannot write to %s\n", Options.OutputDir.c_str());
+        return 1;
+    }
+
+    std::printf("fontbake: %zu glyphs, %zu stored glyphs, %zu kerning pairs, %ux%d atlas\n",
+        Glyphs.size(), Stored.size(), Kerning.size(), Options.AtlasWidth, AtlasHeight);
+    if(Missing > 0)
+    {
+        std::printf("fontbake: %zu code points are not in the font%s\n",
+            Missing, Options.FallbackFile.empty() ? ", a fallback font may be given with --fallback" : "");
+    }
+    return 0;
+}
+
+// EOF
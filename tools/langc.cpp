@@ -0,0 +1,495 @@
+// tools/langc.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+/**
+ * @file
+ * Host tool that compiles the language files into C++ tables.
+ *
+ * Each XML file of the languages folder is parsed and checked: every file
+ * must have the same translation keys, no duplicate, at least one message
+ * of each kind, and the arguments ({0}, {1}) of each text must be valid.
+ * The output is a C++ source file with a LanguageData per file, and a
+ * header with the list of keys and a consteval function giving the ID of
+ * a key, so the game needs no XML parser and an unknown key does not
+ * compile.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "xmlreader.h"
+
+/**
+ * A language once read from its file.
+ */
+struct LanguageFile
+{
+    std::string Path;                                      /**< File it was read from. */
+    std::string Type;                                      /**< Type attribute of the root element. */
+    std::vector<std::pair<std::string, std::string>> Texts; /**< Translations in file order. */
+    std::map<std::string, std::vector<std::string>> Messages; /**< Messages of each group. */
+};
+
+/**
+ * Elements holding a list of messages, in the order of LanguageData.
+ */
+static constexpr const char *MessageGroups[] = {"winning_game", "tie_game", "turn_over"};
+
+/**
+ * Print the command line usage.
+ */
+static void Usage()
+{
+    std::fputs("Usage: langc <output_dir> <name> <language.xml>...\n", stderr);
+}
+
+/**
+ * Report an error in a language file.
+ * @return Always false.
+ */
+static bool Error(const LanguageFile &Language, size_t Line, const std::string &Message)
+{
+    std::fprintf(stderr, "%s:%zu: error: %s\n", Language.Path.c_str(), Line, Message.c_str());
+    return false;
+}
+
+/**
+ * Read a language file.
+ * Only what the game uses is kept: the type of the root element, the
+ * translation elements and the message elements of each group.
+ * @param[in] Path File to read.
+ * @param[out] Language The content of the file.
+ * @return true on success, false if the file cannot be read or is malformed.
+ */
+static bool ReadLanguage(const std::string &Path, LanguageFile &Language)
+{
+    Language.Path = Path;
+    std::ifstream File(Path, std::ios::binary);
+    if(!File)
+    {
+        std::fprintf(stderr, "%s: error: cannot open the file\n", Path.c_str());
+        return false;
+    }
+    std::stringstream Buffer;
+    Buffer << File.rdbuf();
+    const std::string Document = Buffer.str();
+
+    XmlReader Reader(Document);
+    std::set<std::string> Keys;
+    while(Reader.Next())
+    {
+        const std::string_view Name = Reader.GetName();
+        const std::string_view Parent = Reader.GetParent();
+        if(Parent.empty())
+        {
+            const std::string *Type = Reader.GetAttribute("type");
+            if(Name != "language" || Type == nullptr || Type->empty())
+            {
+                return Error(Language, Reader.GetLine(), "the root must be <language> with a type");
+            }
+            Language.Type = *Type;
+        }
+        else if(Name == "translation" && Parent == "language")
+        {
+            const std::string *From = Reader.GetAttribute("from");
+            const std::string *To = Reader.GetAttribute("to");
+            if(From == nullptr || To == nullptr)
+            {
+                return Error(Language, Reader.GetLine(), "<translation> needs a from and a to attribute");
+            }
+            if(!Keys.insert(*From).second)
+            {
+                return Error(Language, Reader.GetLine(), "duplicate translation of \"" + *From + "\"");
+            }
+            Language.Texts.emplace_back(*From, *To);
+        }
+        else if(Name == "message" &&
+            std::find(std::begin(MessageGroups), std::end(MessageGroups), Parent) != std::end(MessageGroups))
+        {
+            const std::string *Text = Reader.GetAttribute("text");
+            if(Text == nullptr)
+            {
+                return Error(Language, Reader.GetLine(), "<message> needs a text attribute");
+            }
+            Language.Messages[std::string(Parent)].push_back(*Text);
+        }
+    }
+    if(Reader.HasError())
+    {
+        return Error(Language, Reader.GetLine(), Reader.GetError());
+    }
+    if(Language.Type.empty())
+    {
+        return Error(Language, 1, "no <language> element");
+    }
+    for(const char *Group : MessageGroups)
+    {
+        if(Language.Messages[Group].empty())
+        {
+            return Error(Language, 1, std::string("no message in <") + Group + ">");
+        }
+    }
+    return true;
+}
+
+/**
+ * Get the name of the file of a language, without folder and extension.
+ * The game looks for a file with this name to reload the language.
+ */
+static std::string GetStem(const LanguageFile &Language)
+{
+    const size_t Slash = Language.Path.find_last_of("/\\");
+    const std::string Stem = Language.Path.substr(Slash == std::string::npos ? 0 : Slash + 1);
+    return Stem.substr(0, Stem.find('.'));
+}
+
+/**
+ * Get the C++ name of a language, the name of its file with a capital letter.
+ * The type attribute is not used, a placeholder file may copy the one of
+ * another language.
+ */
+static std::string GetSymbol(const LanguageFile &Language)
+{
+    std::string Symbol;
+    for(const char c : GetStem(Language))
+    {
+        if(std::isalnum(static_cast<unsigned char>(c)))
+        {
+            Symbol += Symbol.empty() ? static_cast<char>(std::toupper(static_cast<unsigned char>(c))) : c;
+        }
+    }
+    return Symbol;
+}
+
+/**
+ * Check that every language has the keys of the first one.
+ * @param[in] Languages Every language.
+ * @return true if the key sets match, false otherwise.
+ */
+static bool CheckKeys(const std::vector<LanguageFile> &Languages)
+{
+    bool Valid = true;
+    std::set<std::string> Symbols;
+    const LanguageFile &Reference = Languages.front();
+    for(const LanguageFile &Language : Languages)
+    {
+        if(!Symbols.insert(GetSymbol(Language)).second)
+        {
+            std::fprintf(stderr, "%s: error: another file has the same name\n", Language.Path.c_str());
+            Valid = false;
+        }
+        auto HasKey = [](const LanguageFile &File, const std::string &Key)
+        {
+            return std::any_of(File.Texts.begin(), File.Texts.end(),
+                [&Key](const auto &Text) { return Text.first == Key; });
+        };
+        for(const auto &Text : Reference.Texts)
+        {
+            if(!HasKey(Language, Text.first))
+            {
+                std::fprintf(stderr, "%s: error: missing translation of \"%s\" (found in %s)\n",
+                    Language.Path.c_str(), Text.first.c_str(), Reference.Path.c_str());
+                Valid = false;
+            }
+        }
+        for(const auto &Text : Language.Texts)
+        {
+            if(!HasKey(Reference, Text.first))
+            {
+                std::fprintf(stderr, "%s: error: translation of \"%s\" is not in %s\n",
+                    Language.Path.c_str(), Text.first.c_str(), Reference.Path.c_str());
+                Valid = false;
+            }
+        }
+    }
+    return Valid;
+}
+
+/**
+ * Get the number of arguments of a text, with the syntax of MessageTemplate:
+ * {} or {0} to {9}, {{ and }} for braces.
+ * @param[in] Text The text.
+ * @return The highest argument plus one, -1 if the text is malformed.
+ */
+static int CountArguments(std::string_view Text)
+{
+    int Count = 0;
+    int Automatic = 0;
+    bool Manual = false;
+    for(size_t i = 0; i < Text.size(); ++i)
+    {
+        if(Text[i] != '{' && Text[i] != '}')
+        {
+            continue;
+        }
+        if(i + 1 < Text.size() && Text[i + 1] == Text[i])
+        {
+            ++i;
+            continue;
+        }
+        const size_t End = Text.find('}', i);
+        if(Text[i] == '}' || End == std::string_view::npos)
+        {
+            return -1;
+        }
+        const std::string_view Index = Text.substr(i + 1, End - i - 1);
+        if(Index.empty() && !Manual)
+        {
+            Count = std::max(Count, ++Automatic);
+        }
+        else if(Index.size() == 1 && std::isdigit(static_cast<unsigned char>(Index[0])) && Automatic == 0)
+        {
+            Manual = true;
+            Count = std::max(Count, Index[0] - '0' + 1);
+        }
+        else
+        {
+            return -1;
+        }
+        i = End;
+    }
+    return Count;
+}
+
+/**
+ * Check the arguments of every text.
+ * A translation cannot use more arguments than its original text, and
+ * messages get two arguments when a game is won and one when a turn is over.
+ * @param[in] Languages Every language.
+ * @return true if the arguments are valid, false otherwise.
+ */
+static bool CheckArguments(const std::vector<LanguageFile> &Languages)
+{
+    bool Valid = true;
+    auto Check = [&Valid](const LanguageFile &Language, const std::string &Text, int Allowed)
+    {
+        const int Count = CountArguments(Text);
+        if(Count < 0 || Count > Allowed)
+        {
+            std::fprintf(stderr, "%s: error: \"%s\" is not a valid text with %d argument%s\n",
+                Language.Path.c_str(), Text.c_str(), Allowed, (Allowed == 1) ? "" : "s");
+            Valid = false;
+        }
+    };
+    for(const LanguageFile &Language : Languages)
+    {
+        for(const auto &[From, To] : Language.Texts)
+        {
+            Check(Language, To, std::max(CountArguments(From), 0));
+        }
+        for(const std::string &Message : Language.Messages.at("winning_game"))
+        {
+            Check(Language, Message, 2);
+        }
+        for(const std::string &Message : Language.Messages.at("turn_over"))
+        {
+            Check(Language, Message, 1);
+        }
+    }
+    return Valid;
+}
+
+/**
+ * Write a text as a C++ string literal.
+ * Bytes outside printable ASCII are written as octal escapes, which never
+ * run into the next character.
+ */
+static void WriteLiteral(FILE *File, std::string_view Text)
+{
+    std::fputc('"', File);
+    for(const char c : Text)
+    {
+        const unsigned char Byte = static_cast<unsigned char>(c);
+        if(c == '"' || c == '\\')
+        {
+            std::fprintf(File, "\\%c", c);
+        }
+        else if(Byte < 0x20 || Byte >= 0x7F)
+        {
+            std::fprintf(File, "\\%03o", Byte);
+        }
+        else
+        {
+            std::fputc(c, File);
+        }
+    }
+    std::fputc('"', File);
+}
+
+/**
+ * Write the generated header.
+ */
+static bool WriteHeader(const std::string &OutputDir, const std::string &Name,
+    const std::vector<LanguageFile> &Languages)
+{
+    const std::string Path = OutputDir + "/" + Name + ".h";
+    FILE *File = std::fopen(Path.c_str(), "w");
+    if(File == nullptr)
+    {
+        return false;
+    }
+    const std::vector<std::pair<std::string, std::string>> &Keys = Languages.front().Texts;
+    std::string Namespace = Name;
+    Namespace[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(Namespace[0])));
+    std::fprintf(File,
+        "/**\n"
+        " * This file was autogenerated by langc. Do not edit.\n"
+        " */\n\n"
+        "#ifndef _%s_h_\n"
+        "#define _%s_h_\n\n"
+        "#include <array>\n"
+        "#include \"languagedata.h\"\n\n"
+        "namespace %s\n"
+        "{\n"
+        "    inline constexpr u16 TEXT_COUNT = %zu;\n\n"
+        "    inline constexpr std::array<std::string_view, TEXT_COUNT> Keys = {\n",
+        Name.c_str(), Name.c_str(), Namespace.c_str(), Keys.size());
+    for(const auto &Key : Keys)
+    {
+        std::fputs("        ", File);
+        WriteLiteral(File, Key.first);
+        std::fputs(",\n", File);
+    }
+    std::fputs(
+        "    };\n\n"
+        "    /**\n"
+        "     * Get the ID of a text. A key that is not in the language files does not compile.\n"
+        "     */\n"
+        "    consteval u16 TextId(std::string_view Key)\n"
+        "    {\n"
+        "        for(u16 i = 0; i < TEXT_COUNT; ++i)\n"
+        "        {\n"
+        "            if(Keys[i] == Key)\n"
+        "            {\n"
+        "                return i;\n"
+        "            }\n"
+        "        }\n"
+        "        throw \"Unknown text, it must be translated in every language file\";\n"
+        "    }\n\n",
+        File);
+    for(const LanguageFile &Language : Languages)
+    {
+        std::fprintf(File, "    extern const LanguageData %s;\n", GetSymbol(Language).c_str());
+    }
+    std::fprintf(File, "\n    inline constexpr std::array<const LanguageData*, %zu> All = {\n", Languages.size());
+    for(const LanguageFile &Language : Languages)
+    {
+        std::fprintf(File, "        &%s,\n", GetSymbol(Language).c_str());
+    }
+    std::fputs("    };\n", File);
+    std::fprintf(File, "}\n\n#endif //_%s_h_\n", Name.c_str());
+    return std::fclose(File) == 0;
+}
+
+/**
+ * Write the generated source file.
+ */
+static bool WriteSource(const std::string &OutputDir, const std::string &Name,
+    const std::vector<LanguageFile> &Languages)
+{
+    const std::string Path = OutputDir + "/" + Name + ".cpp";
+    FILE *File = std::fopen(Path.c_str(), "w");
+    if(File == nullptr)
+    {
+        return false;
+    }
+    std::fprintf(File,
+        "/**\n"
+        " * This file was autogenerated by langc. Do not edit.\n"
+        " */\n\n"
+        "#include \"%s.h\"\n",
+        Name.c_str());
+
+    const std::vector<std::pair<std::string, std::string>> &Keys = Languages.front().Texts;
+    for(const LanguageFile &Language : Languages)
+    {
+        const std::string Symbol = GetSymbol(Language);
+        std::fprintf(File, "\n// %s\nstatic constexpr std::string_view %s_Texts[] = {\n",
+            Language.Type.c_str(), Symbol.c_str());
+        for(const auto &Key : Keys)
+        {   // In the order of the keys, not of the file
+            const auto Text = std::find_if(Language.Texts.begin(), Language.Texts.end(),
+                [&Key](const auto &Item) { return Item.first == Key.first; });
+            std::fputs("\t", File);
+            WriteLiteral(File, Text->second);
+            std::fputs(",\n", File);
+        }
+        std::fputs("};\n", File);
+        for(const char *Group : MessageGroups)
+        {
+            std::fprintf(File, "static constexpr std::string_view %s_%s[] = {\n", Symbol.c_str(), Group);
+            for(const std::string &Message : Language.Messages.at(Group))
+            {
+                std::fputs("\t", File);
+                WriteLiteral(File, Message);
+                std::fputs(",\n", File);
+            }
+            std::fputs("};\n", File);
+        }
+        std::fprintf(File,
+            "const LanguageData %c%s::%s = {\n"
+            "\t\"%s\", %s_Texts,\n"
+            "\t%s_winning_game, %zu,\n"
+            "\t%s_tie_game, %zu,\n"
+            "\t%s_turn_over, %zu\n"
+            "};\n",
+            std::toupper(static_cast<unsigned char>(Name[0])), Name.c_str() + 1, Symbol.c_str(),
+            GetStem(Language).c_str(), Symbol.c_str(),
+            Symbol.c_str(), Language.Messages.at("winning_game").size(),
+            Symbol.c_str(), Language.Messages.at("tie_game").size(),
+            Symbol.c_str(), Language.Messages.at("turn_over").size());
+    }
+    return std::fclose(File) == 0;
+}
+
+/**
+ * Entry point.
+ * @param[in] argc The number of arguments invoked with the program.
+ * @param[in] argv The array containing the arguments.
+ * @return 0 on success, 1 if a file is invalid or cannot be written.
+ */
+int main(int argc, char **argv)
+{
+    if(argc < 4)
+    {
+        Usage();
+        return 1;
+    }
+    const std::string OutputDir = argv[1];
+    const std::string Name = argv[2];
+
+    std::vector<LanguageFile> Languages(argc - 3);
+    bool Valid = true;
+    for(int i = 3; i < argc; ++i)
+    {
+        Valid = ReadLanguage(argv[i], Languages[i - 3]) && Valid;
+    }
+    if(!Valid || !CheckKeys(Languages) || !CheckArguments(Languages))
+    {
+        return 1;
+    }
+
+    if(!WriteHeader(OutputDir, Name, Languages) || !WriteSource(OutputDir, Name, Languages))
+    {
+        std::fputs("langc: cannot write the output files\n", stderr);
+        return 1;
+    }
+    return 0;
+}
+
+// EOF
@@ -0,0 +1,575 @@
+// tools/sfxconv.cpp
+// SPDX-License-Identifier: MIT
+//
+// Wii-Tac-Toe
+//
+// Copyright (C) 2025 Crayon
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the MIT License. A copy of the license is
+// located in the LICENSE file included with this distribution.
+
+/**
+ * @file
+ * Host tool that converts a sound effect for the game.
+ *
+ * The input is raw signed 16-bit mono PCM. It is resampled to the rate of
+ * the DSP mixer with a windowed sinc filter, so no rate conversion is done
+ * while playing, and optionally encoded to GameCube DSP-ADPCM, about a
+ * quarter of the size. The output is a C++ source file and header defining
+ * a Sound, ready to be played by the Audio class of the game, or a standard
+ * .dsp file for the music streamed from the SD card.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "adpcm.h"
+
+/**
+ * Options given on the command line.
+ */
+struct ConvertOptions
+{
+    std::string InputFile;
+    std::string OutputDir;
+    std::string Name;
+    double InputRate{44100.0};   /**< Rate of the input file. */
+    double OutputRate{48000.0};  /**< Rate of the DSP mixer. */
+    bool LittleEndian{false};    /**< Byte order of the input file. */
+    bool Compress{false};        /**< Encode to DSP-ADPCM. */
+    bool DspFile{false};         /**< Write a .dsp file instead of C++. */
+};
+
+/**
+ * Half the number of taps of the resampling filter.
+ */
+static constexpr int FILTER_HALF_TAPS = 16;
+
+/**
+ * Number of times the predictors are fitted to the sound.
+ */
+static constexpr int TRAINING_PASSES = 8;
+
+/**
+ * Print the command line usage.
+ */
+static void Usage()
+{
+    std::fputs(
+        "Usage: sfxconv [options] <input.raw> <output_dir> <name>\n"
+        "  --input-rate <hz>   Rate of the input (default: 44100)\n"
+        "  --output-rate <hz>  Rate of the output (default: 48000)\n"
+        "  --little-endian     The input is little-endian (default: big-endian)\n"
+        "  --adpcm             Encode to GameCube DSP-ADPCM\n"
+        "  --dsp               Write <name>.dsp, a music track for the SD card\n",
+        stderr);
+}
+
+/**
+ * Read the command line.
+ * @return true if the options are valid, false otherwise.
+ */
+static bool ParseOptions(int argc, char **argv, ConvertOptions &Options)
+{
+    std::vector<std::string> Positional;
+    for(int i = 1; i < argc; ++i)
+    {
+        const std::string_view Arg = argv[i];
+        const bool HasValue = (i + 1 < argc);
+        if(Arg == "--input-rate" && HasValue)
+        {
+            Options.InputRate = std::strtod(argv[++i], nullptr);
+        }
+        else if(Arg == "--output-rate" && HasValue)
+        {
+            Options.OutputRate = std::strtod(argv[++i], nullptr);
+        }
+        else if(Arg == "--little-endian")
+        {
+            Options.LittleEndian = true;
+        }
+        else if(Arg == "--adpcm")
+        {
+            Options.Compress = true;
+        }
+        else if(Arg == "--dsp")
+        {
+            Options.Compress = true;
+            Options.DspFile = true;
+        }
+        else if(Arg.starts_with("--"))
+        {
+            return false;
+        }
+        else
+        {
+            Positional.emplace_back(Arg);
+        }
+    }
+    if(Positional.size() != 3 || Options.InputRate <= 0.0 || Options.OutputRate <= 0.0)
+    {
+        return false;
+    }
+    Options.InputFile = Positional[0];
+    Options.OutputDir = Positional[1];
+    Options.Name = Positional[2];
+    return true;
+}
+
+/**
+ * Read the samples of a raw file.
+ * @return The samples, empty if the file cannot be read.
+ */
+static std::vector<double> ReadSamples(const ConvertOptions &Options)
+{
+    std::ifstream File(Options.InputFile, std::ios::binary);
+    const std::vector<unsigned char> Bytes((std::istreambuf_iterator<char>(File)), std::istreambuf_iterator<char>());
+    std::vector<double> Samples(Bytes.size() / 2);
+    for(size_t i = 0; i < Samples.size(); ++i)
+    {
+        const unsigned char High = Options.LittleEndian ? Bytes[i * 2 + 1] : Bytes[i * 2];
+        const unsigned char Low = Options.LittleEndian ? Bytes[i * 2] : Bytes[i * 2 + 1];
+        Samples[i] = static_cast<int16_t>((High << 8) | Low);
+    }
+    return Samples;
+}
+
+/**
+ * Resample with a Blackman windowed sinc.
+ * When the rate goes down, the cutoff follows the output rate so nothing
+ * folds back below its Nyquist frequency.
+ * @param[in] Input The samples.
+ * @param[in] Ratio Output rate divided by input rate.
+ * @return The resampled samples.
+ */
+static std::vector<double> Resample(const std::vector<double> &Input, double Ratio)
+{
+    if(Ratio == 1.0)
+    {
+        return Input;
+    }
+    const double Cutoff = std::min(1.0, Ratio);
+    const size_t OutputCount = static_cast<size_t>(std::floor(Input.size() * Ratio));
+    std::vector<double> Output(OutputCount);
+    for(size_t n = 0; n < OutputCount; ++n)
+    {
+        const double Position = n / Ratio;
+        const long Center = static_cast<long>(std::floor(Position));
+        double Sum = 0.0;
+        for(long k = Center - FILTER_HALF_TAPS + 1; k <= Center + FILTER_HALF_TAPS; ++k)
+        {
+            if(k < 0 || k >= static_cast<long>(Input.size()))
+            {
+                continue;
+            }
+            const double x = (Position - k) * Cutoff;
+            const double Sinc = (x == 0.0) ? 1.0 : std::sin(M_PI * x) / (M_PI * x);
+            const double w = (Position - k) / FILTER_HALF_TAPS; // -1 to 1
+            const double Window = (std::abs(w) >= 1.0) ? 0.0 :
+                0.42 + 0.5 * std::cos(M_PI * w) + 0.08 * std::cos(2.0 * M_PI * w);
+            Sum += Input[k] * Sinc * Window * Cutoff;
+        }
+        Output[n] = Sum;
+    }
+    return Output;
+}
+
+/**
+ * Round the samples to 16 bits.
+ */
+static std::vector<int16_t> Quantize(const std::vector<double> &Samples)
+{
+    std::vector<int16_t> Result(Samples.size());
+    for(size_t i = 0; i < Samples.size(); ++i)
+    {
+        Result[i] = static_cast<int16_t>(std::clamp(std::lround(Samples[i]), -32768L, 32767L));
+    }
+    return Result;
+}
+
+/**
+ * Sums of products of a sound and its two previous samples, enough to find
+ * the predictor of least squared error.
+ */
+struct Correlation
+{
+    double R11{0.0}, R12{0.0}, R22{0.0}, P1{0.0}, P2{0.0};
+
+    /**
+     * Add the samples of a frame.
+     */
+    void Add(const std::vector<int16_t> &Samples, size_t Start, size_t End)
+    {
+        for(size_t n = std::max<size_t>(Start, 2); n < End; ++n)
+        {
+            const double x0 = Samples[n], x1 = Samples[n - 1], x2 = Samples[n - 2];
+            R11 += x1 * x1;
+            R12 += x1 * x2;
+            R22 += x2 * x2;
+            P1 += x0 * x1;
+            P2 += x0 * x2;
+        }
+    }
+
+    /**
+     * Get the predictor of least squared error, in 11-bit fixed point.
+     * @return false if there is no single solution.
+     */
+    bool Solve(int16_t &First, int16_t &Second) const
+    {
+        const double Determinant = R11 * R22 - R12 * R12;
+        if(std::abs(Determinant) < 1e-3)
+        {
+            return false;
+        }
+        const double a = (P1 * R22 - P2 * R12) / Determinant;
+        const double b = (P2 * R11 - P1 * R12) / Determinant;
+        // The DSP keeps the filter stable only with coefficients below 2 and 1
+        First = static_cast<int16_t>(std::clamp(std::lround(a * 2048.0), -4095L, 4095L));
+        Second = static_cast<int16_t>(std::clamp(std::lround(b * 2048.0), -2047L, 2047L));
+        return true;
+    }
+};
+
+/**
+ * Get the squared error of a predictor on a frame of the original sound.
+ */
+static double GetPredictionError(const std::vector<int16_t> &Samples, size_t Start, size_t End,
+    const int16_t *Predictor)
+{
+    double Error = 0.0;
+    for(size_t n = std::max<size_t>(Start, 2); n < End; ++n)
+    {
+        const double e = Samples[n] - (Predictor[0] * Samples[n - 1] + Predictor[1] * Samples[n - 2]) / 2048.0;
+        Error += e * e;
+    }
+    return Error;
+}
+
+/**
+ * Build the predictors of a sound.
+ * Each frame is given the predictor that fits it best, then each predictor
+ * is fitted again to its frames, a few times (k-means). The table starts
+ * from common fixed predictors, which are kept when no frame uses them.
+ * @param[in] Samples The sound.
+ * @return The 16 coefficients, in 11-bit fixed point.
+ */
+static std::vector<int16_t> BuildCoefficients(const std::vector<int16_t> &Samples)
+{
+    std::vector<int16_t> Coefficients = {
+        0, 0,
+        2048, 0,
+        4096, -2048,
+        1536, 512,
+        1920, 0,
+        3680, -1664,
+        3136, -1856,
+        0, 0
+    };
+    Correlation Whole;
+    Whole.Add(Samples, 0, Samples.size());
+    Whole.Solve(Coefficients[14], Coefficients[15]);
+
+    constexpr int PREDICTOR_COUNT = Adpcm::COEFFICIENT_COUNT / 2;
+    for(int Pass = 0; Pass < TRAINING_PASSES; ++Pass)
+    {
+        Correlation Clusters[PREDICTOR_COUNT];
+        for(size_t Start = 0; Start < Samples.size(); Start += Adpcm::SAMPLES_PER_FRAME)
+        {
+            const size_t End = std::min(Start + Adpcm::SAMPLES_PER_FRAME, Samples.size());
+            int Best = 0;
+            double BestError = std::numeric_limits<double>::max();
+            for(int p = 0; p < PREDICTOR_COUNT; ++p)
+            {
+                const double Error = GetPredictionError(Samples, Start, End, &Coefficients[p * 2]);
+                if(Error < BestError)
+                {
+                    BestError = Error;
+                    Best = p;
+                }
+            }
+            Clusters[Best].Add(Samples, Start, End);
+        }
+        for(int p = 1; p < PREDICTOR_COUNT; ++p)
+        {   // The first one stays silence
+            Clusters[p].Solve(Coefficients[p * 2], Coefficients[p * 2 + 1]);
+        }
+    }
+    return Coefficients;
+}
+
+/**
+ * Encode a frame with a predictor and a scale, and measure the error.
+ * @param[in] Samples The samples of the frame, zero padded.
+ * @param[in] Header Predictor and scale exponent.
+ * @param[in] Coefficients The 16 coefficients.
+ * @param[in,out] State The previous decoded samples, updated.
+ * @param[out] Nibbles The codes of the samples.
+ * @return The sum of squared errors.
+ */
+static double EncodeFrame(const int16_t *Samples, uint8_t Header, const int16_t *Coefficients,
+    Adpcm::History &State, int *Nibbles)
+{
+    const int Scale = 1 << (Header & 0x0F);
+    const int Predictor = Header >> 4;
+    double Error = 0.0;
+    for(uint32_t i = 0; i < Adpcm::SAMPLES_PER_FRAME; ++i)
+    {
+        const double Predicted = (Coefficients[Predictor * 2] * State.Previous +
+            Coefficients[Predictor * 2 + 1] * State.Before) / 2048.0;
+        Nibbles[i] = std::clamp(static_cast<int>(std::lround((Samples[i] - Predicted) / Scale)), -8, 7);
+        const int16_t Decoded = Adpcm::DecodeSample(Nibbles[i], Header, Coefficients, State);
+        Error += static_cast<double>(Samples[i] - Decoded) * (Samples[i] - Decoded);
+    }
+    return Error;
+}
+
+/**
+ * Encode a sound to DSP-ADPCM.
+ * Every predictor and scale is tried on each frame, the one of lowest error
+ * is kept.
+ * @param[in] Samples The sound.
+ * @param[in] Coefficients The 16 coefficients.
+ * @return The frames.
+ */
+static std::vector<uint8_t> Encode(const std::vector<int16_t> &Samples, const std::vector<int16_t> &Coefficients)
+{
+    std::vector<uint8_t> Frames;
+    Adpcm::History State;
+    for(size_t Start = 0; Start < Samples.size(); Start += Adpcm::SAMPLES_PER_FRAME)
+    {
+        int16_t Frame[Adpcm::SAMPLES_PER_FRAME] = {};
+        std::copy_n(Samples.begin() + Start, std::min<size_t>(Adpcm::SAMPLES_PER_FRAME, Samples.size() - Start), Frame);
+
+        double BestError = std::numeric_limits<double>::max();
+        uint8_t BestHeader = 0;
+        int BestNibbles[Adpcm::SAMPLES_PER_FRAME] = {};
+        Adpcm::History BestState;
+        for(uint8_t Predictor = 0; Predictor < 8; ++Predictor)
+        {
+            for(uint8_t Exponent = 0; Exponent <= 11; ++Exponent)
+            {
+                const uint8_t Header = (Predictor << 4) | Exponent;
+                Adpcm::History Trial = State;
+                int Nibbles[Adpcm::SAMPLES_PER_FRAME];
+                const double Error = EncodeFrame(Frame, Header, Coefficients.data(), Trial, Nibbles);
+                if(Error < BestError)
+                {
+                    BestError = Error;
+                    BestHeader = Header;
+                    BestState = Trial;
+                    std::copy(std::begin(Nibbles), std::end(Nibbles), BestNibbles);
+                }
+            }
+        }
+        State = BestState;
+        Frames.push_back(BestHeader);
+        for(uint32_t i = 0; i < Adpcm::SAMPLES_PER_FRAME; i += 2)
+        {
+            Frames.push_back(static_cast<uint8_t>(((BestNibbles[i] & 0x0F) << 4) | (BestNibbles[i + 1] & 0x0F)));
+        }
+    }
+    return Frames;
+}
+
+/**
+ * Get the signal to noise ratio of a decoded sound.
+ * @return The ratio in decibels.
+ */
+static double GetSignalToNoise(const std::vector<int16_t> &Original, const std::vector<int16_t> &Decoded)
+{
+    double Signal = 0.0, Noise = 0.0;
+    for(size_t i = 0; i < Original.size(); ++i)
+    {
+        Signal += static_cast<double>(Original[i]) * Original[i];
+        Noise += static_cast<double>(Original[i] - Decoded[i]) * (Original[i] - Decoded[i]);
+    }
+    return (Noise == 0.0) ? std::numeric_limits<double>::infinity() : 10.0 * std::log10(Signal / Noise);
+}
+
+/**
+ * Write the generated header.
+ */
+static bool WriteHeader(const ConvertOptions &Options)
+{
+    const std::string Path = Options.OutputDir + "/" + Options.Name + ".h";
+    FILE *File = std::fopen(Path.c_str(), "w");
+    if(File == nullptr)
+    {
+        return false;
+    }
+    std::fprintf(File,
+        "/**\n"
+        " * This file was autogenerated by sfxconv. Do not edit.\n"
+        " */\n\n"
+        "#ifndef _%s_h_\n"
+        "#define _%s_h_\n\n"
+        "#include \"sound.h\"\n\n"
+        "extern const Sound %s;\n\n"
+        "#endif //_%s_h_\n",
+        Options.Name.c_str(), Options.Name.c_str(), Options.Name.c_str(), Options.Name.c_str());
+    return std::fclose(File) == 0;
+}
+
+/**
+ * Write the generated source file.
+ * @param[in] Options The command line options.
+ * @param[in] Data The samples, big-endian PCM or ADPCM frames.
+ * @param[in] SampleCount Number of samples.
+ * @param[in] Coefficients The ADPCM coefficients, empty for PCM.
+ */
+static bool WriteSource(const ConvertOptions &Options, const std::vector<uint8_t> &Data,
+    size_t SampleCount, const std::vector<int16_t> &Coefficients)
+{
+    const std::string Path = Options.OutputDir + "/" + Options.Name + ".cpp";
+    FILE *File = std::fopen(Path.c_str(), "w");
+    if(File == nullptr)
+    {
+        return false;
+    }
+    std::fprintf(File,
+        "/**\n"
+        " * This file was autogenerated by sfxconv. Do not edit.\n"
+        " */\n\n"
+        "#include \"%s.h\"\n\n"
+        "alignas(32) static const u8 Data[] = {",
+        Options.Name.c_str());
+    for(size_t i = 0; i < Data.size(); ++i)
+    {
+        std::fprintf(File, "%s0x%02X,", (i % 16 == 0) ? "\n\t" : " ", Data[i]);
+    }
+    std::fputs("\n};\n\n", File);
+
+    if(Coefficients.empty())
+    {
+        std::fprintf(File, "const Sound %s(SoundFormat::Mono16, Data, %.1ff);\n",
+            Options.Name.c_str(), Options.OutputRate);
+    }
+    else
+    {
+        std::fputs("static const s16 Coefficients[] = {", File);
+        for(size_t i = 0; i < Coefficients.size(); ++i)
+        {
+            std::fprintf(File, "%s%d", (i == 0) ? "" : ", ", Coefficients[i]);
+        }
+        std::fprintf(File, "};\n\nconst Sound %s(SoundFormat::MonoAdpcm, Data, %.1ff, %zu, Coefficients);\n",
+            Options.Name.c_str(), Options.OutputRate, SampleCount);
+    }
+    return std::fclose(File) == 0;
+}
+
+/**
+ * Write a standard .dsp file: a 96-byte big-endian header followed by the
+ * frames.
+ * @param[in] Options The command line options.
+ * @param[in] Data The ADPCM frames.
+ * @param[in] SampleCount Number of samples.
+ * @param[in] Coefficients The ADPCM coefficients.
+ */
+static bool WriteDsp(const ConvertOptions &Options, const std::vector<uint8_t> &Data,
+    size_t SampleCount, const std::vector<int16_t> &Coefficients)
+{
+    std::vector<uint8_t> Header;
+    const auto Put16 = [&Header](uint32_t Value)
+    {
+        Header.push_back(static_cast<uint8_t>(Value >> 8));
+        Header.push_back(static_cast<uint8_t>(Value & 0xFF));
+    };
+    const auto Put32 = [&Put16](uint32_t Value)
+    {
+        Put16(Value >> 16);
+        Put16(Value & 0xFFFF);
+    };
+    // Each frame is a header byte (2 nibbles) then 14 nibbles
+    const size_t Tail = SampleCount % Adpcm::SAMPLES_PER_FRAME;
+    const uint32_t Nibbles = static_cast<uint32_t>(SampleCount / Adpcm::SAMPLES_PER_FRAME * 16 + (Tail ? Tail + 2 : 0));
+
+    Put32(static_cast<uint32_t>(SampleCount));
+    Put32(Nibbles);
+    Put32(static_cast<uint32_t>(Options.OutputRate));
+    Put16(0);               // Not looped
+    Put16(0);               // ADPCM
+    Put32(2);               // Loop start, nibble address
+    Put32(Nibbles - 1);     // Loop end
+    Put32(2);               // Current address
+    for(const int16_t Coefficient : Coefficients)
+    {
+        Put16(static_cast<uint16_t>(Coefficient));
+    }
+    Put16(0);               // Gain
+    Put16(Data.empty() ? 0 : Data[0]); // First frame header
+    Put16(0);               // History
+    Put16(0);
+    Header.resize(0x60, 0); // Loop context and padding
+
+    const std::string Path = Options.OutputDir + "/" + Options.Name + ".dsp";
+    std::ofstream File(Path, std::ios::binary);
+    File.write(reinterpret_cast<const char*>(Header.data()), Header.size());
+    File.write(reinterpret_cast<const char*>(Data.data()), Data.size());
+    return File.good();
+}
+
+/**
+ * Entry point.
+ * @param[in] argc The number of arguments invoked with the program.
+ * @param[in] argv The array containing the arguments.
+ * @return 0 on success, 1 on error.
+ */
+int main(int argc, char **argv)
+{
+    ConvertOptions Options;
+    if(!ParseOptions(argc, argv, Options))
+    {
+        Usage();
+        return 1;
+    }
+
+    const std::vector<double> Input = ReadSamples(Options);
+    if(Input.empty())
+    {
+        std::fprintf(stderr, "sfxconv: cannot read %s\n", Options.InputFile.c_str());
+        return 1;
+    }
+    const std::vector<int16_t> Samples = Quantize(Resample(Input, Options.OutputRate / Options.InputRate));
+
+    std::vector<uint8_t> Data;
+    std::vector<int16_t> Coefficients;
+    if(Options.Compress)
+    {
+        Coefficients = BuildCoefficients(Samples);
+        Data = Encode(Samples, Coefficients);
+        std::vector<s16> Decoded(Samples.size());
+        Adpcm::Decode(Data, Coefficients.data(), Decoded);
+        std::printf("sfxconv: %s, %zu samples, %zu bytes, %.1f dB SNR\n", Options.Name.c_str(),
+            Samples.size(), Data.size(), GetSignalToNoise(Samples, Decoded));
+    }
+    else
+    {
+        for(const int16_t Sample : Samples)
+        {   // Big-endian, like the Wii
+            Data.push_back(static_cast<uint8_t>(static_cast<uint16_t>(Sample) >> 8));
+            Data.push_back(static_cast<uint8_t>(Sample & 0xFF));
+        }
+        std::printf("sfxconv: %s, %zu samples, %zu bytes\n", Options.Name.c_str(), Samples.size(), Data.size());
+    }
+
+    const bool Written = Options.DspFile ?
+        WriteDsp(Options, Data, Samples.size(), Coefficients) :
+        (WriteHeader(Options) && WriteSource(Options, Data, Samples.size(), Coefficients));
+    if(!Written)
+    {
+        std::fputs("sfxconv: cannot write the output files\n", stderr);
+        return 1;
+    }
+    return 0;
+}
+
+// EOF